@@ -15,6 +15,7 @@ prefix=
 path=
 
 gmp=no
+bvlimb64=no
 
 lingeling=unknown
 minisat=unknown
@@ -67,6 +68,7 @@ where <option> is one of the following:
   --time-stats      compile with time statistics
 
   --gmp             use gmp for bit-vector implementation
+  --bv-limb64       use 64-bit limbs for non-gmp bit-vector implementation
 
 By default all supported SAT solvers available are used and linked.
 If explicitly enabled, configuration will fail if the SAT solver library
@@ -141,6 +143,7 @@ do
     --time-stats) timestats=yes;;
 
     --gmp) gmp=yes;;
+    --bv-limb64) bvlimb64=yes;;
 
     --no-cadical)   cadical=no;;
     --no-cms)       cms=no;;
@@ -176,6 +179,7 @@ cmake_opts="$CMAKE_OPTS"
 [ -n "$path" ] && cmake_opts="$cmake_opts -DCMAKE_PREFIX_PATH=$path"
 
 [ $gmp = yes ] && cmake_opts="$cmake_opts -DUSE_GMP=ON"
+[ $bvlimb64 = yes ] && cmake_opts="$cmake_opts -DUSE_BV_LIMB64=ON"
 
 [ $cadical = yes ] && cmake_opts="$cmake_opts -DUSE_CADICAL=ON"
 [ $cms = yes ] && cmake_opts="$cmake_opts -DUSE_CMS=ON"
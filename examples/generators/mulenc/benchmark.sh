@@ -0,0 +1,73 @@
+#!/bin/bash
+#
+# Compare the multiplier encodings (option 'mul-enc') on the mulcom, mulass,
+# umulo and smulo benchmark families.  For every instance and encoding, the
+# result, the number of CNF clauses and the run time are printed.  Run via
+# 'make benchmark', 'make all' (as invoked from examples/generators) does
+# not run it.
+#
+dir="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+boolector=${BOOLECTOR:-$dir/../../../build/bin/boolector}
+if [ ! -e $boolector ]
+then
+  echo "[error] Boolector not built"
+  exit 1
+fi
+
+timeout=60
+encodings="array booth wallace dadda"
+TIMEFORMAT=%R
+
+usage ()
+{
+  echo "usage: $(basename $0) [-t <seconds>] [-e <encodings>]"
+  echo
+  echo "  -t <seconds>    time limit per instance (default: $timeout)"
+  echo "  -e <encodings>  space separated list of encodings"
+  echo "                  (default: \"$encodings\")"
+  exit 1
+}
+
+while [ $# -gt 0 ]
+do
+  case $1 in
+    -t) shift; timeout=$1;;
+    -e) shift; encodings=$1;;
+    *) usage;;
+  esac
+  shift
+done
+
+run ()
+{
+  local name=$1 file=$2 enc res clauses time
+  shift 2
+  for enc in $encodings
+  do
+    time=$( { time timeout $timeout $boolector -v --mul-enc=$enc $* $file \
+              > $name-$enc.log 2>&1; } 2>&1 )
+    res=$(grep -E '^(sat|unsat)$' $name-$enc.log)
+    clauses=$(sed -e '/CNF clauses$/!d' -e 's, *CNF clauses,,' -e 's,.* ,,' \
+              $name-$enc.log | tail -n 1)
+    printf "%-16s %-8s %-6s %10s %8s\n" \
+      $name $enc ${res:-unknown} ${clauses:-?} $time
+  done
+}
+
+printf "%-16s %-8s %-6s %10s %8s\n" instance encoding result clauses time
+for bits in 4 6 8 10 12
+do
+  n=`printf '%02d' $bits`
+  sed -e "s,@,$bits," $dir/../mulcom/mulcom.template > mulcom$n.smt2
+  run mulcom$n mulcom$n.smt2 -rwl 2 --no-sort-exp --no-sort-aigvec
+  sed -e "s,@,$bits," $dir/../mulass/mulass.template > mulass$n.smt2
+  run mulass$n mulass$n.smt2 -rwl 2
+done
+for bits in 8 16 32 64
+do
+  n=`printf '%02d' $bits`
+  $dir/../umulo/umulov1.sh $bits > umulov1bw$n.btor
+  run umulov1bw$n umulov1bw$n.btor
+  $dir/../smulo/smulov1.sh $bits > smulov1bw$n.btor
+  run smulov1bw$n smulov1bw$n.btor
+done
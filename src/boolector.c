@@ -391,6 +391,31 @@ boolector_print_stats (Btor *btor)
 #endif
 }
 
+size_t
+boolector_get_mem_allocated (Btor *btor, const char *category)
+{
+  size_t res;
+  BtorMemTag tag;
+
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_TRAPI ("%s", category ? category : "(null)");
+  if (!category)
+    res = btor->mm->allocated + btor->mm->sat_allocated;
+  else if (!strcmp (category, "SAT solver"))
+    res = btor->mm->sat_allocated;
+  else
+  {
+    for (tag = 0; tag < BTOR_MEM_TAG_NUM; tag++)
+      if (!strcmp (category, btor_mem_tag_name (tag))) break;
+    BTOR_ABORT (tag == BTOR_MEM_TAG_NUM,
+                "invalid memory category '%s'",
+                category);
+    res = btor_mem_tag_allocated (btor->mm, tag);
+  }
+  BTOR_TRAPI_RETURN ("%zu", res);
+  return res;
+}
+
 void
 boolector_set_trapi (Btor *btor, FILE *apitrace)
 {
@@ -419,11 +444,16 @@ boolector_push (Btor *btor, uint32_t level)
   if (level == 0) return;
 
   uint32_t i;
+  BtorSortId sort;
+
+  sort = btor_sort_bool (btor);
   for (i = 0; i < level; i++)
   {
     BTOR_PUSH_STACK (btor->assertions_trail,
                      BTOR_COUNT_STACK (btor->assertions));
+    BTOR_PUSH_STACK (btor->assertions_act, btor_exp_var (btor, sort, 0));
   }
+  btor_sort_release (btor, sort);
   btor->num_push_pop++;
 }
 
@@ -445,7 +475,10 @@ boolector_pop (Btor *btor, uint32_t level)
   BtorNode *cur;
 
   for (i = 0, pos = 0; i < level; i++)
+  {
     pos = BTOR_POP_STACK (btor->assertions_trail);
+    btor_disable_activation_exp (btor, BTOR_POP_STACK (btor->assertions_act));
+  }
 
   while (BTOR_COUNT_STACK (btor->assertions) > pos)
   {
@@ -477,15 +510,20 @@ boolector_assert (Btor *btor, BoolectorNode *node)
   BTOR_ABORT (btor_node_real_addr (exp)->parameterized,
               "assertion must not be parameterized");
 
-  /* all assertions at a context level > 0 are internally handled as
-   * assumptions. */
+  /* all assertions at a context level > 0 are internally guarded by the
+   * activation variable of the current context level, which is assumed on
+   * every sat call and disabled on pop. */
   if (BTOR_COUNT_STACK (btor->assertions_trail) > 0)
   {
     int32_t id = btor_node_get_id (exp);
     if (!btor_hashint_table_contains (btor->assertions_cache, id))
     {
+      BtorNode *imp;
       BTOR_PUSH_STACK (btor->assertions, btor_node_copy (btor, exp));
       btor_hashint_table_add (btor->assertions_cache, id);
+      imp = btor_exp_implies (btor, BTOR_TOP_STACK (btor->assertions_act), exp);
+      btor_assert_exp (btor, imp);
+      btor_node_release (btor, imp);
     }
   }
   else
@@ -660,6 +698,21 @@ boolector_limited_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
   return res;
 }
 
+int32_t
+boolector_get_unknown_reason (Btor *btor)
+{
+  int32_t res;
+
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_TRAPI ("");
+  res = btor->unknown_reason;
+  BTOR_TRAPI_RETURN_INT (res);
+#ifndef NDEBUG
+  BTOR_CHKCLONE_RES_INT (res, get_unknown_reason);
+#endif
+  return res;
+}
+
 /*------------------------------------------------------------------------*/
 
 int32_t
@@ -55,6 +55,38 @@ extern "C" {
     boolector_parse
 */
 #define BOOLECTOR_PARSE_UNKNOWN 2
+/*!
+  Preprocessor constant representing that the last call to boolector_sat or
+  boolector_limited_sat did not return ``unknown``.
+
+  .. seealso::
+    boolector_get_unknown_reason
+*/
+#define BOOLECTOR_UNKNOWN_REASON_NONE BTOR_UNKNOWN_REASON_NONE
+/*!
+  Preprocessor constant representing an ``unknown`` result due to an
+  incomplete engine or an exceeded lemma or conflict limit.
+
+  .. seealso::
+    boolector_get_unknown_reason
+*/
+#define BOOLECTOR_UNKNOWN_REASON_INCOMPLETE BTOR_UNKNOWN_REASON_INCOMPLETE
+/*!
+  Preprocessor constant representing an ``unknown`` result due to the
+  termination callback.
+
+  .. seealso::
+    boolector_get_unknown_reason, boolector_set_term
+*/
+#define BOOLECTOR_UNKNOWN_REASON_TERMINATED BTOR_UNKNOWN_REASON_TERMINATED
+/*!
+  Preprocessor constant representing an ``unknown`` result due to an
+  exceeded memory limit.
+
+  .. seealso::
+    boolector_get_unknown_reason, BTOR_OPT_MEMORY_LIMIT
+*/
+#define BOOLECTOR_UNKNOWN_REASON_MEMORY BTOR_UNKNOWN_REASON_MEMORY
 
 /*------------------------------------------------------------------------*/
 
@@ -178,6 +210,21 @@ void boolector_reset_stats (Btor *btor);
 */
 void boolector_print_stats (Btor *btor);
 
+/*!
+  Get the number of bytes currently allocated in a memory category.
+
+  The categories are the ones reported in the memory statistics printed by
+  boolector_print_stats: ``"other"``, ``"nodes"``, ``"AIGs"``,
+  ``"AIG vectors"``, ``"bit-vectors"``, ``"hash tables"``,
+  ``"rewrite cache"``, ``"beta reduction"``, ``"models"``, ``"clones"`` and
+  ``"SAT solver"``.
+
+  :param btor: Boolector instance.
+  :param category: Memory category, or 0 for the total over all categories.
+  :return: The number of bytes allocated in the given category.
+*/
+size_t boolector_get_mem_allocated (Btor *btor, const char *category);
+
 /*!
   Set the output API trace file and enable API tracing.
 
@@ -365,6 +412,22 @@ int32_t boolector_limited_sat (Btor *btor,
                                int32_t lod_limit,
                                int32_t sat_limit);
 
+/*!
+  Get the reason why the last call to boolector_sat or boolector_limited_sat
+  returned BOOLECTOR_UNKNOWN.
+
+  :param btor: Boolector instance.
+  :return: BOOLECTOR_UNKNOWN_REASON_MEMORY if the memory limit was exceeded,
+           BOOLECTOR_UNKNOWN_REASON_TERMINATED if the solver was terminated
+           via the termination callback, BOOLECTOR_UNKNOWN_REASON_INCOMPLETE
+           for any other unknown result, and BOOLECTOR_UNKNOWN_REASON_NONE if
+           the last result was not unknown.
+
+  .. seealso::
+    boolector_sat, boolector_limited_sat
+*/
+int32_t boolector_get_unknown_reason (Btor *btor);
+
 /*------------------------------------------------------------------------*/
 
 /*!
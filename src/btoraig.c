@@ -9,9 +9,11 @@
 #include "btoraig.h"
 
 #include "btorabort.h"
+#include "btoraigrw.h"
 #include "btorcore.h"
 #include "btorsat.h"
 #include "utils/btoraigmap.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btorutil.h"
 
@@ -29,18 +31,23 @@
     assert (mm);                              \
     (table).size         = 1;                 \
     (table).num_elements = 0;                 \
-    BTOR_CNEW (mm, (table).chains);           \
+    BTOR_CNEW_TAG (mm, BTOR_MEM_TAG_AIG, (table).chains); \
   } while (0)
 
-#define BTOR_RELEASE_AIG_UNIQUE_TABLE(mm, table)     \
-  do                                                 \
-  {                                                  \
-    assert (mm);                                     \
-    BTOR_DELETEN (mm, (table).chains, (table).size); \
+#define BTOR_RELEASE_AIG_UNIQUE_TABLE(mm, table)             \
+  do                                                         \
+  {                                                          \
+    assert (mm);                                             \
+    BTOR_DELETEN_TAG (mm, BTOR_MEM_TAG_AIG, (table).chains, (table).size); \
+    BTOR_DELETEN_TAG (                                                    \
+        mm, BTOR_MEM_TAG_AIG, (table).old_chains, (table).old_size);      \
   } while (0)
 
 #define BTOR_AIG_UNIQUE_TABLE_LIMIT 30
 
+/* Number of old chains migrated per insertion while resizing. */
+#define BTOR_AIG_UNIQUE_TABLE_MIGRATE 8
+
 #define BTOR_AIG_UNIQUE_TABLE_PRIME 2000000137u
 
 #define BTOR_FIND_AND_AIG_CONTRADICTION_LIMIT 8
@@ -57,23 +64,72 @@
 
 #define BTOR_AIG_TO_CNF_EXTRACT_XOR
 
-// #define BTOR_AIG_TO_CNF_NARY_AND
+/*------------------------------------------------------------------------*/
+
+/* Polarities in which the definition of an AIG is encoded to CNF. */
+#define BTOR_AIG_POL_POS 1u
+#define BTOR_AIG_POL_NEG 2u
+#define BTOR_AIG_POL_BOTH (BTOR_AIG_POL_POS | BTOR_AIG_POL_NEG)
+#define BTOR_AIG_POL_FLIP(pol) ((((pol) &1u) << 1) | (((pol) >> 1) & 1u))
+/* Internal flag for 'aig_to_sat_pol', counts a reference from the cone. */
+#define BTOR_AIG_POL_EDGE 4u
+
+enum BtorAIGGateKind
+{
+  BTOR_AIG_GATE_AND,
+  BTOR_AIG_GATE_XOR,
+  BTOR_AIG_GATE_ITE,
+};
+typedef enum BtorAIGGateKind BtorAIGGateKind;
 
 /*------------------------------------------------------------------------*/
 
 static void
-setup_aig_and_add_to_id_table (BtorAIGMgr *amgr, BtorAIG *aig)
+new_aig_page (BtorAIGMgr *amgr)
 {
+  BtorAIG *page;
+
+  BTOR_CNEWN_TAG (amgr->btor->mm, BTOR_MEM_TAG_AIG, page, BTOR_AIG_PAGE_SIZE);
+  BTOR_PUSH_STACK (amgr->pages, page);
+  BTOR_PUSH_STACK (amgr->page_refs, 0);
+  amgr->num_pages++;
+}
+
+static void
+delete_aig_page (BtorAIGMgr *amgr, uint32_t idx)
+{
+  assert (amgr->pages.start[idx]);
+  assert (!amgr->page_refs.start[idx]);
+  BTOR_DELETEN_TAG (amgr->btor->mm,
+                    BTOR_MEM_TAG_AIG,
+                    amgr->pages.start[idx],
+                    BTOR_AIG_PAGE_SIZE);
+  amgr->pages.start[idx] = 0;
+  assert (amgr->num_pages > 0);
+  amgr->num_pages--;
+}
+
+static BtorAIG *
+new_aig (BtorAIGMgr *amgr)
+{
+  BtorAIG *aig;
   int32_t id;
+  uint32_t page;
 
-  id = BTOR_COUNT_STACK (amgr->id2aig);
+  id = amgr->num_ids;
   BTOR_ABORT (id == INT32_MAX, "AIG id overflow");
+  page = (uint32_t) id >> BTOR_AIG_PAGE_BITS;
+  if (page == BTOR_COUNT_STACK (amgr->pages)) new_aig_page (amgr);
+  assert (page + 1 == BTOR_COUNT_STACK (amgr->pages));
+  amgr->page_refs.start[page]++;
+  amgr->num_ids++;
+  aig = amgr->pages.start[page] + (id & BTOR_AIG_PAGE_MASK);
+  assert (!aig->id);
   aig->refs = 1;
   aig->id   = id;
-  BTOR_PUSH_STACK (amgr->id2aig, aig);
   assert (aig->id >= 0);
-  assert (BTOR_COUNT_STACK (amgr->id2aig) == (size_t) aig->id + 1);
-  assert (BTOR_PEEK_STACK (amgr->id2aig, aig->id) == aig);
+  assert (btor_aig_get_by_id (amgr, aig->id) == aig);
+  return aig;
 }
 
 static BtorAIG *
@@ -84,12 +140,8 @@ new_and_aig (BtorAIGMgr *amgr, BtorAIG *left, BtorAIG *right)
   assert (!btor_aig_is_const (right));
 
   BtorAIG *aig;
-  size_t size;
 
-  size = sizeof (BtorAIG) + 2 * sizeof (int32_t);
-  aig  = btor_mem_malloc (amgr->btor->mm, size);
-  memset (aig, 0, size);
-  setup_aig_and_add_to_id_table (amgr, aig);
+  aig              = new_aig (amgr);
   aig->children[0] = btor_aig_get_id (left);
   aig->children[1] = btor_aig_get_id (right);
   amgr->cur_num_aigs++;
@@ -108,7 +160,8 @@ release_cnf_id_aig_mgr (BtorAIGMgr *amgr, BtorAIG *aig)
   if (amgr->smgr->have_restore) return;
   amgr->cnfid2aig.start[aig->cnf_id] = 0;
   btor_sat_mgr_release_cnf_id (amgr->smgr, aig->cnf_id);
-  aig->cnf_id = 0;
+  aig->cnf_id  = 0;
+  aig->encoded = 0;
 }
 
 static void
@@ -117,55 +170,69 @@ delete_aig_node (BtorAIGMgr *amgr, BtorAIG *aig)
   assert (!BTOR_IS_INVERTED_AIG (aig));
   assert (amgr);
   if (btor_aig_is_const (aig)) return;
+
+  uint32_t page;
+
   if (aig->cnf_id) release_cnf_id_aig_mgr (amgr, aig);
-  amgr->id2aig.start[aig->id] = 0;
   if (aig->is_var)
-  {
     amgr->cur_num_aig_vars--;
-    BTOR_DELETE (amgr->btor->mm, aig);
-  }
   else
-  {
     amgr->cur_num_aigs--;
-    btor_mem_free (
-        amgr->btor->mm, aig, sizeof (BtorAIG) + 2 * sizeof (int32_t));
-  }
+  page = (uint32_t) aig->id >> BTOR_AIG_PAGE_BITS;
+  memset (aig, 0, sizeof *aig);
+  assert (amgr->page_refs.start[page] > 0);
+  amgr->page_refs.start[page]--;
+  /* release page if all of its AIGs have been allocated and deleted */
+  if (!amgr->page_refs.start[page]
+      && (page + 1) * BTOR_AIG_PAGE_SIZE <= (uint32_t) amgr->num_ids)
+    delete_aig_page (amgr, page);
 }
 
 static uint32_t
-hash_aig (int32_t id0, int32_t id1, uint32_t table_size)
+hash_aig (int32_t id0, int32_t id1)
 {
   uint32_t hash;
-  assert (table_size > 0);
-  assert (btor_util_is_power_of_2 (table_size));
   hash = 547789289u * (uint32_t) abs (id0);
   hash += 786695309u * (uint32_t) abs (id1);
   hash *= BTOR_AIG_UNIQUE_TABLE_PRIME;
-  hash &= table_size - 1;
   return hash;
 }
 
 static uint32_t
-compute_aig_hash (BtorAIG *aig, uint32_t table_size)
+compute_aig_hash (BtorAIG *aig)
 {
   uint32_t hash;
   assert (!BTOR_IS_INVERTED_AIG (aig));
   assert (btor_aig_is_and (aig));
-  hash = hash_aig (aig->children[0], aig->children[1], table_size);
+  hash = hash_aig (aig->children[0], aig->children[1]);
   return hash;
 }
 
+/* Returns the chain that holds AIGs with given hash value. */
+static inline int32_t *
+get_aig_unique_table_chain (BtorAIGUniqueTable *table, uint32_t hash)
+{
+  uint32_t i;
+
+  if (table->old_chains)
+  {
+    i = hash & (table->old_size - 1);
+    if (i >= table->migrated) return table->old_chains + i;
+  }
+  return table->chains + (hash & (table->size - 1));
+}
+
 static void
 delete_aig_nodes_unique_table_entry (BtorAIGMgr *amgr, BtorAIG *aig)
 {
-  uint32_t hash;
+  int32_t *chain;
   BtorAIG *cur, *prev;
   assert (amgr);
   assert (!BTOR_IS_INVERTED_AIG (aig));
   assert (btor_aig_is_and (aig));
-  prev = 0;
-  hash = compute_aig_hash (aig, amgr->table.size);
-  cur  = btor_aig_get_by_id (amgr, amgr->table.chains[hash]);
+  prev  = 0;
+  chain = get_aig_unique_table_chain (&amgr->table, compute_aig_hash (aig));
+  cur   = btor_aig_get_by_id (amgr, *chain);
   while (cur != aig)
   {
     assert (!BTOR_IS_INVERTED_AIG (cur));
@@ -174,7 +241,7 @@ delete_aig_nodes_unique_table_entry (BtorAIGMgr *amgr, BtorAIG *aig)
   }
   assert (cur);
   if (!prev)
-    amgr->table.chains[hash] = cur->next;
+    *chain = cur->next;
   else
     prev->next = cur->next;
   amgr->table.num_elements--;
@@ -216,9 +283,8 @@ find_and_aig (BtorAIGMgr *amgr, BtorAIG *left, BtorAIG *right)
   }
 
   hash   = hash_aig (BTOR_REAL_ADDR_AIG (left)->id,
-                   BTOR_REAL_ADDR_AIG (right)->id,
-                   amgr->table.size);
-  result = amgr->table.chains + hash;
+                   BTOR_REAL_ADDR_AIG (right)->id);
+  result = get_aig_unique_table_chain (&amgr->table, hash);
   cur    = btor_aig_get_by_id (amgr, *result);
   while (cur)
   {
@@ -249,38 +315,94 @@ find_and_aig_node (BtorAIGMgr *amgr, BtorAIG *left, BtorAIG *right)
   return res;
 }
 
+/* Moves at most 'n' old chains to the new chains. */
 static void
-enlarge_aig_nodes_unique_table (BtorAIGMgr *amgr)
+migrate_aig_nodes_unique_table (BtorAIGMgr *amgr, uint32_t n)
 {
-  BtorMemMgr *mm;
-  int32_t *new_chains;
-  uint32_t i, size, new_size;
+  BtorAIGUniqueTable *table;
   uint32_t hash;
-  BtorAIG *temp = 0;
-  BtorAIG *cur  = 0;
+  BtorAIG *cur;
+  int32_t temp;
   assert (amgr);
-  size     = amgr->table.size;
-  new_size = size << 1;
-  assert (new_size / size == 2);
-  mm = amgr->btor->mm;
-  BTOR_CNEWN (mm, new_chains, new_size);
-  for (i = 0; i < size; i++)
+  table = &amgr->table;
+  assert (table->old_chains);
+  for (; n > 0 && table->migrated < table->old_size; n--, table->migrated++)
   {
-    cur = btor_aig_get_by_id (amgr, amgr->table.chains[i]);
+    cur = btor_aig_get_by_id (amgr, table->old_chains[table->migrated]);
+    table->old_chains[table->migrated] = 0;
     while (cur)
     {
       assert (!BTOR_IS_INVERTED_AIG (cur));
       assert (btor_aig_is_and (cur));
-      temp             = btor_aig_get_by_id (amgr, cur->next);
-      hash             = compute_aig_hash (cur, new_size);
-      cur->next        = new_chains[hash];
-      new_chains[hash] = cur->id;
-      cur              = temp;
+      temp                = cur->next;
+      hash                = compute_aig_hash (cur) & (table->size - 1);
+      cur->next           = table->chains[hash];
+      table->chains[hash] = cur->id;
+      cur                 = btor_aig_get_by_id (amgr, temp);
     }
   }
-  BTOR_RELEASE_AIG_UNIQUE_TABLE (mm, amgr->table);
-  amgr->table.size   = new_size;
-  amgr->table.chains = new_chains;
+  if (table->migrated == table->old_size)
+  {
+    BTOR_DELETEN_TAG (amgr->btor->mm,
+                      BTOR_MEM_TAG_AIG,
+                      table->old_chains,
+                      table->old_size);
+    table->old_chains = 0;
+    table->old_size   = 0;
+    table->migrated   = 0;
+  }
+}
+
+/* Enlarges unique table if necessary and migrates some of the old chains.
+ * Returns true if chains have been modified. */
+static bool
+update_aig_nodes_unique_table (BtorAIGMgr *amgr)
+{
+  BtorAIGUniqueTable *table;
+  assert (amgr);
+  table = &amgr->table;
+  if (table->num_elements >= table->size
+      && btor_util_log_2 (table->size) < BTOR_AIG_UNIQUE_TABLE_LIMIT)
+  {
+    if (table->old_chains) migrate_aig_nodes_unique_table (amgr, UINT32_MAX);
+    assert (!table->old_chains);
+    table->old_chains = table->chains;
+    table->old_size   = table->size;
+    table->migrated   = 0;
+    table->size <<= 1;
+    BTOR_CNEWN_TAG (
+        amgr->btor->mm, BTOR_MEM_TAG_AIG, table->chains, table->size);
+  }
+  else if (!table->old_chains)
+    return false;
+  migrate_aig_nodes_unique_table (amgr, BTOR_AIG_UNIQUE_TABLE_MIGRATE);
+  return true;
+}
+
+void
+btor_aig_mgr_compact (BtorAIGMgr *amgr)
+{
+  assert (amgr);
+
+  BtorAIGUniqueTable *table;
+  uint32_t size;
+
+  table = &amgr->table;
+  if (table->old_chains) migrate_aig_nodes_unique_table (amgr, UINT32_MAX);
+  assert (!table->old_chains);
+
+  /* keep the load factor at or below 1/2 to avoid immediate regrowth */
+  size = table->size;
+  while (size > 1 && 2 * table->num_elements <= size / 2) size >>= 1;
+  if (size == table->size) return;
+
+  table->old_chains = table->chains;
+  table->old_size   = table->size;
+  table->migrated   = 0;
+  table->size       = size;
+  BTOR_CNEWN_TAG (amgr->btor->mm, BTOR_MEM_TAG_AIG, table->chains, size);
+  migrate_aig_nodes_unique_table (amgr, UINT32_MAX);
+  assert (!table->old_chains);
 }
 
 BtorAIG *
@@ -352,8 +474,7 @@ btor_aig_var (BtorAIGMgr *amgr)
 {
   BtorAIG *aig;
   assert (amgr);
-  BTOR_CNEW (amgr->btor->mm, aig);
-  setup_aig_and_add_to_id_table (amgr, aig);
+  aig         = new_aig (amgr);
   aig->is_var = 1;
   amgr->cur_num_aig_vars++;
   if (amgr->max_num_aig_vars < amgr->cur_num_aig_vars)
@@ -409,6 +530,10 @@ simp_aig_by_sat (BtorAIGMgr *amgr, BtorAIG *aig)
    * (returns 0) FIXME why? */
   if (btor_aig_is_const (aig)) return aig;
 
+  /* the SAT assignment of partially encoded AIGs is not determined by their
+   * inputs */
+  if (BTOR_REAL_ADDR_AIG (aig)->encoded != BTOR_AIG_POL_BOTH) return aig;
+
   lit = btor_aig_get_cnf_id (aig);
   if (!lit) return aig;
   val = btor_sat_fixed (amgr->smgr, lit);
@@ -418,7 +543,7 @@ simp_aig_by_sat (BtorAIGMgr *amgr, BtorAIG *aig)
   assert (repr >= 0);
   assert ((size_t) repr < BTOR_SIZE_STACK (amgr->cnfid2aig));
   res = btor_aig_get_by_id (amgr, amgr->cnfid2aig.start[repr]);
-  if (!res) return aig;
+  if (!res || res->encoded != BTOR_AIG_POL_BOTH) return aig;
   if (sign) res = BTOR_INVERT_AIG (res);
   return res;
 }
@@ -714,12 +839,8 @@ BTOR_AIG_TWO_LEVEL_OPT_TRY_AGAIN:
   res = *lookup ? btor_aig_get_by_id (amgr, *lookup) : 0;
   if (!res)
   {
-    if (amgr->table.num_elements == amgr->table.size
-        && btor_util_log_2 (amgr->table.size) < BTOR_AIG_UNIQUE_TABLE_LIMIT)
-    {
-      enlarge_aig_nodes_unique_table (amgr);
+    if (update_aig_nodes_unique_table (amgr))
       lookup = find_and_aig (amgr, left, right);
-    }
     if (btor_opt_get (amgr->btor, BTOR_OPT_SORT_AIG) > 0
         && real_right->id < real_left->id)
     {
@@ -790,35 +911,17 @@ btor_aig_mgr_new (Btor *btor)
   amgr->btor = btor;
   BTOR_INIT_AIG_UNIQUE_TABLE (btor->mm, amgr->table);
   amgr->smgr = btor_sat_mgr_new (btor);
-  BTOR_INIT_STACK (btor->mm, amgr->id2aig);
-  BTOR_PUSH_STACK (amgr->id2aig, BTOR_AIG_FALSE);
-  BTOR_PUSH_STACK (amgr->id2aig, BTOR_AIG_TRUE);
+  BTOR_INIT_STACK (btor->mm, amgr->pages);
+  BTOR_INIT_STACK (btor->mm, amgr->page_refs);
+  new_aig_page (amgr);
+  /* ids 0 and 1 are reserved for constants FALSE and TRUE */
+  amgr->num_ids = 2;
   assert ((size_t) BTOR_AIG_FALSE == 0);
   assert ((size_t) BTOR_AIG_TRUE == 1);
   BTOR_INIT_STACK (btor->mm, amgr->cnfid2aig);
   return amgr;
 }
 
-static BtorAIG *
-clone_aig (BtorMemMgr *mm, BtorAIG *aig)
-{
-  assert (mm);
-
-  size_t size;
-  BtorAIG *res, *real_aig;
-
-  if (btor_aig_is_const (aig)) return aig;
-
-  real_aig = BTOR_REAL_ADDR_AIG (aig);
-  size     = sizeof (BtorAIG);
-  if (!real_aig->is_var) size += 2 * sizeof (int32_t);
-  res = btor_mem_malloc (mm, size);
-  memcpy (res, real_aig, size);
-
-  res = BTOR_IS_INVERTED_AIG (aig) ? BTOR_INVERT_AIG (res) : res;
-  return res;
-}
-
 static void
 clone_aigs (BtorAIGMgr *amgr, BtorAIGMgr *clone)
 {
@@ -828,32 +931,55 @@ clone_aigs (BtorAIGMgr *amgr, BtorAIGMgr *clone)
   uint32_t i;
   size_t size;
   BtorMemMgr *mm;
-  BtorAIG *aig;
+  BtorAIG *page;
 
   mm = clone->btor->mm;
 
-  /* clone id2aig table */
-  BTOR_INIT_STACK (mm, clone->id2aig);
-  size = BTOR_SIZE_STACK (amgr->id2aig);
+  /* clone AIG pages, AIGs only refer to each other by id and can therefore
+   * be copied as a whole */
+  BTOR_INIT_STACK (mm, clone->pages);
+  BTOR_INIT_STACK (mm, clone->page_refs);
+  size = BTOR_SIZE_STACK (amgr->pages);
   if (size)
   {
-    BTOR_CNEWN (mm, clone->id2aig.start, size);
-    clone->id2aig.end = clone->id2aig.start + size;
-    clone->id2aig.top = clone->id2aig.start + BTOR_COUNT_STACK (amgr->id2aig);
+    BTOR_CNEWN (mm, clone->pages.start, size);
+    clone->pages.end = clone->pages.start + size;
+    clone->pages.top = clone->pages.start + BTOR_COUNT_STACK (amgr->pages);
+    BTOR_CNEWN (mm, clone->page_refs.start, size);
+    clone->page_refs.end = clone->page_refs.start + size;
+    clone->page_refs.top =
+        clone->page_refs.start + BTOR_COUNT_STACK (amgr->page_refs);
+    memcpy (clone->page_refs.start,
+            amgr->page_refs.start,
+            BTOR_COUNT_STACK (amgr->page_refs) * sizeof (uint32_t));
   }
-  for (i = 0; i < BTOR_COUNT_STACK (amgr->id2aig); i++)
+  for (i = 0; i < BTOR_COUNT_STACK (amgr->pages); i++)
   {
-    aig = clone_aig (mm, BTOR_PEEK_STACK (amgr->id2aig, i));
-    BTOR_POKE_STACK (clone->id2aig, i, aig);
+    if (!amgr->pages.start[i]) continue;
+    BTOR_NEWN_TAG (mm, BTOR_MEM_TAG_AIG, page, BTOR_AIG_PAGE_SIZE);
+    memcpy (page, amgr->pages.start[i], BTOR_AIG_PAGE_SIZE * sizeof *page);
+    clone->pages.start[i] = page;
   }
+  clone->num_pages = amgr->num_pages;
+  clone->num_ids   = amgr->num_ids;
 
   /* clone unique table */
-  BTOR_CNEWN (mm, clone->table.chains, amgr->table.size);
+  BTOR_CNEWN_TAG (mm, BTOR_MEM_TAG_AIG, clone->table.chains, amgr->table.size);
   clone->table.size         = amgr->table.size;
   clone->table.num_elements = amgr->table.num_elements;
   memcpy (clone->table.chains,
           amgr->table.chains,
           amgr->table.size * sizeof (int32_t));
+  clone->table.old_size = amgr->table.old_size;
+  clone->table.migrated = amgr->table.migrated;
+  if (amgr->table.old_chains)
+  {
+    BTOR_NEWN_TAG (
+        mm, BTOR_MEM_TAG_AIG, clone->table.old_chains, amgr->table.old_size);
+    memcpy (clone->table.old_chains,
+            amgr->table.old_chains,
+            amgr->table.old_size * sizeof (int32_t));
+  }
 
   /* clone cnfid2aig table */
   BTOR_INIT_STACK (mm, clone->cnfid2aig);
@@ -886,13 +1012,15 @@ btor_aig_mgr_clone (Btor *btor, BtorAIGMgr *amgr)
   res->smgr = btor_sat_mgr_clone (btor, amgr->smgr);
   /* Note: we do not yet clone aigs here (we need the clone of the aig
    *       manager for that). */
-  res->max_num_aigs     = amgr->max_num_aigs;
-  res->max_num_aig_vars = amgr->max_num_aig_vars;
-  res->cur_num_aigs     = amgr->cur_num_aigs;
-  res->cur_num_aig_vars = amgr->cur_num_aig_vars;
-  res->num_cnf_vars     = amgr->num_cnf_vars;
-  res->num_cnf_clauses  = amgr->num_cnf_clauses;
-  res->num_cnf_literals = amgr->num_cnf_literals;
+  res->max_num_aigs       = amgr->max_num_aigs;
+  res->max_num_aig_vars   = amgr->max_num_aig_vars;
+  res->cur_num_aigs       = amgr->cur_num_aigs;
+  res->cur_num_aig_vars   = amgr->cur_num_aig_vars;
+  res->num_cnf_vars       = amgr->num_cnf_vars;
+  res->num_cnf_clauses    = amgr->num_cnf_clauses;
+  res->num_cnf_literals   = amgr->num_cnf_literals;
+  res->num_rw_ands_before = amgr->num_rw_ands_before;
+  res->num_rw_ands_after  = amgr->num_rw_ands_after;
   clone_aigs (amgr, res);
   return res;
 }
@@ -900,6 +1028,7 @@ btor_aig_mgr_clone (Btor *btor, BtorAIGMgr *amgr)
 void
 btor_aig_mgr_delete (BtorAIGMgr *amgr)
 {
+  uint32_t i;
   BtorMemMgr *mm;
   assert (amgr);
   assert (getenv ("BTORLEAK") || getenv ("BTORLEAKAIG")
@@ -907,8 +1036,14 @@ btor_aig_mgr_delete (BtorAIGMgr *amgr)
   mm = amgr->btor->mm;
   BTOR_RELEASE_AIG_UNIQUE_TABLE (mm, amgr->table);
   btor_sat_mgr_delete (amgr->smgr);
-  BTOR_RELEASE_STACK (amgr->id2aig);
+  for (i = 0; i < BTOR_COUNT_STACK (amgr->pages); i++)
+    if (amgr->pages.start[i])
+      BTOR_DELETEN_TAG (
+          mm, BTOR_MEM_TAG_AIG, amgr->pages.start[i], BTOR_AIG_PAGE_SIZE);
+  BTOR_RELEASE_STACK (amgr->pages);
+  BTOR_RELEASE_STACK (amgr->page_refs);
   BTOR_RELEASE_STACK (amgr->cnfid2aig);
+  btor_aig_rw_lib_delete (mm, amgr->rwlib);
   BTOR_DELETE (mm, amgr);
 }
 
@@ -1107,198 +1242,251 @@ is_or_aig (BtorAIGMgr *amgr, BtorAIG *root, BtorAIGPtrStack *leafs)
 }
 #endif
 
-void
-btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
+/* Collect the inputs of the gate rooted at 'root' and return its kind.  For
+ * AND gates with 'nary' enabled, trees of non-shared AND nodes without CNF
+ * id are flattened into one n-ary AND (or, negated, n-ary OR) gate. */
+static BtorAIGGateKind
+get_gate_aig (BtorAIGMgr *amgr,
+              BtorAIG *root,
+              bool nary,
+              BtorAIGPtrStack *tree,
+              BtorAIGPtrStack *leafs)
 {
-  BtorAIGPtrStack stack, tree, leafs, marked;
-  int32_t x, y, a, b, c;
-  bool isxor, isite;
-  BtorAIG *root, *cur;
-  BtorSATMgr *smgr;
-  BtorMemMgr *mm;
-  uint32_t local;
+  BtorAIG *cur;
+
+  assert (BTOR_EMPTY_STACK (*tree));
+  assert (BTOR_EMPTY_STACK (*leafs));
+
+  if (is_xor_aig (amgr, root, leafs)) return BTOR_AIG_GATE_XOR;
+  if (is_ite_aig (amgr, root, leafs)) return BTOR_AIG_GATE_ITE;
+
+  if (!nary)
+  {
+    BTOR_PUSH_STACK (*leafs, btor_aig_get_left_child (amgr, root));
+    BTOR_PUSH_STACK (*leafs, btor_aig_get_right_child (amgr, root));
+    return BTOR_AIG_GATE_AND;
+  }
+
+  BTOR_PUSH_STACK (*tree, btor_aig_get_right_child (amgr, root));
+  BTOR_PUSH_STACK (*tree, btor_aig_get_left_child (amgr, root));
+  while (!BTOR_EMPTY_STACK (*tree))
+  {
+    cur = BTOR_POP_STACK (*tree);
+    if (BTOR_IS_INVERTED_AIG (cur) || btor_aig_is_var (cur) || cur->refs > 1u
+        || cur->cnf_id)
+    {
+      BTOR_PUSH_STACK (*leafs, cur);
+    }
+    else
+    {
+      BTOR_PUSH_STACK (*tree, btor_aig_get_right_child (amgr, cur));
+      BTOR_PUSH_STACK (*tree, btor_aig_get_left_child (amgr, cur));
+    }
+  }
+  return BTOR_AIG_GATE_AND;
+}
+
+/* Returns the polarities required for an input of a gate of kind 'kind'
+ * if the gate itself occurs with polarities 'pol'.  The polarities are
+ * flipped for inverted inputs when the input is processed. */
+static uint32_t
+get_leaf_pol_aig (BtorAIGGateKind kind, uint32_t pol, bool is_cond)
+{
+  if (kind == BTOR_AIG_GATE_XOR || is_cond) return BTOR_AIG_POL_BOTH;
+  return pol;
+}
+
+static void
+add_clause_aig (BtorAIGMgr *amgr, int32_t a, int32_t b, int32_t c)
+{
+  btor_sat_add (amgr->smgr, a);
+  btor_sat_add (amgr->smgr, b);
+  if (c) btor_sat_add (amgr->smgr, c);
+  btor_sat_add (amgr->smgr, 0);
+  amgr->num_cnf_clauses++;
+  amgr->num_cnf_literals += c ? 3 : 2;
+}
+
+/* Encode the definition of 'root' for the polarities in 'pol'.  The inputs
+ * of the gate are already encoded. */
+static void
+encode_gate_aig (BtorAIGMgr *amgr,
+                 BtorAIG *root,
+                 uint32_t pol,
+                 BtorAIGGateKind kind,
+                 BtorAIGPtrStack *leafs)
+{
+  int32_t x, a, b, c;
   BtorAIG **p;
 
-  if (btor_aig_is_const (start)) return;
+  x = root->cnf_id;
+  assert (x);
+
+  if (kind == BTOR_AIG_GATE_XOR)
+  {
+    assert (BTOR_COUNT_STACK (*leafs) == 2);
+    a = btor_aig_get_cnf_id (leafs->start[0]);
+    b = btor_aig_get_cnf_id (leafs->start[1]);
+    if (pol & BTOR_AIG_POL_POS)
+    {
+      add_clause_aig (amgr, -x, a, -b);
+      add_clause_aig (amgr, -x, -a, b);
+    }
+    if (pol & BTOR_AIG_POL_NEG)
+    {
+      add_clause_aig (amgr, x, -a, -b);
+      add_clause_aig (amgr, x, a, b);
+    }
+  }
+  else if (kind == BTOR_AIG_GATE_ITE)
+  {
+    assert (BTOR_COUNT_STACK (*leafs) == 3);
+    a = btor_aig_get_cnf_id (leafs->start[0]);  // else
+    b = btor_aig_get_cnf_id (leafs->start[1]);  // then
+    c = btor_aig_get_cnf_id (leafs->start[2]);  // cond
+    if (pol & BTOR_AIG_POL_POS)
+    {
+      add_clause_aig (amgr, -x, -c, b);
+      add_clause_aig (amgr, -x, c, a);
+    }
+    if (pol & BTOR_AIG_POL_NEG)
+    {
+      add_clause_aig (amgr, x, -c, -b);
+      add_clause_aig (amgr, x, c, -a);
+    }
+  }
+  else
+  {
+    assert (kind == BTOR_AIG_GATE_AND);
+    if (pol & BTOR_AIG_POL_NEG)
+    {
+      for (p = leafs->start; p < leafs->top; p++)
+      {
+        a = btor_aig_get_cnf_id (*p);
+        assert (a);
+        btor_sat_add (amgr->smgr, -a);
+        amgr->num_cnf_literals++;
+      }
+      btor_sat_add (amgr->smgr, x);
+      btor_sat_add (amgr->smgr, 0);
+      amgr->num_cnf_clauses++;
+      amgr->num_cnf_literals++;
+    }
+    if (pol & BTOR_AIG_POL_POS)
+    {
+      for (p = leafs->start; p < leafs->top; p++)
+        add_clause_aig (amgr, -x, btor_aig_get_cnf_id (*p), 0);
+    }
+  }
+  root->encoded |= pol;
+}
+
+/* Translate the cone of 'start' to CNF such that the definitions of all
+ * AIGs are encoded at least for the polarities in which they occur if
+ * 'start' occurs with polarities 'pol' (Plaisted-Greenbaum).  Definitions
+ * that were previously encoded for one polarity only are completed on
+ * demand, which keeps the encoding sound in incremental mode. */
+static void
+aig_to_sat_pol (BtorAIGMgr *amgr, BtorAIG *start, uint32_t pol)
+{
+  BtorAIGPtrStack stack, tree, leafs, marked;
+  BtorIntStack pols;
+  BtorAIGGateKind kind;
+  BtorAIG *root, *cur, **p;
+  BtorMemMgr *mm;
+  uint32_t local, lpol, i;
+  bool nary, edge, expand_first;
 
   assert (amgr);
+  assert (pol);
+
+  if (btor_aig_is_const (start)) return;
 
-  smgr = amgr->smgr;
   mm   = amgr->btor->mm;
+  nary = btor_opt_get (amgr->btor, BTOR_OPT_AIG_CNF_NARY) == 1;
 
   BTOR_INIT_STACK (mm, stack);
+  BTOR_INIT_STACK (mm, pols);
   BTOR_INIT_STACK (mm, tree);
   BTOR_INIT_STACK (mm, leafs);
   BTOR_INIT_STACK (mm, marked);
 
-  start = BTOR_REAL_ADDR_AIG (start);
+  /* Collect all AIGs that need (additional) clauses and the polarities in
+   * which they occur.  The mark of an AIG holds the polarities requested
+   * during this call, its local counter the number of references from
+   * within the cone. */
   BTOR_PUSH_STACK (stack, start);
-
+  BTOR_PUSH_STACK (pols, pol | BTOR_AIG_POL_EDGE);
   while (!BTOR_EMPTY_STACK (stack))
   {
-    root = BTOR_REAL_ADDR_AIG (BTOR_POP_STACK (stack));
-
-    if (root->mark == 2)
-    {
-      assert (root->cnf_id);
-      assert (root->local < root->refs);
-      root->local++;
-      continue;
-    }
-
-    if (root->cnf_id) continue;
+    cur  = BTOR_POP_STACK (stack);
+    lpol = BTOR_POP_STACK (pols);
+    edge = lpol & BTOR_AIG_POL_EDGE;
+    lpol &= BTOR_AIG_POL_BOTH;
+    root = BTOR_REAL_ADDR_AIG (cur);
+    if (BTOR_IS_INVERTED_AIG (cur)) lpol = BTOR_AIG_POL_FLIP (lpol);
 
     if (btor_aig_is_var (root))
     {
-      set_next_id_aig_mgr (amgr, root);
+      if (!root->cnf_id)
+      {
+        set_next_id_aig_mgr (amgr, root);
+        root->encoded = BTOR_AIG_POL_BOTH;
+      }
       continue;
     }
 
-    assert (root->mark < 2);
     assert (btor_aig_is_and (root));
-    assert (BTOR_EMPTY_STACK (tree));
-    assert (BTOR_EMPTY_STACK (leafs));
-
-    if ((isxor = is_xor_aig (amgr, root, &leafs)))
-      isite = 0;
-    else
-      isite = is_ite_aig (amgr, root, &leafs);
-
-    if (!isxor && !isite)
+    if (root->mark)
     {
-#ifdef BTOR_AIG_TO_CNF_NARY_AND
-      BTOR_PUSH_STACK (tree, btor_aig_get_right_child (amgr, root));
-      BTOR_PUSH_STACK (tree, btor_aig_get_left_child (amgr, root));
-
-      while (!BTOR_EMPTY_STACK (tree))
+      if (edge)
       {
-        cur = BTOR_POP_STACK (tree);
-
-        if (BTOR_IS_INVERTED_AIG (cur) || btor_aig_is_var (cur)
-            || cur->refs > 1u || cur->cnf_id)
-        {
-          BTOR_PUSH_STACK (leafs, cur);
-        }
-        else
-        {
-          BTOR_PUSH_STACK (tree, btor_aig_get_right_child (amgr, cur));
-          BTOR_PUSH_STACK (tree, btor_aig_get_left_child (amgr, cur));
-        }
+        assert (root->local < root->refs);
+        root->local++;
       }
-#else
-      BTOR_PUSH_STACK (leafs, btor_aig_get_left_child (amgr, root));
-      BTOR_PUSH_STACK (leafs, btor_aig_get_right_child (amgr, root));
-#endif
+      lpol &= ~(root->mark | root->encoded);
+      if (!lpol) continue;
+      root->mark |= lpol;
+      expand_first = false;
     }
-
-    if (root->mark == 0)
+    else
     {
-      root->mark = 1;
-      assert (root->refs >= 1);
-      assert (!root->local);
+      lpol &= ~root->encoded;
+      if (!lpol) continue;
+      root->mark  = lpol;
       root->local = 1;
       BTOR_PUSH_STACK (marked, root);
-      BTOR_PUSH_STACK (stack, root);
-      for (p = leafs.start; p < leafs.top; p++) BTOR_PUSH_STACK (stack, *p);
+      expand_first = true;
     }
-    else
-    {
-      assert (root->mark == 1);
-      root->mark = 2;
 
-      set_next_id_aig_mgr (amgr, root);
-      x = root->cnf_id;
-      assert (x);
-
-      if (isxor)
-      {
-        assert (BTOR_COUNT_STACK (leafs) == 2);
-        a = btor_aig_get_cnf_id (leafs.start[0]);
-        b = btor_aig_get_cnf_id (leafs.start[1]);
-
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, a);
-        btor_sat_add (smgr, -b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, -a);
-        btor_sat_add (smgr, b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, -a);
-        btor_sat_add (smgr, -b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, a);
-        btor_sat_add (smgr, b);
-        btor_sat_add (smgr, 0);
-        amgr->num_cnf_clauses += 4;
-        amgr->num_cnf_literals += 12;
-      }
-      else if (isite)
-      {
-        assert (BTOR_COUNT_STACK (leafs) == 3);
-        a = btor_aig_get_cnf_id (leafs.start[0]);  // else
-        b = btor_aig_get_cnf_id (leafs.start[1]);  // then
-        c = btor_aig_get_cnf_id (leafs.start[2]);  // cond
-
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, -c);
-        btor_sat_add (smgr, b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, -x);
-        btor_sat_add (smgr, c);
-        btor_sat_add (smgr, a);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, -c);
-        btor_sat_add (smgr, -b);
-        btor_sat_add (smgr, 0);
-
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, c);
-        btor_sat_add (smgr, -a);
-        btor_sat_add (smgr, 0);
-        amgr->num_cnf_clauses += 4;
-        amgr->num_cnf_literals += 12;
-      }
-      else
-      {
-        for (p = leafs.start; p < leafs.top; p++)
-        {
-          cur = *p;
-          y   = btor_aig_get_cnf_id (cur);
-          assert (y);
-          btor_sat_add (smgr, -y);
-          amgr->num_cnf_literals++;
-        }
-        btor_sat_add (smgr, x);
-        btor_sat_add (smgr, 0);
-        amgr->num_cnf_clauses++;
-        amgr->num_cnf_literals++;
-
-        for (p = leafs.start; p < leafs.top; p++)
-        {
-          cur = *p;
-          y   = btor_aig_get_cnf_id (cur);
-          btor_sat_add (smgr, -x);
-          btor_sat_add (smgr, y);
-          btor_sat_add (smgr, 0);
-          amgr->num_cnf_clauses++;
-          amgr->num_cnf_literals += 2;
-        }
-      }
+    /* only references from the first expansion of an AIG are counted */
+    kind = get_gate_aig (amgr, root, nary, &tree, &leafs);
+    for (i = 0; i < BTOR_COUNT_STACK (leafs); i++)
+    {
+      cur = BTOR_PEEK_STACK (leafs, i);
+      BTOR_PUSH_STACK (stack, cur);
+      BTOR_PUSH_STACK (
+          pols,
+          get_leaf_pol_aig (kind, lpol, kind == BTOR_AIG_GATE_ITE && i == 2)
+              | (expand_first ? BTOR_AIG_POL_EDGE : 0));
     }
     BTOR_RESET_STACK (leafs);
   }
-  BTOR_RELEASE_STACK (stack);
-  BTOR_RELEASE_STACK (leafs);
-  BTOR_RELEASE_STACK (tree);
+
+  /* AIGs are created after their children, hence encoding in the order of
+   * ascending ids guarantees that all gate inputs have a CNF id. */
+  qsort (marked.start,
+         BTOR_COUNT_STACK (marked),
+         sizeof (BtorAIG *),
+         btor_compare_aig_by_id_qsort_asc);
+  for (p = marked.start; p < marked.top; p++)
+  {
+    root = *p;
+    if (!root->cnf_id) set_next_id_aig_mgr (amgr, root);
+    kind = get_gate_aig (amgr, root, nary, &tree, &leafs);
+    encode_gate_aig (amgr, root, root->mark & ~root->encoded, kind, &leafs);
+    BTOR_RESET_STACK (leafs);
+  }
 
   while (!BTOR_EMPTY_STACK (marked))
   {
@@ -1311,12 +1499,23 @@ btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
     local = cur->local;
     assert (local > 0);
     cur->local = 0;
-    if (cur == start) continue;
+    if (cur == BTOR_REAL_ADDR_AIG (start)) continue;
     assert (cur->refs >= local);
     if (cur->refs > local) continue;
     release_cnf_id_aig_mgr (amgr, cur);
   }
+
   BTOR_RELEASE_STACK (marked);
+  BTOR_RELEASE_STACK (leafs);
+  BTOR_RELEASE_STACK (tree);
+  BTOR_RELEASE_STACK (pols);
+  BTOR_RELEASE_STACK (stack);
+}
+
+void
+btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *start)
+{
+  aig_to_sat_pol (amgr, start, BTOR_AIG_POL_BOTH);
 }
 
 static void
@@ -1452,7 +1651,10 @@ btor_aig_add_toplevel_to_sat (BtorAIGMgr *amgr, BtorAIG *root)
     btor_sat_add (amgr->smgr, 0);
     return;
   }
-  btor_aig_to_sat (amgr, root);
+  if (btor_opt_get (amgr->btor, BTOR_OPT_AIG_CNF_PG))
+    aig_to_sat_pol (amgr, root, BTOR_AIG_POL_POS);
+  else
+    btor_aig_to_sat (amgr, root);
   btor_sat_add (amgr->smgr, btor_aig_get_cnf_id (root));
   btor_sat_add (amgr->smgr, 0);
 #endif
@@ -1464,24 +1666,109 @@ btor_aig_get_sat_mgr (const BtorAIGMgr *amgr)
   return amgr ? amgr->smgr : 0;
 }
 
-int32_t
-btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
+/* Returns the SAT assignment of an AIG variable or of an AND whose
+ * definition is fully encoded. */
+static int32_t
+get_sat_assignment_aig (BtorAIGMgr *amgr, BtorAIG *aig)
 {
-  assert (amgr);
-  if (aig == BTOR_AIG_TRUE) return 1;
-  if (aig == BTOR_AIG_FALSE) return -1;
+  int32_t val;
+
+  assert (!BTOR_IS_INVERTED_AIG (aig));
 
   /* Note: If an AIG is not yet encoded to SAT or if the SAT solver returns
    * undefined for a variable, we implicitly initialize it with false (-1). */
-  int32_t val = -1;
-  if (BTOR_REAL_ADDR_AIG (aig)->cnf_id > 0)
+  val = -1;
+  if (aig->cnf_id > 0)
   {
-    val = btor_sat_deref (amgr->smgr, BTOR_REAL_ADDR_AIG (aig)->cnf_id);
+    val = btor_sat_deref (amgr->smgr, aig->cnf_id);
     if (val == 0)
     {
       val = -1;
     }
   }
+  return val;
+}
+
+/* The SAT assignment of an AND whose definition is not (fully) encoded is
+ * not determined by its inputs, compute it from its children instead. */
+static int32_t
+eval_assignment_aig (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  assert (!BTOR_IS_INVERTED_AIG (aig));
+  assert (btor_aig_is_and (aig));
+
+  int32_t res, val;
+  uint32_t i;
+  BtorAIG *cur, *child;
+  BtorAIGPtrStack stack;
+  BtorIntHashTable *cache;
+  BtorHashTableData *d;
+
+  BTOR_INIT_STACK (amgr->btor->mm, stack);
+  cache = btor_hashint_map_new (amgr->btor->mm);
+
+  BTOR_PUSH_STACK (stack, aig);
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_POP_STACK (stack);
+    assert (!BTOR_IS_INVERTED_AIG (cur));
+
+    d = btor_hashint_map_get (cache, cur->id);
+    if (!d)
+    {
+      if (btor_aig_is_var (cur) || cur->encoded == BTOR_AIG_POL_BOTH)
+      {
+        btor_hashint_map_add (cache, cur->id)->as_int =
+            get_sat_assignment_aig (amgr, cur);
+        continue;
+      }
+      btor_hashint_map_add (cache, cur->id)->as_int = 0;
+      BTOR_PUSH_STACK (stack, cur);
+      for (i = 0; i < 2; i++)
+      {
+        child = i ? btor_aig_get_right_child (amgr, cur)
+                  : btor_aig_get_left_child (amgr, cur);
+        if (!btor_hashint_map_contains (cache, BTOR_REAL_ADDR_AIG (child)->id))
+          BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (child));
+      }
+    }
+    else if (d->as_int == 0)
+    {
+      val = 1;
+      for (i = 0; i < 2 && val == 1; i++)
+      {
+        child = i ? btor_aig_get_right_child (amgr, cur)
+                  : btor_aig_get_left_child (amgr, cur);
+        val = btor_hashint_map_get (cache, BTOR_REAL_ADDR_AIG (child)->id)
+                  ->as_int;
+        assert (val);
+        if (BTOR_IS_INVERTED_AIG (child)) val = -val;
+      }
+      d->as_int = val;
+    }
+  }
+  res = btor_hashint_map_get (cache, aig->id)->as_int;
+
+  btor_hashint_map_delete (cache);
+  BTOR_RELEASE_STACK (stack);
+  return res;
+}
+
+int32_t
+btor_aig_get_assignment (BtorAIGMgr *amgr, BtorAIG *aig)
+{
+  assert (amgr);
+  if (aig == BTOR_AIG_TRUE) return 1;
+  if (aig == BTOR_AIG_FALSE) return -1;
+
+  int32_t val;
+  BtorAIG *real_aig;
+
+  real_aig = BTOR_REAL_ADDR_AIG (aig);
+  if (btor_aig_is_and (real_aig) && real_aig->encoded != BTOR_AIG_POL_BOTH)
+    val = eval_assignment_aig (amgr, real_aig);
+  else
+    val = get_sat_assignment_aig (amgr, real_aig);
   return BTOR_IS_INVERTED_AIG (aig) ? -val : val;
 }
 
@@ -30,20 +30,33 @@ struct BtorAIG
   uint32_t refs;
   int32_t next; /* next AIG id for unique table */
   uint8_t mark : 2;
-  uint8_t is_var : 1; /* is it an AIG variable or an AND? */
+  uint8_t is_var : 1;  /* is it an AIG variable or an AND? */
+  uint8_t encoded : 2; /* polarities of the CNF encoding of its definition */
   uint32_t local;
-  int32_t children[]; /* only allocated for AIG AND */
+  int32_t children[2]; /* only used for AIG AND */
 };
 
 typedef struct BtorAIG BtorAIG;
 
 BTOR_DECLARE_STACK (BtorAIGPtr, BtorAIG *);
 
+/* AIGs are stored densely by id in fixed size pages, i.e., the AIG with id
+ * 'id' lives at slot 'id & BTOR_AIG_PAGE_MASK' of page
+ * 'id >> BTOR_AIG_PAGE_BITS'. Pages never move, hence AIG pointers stay
+ * valid. A page is released as soon as all of its AIGs are deleted. */
+#define BTOR_AIG_PAGE_BITS 10
+#define BTOR_AIG_PAGE_SIZE (1u << BTOR_AIG_PAGE_BITS)
+#define BTOR_AIG_PAGE_MASK (BTOR_AIG_PAGE_SIZE - 1)
+
+/* Resized incrementally, cf. BtorNodeUniqueTable. */
 struct BtorAIGUniqueTable
 {
   uint32_t size;
   uint32_t num_elements;
   int32_t *chains;
+  uint32_t old_size;
+  uint32_t migrated;
+  int32_t *old_chains;
 };
 
 typedef struct BtorAIGUniqueTable BtorAIGUniqueTable;
@@ -53,8 +66,12 @@ struct BtorAIGMgr
   Btor *btor;
   BtorAIGUniqueTable table;
   BtorSATMgr *smgr;
-  BtorAIGPtrStack id2aig; /* id to AIG node */
-  BtorIntStack cnfid2aig; /* cnf id to AIG id */
+  BtorAIGPtrStack pages;      /* AIG pages, 0 if released */
+  BtorUIntStack page_refs;    /* number of live AIGs per page */
+  uint32_t num_pages;         /* number of allocated pages */
+  int32_t num_ids;            /* next AIG id */
+  BtorIntStack cnfid2aig;     /* cnf id to AIG id */
+  struct BtorAIGRwLib *rwlib; /* NPN class implementations, cf. btoraigrw.h */
 
   uint_least64_t cur_num_aigs;     /* current number of ANDs */
   uint_least64_t cur_num_aig_vars; /* current number of AIG variables */
@@ -65,6 +82,8 @@ struct BtorAIGMgr
   uint_least64_t num_cnf_vars;
   uint_least64_t num_cnf_clauses;
   uint_least64_t num_cnf_literals;
+  uint_least64_t num_rw_ands_before; /* ANDs before rewriting */
+  uint_least64_t num_rw_ands_after;  /* ANDs after rewriting */
 };
 
 typedef struct BtorAIGMgr BtorAIGMgr;
@@ -126,13 +145,22 @@ btor_aig_get_id (const BtorAIG *aig)
   return BTOR_IS_INVERTED_AIG (aig) ? -BTOR_REAL_ADDR_AIG (aig)->id : aig->id;
 }
 
+/* Returns 0 for ids of deleted AIGs. */
 static inline BtorAIG *
 btor_aig_get_by_id (BtorAIGMgr *amgr, int32_t id)
 {
   assert (amgr);
 
-  return id < 0 ? BTOR_INVERT_AIG (BTOR_PEEK_STACK (amgr->id2aig, -id))
-                : BTOR_PEEK_STACK (amgr->id2aig, id);
+  BtorAIG *page, *res;
+  uint32_t idx;
+
+  idx = id < 0 ? -id : id;
+  assert (idx < (uint32_t) amgr->num_ids);
+  page = BTOR_PEEK_STACK (amgr->pages, idx >> BTOR_AIG_PAGE_BITS);
+  if (!page) return 0;
+  res = page + (idx & BTOR_AIG_PAGE_MASK);
+  if (!res->id) return 0;
+  return id < 0 ? BTOR_INVERT_AIG (res) : res;
 }
 
 static inline int32_t
@@ -167,6 +195,10 @@ BtorAIGMgr *btor_aig_mgr_new (Btor *btor);
 BtorAIGMgr *btor_aig_mgr_clone (Btor *btor, BtorAIGMgr *amgr);
 void btor_aig_mgr_delete (BtorAIGMgr *amgr);
 
+/* Shrink the unique table if it is sparse (e.g., after many AIGs have been
+ * released) in order to reduce memory usage. */
+void btor_aig_mgr_compact (BtorAIGMgr *amgr);
+
 BtorSATMgr *btor_aig_get_sat_mgr (const BtorAIGMgr *amgr);
 
 /* Variable representing 1 bit. */
@@ -209,8 +241,9 @@ void btor_aig_to_sat (BtorAIGMgr *amgr, BtorAIG *aig);
 void btor_aig_add_toplevel_to_sat (BtorAIGMgr *, BtorAIG *);
 
 /* Translates AIG into SAT instance in both phases.
- * The function guarantees that after finishing every reachable AIG
- * has a CNF id.
+ * The function guarantees that after finishing the AIG has a CNF id that is
+ * equivalent to the AIG in every model.  Definitions of AIGs in its cone
+ * that were encoded in one polarity only are completed.
  */
 void btor_aig_to_sat_tseitin (BtorAIGMgr *amgr, BtorAIG *aig);
 
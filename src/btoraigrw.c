@@ -0,0 +1,935 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btoraigrw.h"
+
+#include "btorcore.h"
+#include "utils/btorhashint.h"
+#include "utils/btorutil.h"
+
+#include <assert.h>
+
+/*------------------------------------------------------------------------*/
+
+/* Maximum number of leaves of a cut. */
+#define BTOR_AIG_RW_CUT_SIZE 4
+
+/* Maximum number of cuts stored per AIG. */
+#define BTOR_AIG_RW_MAX_CUTS 8
+
+#define BTOR_AIG_RW_NUM_TT (1u << 16)
+
+#define BTOR_AIG_RW_NUM_PERMS 24
+
+#define BTOR_AIG_RW_TT_FULL ((uint16_t) 0xffff)
+
+/* Flag in 'trans' indicating that the NPN class has been computed. */
+#define BTOR_AIG_RW_TRANS_DONE 0x8000u
+
+/* Truth tables of the cut leaves. */
+static const uint16_t tt_vars[BTOR_AIG_RW_CUT_SIZE] = {
+    0xaaaa, 0xcccc, 0xf0f0, 0xff00};
+
+/*------------------------------------------------------------------------*/
+
+enum BtorAIGRwImplKind
+{
+  BTOR_AIG_RW_IMPL_CONST,
+  BTOR_AIG_RW_IMPL_VAR,
+  BTOR_AIG_RW_IMPL_SHANNON, /* decomposition w.r.t. one variable */
+  BTOR_AIG_RW_IMPL_AND,     /* f = g (A) & h (B), A, B disjoint */
+  BTOR_AIG_RW_IMPL_OR,      /* f = g (A) | h (B), A, B disjoint */
+  BTOR_AIG_RW_IMPL_XOR,     /* f = g (A) ^ h (B), A, B disjoint */
+};
+
+typedef enum BtorAIGRwImplKind BtorAIGRwImplKind;
+
+/* Implementations are encoded as integers: bits 0-7 hold the number of
+ * ANDs, bits 8-11 the kind and bits 12-15 the variable (Shannon) or the
+ * variable set A (disjoint decompositions). */
+#define BTOR_AIG_RW_IMPL(cost, kind, param) \
+  ((int32_t) ((cost) | (kind) << 8 | (param) << 12))
+#define BTOR_AIG_RW_IMPL_COST(impl) ((uint32_t) (impl) &0xff)
+#define BTOR_AIG_RW_IMPL_KIND(impl) ((uint32_t) (impl) >> 8 & 0xf)
+#define BTOR_AIG_RW_IMPL_PARAM(impl) ((uint32_t) (impl) >> 12 & 0xf)
+
+struct BtorAIGRwLib
+{
+  BtorMemMgr *mm;
+  uint8_t perms[BTOR_AIG_RW_NUM_PERMS][BTOR_AIG_RW_CUT_SIZE];
+  /* 'zmap[p][m][y]' is the minterm of a function that is mapped to minterm
+   * 'y' by permutation 'p' and input negation 'm' */
+  uint8_t zmap[BTOR_AIG_RW_NUM_PERMS][16][16];
+  uint16_t *canon;         /* NPN representative of truth table */
+  uint16_t *trans;         /* transformation into representative */
+  BtorIntHashTable *impls; /* representative + 1 -> implementation */
+};
+
+/*------------------------------------------------------------------------*/
+
+static uint16_t
+cofactor0 (uint16_t tt, uint32_t x)
+{
+  uint16_t m = tt & (uint16_t) ~tt_vars[x];
+  return m | (uint16_t) (m << (1u << x));
+}
+
+static uint16_t
+cofactor1 (uint16_t tt, uint32_t x)
+{
+  uint16_t m = tt & tt_vars[x];
+  return m | (uint16_t) (m >> (1u << x));
+}
+
+/* Cofactor w.r.t. all variables in 'vars' set to 0. */
+static uint16_t
+cofactor0_vars (uint16_t tt, uint32_t vars)
+{
+  uint32_t x;
+  for (x = 0; x < BTOR_AIG_RW_CUT_SIZE; x++)
+    if (vars & (1u << x)) tt = cofactor0 (tt, x);
+  return tt;
+}
+
+static uint16_t
+exists_vars (uint16_t tt, uint32_t vars)
+{
+  uint32_t x;
+  for (x = 0; x < BTOR_AIG_RW_CUT_SIZE; x++)
+    if (vars & (1u << x)) tt = cofactor0 (tt, x) | cofactor1 (tt, x);
+  return tt;
+}
+
+static uint16_t
+forall_vars (uint16_t tt, uint32_t vars)
+{
+  uint32_t x;
+  for (x = 0; x < BTOR_AIG_RW_CUT_SIZE; x++)
+    if (vars & (1u << x)) tt = cofactor0 (tt, x) & cofactor1 (tt, x);
+  return tt;
+}
+
+static uint32_t
+get_support (uint16_t tt)
+{
+  uint32_t x, res;
+  for (x = 0, res = 0; x < BTOR_AIG_RW_CUT_SIZE; x++)
+    if (cofactor0 (tt, x) != cofactor1 (tt, x)) res |= 1u << x;
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static BtorAIGRwLib *
+new_rw_lib (BtorMemMgr *mm)
+{
+  BtorAIGRwLib *lib;
+  uint32_t i, p, m, y, z, x[BTOR_AIG_RW_CUT_SIZE];
+
+  BTOR_CNEW_TAG (mm, BTOR_MEM_TAG_AIG, lib);
+  lib->mm = mm;
+  BTOR_CNEWN_TAG (mm, BTOR_MEM_TAG_AIG, lib->canon, BTOR_AIG_RW_NUM_TT);
+  BTOR_CNEWN_TAG (mm, BTOR_MEM_TAG_AIG, lib->trans, BTOR_AIG_RW_NUM_TT);
+  lib->impls = btor_hashint_map_new (mm);
+
+  p = 0;
+  for (x[0] = 0; x[0] < 4; x[0]++)
+    for (x[1] = 0; x[1] < 4; x[1]++)
+      for (x[2] = 0; x[2] < 4; x[2]++)
+      {
+        if (x[1] == x[0] || x[2] == x[0] || x[2] == x[1]) continue;
+        x[3] = 6 - x[0] - x[1] - x[2];
+        for (i = 0; i < BTOR_AIG_RW_CUT_SIZE; i++) lib->perms[p][i] = x[i];
+        for (m = 0; m < 16; m++)
+          for (y = 0; y < 16; y++)
+          {
+            for (i = 0, z = 0; i < BTOR_AIG_RW_CUT_SIZE; i++)
+              if (((y >> x[i]) ^ (m >> i)) & 1) z |= 1u << i;
+            lib->zmap[p][m][y] = z;
+          }
+        p++;
+      }
+  assert (p == BTOR_AIG_RW_NUM_PERMS);
+  return lib;
+}
+
+void
+btor_aig_rw_lib_delete (BtorMemMgr *mm, BtorAIGRwLib *lib)
+{
+  assert (mm);
+
+  if (!lib) return;
+  btor_hashint_map_delete (lib->impls);
+  BTOR_DELETEN_TAG (mm, BTOR_MEM_TAG_AIG, lib->canon, BTOR_AIG_RW_NUM_TT);
+  BTOR_DELETEN_TAG (mm, BTOR_MEM_TAG_AIG, lib->trans, BTOR_AIG_RW_NUM_TT);
+  BTOR_DELETE_TAG (mm, BTOR_MEM_TAG_AIG, lib);
+}
+
+/* Returns the NPN representative (smallest truth table of the NPN class)
+ * of 'tt'.  The transformation into the representative is stored in
+ * 'trans': permutation (bits 0-4), input negation (bits 5-8) and output
+ * negation (bit 9). */
+static uint16_t
+get_npn_class (BtorAIGRwLib *lib, uint16_t tt, uint32_t *trans)
+{
+  uint32_t p, m, y, best_trans;
+  uint16_t res, best;
+
+  if (!(lib->trans[tt] & BTOR_AIG_RW_TRANS_DONE))
+  {
+    best       = tt;
+    best_trans = 0;
+    for (p = 0; p < BTOR_AIG_RW_NUM_PERMS; p++)
+      for (m = 0; m < 16; m++)
+      {
+        for (y = 0, res = 0; y < 16; y++)
+          if ((tt >> lib->zmap[p][m][y]) & 1) res |= 1u << y;
+        if (res < best)
+        {
+          best       = res;
+          best_trans = p | m << 5;
+        }
+        res ^= BTOR_AIG_RW_TT_FULL;
+        if (res < best)
+        {
+          best       = res;
+          best_trans = p | m << 5 | 1u << 9;
+        }
+      }
+    lib->canon[tt] = best;
+    lib->trans[tt] = best_trans | BTOR_AIG_RW_TRANS_DONE;
+  }
+  *trans = lib->trans[tt] & ~BTOR_AIG_RW_TRANS_DONE;
+  return lib->canon[tt];
+}
+
+static uint32_t get_cost (BtorAIGRwLib *lib, uint16_t tt);
+
+/* Determines the cheapest decomposition of NPN representative 'c'. */
+static int32_t
+get_impl (BtorAIGRwLib *lib, uint16_t c)
+{
+  BtorHashTableData *d;
+  uint32_t supp, x, a, b, cost, best, kind, param;
+  uint16_t f0, f1, g, h;
+
+  if ((d = btor_hashint_map_get (lib->impls, c + 1))) return d->as_int;
+
+  supp  = get_support (c);
+  best  = UINT32_MAX;
+  kind  = BTOR_AIG_RW_IMPL_CONST;
+  param = 0;
+
+  if (!supp)
+  {
+    assert (c == 0);
+    best = 0;
+  }
+  else if (!(supp & (supp - 1)))
+  {
+    best = 0;
+    kind = BTOR_AIG_RW_IMPL_VAR;
+    for (param = 0; !(supp & (1u << param)); param++)
+      ;
+  }
+  else
+  {
+    for (x = 0; x < BTOR_AIG_RW_CUT_SIZE; x++)
+    {
+      if (!(supp & (1u << x))) continue;
+      f0 = cofactor0 (c, x);
+      f1 = cofactor1 (c, x);
+      if (!f0 || f0 == BTOR_AIG_RW_TT_FULL)
+        cost = 1 + get_cost (lib, f1);
+      else if (!f1 || f1 == BTOR_AIG_RW_TT_FULL)
+        cost = 1 + get_cost (lib, f0);
+      else if ((f0 ^ f1) == BTOR_AIG_RW_TT_FULL)
+        cost = 3 + get_cost (lib, f0);
+      else
+        cost = 3 + get_cost (lib, f0) + get_cost (lib, f1);
+      if (cost < best)
+      {
+        best  = cost;
+        kind  = BTOR_AIG_RW_IMPL_SHANNON;
+        param = x;
+      }
+    }
+
+    /* 'a' always contains the lowest variable in the support in order to
+     * consider each partition only once */
+    for (a = 1; a < 16; a++)
+    {
+      if ((a & supp) != a || a == supp || !(a & supp & -supp)) continue;
+      b = supp & ~a;
+
+      g = exists_vars (c, b);
+      h = exists_vars (c, a);
+      if ((g & h) == c
+          && (cost = 1 + get_cost (lib, g) + get_cost (lib, h)) < best)
+      {
+        best  = cost;
+        kind  = BTOR_AIG_RW_IMPL_AND;
+        param = a;
+      }
+
+      g = forall_vars (c, b);
+      h = forall_vars (c, a);
+      if ((g | h) == c
+          && (cost = 1 + get_cost (lib, g) + get_cost (lib, h)) < best)
+      {
+        best  = cost;
+        kind  = BTOR_AIG_RW_IMPL_OR;
+        param = a;
+      }
+
+      g = cofactor0_vars (c, b);
+      h = cofactor0_vars (c, a) ^ cofactor0_vars (c, supp);
+      if ((g ^ h) == c
+          && (cost = 3 + get_cost (lib, g) + get_cost (lib, h)) < best)
+      {
+        best  = cost;
+        kind  = BTOR_AIG_RW_IMPL_XOR;
+        param = a;
+      }
+    }
+  }
+
+  assert (best < 256);
+  d        = btor_hashint_map_add (lib->impls, c + 1);
+  d->as_int = BTOR_AIG_RW_IMPL (best, kind, param);
+  return d->as_int;
+}
+
+/* Returns the number of ANDs of the implementation of 'tt'. */
+static uint32_t
+get_cost (BtorAIGRwLib *lib, uint16_t tt)
+{
+  uint32_t trans;
+  return BTOR_AIG_RW_IMPL_COST (get_impl (lib, get_npn_class (lib, tt, &trans)));
+}
+
+static BtorAIG *build_tt (BtorAIGRwLib *lib,
+                          BtorAIGMgr *amgr,
+                          uint16_t tt,
+                          BtorAIG *leaves[]);
+
+/* Instantiates the implementation of NPN representative 'c'. */
+static BtorAIG *
+build_class (BtorAIGRwLib *lib,
+             BtorAIGMgr *amgr,
+             uint16_t c,
+             BtorAIG *inputs[])
+{
+  int32_t impl;
+  uint32_t x, a, b;
+  uint16_t f0, f1;
+  BtorAIG *g, *h, *res;
+
+  impl = get_impl (lib, c);
+  x = a = BTOR_AIG_RW_IMPL_PARAM (impl);
+  b     = get_support (c) & ~a;
+  h     = 0;
+
+  switch (BTOR_AIG_RW_IMPL_KIND (impl))
+  {
+    case BTOR_AIG_RW_IMPL_CONST: assert (c == 0); return BTOR_AIG_FALSE;
+
+    case BTOR_AIG_RW_IMPL_VAR:
+      assert (c == tt_vars[x] || (c ^ tt_vars[x]) == BTOR_AIG_RW_TT_FULL);
+      return btor_aig_copy (
+          amgr, c == tt_vars[x] ? inputs[x] : BTOR_INVERT_AIG (inputs[x]));
+
+    case BTOR_AIG_RW_IMPL_SHANNON:
+      f0 = cofactor0 (c, x);
+      f1 = cofactor1 (c, x);
+      if (!f0)
+      {
+        g   = build_tt (lib, amgr, f1, inputs);
+        res = btor_aig_and (amgr, inputs[x], g);
+      }
+      else if (!f1)
+      {
+        g   = build_tt (lib, amgr, f0, inputs);
+        res = btor_aig_and (amgr, BTOR_INVERT_AIG (inputs[x]), g);
+      }
+      else if (f0 == BTOR_AIG_RW_TT_FULL)
+      {
+        g   = build_tt (lib, amgr, f1, inputs);
+        res = btor_aig_or (amgr, BTOR_INVERT_AIG (inputs[x]), g);
+      }
+      else if (f1 == BTOR_AIG_RW_TT_FULL)
+      {
+        g   = build_tt (lib, amgr, f0, inputs);
+        res = btor_aig_or (amgr, inputs[x], g);
+      }
+      else if ((f0 ^ f1) == BTOR_AIG_RW_TT_FULL)
+      {
+        g   = build_tt (lib, amgr, f0, inputs);
+        res = BTOR_INVERT_AIG (btor_aig_eq (amgr, inputs[x], g));
+      }
+      else
+      {
+        g   = build_tt (lib, amgr, f0, inputs);
+        h   = build_tt (lib, amgr, f1, inputs);
+        res = btor_aig_cond (amgr, inputs[x], h, g);
+      }
+      break;
+
+    case BTOR_AIG_RW_IMPL_AND:
+      g   = build_tt (lib, amgr, exists_vars (c, b), inputs);
+      h   = build_tt (lib, amgr, exists_vars (c, a), inputs);
+      res = btor_aig_and (amgr, g, h);
+      break;
+
+    case BTOR_AIG_RW_IMPL_OR:
+      g   = build_tt (lib, amgr, forall_vars (c, b), inputs);
+      h   = build_tt (lib, amgr, forall_vars (c, a), inputs);
+      res = btor_aig_or (amgr, g, h);
+      break;
+
+    default:
+      assert (BTOR_AIG_RW_IMPL_KIND (impl) == BTOR_AIG_RW_IMPL_XOR);
+      g = build_tt (lib, amgr, cofactor0_vars (c, b), inputs);
+      h = build_tt (lib,
+                    amgr,
+                    cofactor0_vars (c, a) ^ cofactor0_vars (c, a | b),
+                    inputs);
+      res = BTOR_INVERT_AIG (btor_aig_eq (amgr, g, h));
+  }
+  btor_aig_release (amgr, g);
+  if (h) btor_aig_release (amgr, h);
+  return res;
+}
+
+/* Instantiates an implementation of the function 'tt' of 'leaves'. */
+static BtorAIG *
+build_tt (BtorAIGRwLib *lib, BtorAIGMgr *amgr, uint16_t tt, BtorAIG *leaves[])
+{
+  uint32_t i, p, m, trans;
+  uint16_t c;
+  BtorAIG *inputs[BTOR_AIG_RW_CUT_SIZE], *res;
+
+  c = get_npn_class (lib, tt, &trans);
+  p = trans & 0x1f;
+  m = trans >> 5 & 0xf;
+  for (i = 0; i < BTOR_AIG_RW_CUT_SIZE; i++)
+    inputs[lib->perms[p][i]] =
+        (m >> i) & 1 ? BTOR_INVERT_AIG (leaves[i]) : leaves[i];
+  res = build_class (lib, amgr, c, inputs);
+  return trans >> 9 & 1 ? BTOR_INVERT_AIG (res) : res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+is_cone_and (BtorAIG *aig)
+{
+  return btor_aig_is_and (aig) && !aig->cnf_id;
+}
+
+/* Collects all AIGs reachable from 'aigs' via ANDs that do not have a CNF
+ * id yet in post-order.  Maps AIG ids to their position in 'nodes'.
+ * Returns the number of ANDs in 'nodes'. */
+static uint32_t
+collect_cone (BtorAIGMgr *amgr,
+              BtorAIG **aigs,
+              uint32_t naigs,
+              BtorAIGPtrStack *nodes,
+              BtorIntHashTable *map)
+{
+  uint32_t i, res;
+  BtorAIG *cur;
+  BtorAIGPtrStack stack;
+  BtorHashTableData *d;
+
+  BTOR_INIT_STACK (amgr->btor->mm, stack);
+  for (i = 0; i < naigs; i++)
+    if (!btor_aig_is_const (aigs[i]))
+      BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (aigs[i]));
+
+  res = 0;
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_POP_STACK (stack);
+    d   = btor_hashint_map_get (map, cur->id);
+    if (!d)
+    {
+      d         = btor_hashint_map_add (map, cur->id);
+      d->as_int = -1;
+      if (is_cone_and (cur))
+      {
+        BTOR_PUSH_STACK (stack, cur);
+        BTOR_PUSH_STACK (
+            stack, BTOR_REAL_ADDR_AIG (btor_aig_get_right_child (amgr, cur)));
+        BTOR_PUSH_STACK (
+            stack, BTOR_REAL_ADDR_AIG (btor_aig_get_left_child (amgr, cur)));
+        continue;
+      }
+    }
+    else if (d->as_int >= 0)
+      continue;
+    d->as_int = BTOR_COUNT_STACK (*nodes);
+    BTOR_PUSH_STACK (*nodes, cur);
+    if (is_cone_and (cur)) res++;
+  }
+  BTOR_RELEASE_STACK (stack);
+  return res;
+}
+
+static uint32_t
+count_cone_ands (BtorAIGMgr *amgr, BtorAIG **aigs, uint32_t naigs)
+{
+  uint32_t res;
+  BtorAIGPtrStack nodes;
+  BtorIntHashTable *map;
+
+  BTOR_INIT_STACK (amgr->btor->mm, nodes);
+  map = btor_hashint_map_new (amgr->btor->mm);
+  res = collect_cone (amgr, aigs, naigs, &nodes, map);
+  btor_hashint_map_delete (map);
+  BTOR_RELEASE_STACK (nodes);
+  return res;
+}
+
+static uint32_t
+get_index (BtorIntHashTable *map, BtorAIG *aig)
+{
+  BtorHashTableData *d;
+  d = btor_hashint_map_get (map, BTOR_REAL_ADDR_AIG (aig)->id);
+  assert (d);
+  assert (d->as_int >= 0);
+  return d->as_int;
+}
+
+/* Replaces 'aigs' with 'res' if 'res' has less than 'num_ands' ANDs in its
+ * cone.  Takes ownership of 'res'.  Returns the resulting number of ANDs. */
+static uint32_t
+replace_if_smaller (BtorAIGMgr *amgr,
+                    BtorAIG **aigs,
+                    BtorAIG **res,
+                    uint32_t naigs,
+                    uint32_t num_ands)
+{
+  uint32_t i, n;
+
+  n = count_cone_ands (amgr, res, naigs);
+  for (i = 0; i < naigs; i++)
+  {
+    if (n < num_ands) BTOR_SWAP (BtorAIG *, aigs[i], res[i]);
+    btor_aig_release (amgr, res[i]);
+  }
+  return n < num_ands ? n : num_ands;
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Collects the inputs of the AND tree rooted at 'aig' that only consists
+ * of ANDs with a single parent. */
+static void
+collect_and_inputs (BtorAIGMgr *amgr, BtorAIG *aig, BtorAIGPtrStack *inputs)
+{
+  BtorAIG *cur;
+  BtorAIGPtrStack stack;
+
+  assert (is_cone_and (aig));
+
+  BTOR_INIT_STACK (amgr->btor->mm, stack);
+  BTOR_PUSH_STACK (stack, btor_aig_get_right_child (amgr, aig));
+  BTOR_PUSH_STACK (stack, btor_aig_get_left_child (amgr, aig));
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_POP_STACK (stack);
+    if (!BTOR_IS_INVERTED_AIG (cur) && is_cone_and (cur) && cur->refs == 1)
+    {
+      BTOR_PUSH_STACK (stack, btor_aig_get_right_child (amgr, cur));
+      BTOR_PUSH_STACK (stack, btor_aig_get_left_child (amgr, cur));
+    }
+    else
+      BTOR_PUSH_STACK (*inputs, cur);
+  }
+  BTOR_RELEASE_STACK (stack);
+}
+
+/* Rebuilds AND trees as balanced trees, where inputs with lower level are
+ * combined first.  Returns the resulting number of ANDs. */
+static uint32_t
+balance (BtorAIGMgr *amgr, BtorAIG **aigs, uint32_t naigs, uint32_t num_ands)
+{
+  uint32_t i, j, k, n, lvl, *level;
+  bool *required;
+  BtorAIG *cur, *and, **res, **roots;
+  BtorAIGPtrStack nodes, inputs, tree;
+  BtorUIntStack levels;
+  BtorIntHashTable *map;
+  BtorMemMgr *mm;
+
+  mm = amgr->btor->mm;
+  BTOR_INIT_STACK (mm, nodes);
+  BTOR_INIT_STACK (mm, inputs);
+  BTOR_INIT_STACK (mm, tree);
+  BTOR_INIT_STACK (mm, levels);
+  map = btor_hashint_map_new (mm);
+  (void) collect_cone (amgr, aigs, naigs, &nodes, map);
+  n = BTOR_COUNT_STACK (nodes);
+  BTOR_CNEWN (mm, required, n);
+  BTOR_CNEWN (mm, level, n);
+  BTOR_CNEWN (mm, res, n);
+  BTOR_NEWN (mm, roots, naigs);
+
+  for (i = 0; i < naigs; i++)
+    if (!btor_aig_is_const (aigs[i])) required[get_index (map, aigs[i])] = true;
+  for (i = n; i-- > 0;)
+  {
+    cur = BTOR_PEEK_STACK (nodes, i);
+    if (!required[i] || !is_cone_and (cur)) continue;
+    collect_and_inputs (amgr, cur, &inputs);
+    while (!BTOR_EMPTY_STACK (inputs))
+      required[get_index (map, BTOR_POP_STACK (inputs))] = true;
+  }
+
+  for (i = 0; i < n; i++)
+  {
+    cur = BTOR_PEEK_STACK (nodes, i);
+    if (!is_cone_and (cur))
+    {
+      res[i] = cur;
+      continue;
+    }
+    if (!required[i]) continue;
+
+    collect_and_inputs (amgr, cur, &inputs);
+    while (!BTOR_EMPTY_STACK (inputs))
+    {
+      cur = BTOR_POP_STACK (inputs);
+      j   = get_index (map, cur);
+      BTOR_PUSH_STACK (
+          tree,
+          btor_aig_copy (amgr,
+                         BTOR_IS_INVERTED_AIG (cur) ? BTOR_INVERT_AIG (res[j])
+                                                    : res[j]));
+      BTOR_PUSH_STACK (levels, level[j]);
+    }
+
+    /* combine the two inputs with the lowest level until one is left */
+    for (;;)
+    {
+      /* sort by decreasing level */
+      for (j = 1; j < BTOR_COUNT_STACK (tree); j++)
+      {
+        cur = BTOR_PEEK_STACK (tree, j);
+        lvl = BTOR_PEEK_STACK (levels, j);
+        for (k = j; k > 0 && BTOR_PEEK_STACK (levels, k - 1) < lvl; k--)
+        {
+          BTOR_POKE_STACK (tree, k, BTOR_PEEK_STACK (tree, k - 1));
+          BTOR_POKE_STACK (levels, k, BTOR_PEEK_STACK (levels, k - 1));
+        }
+        BTOR_POKE_STACK (tree, k, cur);
+        BTOR_POKE_STACK (levels, k, lvl);
+      }
+      if (BTOR_COUNT_STACK (tree) == 1) break;
+      cur = BTOR_POP_STACK (tree);
+      and = BTOR_POP_STACK (tree);
+      (void) BTOR_POP_STACK (levels);
+      lvl = BTOR_POP_STACK (levels) + 1;
+      BTOR_PUSH_STACK (tree, btor_aig_and (amgr, cur, and));
+      BTOR_PUSH_STACK (levels, lvl);
+      btor_aig_release (amgr, cur);
+      btor_aig_release (amgr, and);
+    }
+    res[i]   = BTOR_POP_STACK (tree);
+    level[i] = BTOR_POP_STACK (levels);
+  }
+
+  for (i = 0; i < naigs; i++)
+  {
+    if (btor_aig_is_const (aigs[i]))
+      roots[i] = aigs[i];
+    else
+    {
+      cur      = res[get_index (map, aigs[i])];
+      roots[i] = btor_aig_copy (
+          amgr, BTOR_IS_INVERTED_AIG (aigs[i]) ? BTOR_INVERT_AIG (cur) : cur);
+    }
+  }
+  for (i = 0; i < n; i++)
+    if (res[i] && is_cone_and (BTOR_PEEK_STACK (nodes, i)))
+      btor_aig_release (amgr, res[i]);
+  num_ands = replace_if_smaller (amgr, aigs, roots, naigs, num_ands + 1);
+
+  BTOR_DELETEN (mm, roots, naigs);
+  BTOR_DELETEN (mm, res, n);
+  BTOR_DELETEN (mm, level, n);
+  BTOR_DELETEN (mm, required, n);
+  btor_hashint_map_delete (map);
+  BTOR_RELEASE_STACK (levels);
+  BTOR_RELEASE_STACK (tree);
+  BTOR_RELEASE_STACK (inputs);
+  BTOR_RELEASE_STACK (nodes);
+  return num_ands;
+}
+
+/*------------------------------------------------------------------------*/
+
+struct BtorAIGRwCut
+{
+  uint32_t leaves[BTOR_AIG_RW_CUT_SIZE]; /* sorted node indices */
+  uint32_t size;
+  uint16_t tt;
+  double flow; /* estimated number of ANDs to implement the cut */
+};
+
+typedef struct BtorAIGRwCut BtorAIGRwCut;
+
+struct BtorAIGRwNode
+{
+  BtorAIGRwCut cuts[BTOR_AIG_RW_MAX_CUTS]; /* sorted by flow */
+  uint32_t ncuts;
+  double flow;
+  bool required;
+  BtorAIG *res;
+};
+
+typedef struct BtorAIGRwNode BtorAIGRwNode;
+
+/* Expresses truth table 'tt' over the leaves of 'cut' in terms of the
+ * leaves of 'merged', which is a superset of 'cut'. */
+static uint16_t
+expand_tt (uint16_t tt, const BtorAIGRwCut *cut, const BtorAIGRwCut *merged)
+{
+  uint32_t i, j, y, z, pos[BTOR_AIG_RW_CUT_SIZE];
+  uint16_t res;
+
+  for (i = 0, j = 0; i < cut->size; i++)
+  {
+    while (merged->leaves[j] != cut->leaves[i]) j++;
+    pos[i] = j;
+  }
+  for (y = 0, res = 0; y < 16; y++)
+  {
+    for (i = 0, z = 0; i < cut->size; i++)
+      if ((y >> pos[i]) & 1) z |= 1u << i;
+    if ((tt >> z) & 1) res |= 1u << y;
+  }
+  return res;
+}
+
+static bool
+merge_leaves (const BtorAIGRwCut *a, const BtorAIGRwCut *b, BtorAIGRwCut *res)
+{
+  uint32_t i, j, l;
+
+  for (i = 0, j = 0, res->size = 0; i < a->size || j < b->size;)
+  {
+    if (res->size == BTOR_AIG_RW_CUT_SIZE) return false;
+    if (j == b->size || (i < a->size && a->leaves[i] < b->leaves[j]))
+      l = a->leaves[i++];
+    else if (i == a->size || b->leaves[j] < a->leaves[i])
+      l = b->leaves[j++];
+    else
+    {
+      l = a->leaves[i++];
+      j++;
+    }
+    res->leaves[res->size++] = l;
+  }
+  return true;
+}
+
+static bool
+is_subset (const BtorAIGRwCut *a, const BtorAIGRwCut *b)
+{
+  uint32_t i, j;
+
+  if (a->size > b->size) return false;
+  for (i = 0, j = 0; i < a->size; i++)
+  {
+    while (j < b->size && b->leaves[j] < a->leaves[i]) j++;
+    if (j == b->size || b->leaves[j] != a->leaves[i]) return false;
+  }
+  return true;
+}
+
+static void
+add_cut (BtorAIGRwNode *node, const BtorAIGRwCut *cut)
+{
+  uint32_t i, k;
+
+  for (i = 0; i < node->ncuts; i++)
+    if (is_subset (&node->cuts[i], cut)) return;
+
+  for (k = node->ncuts; k > 0; k--)
+  {
+    if (node->cuts[k - 1].flow < cut->flow
+        || (node->cuts[k - 1].flow == cut->flow
+            && node->cuts[k - 1].size <= cut->size))
+      break;
+  }
+  if (k == BTOR_AIG_RW_MAX_CUTS) return;
+  if (node->ncuts < BTOR_AIG_RW_MAX_CUTS) node->ncuts++;
+  for (i = node->ncuts - 1; i > k; i--) node->cuts[i] = node->cuts[i - 1];
+  node->cuts[k] = *cut;
+}
+
+/* Enumerates the cuts of AND 'aig' at position 'idx' from the cuts of its
+ * children. */
+static void
+enum_cuts (BtorAIGRwLib *lib,
+           BtorAIGMgr *amgr,
+           BtorAIGRwNode *nodes,
+           BtorIntHashTable *map,
+           BtorAIG *aig,
+           uint32_t idx)
+{
+  uint32_t i, j, k, n[2], cidx[2];
+  uint16_t tl, tr;
+  BtorAIG *child[2];
+  BtorAIGRwCut cut, *cuts[2], trivial[2];
+
+  child[0] = btor_aig_get_left_child (amgr, aig);
+  child[1] = btor_aig_get_right_child (amgr, aig);
+  for (i = 0; i < 2; i++)
+  {
+    cidx[i]              = get_index (map, child[i]);
+    trivial[i].leaves[0] = cidx[i];
+    trivial[i].size      = 1;
+    trivial[i].tt        = tt_vars[0];
+    trivial[i].flow      = nodes[cidx[i]].flow;
+  }
+
+  for (i = 0; i < 2; i++)
+  {
+    n[i]    = nodes[cidx[i]].ncuts + 1;
+    cuts[i] = nodes[cidx[i]].cuts;
+  }
+  for (i = 0; i < n[0]; i++)
+    for (j = 0; j < n[1]; j++)
+    {
+      const BtorAIGRwCut *l = i ? &cuts[0][i - 1] : &trivial[0];
+      const BtorAIGRwCut *r = j ? &cuts[1][j - 1] : &trivial[1];
+      if (!merge_leaves (l, r, &cut)) continue;
+      tl = expand_tt (l->tt, l, &cut);
+      tr = expand_tt (r->tt, r, &cut);
+      if (BTOR_IS_INVERTED_AIG (child[0])) tl = ~tl;
+      if (BTOR_IS_INVERTED_AIG (child[1])) tr = ~tr;
+      cut.tt   = tl & tr;
+      cut.flow = get_cost (lib, cut.tt);
+      for (k = 0; k < cut.size; k++) cut.flow += nodes[cut.leaves[k]].flow;
+      add_cut (&nodes[idx], &cut);
+    }
+  assert (nodes[idx].ncuts > 0);
+  nodes[idx].flow = nodes[idx].cuts[0].flow / (aig->refs ? aig->refs : 1);
+}
+
+/* Selects the cut with the lowest area flow for every AND that is needed
+ * to implement 'aigs' and replaces them by the implementation of their NPN
+ * class.  Returns the resulting number of ANDs. */
+static uint32_t
+rewrite_cuts (BtorAIGRwLib *lib,
+              BtorAIGMgr *amgr,
+              BtorAIG **aigs,
+              uint32_t naigs,
+              uint32_t num_ands)
+{
+  uint32_t i, j, n, cost;
+  BtorAIG *cur, **roots, *leaves[BTOR_AIG_RW_CUT_SIZE];
+  BtorAIGPtrStack stack;
+  BtorAIGRwNode *nodes;
+  BtorAIGRwCut *cut;
+  BtorIntHashTable *map;
+  BtorMemMgr *mm;
+
+  mm = amgr->btor->mm;
+  BTOR_INIT_STACK (mm, stack);
+  map = btor_hashint_map_new (mm);
+  (void) collect_cone (amgr, aigs, naigs, &stack, map);
+  n = BTOR_COUNT_STACK (stack);
+  BTOR_CNEWN (mm, nodes, n);
+
+  for (i = 0; i < n; i++)
+  {
+    cur = BTOR_PEEK_STACK (stack, i);
+    if (is_cone_and (cur)) enum_cuts (lib, amgr, nodes, map, cur, i);
+  }
+
+  /* select cover */
+  for (i = 0; i < naigs; i++)
+    if (!btor_aig_is_const (aigs[i]))
+      nodes[get_index (map, aigs[i])].required = true;
+  for (i = n, cost = 0; i-- > 0;)
+  {
+    if (!nodes[i].required || !is_cone_and (BTOR_PEEK_STACK (stack, i)))
+      continue;
+    cut = &nodes[i].cuts[0];
+    cost += get_cost (lib, cut->tt);
+    for (j = 0; j < cut->size; j++) nodes[cut->leaves[j]].required = true;
+  }
+
+  if (cost < num_ands)
+  {
+    for (i = 0; i < n; i++)
+    {
+      cur = BTOR_PEEK_STACK (stack, i);
+      if (!is_cone_and (cur))
+      {
+        nodes[i].res = cur;
+        continue;
+      }
+      if (!nodes[i].required) continue;
+      cut = &nodes[i].cuts[0];
+      for (j = 0; j < BTOR_AIG_RW_CUT_SIZE; j++)
+        leaves[j] = j < cut->size ? nodes[cut->leaves[j]].res : BTOR_AIG_FALSE;
+      nodes[i].res = build_tt (lib, amgr, cut->tt, leaves);
+    }
+
+    BTOR_NEWN (mm, roots, naigs);
+    for (i = 0; i < naigs; i++)
+    {
+      if (btor_aig_is_const (aigs[i]))
+        roots[i] = aigs[i];
+      else
+      {
+        cur      = nodes[get_index (map, aigs[i])].res;
+        roots[i] = btor_aig_copy (
+            amgr, BTOR_IS_INVERTED_AIG (aigs[i]) ? BTOR_INVERT_AIG (cur) : cur);
+      }
+    }
+    for (i = 0; i < n; i++)
+      if (nodes[i].res && is_cone_and (BTOR_PEEK_STACK (stack, i)))
+        btor_aig_release (amgr, nodes[i].res);
+    num_ands = replace_if_smaller (amgr, aigs, roots, naigs, num_ands);
+    BTOR_DELETEN (mm, roots, naigs);
+  }
+
+  BTOR_DELETEN (mm, nodes, n);
+  btor_hashint_map_delete (map);
+  BTOR_RELEASE_STACK (stack);
+  return num_ands;
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_aig_rewrite (BtorAIGMgr *amgr, BtorAIG **aigs, uint32_t naigs)
+{
+  assert (amgr);
+  assert (aigs);
+
+  uint32_t before, after;
+
+  before = count_cone_ands (amgr, aigs, naigs);
+  if (!before) return;
+
+  if (!amgr->rwlib) amgr->rwlib = new_rw_lib (amgr->btor->mm);
+
+  after = balance (amgr, aigs, naigs, before);
+  after = rewrite_cuts (amgr->rwlib, amgr, aigs, naigs, after);
+  assert (after <= before);
+
+  amgr->num_rw_ands_before += before;
+  amgr->num_rw_ands_after += after;
+}
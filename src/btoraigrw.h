@@ -0,0 +1,32 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORAIGRW_H_INCLUDED
+#define BTORAIGRW_H_INCLUDED
+
+#include "btoraig.h"
+
+/*------------------------------------------------------------------------*/
+
+/* Implementations of 4-input functions, one per NPN class.  Created on
+ * demand by 'btor_aig_rewrite' and owned by the AIG manager. */
+struct BtorAIGRwLib;
+
+typedef struct BtorAIGRwLib BtorAIGRwLib;
+
+void btor_aig_rw_lib_delete (BtorMemMgr *mm, BtorAIGRwLib *lib);
+
+/*------------------------------------------------------------------------*/
+
+/* Rewrite the cones of the AIGs in 'aigs' that have not been translated to
+ * CNF yet.  Balances AND trees and replaces 4-feasible cuts by the
+ * implementation of their NPN class if this reduces the number of ANDs.
+ * The AIGs in 'aigs' are replaced by (equivalent) rewritten AIGs. */
+void btor_aig_rewrite (BtorAIGMgr *amgr, BtorAIG **aigs, uint32_t naigs);
+
+#endif
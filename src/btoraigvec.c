@@ -27,8 +27,10 @@ new_aigvec (BtorAIGVecMgr *avmgr, uint32_t width)
 
   BtorAIGVec *result;
 
-  result        = btor_mem_malloc (avmgr->btor->mm,
-                            sizeof (BtorAIGVec) + sizeof (BtorAIG *) * width);
+  result        = btor_mem_malloc_tag (
+      avmgr->btor->mm,
+      BTOR_MEM_TAG_AIGVEC,
+      sizeof (BtorAIGVec) + sizeof (BtorAIG *) * width);
   result->width = width;
   avmgr->cur_num_aigvecs++;
   if (avmgr->max_num_aigvecs < avmgr->cur_num_aigvecs)
@@ -565,12 +567,6 @@ mul_aigvec (BtorAIGVecMgr *avmgr, BtorAIGVec *a, BtorAIGVec *b)
   assert (width > 0);
   assert (width == b->width);
 
-  if (btor_opt_get (avmgr->btor, BTOR_OPT_SORT_AIGVEC) > 0
-      && compare_aigvec_lsb_first (a, b) > 0)
-  {
-    BTOR_SWAP (BtorAIGVec *, a, b);
-  }
-
   res = new_aigvec (avmgr, width);
 
   for (k = 0; k < width; k++)
@@ -595,10 +591,355 @@ mul_aigvec (BtorAIGVecMgr *avmgr, BtorAIGVec *a, BtorAIGVec *b)
   return res;
 }
 
+/*------------------------------------------------------------------------*/
+
+/* The multipliers below collect partial product bits in columns, where
+ * 'cols[i]' holds the bits of weight 2^i.  Bits of weight >= 2^width are
+ * dropped since the product is truncated to 'width' bits. */
+
+static BtorAIGPtrStack *
+new_columns (BtorAIGVecMgr *avmgr, uint32_t width)
+{
+  BtorAIGPtrStack *cols;
+  uint32_t i;
+
+  BTOR_NEWN (avmgr->btor->mm, cols, width);
+  for (i = 0; i < width; i++) BTOR_INIT_STACK (avmgr->btor->mm, cols[i]);
+  return cols;
+}
+
+static void
+delete_columns (BtorAIGVecMgr *avmgr, BtorAIGPtrStack *cols, uint32_t width)
+{
+  uint32_t i;
+
+  for (i = 0; i < width; i++)
+  {
+    while (!BTOR_EMPTY_STACK (cols[i]))
+      btor_aig_release (avmgr->amgr, BTOR_POP_STACK (cols[i]));
+    BTOR_RELEASE_STACK (cols[i]);
+  }
+  BTOR_DELETEN (avmgr->btor->mm, cols, width);
+}
+
+/* Adds 'aig' with weight 2^col, takes ownership of 'aig'. */
+static void
+push_column (BtorAIGMgr *amgr,
+             BtorAIGPtrStack *cols,
+             uint32_t width,
+             uint32_t col,
+             BtorAIG *aig)
+{
+  if (col >= width || aig == BTOR_AIG_FALSE)
+    btor_aig_release (amgr, aig);
+  else
+    BTOR_PUSH_STACK (cols[col], aig);
+}
+
+/* Reduces three (full adder) or two (half adder) bits of column 'col' of
+ * 'cols' to a sum bit in column 'col' and a carry bit in column 'col + 1'
+ * of 'next'. */
+static void
+compress_column (BtorAIGMgr *amgr,
+                 BtorAIGPtrStack *cols,
+                 BtorAIGPtrStack *next,
+                 uint32_t width,
+                 uint32_t col,
+                 bool full)
+{
+  BtorAIG *x, *y, *z, *sum, *carry;
+
+  assert (BTOR_COUNT_STACK (cols[col]) >= (full ? 3u : 2u));
+
+  x   = BTOR_POP_STACK (cols[col]);
+  y   = BTOR_POP_STACK (cols[col]);
+  z   = full ? BTOR_POP_STACK (cols[col]) : BTOR_AIG_FALSE;
+  sum = full ? full_adder (amgr, x, y, z, &carry)
+             : half_adder (amgr, x, y, &carry);
+  push_column (amgr, next, width, col, sum);
+  push_column (amgr, next, width, col + 1, carry);
+  btor_aig_release (amgr, x);
+  btor_aig_release (amgr, y);
+  btor_aig_release (amgr, z);
+}
+
+/* Sums up the partial product bits in 'cols' with a Wallace or Dadda tree
+ * and a final ripple carry adder.  Releases all bits in 'cols'. */
+static BtorAIGVec *
+sum_columns (BtorAIGVecMgr *avmgr,
+             BtorAIGPtrStack *cols,
+             uint32_t width,
+             bool dadda)
+{
+  BtorAIGMgr *amgr;
+  BtorAIGVec *res;
+  BtorAIGPtrStack *next;
+  BtorAIG *x, *y, *cin, *cout, *tmp;
+  uint32_t i, h, d, max;
+  bool full;
+
+  amgr = avmgr->amgr;
+  next = new_columns (avmgr, width);
+
+  /* The topmost column is not compressed, its sum bit is computed by
+   * XOR-ing all of its bits at the end. */
+  for (;;)
+  {
+    for (i = 0, max = 0; i + 1 < width; i++)
+      if (BTOR_COUNT_STACK (cols[i]) > max) max = BTOR_COUNT_STACK (cols[i]);
+    if (max <= 2) break;
+
+    /* Dadda: reduce to the largest height d_j < max, where d_1 = 2 and
+     * d_j+1 = floor (1.5 * d_j), with as few adders as possible */
+    for (d = 2; dadda && d * 3 / 2 < max; d = d * 3 / 2)
+      ;
+
+    for (i = 0; i + 1 < width; i++)
+    {
+      if (dadda)
+      {
+        /* 'next[i]' already contains the carries of column i - 1 */
+        h = BTOR_COUNT_STACK (cols[i]) + BTOR_COUNT_STACK (next[i]);
+        while (h > d)
+        {
+          full = h - d >= 2 && BTOR_COUNT_STACK (cols[i]) >= 3;
+          compress_column (amgr, cols, next, width, i, full);
+          h -= full ? 2 : 1;
+        }
+      }
+      else
+      {
+        /* Wallace: reduce as many bits as possible */
+        while (BTOR_COUNT_STACK (cols[i]) >= 3)
+          compress_column (amgr, cols, next, width, i, true);
+        if (BTOR_COUNT_STACK (cols[i]) == 2)
+          compress_column (amgr, cols, next, width, i, false);
+      }
+      while (!BTOR_EMPTY_STACK (cols[i]))
+        BTOR_PUSH_STACK (next[i], BTOR_POP_STACK (cols[i]));
+    }
+    while (!BTOR_EMPTY_STACK (cols[width - 1]))
+      BTOR_PUSH_STACK (next[width - 1], BTOR_POP_STACK (cols[width - 1]));
+    for (i = 0; i < width; i++) BTOR_SWAP (BtorAIGPtrStack, cols[i], next[i]);
+  }
+
+  res = new_aigvec (avmgr, width);
+  cin = BTOR_AIG_FALSE;
+  for (i = 0; i + 1 < width; i++)
+  {
+    assert (BTOR_COUNT_STACK (cols[i]) <= 2);
+    x = BTOR_EMPTY_STACK (cols[i]) ? BTOR_AIG_FALSE : BTOR_POP_STACK (cols[i]);
+    y = BTOR_EMPTY_STACK (cols[i]) ? BTOR_AIG_FALSE : BTOR_POP_STACK (cols[i]);
+    res->aigs[width - 1 - i] = full_adder (amgr, x, y, cin, &cout);
+    btor_aig_release (amgr, x);
+    btor_aig_release (amgr, y);
+    btor_aig_release (amgr, cin);
+    cin = cout;
+  }
+  while (!BTOR_EMPTY_STACK (cols[width - 1]))
+  {
+    x   = BTOR_POP_STACK (cols[width - 1]);
+    tmp = btor_aig_eq (amgr, cin, x);
+    btor_aig_release (amgr, cin);
+    btor_aig_release (amgr, x);
+    cin = BTOR_INVERT_AIG (tmp);
+  }
+  res->aigs[0] = cin;
+
+  delete_columns (avmgr, next, width);
+  return res;
+}
+
+/* Multiplier with AND partial products summed up by a Wallace or Dadda
+ * tree. */
+static BtorAIGVec *
+mul_tree_aigvec (BtorAIGVecMgr *avmgr,
+                 BtorAIGVec *a,
+                 BtorAIGVec *b,
+                 bool dadda)
+{
+  BtorAIGMgr *amgr;
+  BtorAIGPtrStack *cols;
+  BtorAIGVec *res;
+  uint32_t i, j, width;
+
+  amgr  = avmgr->amgr;
+  width = a->width;
+  cols  = new_columns (avmgr, width);
+
+  for (i = 0; i < width; i++)
+    for (j = 0; i + j < width; j++)
+      push_column (amgr,
+                   cols,
+                   width,
+                   i + j,
+                   btor_aig_and (amgr,
+                                 a->aigs[width - 1 - i],
+                                 b->aigs[width - 1 - j]));
+
+  res = sum_columns (avmgr, cols, width, dadda);
+  delete_columns (avmgr, cols, width);
+  return res;
+}
+
+/* Radix-4 Booth multiplier.  Operand 'b' is recoded into digits
+ * -2, -1, 0, 1, 2 of weight 4^k, which halves the number of partial
+ * products.  Since the product is truncated to 'width' bits, partial
+ * products do not need to be sign extended.  The partial products are
+ * summed up by a Dadda tree. */
+static BtorAIGVec *
+mul_booth_aigvec (BtorAIGVecMgr *avmgr, BtorAIGVec *a, BtorAIGVec *b)
+{
+  BtorAIGMgr *amgr;
+  BtorAIGPtrStack *cols;
+  BtorAIGVec *res;
+  BtorAIG *b0, *b1, *b2, *neg, *one, *two, *tmp, *and1, *and2, *m;
+  uint32_t j, k, width;
+
+  amgr  = avmgr->amgr;
+  width = a->width;
+  cols  = new_columns (avmgr, width);
+
+  for (k = 0; k < width; k += 2)
+  {
+    /* digit = -2 * b[k + 1] + b[k] + b[k - 1] */
+    b0  = k > 0 ? b->aigs[width - k] : BTOR_AIG_FALSE;
+    b1  = b->aigs[width - 1 - k];
+    b2  = k + 1 < width ? b->aigs[width - 2 - k] : BTOR_AIG_FALSE;
+    neg = b2;
+    tmp = btor_aig_eq (amgr, b1, b0);
+    one = BTOR_INVERT_AIG (tmp);
+    two = btor_aig_eq (amgr, b2, b1);
+    m   = btor_aig_and (amgr, BTOR_INVERT_AIG (two), tmp);
+    btor_aig_release (amgr, two);
+    two = m;
+
+    /* the digit times 'a', negated by one's complement plus 1 */
+    for (j = 0; k + j < width; j++)
+    {
+      and1 = btor_aig_and (amgr, one, a->aigs[width - 1 - j]);
+      and2 = j > 0 ? btor_aig_and (amgr, two, a->aigs[width - j])
+                   : BTOR_AIG_FALSE;
+      m    = btor_aig_or (amgr, and1, and2);
+      push_column (amgr,
+                   cols,
+                   width,
+                   k + j,
+                   BTOR_INVERT_AIG (btor_aig_eq (amgr, m, neg)));
+      btor_aig_release (amgr, and1);
+      btor_aig_release (amgr, and2);
+      btor_aig_release (amgr, m);
+    }
+    push_column (amgr, cols, width, k, btor_aig_copy (amgr, neg));
+    btor_aig_release (amgr, tmp);
+    btor_aig_release (amgr, two);
+  }
+
+  res = sum_columns (avmgr, cols, width, true);
+  delete_columns (avmgr, cols, width);
+  return res;
+}
+
+static bool
+is_const_aigvec (BtorAIGVec *av)
+{
+  uint32_t i;
+  for (i = 0; i < av->width; i++)
+    if (!btor_aig_is_const (av->aigs[i])) return false;
+  return true;
+}
+
+/* Multiplication with constant 'b'.  'b' is recoded into canonical signed
+ * digit form, which has a minimal number of non-zero digits, and a shifted
+ * copy of 'a' or its negation is added for each non-zero digit. */
+static BtorAIGVec *
+mul_csd_aigvec (BtorAIGVecMgr *avmgr, BtorAIGVec *a, BtorAIGVec *b)
+{
+  BtorAIGMgr *amgr;
+  BtorAIGPtrStack *cols;
+  BtorAIGVec *res;
+  uint32_t i, j, t, c, next, width;
+
+  assert (is_const_aigvec (b));
+
+  amgr  = avmgr->amgr;
+  width = a->width;
+  cols  = new_columns (avmgr, width);
+
+  for (i = 0, c = 0; i < width; i++)
+  {
+    t    = (b->aigs[width - 1 - i] == BTOR_AIG_TRUE) + c;
+    next = i + 1 < width && b->aigs[width - 2 - i] == BTOR_AIG_TRUE;
+    if (t == 1 && next)
+    {
+      /* digit -1: -(a << i) = (~a << i) + 2^i */
+      for (j = 0; i + j < width; j++)
+        push_column (amgr,
+                     cols,
+                     width,
+                     i + j,
+                     btor_aig_copy (amgr,
+                                    BTOR_INVERT_AIG (a->aigs[width - 1 - j])));
+      push_column (amgr, cols, width, i, BTOR_AIG_TRUE);
+      c = 1;
+    }
+    else if (t == 1)
+    {
+      /* digit 1 */
+      for (j = 0; i + j < width; j++)
+        push_column (
+            amgr, cols, width, i + j, btor_aig_copy (amgr, a->aigs[width - 1 - j]));
+      c = 0;
+    }
+    else
+      c = t == 2;
+  }
+
+  res = sum_columns (avmgr, cols, width, true);
+  delete_columns (avmgr, cols, width);
+  return res;
+}
+
 BtorAIGVec *
 btor_aigvec_mul (BtorAIGVecMgr *avmgr, BtorAIGVec *a, BtorAIGVec *b)
 {
-  return mul_aigvec (avmgr, a, b);
+  assert (avmgr);
+  assert (a);
+  assert (b);
+  assert (a->width > 0);
+  assert (a->width == b->width);
+
+  Btor *btor;
+
+  btor = avmgr->btor;
+
+  if (btor_opt_get (btor, BTOR_OPT_MUL_CSD))
+  {
+    if (is_const_aigvec (a)) BTOR_SWAP (BtorAIGVec *, a, b);
+    if (is_const_aigvec (b)) return mul_csd_aigvec (avmgr, a, b);
+  }
+
+  if (btor_opt_get (btor, BTOR_OPT_SORT_AIGVEC) > 0
+      && compare_aigvec_lsb_first (a, b) > 0)
+  {
+    BTOR_SWAP (BtorAIGVec *, a, b);
+  }
+
+  switch (btor_opt_get (btor, BTOR_OPT_MUL_ENC))
+  {
+    case BTOR_MUL_ENC_BOOTH:
+      /* never recode a variable operand if the other one is constant,
+       * recode the constant into canonical signed digits instead, which
+       * has at most as many non-zero digits as its radix-4 Booth form */
+      if (is_const_aigvec (a)) BTOR_SWAP (BtorAIGVec *, a, b);
+      if (is_const_aigvec (b)) return mul_csd_aigvec (avmgr, a, b);
+      return mul_booth_aigvec (avmgr, a, b);
+    case BTOR_MUL_ENC_WALLACE: return mul_tree_aigvec (avmgr, a, b, false);
+    case BTOR_MUL_ENC_DADDA: return mul_tree_aigvec (avmgr, a, b, true);
+    default:
+      assert (btor_opt_get (btor, BTOR_OPT_MUL_ENC) == BTOR_MUL_ENC_ARRAY);
+      return mul_aigvec (avmgr, a, b);
+  }
 }
 
 static void
@@ -641,6 +982,10 @@ SC_GATE_S_aigvec (BtorAIGMgr *amgr,
   btor_aig_release (amgr, T2_or_R);
 }
 
+/* Restoring array divider.  The partial remainder is smaller than the
+ * divisor and than the dividend bits shifted in so far, hence row j only
+ * compares and subtracts the j + 1 least significant bits, and the
+ * quotient bit is zero if any higher bit of the divisor is set. */
 static void
 udiv_urem_aigvec (BtorAIGVecMgr *avmgr,
                   BtorAIGVec *Ain,
@@ -648,11 +993,11 @@ udiv_urem_aigvec (BtorAIGVecMgr *avmgr,
                   BtorAIGVec **Qptr,
                   BtorAIGVec **Rptr)
 {
-  BtorAIG **A, **nD, ***S, ***C;
-  BtorAIGVec *Q, *R;
+  BtorAIG **R, **nD, **Z, **C, *tmp;
+  BtorAIGVec *Q, *Rv;
   BtorAIGMgr *amgr;
   BtorMemMgr *mem;
-  uint32_t size, i, j;
+  uint32_t size, i, j, w;
 
   size = Ain->width;
   assert (size > 0);
@@ -660,95 +1005,287 @@ udiv_urem_aigvec (BtorAIGVecMgr *avmgr,
   amgr = btor_aigvec_get_aig_mgr (avmgr);
   mem  = avmgr->btor->mm;
 
-  BTOR_NEWN (mem, A, size);
-  for (i = 0; i < size; i++) A[i] = Ain->aigs[size - 1 - i];
-
+  /* inverted divisor, LSB first */
   BTOR_NEWN (mem, nD, size);
   for (i = 0; i < size; i++) nD[i] = BTOR_INVERT_AIG (Din->aigs[size - 1 - i]);
 
-  BTOR_NEWN (mem, S, size + 1);
-  for (j = 0; j <= size; j++)
-  {
-    BTOR_NEWN (mem, S[j], size + 1);
-    for (i = 0; i <= size; i++) S[j][i] = BTOR_AIG_FALSE;
-  }
+  /* Z[w]: all divisor bits w and above are zero */
+  BTOR_NEWN (mem, Z, size + 1);
+  Z[size] = BTOR_AIG_TRUE;
+  for (w = size - 1; w >= 1; w--) Z[w] = btor_aig_and (amgr, Z[w + 1], nD[w]);
 
+  /* partial remainder, LSB first, and carries */
+  BTOR_NEWN (mem, R, size);
   BTOR_NEWN (mem, C, size + 1);
-  for (j = 0; j <= size; j++)
+
+  Q  = new_aigvec (avmgr, size);
+  Rv = new_aigvec (avmgr, size);
+
+  for (j = 0; j < size; j++)
   {
-    BTOR_NEWN (mem, C[j], size + 1);
-    for (i = 0; i <= size; i++) C[j][i] = BTOR_AIG_FALSE;
+    w = j + 1;
+    for (i = w - 1; i >= 1; i--) R[i] = R[i - 1];
+    R[0] = btor_aig_copy (amgr, Ain->aigs[j]);
+
+    C[0] = BTOR_AIG_TRUE;
+    for (i = 0; i < w; i++)
+      SC_GATE_CO_aigvec (amgr, &C[i + 1], R[i], nD[i], C[i]);
+
+    Q->aigs[j] = btor_aig_and (amgr, C[w], Z[w]);
+
+    for (i = 0; i < w; i++)
+    {
+      SC_GATE_S_aigvec (amgr, &tmp, R[i], nD[i], C[i], Q->aigs[j]);
+      btor_aig_release (amgr, R[i]);
+      R[i] = tmp;
+    }
+    for (i = 0; i <= w; i++) btor_aig_release (amgr, C[i]);
   }
 
-  R = new_aigvec (avmgr, size);
+  for (i = 0; i < size; i++) Rv->aigs[size - 1 - i] = R[i];
+
+  for (w = 1; w <= size; w++) btor_aig_release (amgr, Z[w]);
+  BTOR_DELETEN (mem, C, size + 1);
+  BTOR_DELETEN (mem, R, size);
+  BTOR_DELETEN (mem, Z, size + 1);
+  BTOR_DELETEN (mem, nD, size);
+
+  *Qptr = Q;
+  *Rptr = Rv;
+}
+
+/* Non-restoring division: the partial remainder P is kept in two's
+ * complement with one extra sign bit.  In every row the divisor is
+ * subtracted if P is non-negative and added otherwise, which replaces the
+ * restoring multiplexers by an XOR on the divisor.  A final conditional
+ * addition corrects a negative remainder. */
+static void
+udiv_urem_nonrestoring_aigvec (BtorAIGVecMgr *avmgr,
+                               BtorAIGVec *Ain,
+                               BtorAIGVec *Din,
+                               BtorAIGVec **Qptr,
+                               BtorAIGVec **Rptr)
+{
+  BtorAIG **P, **Y, *sub, *cin, *cout, *tmp;
+  BtorAIGVec *Q, *R;
+  BtorAIGMgr *amgr;
+  BtorMemMgr *mem;
+  uint32_t size, i, j, k;
+
+  size = Ain->width;
+  assert (size > 0);
+
+  amgr = btor_aigvec_get_aig_mgr (avmgr);
+  mem  = avmgr->btor->mm;
+
+  /* partial remainder and divisor operand, LSB first, with sign bit */
+  BTOR_NEWN (mem, P, size + 1);
+  BTOR_NEWN (mem, Y, size + 1);
+  for (i = 0; i <= size; i++) P[i] = BTOR_AIG_FALSE;
+
   Q = new_aigvec (avmgr, size);
+  R = new_aigvec (avmgr, size);
 
-  for (j = 0; j <= size - 1; j++)
+  sub = BTOR_AIG_TRUE;
+  for (j = 0; j < size; j++)
   {
-    S[j][0] = btor_aig_copy (amgr, A[size - j - 1]);
-    C[j][0] = BTOR_AIG_TRUE;
+    /* P = 2 * P + a_j -/+ D */
+    btor_aig_release (amgr, P[size]);
+    for (i = size; i >= 1; i--) P[i] = P[i - 1];
+    P[0] = btor_aig_copy (amgr, Ain->aigs[j]);
+
+    for (i = 0, k = size - 1; i < size; i++, k--)
+      Y[i] = BTOR_INVERT_AIG (btor_aig_eq (amgr, Din->aigs[k], sub));
+    Y[size] = btor_aig_copy (amgr, sub);
 
-    for (i = 0; i <= size - 1; i++)
-      SC_GATE_CO_aigvec (amgr, &C[j][i + 1], S[j][i], nD[i], C[j][i]);
+    cin = btor_aig_copy (amgr, sub);
+    for (i = 0; i <= size; i++)
+    {
+      tmp = full_adder (amgr, P[i], Y[i], cin, &cout);
+      btor_aig_release (amgr, P[i]);
+      btor_aig_release (amgr, Y[i]);
+      btor_aig_release (amgr, cin);
+      P[i] = tmp;
+      cin  = cout;
+    }
+    btor_aig_release (amgr, cin);
 
-    Q->aigs[j] = btor_aig_or (amgr, C[j][size], S[j][size]);
+    btor_aig_release (amgr, sub);
+    sub        = BTOR_INVERT_AIG (btor_aig_copy (amgr, P[size]));
+    Q->aigs[j] = btor_aig_copy (amgr, sub);
+  }
+  btor_aig_release (amgr, sub);
 
-    for (i = 0; i <= size - 1; i++)
-      SC_GATE_S_aigvec (
-          amgr, &S[j + 1][i + 1], S[j][i], nD[i], C[j][i], Q->aigs[j]);
+  /* R = P + (P < 0 ? D : 0) */
+  cin = BTOR_AIG_FALSE;
+  for (i = 0, k = size - 1; i < size; i++, k--)
+  {
+    tmp        = btor_aig_and (amgr, Din->aigs[k], P[size]);
+    R->aigs[k] = full_adder (amgr, P[i], tmp, cin, &cout);
+    btor_aig_release (amgr, tmp);
+    btor_aig_release (amgr, cin);
+    cin = cout;
   }
+  btor_aig_release (amgr, cin);
 
-  for (i = size; i >= 1; i--)
-    R->aigs[size - i] = btor_aig_copy (amgr, S[size][i]);
+  for (i = 0; i <= size; i++) btor_aig_release (amgr, P[i]);
+  BTOR_DELETEN (mem, Y, size + 1);
+  BTOR_DELETEN (mem, P, size + 1);
 
-  for (j = 0; j <= size; j++)
+  *Qptr = Q;
+  *Rptr = R;
+}
+
+static uint32_t
+hash_div_aigvec (BtorAIGVecDiv *d)
+{
+  assert (d);
+  assert (d->a->width == d->b->width);
+
+  uint32_t i, res;
+  BtorAIG *aig;
+
+  res = d->a->width;
+  for (i = 0; i < d->a->width; i++)
   {
-    for (i = 0; i <= size; i++) btor_aig_release (amgr, C[j][i]);
-    BTOR_DELETEN (mem, C[j], size + 1);
+    aig = d->a->aigs[i];
+    res = res * 31
+          + (btor_aig_is_const (aig) ? (uint32_t) (uintptr_t) aig
+                                     : (uint32_t) btor_aig_get_id (aig));
+    aig = d->b->aigs[i];
+    res = res * 31
+          + (btor_aig_is_const (aig) ? (uint32_t) (uintptr_t) aig
+                                     : (uint32_t) btor_aig_get_id (aig));
   }
-  BTOR_DELETEN (mem, C, size + 1);
+  return res;
+}
+
+static int32_t
+compare_div_aigvec (BtorAIGVecDiv *d0, BtorAIGVecDiv *d1)
+{
+  assert (d0);
+  assert (d1);
+
+  uint32_t width;
+
+  width = d0->a->width;
+  if (width != d1->a->width) return 1;
+  if (memcmp (d0->a->aigs, d1->a->aigs, sizeof (BtorAIG *) * width)) return 1;
+  return memcmp (d0->b->aigs, d1->b->aigs, sizeof (BtorAIG *) * width);
+}
+
+static void
+delete_div_aigvec (BtorAIGVecMgr *avmgr, BtorAIGVecDiv *d)
+{
+  assert (avmgr);
+  assert (d);
+
+  if (d->a) btor_aigvec_release_delete (avmgr, d->a);
+  if (d->b) btor_aigvec_release_delete (avmgr, d->b);
+  if (d->q) btor_aigvec_release_delete (avmgr, d->q);
+  if (d->r) btor_aigvec_release_delete (avmgr, d->r);
+  BTOR_DELETE (avmgr->btor->mm, d);
+}
+
+/* Return the quotient (if 'quotient' is true) or the remainder of a / b.
+ * The other result is cached until requested by btor_aigvec_udiv or
+ * btor_aigvec_urem over the same operands, or until it is evicted by
+ * newer entries.  Operands are compared by
+ * their AIGs rather than by the vector pointers since the vectors of
+ * inverted nodes are inverted in place while synthesizing. */
+static BtorAIGVec *
+udiv_urem_cached_aigvec (BtorAIGVecMgr *avmgr,
+                         BtorAIGVec *a,
+                         BtorAIGVec *b,
+                         bool quotient)
+{
+  assert (avmgr);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (a->width > 0);
+
+  BtorPtrHashBucket *bucket;
+  BtorAIGVecDiv key, *d, *oldest;
+  BtorAIGVec *res, **cached;
+
+  if (!avmgr->div_cache)
+    avmgr->div_cache = btor_hashptr_table_new (avmgr->btor->mm,
+                                               (BtorHashPtr) hash_div_aigvec,
+                                               (BtorCmpPtr) compare_div_aigvec);
+
+  key.a  = a;
+  key.b  = b;
+  bucket = btor_hashptr_table_get (avmgr->div_cache, &key);
 
-  for (j = 0; j <= size; j++)
+  if (bucket)
   {
-    for (i = 0; i <= size; i++) btor_aig_release (amgr, S[j][i]);
-    BTOR_DELETEN (mem, S[j], size + 1);
+    d      = bucket->key;
+    cached = quotient ? &d->q : &d->r;
+    if ((res = *cached))
+    {
+      *cached = 0;
+      if (!d->q && !d->r)
+      {
+        btor_hashptr_table_remove (avmgr->div_cache, d, 0, 0);
+        delete_div_aigvec (avmgr, d);
+      }
+      return res;
+    }
   }
-  BTOR_DELETEN (mem, S, size + 1);
 
-  BTOR_DELETEN (mem, nD, size);
-  BTOR_DELETEN (mem, A, size);
+  BTOR_CNEW (avmgr->btor->mm, d);
+  if (btor_opt_get (avmgr->btor, BTOR_OPT_DIV_ENC) == BTOR_DIV_ENC_NONRESTORING)
+    udiv_urem_nonrestoring_aigvec (avmgr, a, b, &d->q, &d->r);
+  else
+    udiv_urem_aigvec (avmgr, a, b, &d->q, &d->r);
+  cached  = quotient ? &d->q : &d->r;
+  res     = *cached;
+  *cached = 0;
 
-  *Qptr = Q;
-  *Rptr = R;
+  if (bucket)
+  {
+    /* result has already been handed out before, the other one is still
+     * cached */
+    delete_div_aigvec (avmgr, d);
+    return res;
+  }
+
+  /* the other result is usually requested right after the first one,
+   * evict the oldest entry rather than keeping unrequested results (and
+   * the operands) alive */
+  if (avmgr->div_cache->count >= BTOR_AIGVEC_DIV_CACHE_SIZE)
+  {
+    oldest = btor_hashptr_table_first (avmgr->div_cache)->key;
+    btor_hashptr_table_remove (avmgr->div_cache, oldest, 0, 0);
+    delete_div_aigvec (avmgr, oldest);
+  }
+  d->a = btor_aigvec_copy (avmgr, a);
+  d->b = btor_aigvec_copy (avmgr, b);
+  btor_hashptr_table_add (avmgr->div_cache, d);
+  return res;
 }
 
 BtorAIGVec *
 btor_aigvec_udiv (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
 {
-  BtorAIGVec *quotient  = 0;
-  BtorAIGVec *remainder = 0;
   assert (avmgr);
   assert (av1);
   assert (av2);
   assert (av1->width == av2->width);
   assert (av1->width > 0);
-  udiv_urem_aigvec (avmgr, av1, av2, &quotient, &remainder);
-  btor_aigvec_release_delete (avmgr, remainder);
-  return quotient;
+  return udiv_urem_cached_aigvec (avmgr, av1, av2, true);
 }
 
 BtorAIGVec *
 btor_aigvec_urem (BtorAIGVecMgr *avmgr, BtorAIGVec *av1, BtorAIGVec *av2)
 {
-  BtorAIGVec *quotient, *remainder;
   assert (avmgr);
   assert (av1);
   assert (av2);
   assert (av1->width == av2->width);
   assert (av1->width > 0);
-  udiv_urem_aigvec (avmgr, av1, av2, &quotient, &remainder);
-  btor_aigvec_release_delete (avmgr, quotient);
-  return remainder;
+  return udiv_urem_cached_aigvec (avmgr, av1, av2, false);
 }
 
 BtorAIGVec *
@@ -837,9 +1374,7 @@ btor_aigvec_clone (BtorAIGVec *av, BtorAIGVecMgr *avmgr)
     {
       aig = av->aigs[i];
       assert (BTOR_REAL_ADDR_AIG (aig)->id >= 0);
-      assert ((size_t) BTOR_REAL_ADDR_AIG (aig)->id
-              < BTOR_COUNT_STACK (amgr->id2aig));
-      caig = BTOR_PEEK_STACK (amgr->id2aig, BTOR_REAL_ADDR_AIG (aig)->id);
+      caig = btor_aig_get_by_id (amgr, BTOR_REAL_ADDR_AIG (aig)->id);
       assert (caig);
       assert (!btor_aig_is_const (caig));
       if (BTOR_IS_INVERTED_AIG (aig))
@@ -852,6 +1387,23 @@ btor_aigvec_clone (BtorAIGVec *av, BtorAIGVecMgr *avmgr)
   return res;
 }
 
+BtorAIGVec *
+btor_aigvec_import (BtorAIGVecMgr *avmgr, BtorAIGMap *map, BtorAIGVec *av)
+{
+  assert (avmgr);
+  assert (map);
+  assert (map->amgr_dst == avmgr->amgr);
+  assert (av);
+
+  uint32_t i;
+  BtorAIGVec *res;
+
+  res = new_aigvec (avmgr, av->width);
+  for (i = 0; i < av->width; i++)
+    res->aigs[i] = btor_aigmap_import (map, av->aigs[i]);
+  return res;
+}
+
 void
 btor_aigvec_to_sat_tseitin (BtorAIGVecMgr *avmgr, BtorAIGVec *av)
 {
@@ -878,7 +1430,10 @@ btor_aigvec_release_delete (BtorAIGVecMgr *avmgr, BtorAIGVec *av)
   amgr  = avmgr->amgr;
   width = av->width;
   for (i = 0; i < width; i++) btor_aig_release (amgr, av->aigs[i]);
-  btor_mem_free (mm, av, sizeof (BtorAIGVec) + sizeof (BtorAIG *) * av->width);
+  btor_mem_free_tag (mm,
+                     BTOR_MEM_TAG_AIGVEC,
+                     av,
+                     sizeof (BtorAIGVec) + sizeof (BtorAIG *) * av->width);
   avmgr->cur_num_aigvecs--;
 }
 
@@ -894,6 +1449,27 @@ btor_aigvec_mgr_new (Btor *btor)
   return avmgr;
 }
 
+static void *
+clone_key_as_div_aigvec (BtorMemMgr *mm, const void *avmgr, const void *key)
+{
+  assert (mm);
+  assert (avmgr);
+  assert (key);
+
+  BtorAIGVecMgr *cavmgr;
+  const BtorAIGVecDiv *d;
+  BtorAIGVecDiv *res;
+
+  cavmgr = (BtorAIGVecMgr *) avmgr;
+  d      = (const BtorAIGVecDiv *) key;
+  BTOR_CNEW (mm, res);
+  res->a = btor_aigvec_clone (d->a, cavmgr);
+  res->b = btor_aigvec_clone (d->b, cavmgr);
+  if (d->q) res->q = btor_aigvec_clone (d->q, cavmgr);
+  if (d->r) res->r = btor_aigvec_clone (d->r, cavmgr);
+  return res;
+}
+
 BtorAIGVecMgr *
 btor_aigvec_mgr_clone (Btor *btor, BtorAIGVecMgr *avmgr)
 {
@@ -901,19 +1477,38 @@ btor_aigvec_mgr_clone (Btor *btor, BtorAIGVecMgr *avmgr)
   assert (avmgr);
 
   BtorAIGVecMgr *res;
-  BTOR_NEW (btor->mm, res);
+  BTOR_CNEW (btor->mm, res);
 
-  res->btor            = btor;
-  res->amgr            = btor_aig_mgr_clone (btor, avmgr->amgr);
+  res->btor = btor;
+  res->amgr = btor_aig_mgr_clone (btor, avmgr->amgr);
+  /* the cached vectors hold references, which are cloned with the AIGs */
+  res->div_cache = btor_hashptr_table_clone (
+      btor->mm, avmgr->div_cache, clone_key_as_div_aigvec, 0, res, 0);
   res->max_num_aigvecs = avmgr->max_num_aigvecs;
   res->cur_num_aigvecs = avmgr->cur_num_aigvecs;
   return res;
 }
 
+void
+btor_aigvec_mgr_reset_div_cache (BtorAIGVecMgr *avmgr)
+{
+  assert (avmgr);
+
+  BtorPtrHashTableIterator it;
+
+  if (!avmgr->div_cache) return;
+  btor_iter_hashptr_init (&it, avmgr->div_cache);
+  while (btor_iter_hashptr_has_next (&it))
+    delete_div_aigvec (avmgr, btor_iter_hashptr_next (&it));
+  btor_hashptr_table_delete (avmgr->div_cache);
+  avmgr->div_cache = 0;
+}
+
 void
 btor_aigvec_mgr_delete (BtorAIGVecMgr *avmgr)
 {
   assert (avmgr);
+  btor_aigvec_mgr_reset_div_cache (avmgr);
   btor_aig_mgr_delete (avmgr->amgr);
   BTOR_DELETE (avmgr->btor->mm, avmgr);
 }
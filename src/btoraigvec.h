@@ -13,6 +13,7 @@
 #include "btorbv.h"
 #include "btoropt.h"
 #include "btortypes.h"
+#include "utils/btorhashptr.h"
 #include "utils/btormem.h"
 
 struct BtorAIGMap;
@@ -29,10 +30,27 @@ typedef struct BtorAIGVec BtorAIGVec;
 
 typedef struct BtorAIGVecMgr BtorAIGVecMgr;
 
+/* Quotient and remainder of an unsigned division, cached such that udiv and
+ * urem over the same operands share one divider circuit.  An entry is
+ * removed as soon as both of its results have been handed out, or evicted
+ * if it is the oldest of BTOR_AIGVEC_DIV_CACHE_SIZE entries. */
+struct BtorAIGVecDiv
+{
+  BtorAIGVec *a; /* dividend */
+  BtorAIGVec *b; /* divisor */
+  BtorAIGVec *q; /* quotient, 0 if already handed out */
+  BtorAIGVec *r; /* remainder, 0 if already handed out */
+};
+
+typedef struct BtorAIGVecDiv BtorAIGVecDiv;
+
+#define BTOR_AIGVEC_DIV_CACHE_SIZE 64
+
 struct BtorAIGVecMgr
 {
   Btor *btor;
   BtorAIGMgr *amgr;
+  BtorPtrHashTable *div_cache; /* BtorAIGVecDiv, created on demand */
   uint_least64_t max_num_aigvecs;
   uint_least64_t cur_num_aigvecs;
 };
@@ -45,6 +63,9 @@ void btor_aigvec_mgr_delete (BtorAIGVecMgr *avmgr);
 
 BtorAIGMgr *btor_aigvec_get_aig_mgr (const BtorAIGVecMgr *avmgr);
 
+/* Release all cached udiv/urem results. */
+void btor_aigvec_mgr_reset_div_cache (BtorAIGVecMgr *avmgr);
+
 /*------------------------------------------------------------------------*/
 
 /**
@@ -147,6 +168,7 @@ BtorAIGVec *btor_aigvec_mul (BtorAIGVecMgr *avmgr,
                              BtorAIGVec *av2);
 /**
  * Create an AIG vector representing av1 / av2 (unsigned).
+ * The divider circuit is shared with btor_aigvec_urem on the same operands.
  * width(av1) = width(av2)
  * width(result) = width(av1) = width(av2)
  */
@@ -155,6 +177,7 @@ BtorAIGVec *btor_aigvec_udiv (BtorAIGVecMgr *avmgr,
                               BtorAIGVec *av2);
 /**
  * Create an AIG vector representing av1 % av2 (unsigned).
+ * The divider circuit is shared with btor_aigvec_udiv on the same operands.
  * width(av1) = width(av2)
  * width(result) = width(av1) = width(av2)
  */
@@ -190,6 +213,15 @@ BtorAIGVec *btor_aigvec_copy (BtorAIGVecMgr *avmgr, BtorAIGVec *av);
  */
 BtorAIGVec *btor_aigvec_clone (BtorAIGVec *av, BtorAIGVecMgr *avmgr);
 
+/**
+ * Import the given AIG vector of another AIG vector manager via 'map'
+ * (cf. btor_aigmap_import).
+ * width(result) = width(av)
+ */
+BtorAIGVec *btor_aigvec_import (BtorAIGVecMgr *avmgr,
+                                struct BtorAIGMap *map,
+                                BtorAIGVec *av);
+
 /*i* Translate every AIG of the given AIG vector into SAT in both phases.  */
 void btor_aigvec_to_sat_tseitin (BtorAIGVecMgr *avmgr, BtorAIGVec *av);
 
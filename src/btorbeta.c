@@ -202,7 +202,7 @@ beta_reduce (Btor *btor,
   BTOR_INIT_STACK (mm, arg_stack);
   BTOR_INIT_STACK (mm, cleanup_stack);
   BTOR_INIT_STACK (mm, reset);
-  mark = btor_hashint_map_new (mm);
+  mark = btor_hashint_map_new_tag (mm, BTOR_MEM_TAG_BETA);
 
   BTOR_PUSH_STACK (stack, exp);
   BTOR_PUSH_STACK (stack, 0);
@@ -608,7 +608,7 @@ beta_reduce_partial_aux (Btor *btor,
   BTOR_INIT_STACK (mm, stack);
   BTOR_INIT_STACK (mm, arg_stack);
   BTOR_INIT_STACK (mm, reset);
-  mark = btor_hashint_map_new (mm);
+  mark = btor_hashint_map_new_tag (mm, BTOR_MEM_TAG_BETA);
 
   real_cur = btor_node_real_addr (exp);
 
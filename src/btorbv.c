@@ -28,9 +28,9 @@ struct BtorBitVector
 #else
   uint32_t len;   /* length of 'bits' array */
 
-  /* 'bits' represents the bit vector in 32-bit chunks, first bit of 32-bit bv
-   * in bits[0] is MSB, bit vector is 'filled' from LSB, hence spare bits (if
-   * any) come in front of the MSB and are zeroed out.
+  /* 'bits' represents the bit vector in BTOR_BV_TYPE_BW-bit chunks (limbs),
+   * first bit of bits[0] is MSB, bit vector is 'filled' from LSB, hence spare
+   * bits (if any) come in front of the MSB and are zeroed out.
    * E.g., for a bit vector of width 31, representing value 1:
    *
    *    bits[0] = 0 0000....1
@@ -65,13 +65,114 @@ set_rem_bits_to_zero (BtorBitVector *bv)
   if (bv->width != BTOR_BV_TYPE_BW * bv->len)
     bv->bits[0] &= BTOR_MASK_REM_BITS (bv);
 }
+
+#ifdef __SIZEOF_INT128__
+#define BTOR_BV_HAVE_UINT128
+__extension__ typedef unsigned __int128 BtorBvUInt128;
+#endif
+
+/* Unsigned integer type of twice the limb size, used to propagate carries
+ * and to compute limb products and quotients. */
+#ifdef BTOR_BV_LIMB64
+#ifndef BTOR_BV_HAVE_UINT128
+#error "64-bit limbs require compiler support for unsigned __int128"
+#endif
+typedef BtorBvUInt128 BtorBvDLimb;
+#else
+typedef uint64_t BtorBvDLimb;
+#endif
+
+/* Get the 64 least significant bits of the given bit-vector. */
+static inline uint64_t
+bv_get_lsb_uint64 (const BtorBitVector *bv)
+{
+#ifdef BTOR_BV_LIMB64
+  return bv->bits[bv->len - 1];
+#else
+  if (bv->len == 1) return bv->bits[0];
+  return ((uint64_t) bv->bits[bv->len - 2] << BTOR_BV_TYPE_BW)
+         | bv->bits[bv->len - 1];
+#endif
+}
+
+/* Set the 64 least significant bits of the given bit-vector. */
+static inline void
+bv_set_lsb_uint64 (BtorBitVector *bv, uint64_t value)
+{
+  bv->bits[bv->len - 1] = (BTOR_BV_TYPE) value;
+#ifndef BTOR_BV_LIMB64
+  if (bv->len > 1) bv->bits[bv->len - 2] = (BTOR_BV_TYPE) (value >> 32);
+#endif
+}
+
+static inline BTOR_BV_TYPE
+bv_rand_limb (BtorRNG *rng)
+{
+#ifdef BTOR_BV_LIMB64
+  BTOR_BV_TYPE res = btor_rng_rand (rng);
+  return (res << 32) | btor_rng_rand (rng);
+#else
+  return btor_rng_rand (rng);
+#endif
+}
+
+/* Bit-vectors of width <= 64 (and <= 128 if the compiler provides a native
+ * 128-bit integer type) are handled as native integers in the arithmetic
+ * kernels rather than limb by limb. */
+
+static inline uint64_t
+bv_get_uint64 (const BtorBitVector *bv)
+{
+  assert (bv->width <= 64);
+  return bv_get_lsb_uint64 (bv);
+}
+
+static inline void
+bv_set_uint64 (BtorBitVector *bv, uint64_t value)
+{
+  assert (bv->width <= 64);
+  if (bv->width < 64) value &= ((uint64_t) 1 << bv->width) - 1;
+  bv_set_lsb_uint64 (bv, value);
+  assert (rem_bits_zero_dbg (bv));
+}
+
+#ifdef BTOR_BV_HAVE_UINT128
+static inline BtorBvUInt128
+bv_get_uint128 (const BtorBitVector *bv)
+{
+  assert (bv->width <= 128);
+
+  uint32_t i;
+  BtorBvUInt128 res;
+
+  for (i = 0, res = 0; i < bv->len; i++)
+    res = (res << BTOR_BV_TYPE_BW) | bv->bits[i];
+  return res;
+}
+
+static inline void
+bv_set_uint128 (BtorBitVector *bv, BtorBvUInt128 value)
+{
+  assert (bv->width <= 128);
+
+  int64_t i;
+
+  if (bv->width < 128) value &= ((BtorBvUInt128) 1 << bv->width) - 1;
+  for (i = bv->len - 1; i >= 0; i--)
+  {
+    bv->bits[i] = (BTOR_BV_TYPE) value;
+    value >>= BTOR_BV_TYPE_BW;
+  }
+  assert (rem_bits_zero_dbg (bv));
+}
+#endif
 #endif
 
 #ifndef NDEBUG
 static bool
 check_bits_sll_dbg (const BtorBitVector *bv,
                     const BtorBitVector *res,
-                    uint32_t shift)
+                    uint64_t shift)
 {
   assert (bv);
   assert (res);
@@ -81,7 +182,7 @@ check_bits_sll_dbg (const BtorBitVector *bv,
 
   if (shift >= bv->width)
   {
-    for (i = 0; i < bv->width; i++) assert (btor_bv_get_bit (bv, i) == 0);
+    for (i = 0; i < res->width; i++) assert (btor_bv_get_bit (res, i) == 0);
   }
   else
   {
@@ -104,7 +205,7 @@ btor_bv_new (BtorMemMgr *mm, uint32_t bw)
   BtorBitVector *res;
 
 #ifdef BTOR_USE_GMP
-  BTOR_NEW (mm, res);
+  BTOR_NEW_TAG (mm, BTOR_MEM_TAG_BV, res);
   res->width = bw;
   mpz_init (res->val);
 #else
@@ -114,8 +215,8 @@ btor_bv_new (BtorMemMgr *mm, uint32_t bw)
   if (bw % BTOR_BV_TYPE_BW > 0) i += 1;
 
   assert (i > 0);
-  res =
-      btor_mem_malloc (mm, sizeof (BtorBitVector) + sizeof (BTOR_BV_TYPE) * i);
+  res = btor_mem_malloc_tag (
+      mm, BTOR_MEM_TAG_BV, sizeof (BtorBitVector) + sizeof (BTOR_BV_TYPE) * i);
   BTOR_CLRN (res->bits, i);
   res->len = i;
   assert (res->len);
@@ -215,10 +316,13 @@ btor_bv_new_random_bit_range (
   res = btor_bv_new_random (mm, rng, bw);
 #else
   res = btor_bv_new (mm, bw);
-  for (i = 1; i < res->len; i++)
-    res->bits[i] = (BTOR_BV_TYPE) btor_rng_rand (rng);
+  for (i = 1; i < res->len; i++) res->bits[i] = bv_rand_limb (rng);
+#ifdef BTOR_BV_LIMB64
+  res->bits[0] = bv_rand_limb (rng);
+#else
   res->bits[0] = (BTOR_BV_TYPE) btor_rng_pick_rand (
       rng, 0, ((~0) >> (BTOR_BV_TYPE_BW - bw % BTOR_BV_TYPE_BW)) - 1);
+#endif
   set_rem_bits_to_zero (res);
 #endif
   for (i = 0; i < lo; i++) btor_bv_set_bit (res, i, 0);
@@ -238,7 +342,7 @@ btor_bv_char_to_bv (BtorMemMgr *mm, const char *assignment)
 
   BtorBitVector *res;
 #ifdef BTOR_USE_GMP
-  BTOR_NEW (mm, res);
+  BTOR_NEW_TAG (mm, BTOR_MEM_TAG_BV, res);
   res->width = strlen (assignment);
   mpz_init_set_str (res->val, assignment, 2);
 #else
@@ -256,16 +360,14 @@ btor_bv_uint64_to_bv (BtorMemMgr *mm, uint64_t value, uint32_t bw)
   BtorBitVector *res;
 
 #ifdef BTOR_USE_GMP
-  BTOR_NEW (mm, res);
+  BTOR_NEW_TAG (mm, BTOR_MEM_TAG_BV, res);
   res->width = bw;
   mpz_init_set_ui (res->val, value);
   mpz_fdiv_r_2exp (res->val, res->val, bw);
 #else
   res = btor_bv_new (mm, bw);
   assert (res->len > 0);
-  res->bits[res->len - 1] = (BTOR_BV_TYPE) value;
-  if (res->width > 32)
-    res->bits[res->len - 2] = (BTOR_BV_TYPE) (value >> BTOR_BV_TYPE_BW);
+  bv_set_lsb_uint64 (res, value);
 
   set_rem_bits_to_zero (res);
   assert (rem_bits_zero_dbg (res));
@@ -282,7 +384,7 @@ btor_bv_int64_to_bv (BtorMemMgr *mm, int64_t value, uint32_t bw)
   BtorBitVector *res;
 
 #ifdef BTOR_USE_GMP
-  BTOR_NEW (mm, res);
+  BTOR_NEW_TAG (mm, BTOR_MEM_TAG_BV, res);
   res->width = bw;
   mpz_init_set_si (res->val, value);
   mpz_fdiv_r_2exp (res->val, res->val, bw);
@@ -299,9 +401,7 @@ btor_bv_int64_to_bv (BtorMemMgr *mm, int64_t value, uint32_t bw)
     res = tmp;
   }
 
-  res->bits[res->len - 1] = (BTOR_BV_TYPE) value;
-  if (res->width > 32)
-    res->bits[res->len - 2] = (BTOR_BV_TYPE) (value >> BTOR_BV_TYPE_BW);
+  bv_set_lsb_uint64 (res, (uint64_t) value);
 
   set_rem_bits_to_zero (res);
   assert (rem_bits_zero_dbg (res));
@@ -317,7 +417,7 @@ btor_bv_const (BtorMemMgr *mm, const char *str, uint32_t bw)
   BtorBitVector *res;
 
 #ifdef BTOR_USE_GMP
-  BTOR_NEW (mm, res);
+  BTOR_NEW_TAG (mm, BTOR_MEM_TAG_BV, res);
   res->width = bw;
   mpz_init_set_str (res->val, str, 2);
 #else
@@ -342,7 +442,7 @@ btor_bv_constd (BtorMemMgr *mm, const char *str, uint32_t bw)
   BtorBitVector *res;
 
 #ifdef BTOR_USE_GMP
-  BTOR_NEW (mm, res);
+  BTOR_NEW_TAG (mm, BTOR_MEM_TAG_BV, res);
   res->width = bw;
   mpz_init_set_str (res->val, str, 10);
 #else
@@ -392,7 +492,7 @@ btor_bv_consth (BtorMemMgr *mm, const char *str, uint32_t bw)
   BtorBitVector *res;
 
 #ifdef BTOR_USE_GMP
-  BTOR_NEW (mm, res);
+  BTOR_NEW_TAG (mm, BTOR_MEM_TAG_BV, res);
   res->width = bw;
   mpz_init_set_str (res->val, str, 16);
 #else
@@ -468,15 +568,25 @@ btor_bv_copy (BtorMemMgr *mm, const BtorBitVector *bv)
   BtorBitVector *res;
 
   res = btor_bv_new (mm, bv->width);
+  btor_bv_copy_into (res, bv);
+  return res;
+}
+
+void
+btor_bv_copy_into (BtorBitVector *res, const BtorBitVector *bv)
+{
+  assert (res);
+  assert (bv);
   assert (res->width == bv->width);
+
+  if (res == bv) return;
 #ifdef BTOR_USE_GMP
   mpz_set (res->val, bv->val);
 #else
   assert (res->len == bv->len);
   memcpy (res->bits, bv->bits, sizeof (*(bv->bits)) * bv->len);
 #endif
-  assert (btor_bv_compare (res, (BtorBitVector *) bv) == 0);
-  return res;
+  assert (btor_bv_compare (res, bv) == 0);
 }
 
 /*------------------------------------------------------------------------*/
@@ -502,10 +612,12 @@ btor_bv_free (BtorMemMgr *mm, BtorBitVector *bv)
   assert (bv);
 #ifdef BTOR_USE_GMP
   mpz_clear (bv->val);
-  btor_mem_free (mm, bv, sizeof (BtorBitVector));
+  btor_mem_free_tag (mm, BTOR_MEM_TAG_BV, bv, sizeof (BtorBitVector));
 #else
-  btor_mem_free (
-      mm, bv, sizeof (BtorBitVector) + sizeof (BTOR_BV_TYPE) * bv->len);
+  btor_mem_free_tag (mm,
+                     BTOR_MEM_TAG_BV,
+                     bv,
+                     sizeof (BtorBitVector) + sizeof (BTOR_BV_TYPE) * bv->len);
 #endif
 }
 
@@ -578,16 +690,21 @@ btor_bv_hash (const BtorBitVector *bv)
     res = ((x >> 16) ^ x);
   }
 #else
+  uint32_t k;
   for (i = 0, j = 0, n = bv->len; i < n; i++)
   {
-    p0 = hash_primes[j++];
-    if (j == NPRIMES) j = 0;
-    p1 = hash_primes[j++];
-    if (j == NPRIMES) j = 0;
-    x   = bv->bits[i] ^ res;
-    x   = ((x >> 16) ^ x) * p0;
-    x   = ((x >> 16) ^ x) * p1;
-    res = ((x >> 16) ^ x);
+    /* hash limbs in 32-bit chunks, most significant chunk first */
+    for (k = BTOR_BV_TYPE_BW / 32; k-- > 0;)
+    {
+      p0 = hash_primes[j++];
+      if (j == NPRIMES) j = 0;
+      p1 = hash_primes[j++];
+      if (j == NPRIMES) j = 0;
+      x   = (uint32_t) (bv->bits[i] >> (32 * k)) ^ res;
+      x   = ((x >> 16) ^ x) * p0;
+      x   = ((x >> 16) ^ x) * p1;
+      res = ((x >> 16) ^ x);
+    }
   }
 #endif
   return res;
@@ -898,11 +1015,11 @@ btor_bv_set_bit (BtorBitVector *bv, uint32_t pos, uint32_t bit)
 
   if (bit)
   {
-    bv->bits[bv->len - 1 - i] |= (1u << j);
+    bv->bits[bv->len - 1 - i] |= ((BTOR_BV_TYPE) 1 << j);
   }
   else
   {
-    bv->bits[bv->len - 1 - i] &= ~(1u << j);
+    bv->bits[bv->len - 1 - i] &= ~((BTOR_BV_TYPE) 1 << j);
   }
 #endif
 }
@@ -983,12 +1100,12 @@ btor_bv_is_ones (const BtorBitVector *bv)
 #else
   for (i = bv->len - 1; i >= 1; i--)
   {
-    if (bv->bits[i] != UINT32_MAX) return false;
+    if (bv->bits[i] != ~(BTOR_BV_TYPE) 0) return false;
   }
   n = BTOR_BV_TYPE_BW - bv->width % BTOR_BV_TYPE_BW;
   assert (n > 0);
-  if (n == BTOR_BV_TYPE_BW) return bv->bits[0] == UINT32_MAX;
-  return bv->bits[0] == (UINT32_MAX >> n);
+  if (n == BTOR_BV_TYPE_BW) return bv->bits[0] == ~(BTOR_BV_TYPE) 0;
+  return bv->bits[0] == (~(BTOR_BV_TYPE) 0 >> n);
 #endif
 }
 
@@ -1017,7 +1134,8 @@ btor_bv_is_min_signed (const BtorBitVector *bv)
   if (get_first_one_bit_idx (bv) != bv->width - 1) return false;
 #else
   uint32_t i;
-  if (bv->bits[0] != (1u << ((bv->width % BTOR_BV_TYPE_BW) - 1))) return false;
+  if (bv->bits[0] != ((BTOR_BV_TYPE) 1 << ((bv->width - 1) % BTOR_BV_TYPE_BW)))
+    return false;
   for (i = 1; i < bv->len; i++)
     if (bv->bits[i] != 0) return false;
 #endif
@@ -1039,12 +1157,12 @@ btor_bv_is_max_signed (const BtorBitVector *bv)
   {
     if (bv->bits[0] != 0) return false;
   }
-  else if (bv->bits[0] != (~0u >> msc))
+  else if (bv->bits[0] != (~(BTOR_BV_TYPE) 0 >> msc))
   {
     return false;
   }
   for (i = 1; i < bv->len; i++)
-    if (bv->bits[i] != ~0u) return false;
+    if (bv->bits[i] != ~(BTOR_BV_TYPE) 0) return false;
 #endif
   return true;
 }
@@ -1106,7 +1224,7 @@ btor_bv_small_positive_int (const BtorBitVector *bv)
 #else
   for (i = 0, n = bv->len - 1; i < n; i++)
     if (bv->bits[i] != 0) return -1;
-  if (((int32_t) bv->bits[bv->len - 1]) < 0) return -1;
+  if (bv->bits[bv->len - 1] > INT32_MAX) return -1;
   res = bv->bits[bv->len - 1];
 #endif
   return res;
@@ -1315,6 +1433,44 @@ btor_bv_get_num_leading_ones (const BtorBitVector *bv)
 
 /*------------------------------------------------------------------------*/
 
+void
+btor_bv_zero_into (BtorBitVector *res)
+{
+  assert (res);
+#ifdef BTOR_USE_GMP
+  mpz_set_ui (res->val, 0);
+#else
+  memset (res->bits, 0, sizeof (*(res->bits)) * res->len);
+#endif
+}
+
+void
+btor_bv_one_into (BtorBitVector *res)
+{
+  assert (res);
+#ifdef BTOR_USE_GMP
+  mpz_set_ui (res->val, 1);
+#else
+  memset (res->bits, 0, sizeof (*(res->bits)) * res->len);
+  res->bits[res->len - 1] = 1;
+#endif
+}
+
+void
+btor_bv_ones_into (BtorBitVector *res)
+{
+  assert (res);
+#ifdef BTOR_USE_GMP
+  mpz_set_ui (res->val, 1);
+  mpz_mul_2exp (res->val, res->val, res->width);
+  mpz_sub_ui (res->val, res->val, 1);
+#else
+  memset (res->bits, 0xff, sizeof (*(res->bits)) * res->len);
+  set_rem_bits_to_zero (res);
+  assert (rem_bits_zero_dbg (res));
+#endif
+}
+
 BtorBitVector *
 btor_bv_one (BtorMemMgr *mm, uint32_t bw)
 {
@@ -1323,7 +1479,7 @@ btor_bv_one (BtorMemMgr *mm, uint32_t bw)
 
   BtorBitVector *res;
 #ifdef BTOR_USE_GMP
-  BTOR_NEW (mm, res);
+  BTOR_NEW_TAG (mm, BTOR_MEM_TAG_BV, res);
   res->width = bw;
   mpz_init_set_ui (res->val, 1);
 #else
@@ -1388,20 +1544,47 @@ btor_bv_neg (BtorMemMgr *mm, const BtorBitVector *bv)
   assert (bv);
 
   BtorBitVector *res;
+
+  res = btor_bv_new (mm, bv->width);
+  btor_bv_neg_into (res, bv);
+  return res;
+}
+
+void
+btor_bv_neg_into (BtorBitVector *res, const BtorBitVector *bv)
+{
+  assert (res);
+  assert (bv);
+  assert (res->width == bv->width);
+
   uint32_t bw = bv->width;
 #ifdef BTOR_USE_GMP
-  res = btor_bv_not (mm, bv);
+  mpz_com (res->val, bv->val);
   mpz_add_ui (res->val, res->val, 1);
   mpz_fdiv_r_2exp (res->val, res->val, bw);
 #else
-  BtorBitVector *not_bv, *one;
-  not_bv = btor_bv_not (mm, bv);
-  one    = btor_bv_uint64_to_bv (mm, 1, bw);
-  res    = btor_bv_add (mm, not_bv, one);
-  btor_bv_free (mm, not_bv);
-  btor_bv_free (mm, one);
+  int64_t i;
+  BtorBvDLimb sum;
+  BTOR_BV_TYPE carry;
+
+  if (bw <= 64)
+  {
+    bv_set_uint64 (res, -bv_get_uint64 (bv));
+  }
+  else
+  {
+    /* ~bv + 1 */
+    carry = 1;
+    for (i = bv->len - 1; i >= 0; i--)
+    {
+      sum          = (BtorBvDLimb) (BTOR_BV_TYPE) ~bv->bits[i] + carry;
+      res->bits[i] = (BTOR_BV_TYPE) sum;
+      carry        = (BTOR_BV_TYPE) (sum >> BTOR_BV_TYPE_BW);
+    }
+    set_rem_bits_to_zero (res);
+  }
+  assert (rem_bits_zero_dbg (res));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -1411,19 +1594,28 @@ btor_bv_not (BtorMemMgr *mm, const BtorBitVector *bv)
   assert (bv);
 
   BtorBitVector *res;
-  uint32_t bw = bv->width;
+
+  res = btor_bv_new (mm, bv->width);
+  btor_bv_not_into (res, bv);
+  return res;
+}
+
+void
+btor_bv_not_into (BtorBitVector *res, const BtorBitVector *bv)
+{
+  assert (res);
+  assert (bv);
+  assert (res->width == bv->width);
+
 #ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
   mpz_com (res->val, bv->val);
-  mpz_fdiv_r_2exp (res->val, res->val, bw);
+  mpz_fdiv_r_2exp (res->val, res->val, bv->width);
 #else
   uint32_t i;
-  res = btor_bv_new (mm, bw);
   for (i = 0; i < bv->len; i++) res->bits[i] = ~bv->bits[i];
   set_rem_bits_to_zero (res);
   assert (rem_bits_zero_dbg (res));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -1433,18 +1625,39 @@ btor_bv_inc (BtorMemMgr *mm, const BtorBitVector *bv)
   assert (bv);
 
   BtorBitVector *res;
+
+  res = btor_bv_new (mm, bv->width);
+  btor_bv_inc_into (res, bv);
+  return res;
+}
+
+void
+btor_bv_inc_into (BtorBitVector *res, const BtorBitVector *bv)
+{
+  assert (res);
+  assert (bv);
+  assert (res->width == bv->width);
+
   uint32_t bw = bv->width;
 #ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
   mpz_add_ui (res->val, bv->val, 1);
   mpz_fdiv_r_2exp (res->val, res->val, bw);
 #else
-  BtorBitVector *one;
-  one = btor_bv_uint64_to_bv (mm, 1, bw);
-  res = btor_bv_add (mm, bv, one);
-  btor_bv_free (mm, one);
+  int64_t i;
+
+  if (bw <= 64)
+  {
+    bv_set_uint64 (res, bv_get_uint64 (bv) + 1);
+  }
+  else
+  {
+    btor_bv_copy_into (res, bv);
+    for (i = res->len - 1; i >= 0 && ++res->bits[i] == 0; i--)
+      ;
+    set_rem_bits_to_zero (res);
+  }
+  assert (rem_bits_zero_dbg (res));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -1454,20 +1667,39 @@ btor_bv_dec (BtorMemMgr *mm, const BtorBitVector *bv)
   assert (bv);
 
   BtorBitVector *res;
+
+  res = btor_bv_new (mm, bv->width);
+  btor_bv_dec_into (res, bv);
+  return res;
+}
+
+void
+btor_bv_dec_into (BtorBitVector *res, const BtorBitVector *bv)
+{
+  assert (res);
+  assert (bv);
+  assert (res->width == bv->width);
+
   uint32_t bw = bv->width;
 #ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
   mpz_sub_ui (res->val, bv->val, 1);
   mpz_fdiv_r_2exp (res->val, res->val, bw);
 #else
-  BtorBitVector *one, *negone;
-  one    = btor_bv_uint64_to_bv (mm, 1, bw);
-  negone = btor_bv_neg (mm, one);
-  res    = btor_bv_add (mm, bv, negone);
-  btor_bv_free (mm, one);
-  btor_bv_free (mm, negone);
+  int64_t i;
+
+  if (bw <= 64)
+  {
+    bv_set_uint64 (res, bv_get_uint64 (bv) - 1);
+  }
+  else
+  {
+    btor_bv_copy_into (res, bv);
+    for (i = res->len - 1; i >= 0 && res->bits[i]-- == 0; i--)
+      ;
+    set_rem_bits_to_zero (res);
+  }
+  assert (rem_bits_zero_dbg (res));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -1482,7 +1714,7 @@ btor_bv_redand (BtorMemMgr *mm, const BtorBitVector *bv)
 #else
   uint32_t i;
   uint32_t bit;
-  uint32_t mask0;
+  BTOR_BV_TYPE mask0;
 
   res = btor_bv_new (mm, 1);
   assert (rem_bits_zero_dbg (res));
@@ -1548,39 +1780,50 @@ btor_bv_add (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->width == b->width);
 
   BtorBitVector *res;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_add_into (res, a, b);
+  return res;
+}
+
+void
+btor_bv_add_into (BtorBitVector *res,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (res);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (res->width == a->width);
+
   uint32_t bw = a->width;
 #ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
   mpz_add (res->val, a->val, b->val);
   mpz_fdiv_r_2exp (res->val, res->val, bw);
 #else
   assert (a->len == b->len);
   int64_t i;
-  uint64_t x, y, sum;
+  BtorBvDLimb sum;
   BTOR_BV_TYPE carry;
 
   if (bw <= 64)
   {
-    x   = btor_bv_to_uint64 (a);
-    y   = btor_bv_to_uint64 (b);
-    res = btor_bv_uint64_to_bv (mm, x + y, bw);
+    bv_set_uint64 (res, bv_get_uint64 (a) + bv_get_uint64 (b));
   }
   else
   {
-    res   = btor_bv_new (mm, bw);
     carry = 0;
     for (i = a->len - 1; i >= 0; i--)
     {
-      sum          = (uint64_t) a->bits[i] + b->bits[i] + carry;
+      sum          = (BtorBvDLimb) a->bits[i] + b->bits[i] + carry;
       res->bits[i] = (BTOR_BV_TYPE) sum;
-      carry        = (BTOR_BV_TYPE) (sum >> 32);
+      carry        = (BTOR_BV_TYPE) (sum >> BTOR_BV_TYPE_BW);
     }
+    set_rem_bits_to_zero (res);
   }
-
-  set_rem_bits_to_zero (res);
   assert (rem_bits_zero_dbg (res));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -1592,20 +1835,50 @@ btor_bv_sub (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->width == b->width);
 
   BtorBitVector *res;
-#ifdef BTOR_USE_GMP
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_sub_into (res, a, b);
+  return res;
+}
+
+void
+btor_bv_sub_into (BtorBitVector *res,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (res);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (res->width == a->width);
+
   uint32_t bw = a->width;
-  res         = btor_bv_new (mm, bw);
+#ifdef BTOR_USE_GMP
   mpz_sub (res->val, a->val, b->val);
   mpz_fdiv_r_2exp (res->val, res->val, bw);
 #else
   assert (a->len == b->len);
-  BtorBitVector *negb;
+  int64_t i;
+  BtorBvDLimb diff;
+  BTOR_BV_TYPE borrow;
 
-  negb = btor_bv_neg (mm, b);
-  res  = btor_bv_add (mm, a, negb);
-  btor_bv_free (mm, negb);
+  if (bw <= 64)
+  {
+    bv_set_uint64 (res, bv_get_uint64 (a) - bv_get_uint64 (b));
+  }
+  else
+  {
+    borrow = 0;
+    for (i = a->len - 1; i >= 0; i--)
+    {
+      diff         = (BtorBvDLimb) a->bits[i] - b->bits[i] - borrow;
+      res->bits[i] = (BTOR_BV_TYPE) diff;
+      borrow       = (BTOR_BV_TYPE) ((diff >> BTOR_BV_TYPE_BW) & 1);
+    }
+    set_rem_bits_to_zero (res);
+  }
+  assert (rem_bits_zero_dbg (res));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -1617,21 +1890,34 @@ btor_bv_and (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->width == b->width);
 
   BtorBitVector *res;
-  uint32_t bw = a->width;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_and_into (res, a, b);
+  return res;
+}
+
+void
+btor_bv_and_into (BtorBitVector *res,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (res);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (res->width == a->width);
+
 #ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
   mpz_and (res->val, a->val, b->val);
-  mpz_fdiv_r_2exp (res->val, res->val, bw);
+  mpz_fdiv_r_2exp (res->val, res->val, a->width);
 #else
   assert (a->len == b->len);
   uint32_t i;
 
-  res = btor_bv_new (mm, bw);
   for (i = 0; i < a->len; i++) res->bits[i] = a->bits[i] & b->bits[i];
 
   assert (rem_bits_zero_dbg (res));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -1669,21 +1955,34 @@ btor_bv_or (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->width == b->width);
 
   BtorBitVector *res;
-  uint32_t bw = a->width;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_or_into (res, a, b);
+  return res;
+}
+
+void
+btor_bv_or_into (BtorBitVector *res,
+                 const BtorBitVector *a,
+                 const BtorBitVector *b)
+{
+  assert (res);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (res->width == a->width);
+
 #ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
   mpz_ior (res->val, a->val, b->val);
-  mpz_fdiv_r_2exp (res->val, res->val, bw);
+  mpz_fdiv_r_2exp (res->val, res->val, a->width);
 #else
   assert (a->len == b->len);
   uint32_t i;
 
-  res = btor_bv_new (mm, bw);
   for (i = 0; i < a->len; i++) res->bits[i] = a->bits[i] | b->bits[i];
 
   assert (rem_bits_zero_dbg (res));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -1779,21 +2078,34 @@ btor_bv_xor (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->width == b->width);
 
   BtorBitVector *res;
-  uint32_t bw = a->width;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_xor_into (res, a, b);
+  return res;
+}
+
+void
+btor_bv_xor_into (BtorBitVector *res,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (res);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (res->width == a->width);
+
 #ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
   mpz_xor (res->val, a->val, b->val);
-  mpz_fdiv_r_2exp (res->val, res->val, bw);
+  mpz_fdiv_r_2exp (res->val, res->val, a->width);
 #else
   assert (a->len == b->len);
   uint32_t i;
 
-  res = btor_bv_new (mm, bw);
   for (i = 0; i < a->len; i++) res->bits[i] = a->bits[i] ^ b->bits[i];
 
   assert (rem_bits_zero_dbg (res));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -2117,10 +2429,29 @@ btor_bv_sll_uint64 (BtorMemMgr *mm, const BtorBitVector *a, uint64_t shift)
   assert (a);
 
   BtorBitVector *res;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_sll_uint64_into (res, a, shift);
+  assert (check_bits_sll_dbg (a, res, shift));
+  return res;
+}
+
+void
+btor_bv_sll_uint64_into (BtorBitVector *res,
+                         const BtorBitVector *a,
+                         uint64_t shift)
+{
+  assert (res);
+  assert (a);
+  assert (res->width == a->width);
+
   uint32_t bw = a->width;
 
-  res = btor_bv_new (mm, bw);
-  if (shift >= bw) return res;
+  if (shift >= bw)
+  {
+    btor_bv_zero_into (res);
+    return;
+  }
 
 #ifdef BTOR_USE_GMP
   mpz_mul_2exp (res->val, a->val, shift);
@@ -2129,22 +2460,28 @@ btor_bv_sll_uint64 (BtorMemMgr *mm, const BtorBitVector *a, uint64_t shift)
   uint32_t skip, i, j, k;
   BTOR_BV_TYPE v;
 
+  if (bw <= 64)
+  {
+    bv_set_uint64 (res, bv_get_uint64 (a) << shift);
+    return;
+  }
+
   k    = shift % BTOR_BV_TYPE_BW;
   skip = shift / BTOR_BV_TYPE_BW;
 
-  v = 0;
-  for (i = a->len - 1, j = res->len - 1 - skip;; i--, j--)
+  /* limb j of the result only depends on limbs j + skip and j + skip + 1 of
+   * 'a', iterating from the MSB allows 'res' to alias 'a' */
+  for (j = 0; j < res->len; j++)
   {
-    v            = (k == 0) ? a->bits[i] : v | (a->bits[i] << k);
+    i = j + skip;
+    v = 0;
+    if (i < a->len) v = a->bits[i] << k;
+    if (k && i + 1 < a->len) v |= a->bits[i + 1] >> (BTOR_BV_TYPE_BW - k);
     res->bits[j] = v;
-    v            = (k == 0) ? a->bits[i] : a->bits[i] >> (BTOR_BV_TYPE_BW - k);
-    if (i == 0 || j == 0) break;
   }
   set_rem_bits_to_zero (res);
   assert (rem_bits_zero_dbg (res));
 #endif
-  assert (check_bits_sll_dbg (a, res, shift));
-  return res;
 }
 
 static bool
@@ -2202,6 +2539,22 @@ btor_bv_sra (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->width == b->width);
 
   BtorBitVector *res;
+#ifndef BTOR_USE_GMP
+  if (a->width <= 64)
+  {
+    uint64_t x, shift, mask;
+    x     = bv_get_uint64 (a);
+    shift = bv_get_uint64 (b);
+    mask  = a->width == 64 ? UINT64_MAX : ((uint64_t) 1 << a->width) - 1;
+    res   = btor_bv_new (mm, a->width);
+    if (shift >= a->width) shift = a->width - 1;
+    if (x >> (a->width - 1))
+      bv_set_uint64 (res, ~((~x & mask) >> shift));
+    else
+      bv_set_uint64 (res, x >> shift);
+    return res;
+  }
+#endif
   if (btor_bv_get_bit (a, a->width - 1))
   {
     BtorBitVector *not_a       = btor_bv_not (mm, a);
@@ -2229,24 +2582,55 @@ btor_bv_srl_uint64 (BtorMemMgr *mm, const BtorBitVector *a, uint64_t shift)
   BtorBitVector *res;
 
   res = btor_bv_new (mm, a->width);
-  if (shift >= a->width) return res;
+  btor_bv_srl_uint64_into (res, a, shift);
+  return res;
+}
+
+void
+btor_bv_srl_uint64_into (BtorBitVector *res,
+                         const BtorBitVector *a,
+                         uint64_t shift)
+{
+  assert (res);
+  assert (a);
+  assert (res->width == a->width);
+
+  if (shift >= a->width)
+  {
+    btor_bv_zero_into (res);
+    return;
+  }
 #ifdef BTOR_USE_GMP
   mpz_fdiv_q_2exp (res->val, a->val, shift);
 #else
   uint32_t skip, i, j, k;
   BTOR_BV_TYPE v;
-  k = shift % BTOR_BV_TYPE_BW;
+
+  if (a->width <= 64)
+  {
+    bv_set_uint64 (res, bv_get_uint64 (a) >> shift);
+    return;
+  }
+
+  k    = shift % BTOR_BV_TYPE_BW;
   skip = shift / BTOR_BV_TYPE_BW;
-  v = 0;
-  for (i = 0, j = skip; i < a->len && j < a->len; i++, j++)
+
+  /* limb j of the result only depends on limbs j - skip and j - skip - 1 of
+   * 'a', iterating from the LSB allows 'res' to alias 'a' */
+  for (j = res->len; j-- > 0;)
   {
-    v = (k == 0) ? a->bits[i] : v | (a->bits[i] >> k);
+    if (j < skip)
+    {
+      res->bits[j] = 0;
+      continue;
+    }
+    i = j - skip;
+    v = a->bits[i] >> k;
+    if (k && i > 0) v |= a->bits[i - 1] << (BTOR_BV_TYPE_BW - k);
     res->bits[j] = v;
-    v = (k == 0) ? a->bits[i] : a->bits[i] << (BTOR_BV_TYPE_BW - k);
   }
   assert (rem_bits_zero_dbg (res));
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -2275,45 +2659,209 @@ btor_bv_mul (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
   assert (a->width == b->width);
 
   BtorBitVector *res;
+
+  res = btor_bv_new (mm, a->width);
+  btor_bv_mul_into (res, a, b);
+  return res;
+}
+
+void
+btor_bv_mul_into (BtorBitVector *res,
+                  const BtorBitVector *a,
+                  const BtorBitVector *b)
+{
+  assert (res);
+  assert (a);
+  assert (b);
+  assert (a->width == b->width);
+  assert (res->width == a->width);
+
   uint32_t bw = a->width;
 #ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
   mpz_mul (res->val, a->val, b->val);
   mpz_fdiv_r_2exp (res->val, res->val, bw);
 #else
   assert (a->len == b->len);
-  uint32_t i;
-  uint64_t x, y;
-  BtorBitVector *and, *shift, *add;
+  int64_t i, j, k, len;
+  BtorBvDLimb x, prod;
+  BTOR_BV_TYPE carry;
 
+  len = res->len;
   if (bw <= 64)
   {
-    x   = btor_bv_to_uint64 (a);
-    y   = btor_bv_to_uint64 (b);
-    res = btor_bv_uint64_to_bv (mm, x * y, bw);
+    bv_set_uint64 (res, bv_get_uint64 (a) * bv_get_uint64 (b));
+  }
+#ifdef BTOR_BV_HAVE_UINT128
+  else if (bw <= 128)
+  {
+    bv_set_uint128 (res, bv_get_uint128 (a) * bv_get_uint128 (b));
   }
+#endif
   else
   {
-    res = btor_bv_new (mm, bw);
-    for (i = 0; i < bw; i++)
+    /* schoolbook multiplication, truncated to 'len' limbs, limbs are
+     * indexed from the LSB via [len - 1 - i] */
+    assert (res != a);
+    assert (res != b);
+    memset (res->bits, 0, sizeof (*(res->bits)) * len);
+    for (i = 0; i < len; i++)
     {
-      if (btor_bv_get_bit (b, i))
-        and = btor_bv_copy (mm, a);
-      else
-        and = btor_bv_new (mm, bw);
-      shift = btor_bv_sll_uint64 (mm, and, i);
-      add   = btor_bv_add (mm, res, shift);
-      btor_bv_free (mm, and);
-      btor_bv_free (mm, shift);
-      btor_bv_free (mm, res);
-      res = add;
+      x = a->bits[len - 1 - i];
+      if (!x) continue;
+      carry = 0;
+      for (j = 0; i + j < len; j++)
+      {
+        k            = len - 1 - (i + j);
+        prod         = x * b->bits[len - 1 - j] + res->bits[k] + carry;
+        res->bits[k] = (BTOR_BV_TYPE) prod;
+        carry        = (BTOR_BV_TYPE) (prod >> BTOR_BV_TYPE_BW);
+      }
     }
+    set_rem_bits_to_zero (res);
   }
+  assert (rem_bits_zero_dbg (res));
 #endif
-  return res;
 }
 
 #ifndef BTOR_USE_GMP
+/* Count the number of leading zero bits of the given (non-zero) limb. */
+static inline uint32_t
+clz_bv_limb (BTOR_BV_TYPE limb)
+{
+  assert (limb);
+  uint32_t res;
+  for (res = 0; !(limb >> (BTOR_BV_TYPE_BW - 1)); res++) limb <<= 1;
+  return res;
+}
+
+/**
+ * Unsigned long division of 'a' by 'b' (b != 0) on limbs, see Knuth, TAOCP
+ * Vol. 2, 4.3.1, Algorithm D.  Each quotient limb is estimated from the two
+ * most significant limbs of the (normalized) remainder via a division of
+ * double limbs.  'q' and 'r' must be zero-initialized.
+ */
+static void
+udiv_urem_limbs (BtorMemMgr *mm,
+                 const BtorBitVector *a,
+                 const BtorBitVector *b,
+                 BtorBitVector *q,
+                 BtorBitVector *r)
+{
+  assert (mm);
+  assert (a);
+  assert (b);
+  assert (!btor_bv_is_zero (b));
+  assert (q);
+  assert (r);
+  assert (a->len == b->len);
+  assert (q->len == a->len);
+  assert (r->len == a->len);
+
+  int64_t i, j;
+  uint32_t len, m, n, s;
+  BTOR_BV_TYPE *un, *vn, qhat_limb, borrow, carry;
+  BtorBvDLimb num, qhat, rhat, p, t;
+
+  /* limbs are indexed from the LSB via [len - 1 - i] */
+  len = a->len;
+#define BV_LIMB(bv, i) ((bv)->bits[len - 1 - (i)])
+
+  for (m = len; m > 0 && !BV_LIMB (a, m - 1); m--)
+    ;
+  for (n = len; !BV_LIMB (b, n - 1); n--)
+    ;
+  assert (n > 0);
+
+  if (m < n)
+  {
+    btor_bv_copy_into (r, a);
+    return;
+  }
+
+  if (n == 1)
+  {
+    /* short division by a single limb */
+    t = 0;
+    for (i = m - 1; i >= 0; i--)
+    {
+      num             = (t << BTOR_BV_TYPE_BW) | BV_LIMB (a, i);
+      BV_LIMB (q, i)  = (BTOR_BV_TYPE) (num / BV_LIMB (b, 0));
+      t               = num % BV_LIMB (b, 0);
+    }
+    BV_LIMB (r, 0) = (BTOR_BV_TYPE) t;
+    return;
+  }
+
+  /* normalize such that the most significant bit of the divisor is set */
+  s = clz_bv_limb (BV_LIMB (b, n - 1));
+  BTOR_NEWN (mm, un, m + 1);
+  BTOR_NEWN (mm, vn, n);
+  for (i = n - 1; i > 0; i--)
+    vn[i] = (BV_LIMB (b, i) << s)
+            | (s ? BV_LIMB (b, i - 1) >> (BTOR_BV_TYPE_BW - s) : 0);
+  vn[0] = BV_LIMB (b, 0) << s;
+  un[m] = s ? BV_LIMB (a, m - 1) >> (BTOR_BV_TYPE_BW - s) : 0;
+  for (i = m - 1; i > 0; i--)
+    un[i] = (BV_LIMB (a, i) << s)
+            | (s ? BV_LIMB (a, i - 1) >> (BTOR_BV_TYPE_BW - s) : 0);
+  un[0] = BV_LIMB (a, 0) << s;
+
+  for (j = m - n; j >= 0; j--)
+  {
+    /* estimate quotient limb, which is at most 2 too large */
+    num  = ((BtorBvDLimb) un[j + n] << BTOR_BV_TYPE_BW) | un[j + n - 1];
+    qhat = num / vn[n - 1];
+    rhat = num % vn[n - 1];
+    while (qhat >> BTOR_BV_TYPE_BW
+           || qhat * vn[n - 2]
+                  > ((rhat << BTOR_BV_TYPE_BW) | un[j + n - 2]))
+    {
+      qhat -= 1;
+      rhat += vn[n - 1];
+      if (rhat >> BTOR_BV_TYPE_BW) break;
+    }
+
+    /* multiply and subtract */
+    carry  = 0;
+    borrow = 0;
+    for (i = 0; i < n; i++)
+    {
+      p         = qhat * vn[i] + carry;
+      carry     = (BTOR_BV_TYPE) (p >> BTOR_BV_TYPE_BW);
+      t         = (BtorBvDLimb) un[i + j] - (BTOR_BV_TYPE) p - borrow;
+      un[i + j] = (BTOR_BV_TYPE) t;
+      borrow    = (t >> BTOR_BV_TYPE_BW) ? 1 : 0;
+    }
+    t         = (BtorBvDLimb) un[j + n] - carry - borrow;
+    un[j + n] = (BTOR_BV_TYPE) t;
+    qhat_limb = (BTOR_BV_TYPE) qhat;
+
+    /* estimate was one too large, add back */
+    if (t >> BTOR_BV_TYPE_BW)
+    {
+      qhat_limb -= 1;
+      carry = 0;
+      for (i = 0; i < n; i++)
+      {
+        t         = (BtorBvDLimb) un[i + j] + vn[i] + carry;
+        un[i + j] = (BTOR_BV_TYPE) t;
+        carry     = (BTOR_BV_TYPE) (t >> BTOR_BV_TYPE_BW);
+      }
+      un[j + n] += carry;
+    }
+    BV_LIMB (q, j) = qhat_limb;
+  }
+
+  /* denormalize remainder */
+  for (i = 0; i < n; i++)
+    BV_LIMB (r, i) =
+        (un[i] >> s) | (s ? un[i + 1] << (BTOR_BV_TYPE_BW - s) : 0);
+
+#undef BV_LIMB
+  BTOR_DELETEN (mm, un, m + 1);
+  BTOR_DELETEN (mm, vn, n);
+}
+
 static void
 udiv_urem_bv (BtorMemMgr *mm,
               const BtorBitVector *a,
@@ -2327,17 +2875,15 @@ udiv_urem_bv (BtorMemMgr *mm,
   assert (a->width == b->width);
 
   assert (a->len == b->len);
-  int64_t i;
-  bool is_true;
   uint64_t x, y, z;
   uint32_t bw = a->width;
 
-  BtorBitVector *neg_b, *quot, *rem, *ult, *eq, *tmp;
+  BtorBitVector *quot, *rem;
 
   if (bw <= 64)
   {
-    x = btor_bv_to_uint64 (a);
-    y = btor_bv_to_uint64 (b);
+    x = bv_get_uint64 (a);
+    y = bv_get_uint64 (b);
     if (y == 0)
     {
       y = x;
@@ -2349,42 +2895,47 @@ udiv_urem_bv (BtorMemMgr *mm,
       y = x % y;
       x = z;
     }
-    quot = btor_bv_uint64_to_bv (mm, x, bw);
-    rem  = btor_bv_uint64_to_bv (mm, y, bw);
+    quot = btor_bv_new (mm, bw);
+    rem  = btor_bv_new (mm, bw);
+    bv_set_uint64 (quot, x);
+    bv_set_uint64 (rem, y);
+  }
+#ifdef BTOR_BV_HAVE_UINT128
+  else if (bw <= 128)
+  {
+    BtorBvUInt128 x128, y128, z128;
+    x128 = bv_get_uint128 (a);
+    y128 = bv_get_uint128 (b);
+    if (y128 == 0)
+    {
+      y128 = x128;
+      x128 = ~(BtorBvUInt128) 0;
+    }
+    else
+    {
+      z128 = x128 / y128;
+      y128 = x128 % y128;
+      x128 = z128;
+    }
+    quot = btor_bv_new (mm, bw);
+    rem  = btor_bv_new (mm, bw);
+    bv_set_uint128 (quot, x128);
+    bv_set_uint128 (rem, y128);
   }
+#endif
   else
   {
-    neg_b = btor_bv_neg (mm, b);
-    quot  = btor_bv_new (mm, bw);
-    rem   = btor_bv_new (mm, bw);
-
-    for (i = bw - 1; i >= 0; i--)
+    quot = btor_bv_new (mm, bw);
+    rem  = btor_bv_new (mm, bw);
+    if (btor_bv_is_zero (b))
     {
-      tmp = btor_bv_sll_uint64 (mm, rem, 1);
-      btor_bv_free (mm, rem);
-      rem = tmp;
-      btor_bv_set_bit (rem, 0, btor_bv_get_bit (a, i));
-
-      ult     = btor_bv_ult (mm, b, rem);
-      is_true = btor_bv_is_true (ult);
-      btor_bv_free (mm, ult);
-
-      if (is_true) goto UDIV_UREM_SUBTRACT;
-
-      eq      = btor_bv_eq (mm, b, rem);
-      is_true = btor_bv_is_true (eq);
-      btor_bv_free (mm, eq);
-
-      if (is_true)
-      {
-      UDIV_UREM_SUBTRACT:
-        tmp = btor_bv_add (mm, rem, neg_b);
-        btor_bv_free (mm, rem);
-        rem = tmp;
-        btor_bv_set_bit (quot, i, 1);
-      }
+      btor_bv_ones_into (quot);
+      btor_bv_copy_into (rem, a);
+    }
+    else
+    {
+      udiv_urem_limbs (mm, a, b, quot, rem);
     }
-    btor_bv_free (mm, neg_b);
   }
 
   if (q)
@@ -2559,6 +3110,12 @@ btor_bv_concat (BtorMemMgr *mm, const BtorBitVector *a, const BtorBitVector *b)
 
   res = btor_bv_new (mm, bw);
 
+  if (bw <= 64)
+  {
+    bv_set_uint64 (res, (bv_get_uint64 (a) << b->width) | bv_get_uint64 (b));
+    return res;
+  }
+
   j = res->len - 1;
 
   /* copy bits from bit vector b */
@@ -2603,21 +3160,60 @@ btor_bv_slice (BtorMemMgr *mm,
   assert (bv);
 
   BtorBitVector *res;
-  uint32_t bw = upper - lower + 1;
+
+  res = btor_bv_new (mm, upper - lower + 1);
+  btor_bv_slice_into (res, bv, upper, lower);
+  return res;
+}
+
+void
+btor_bv_slice_into (BtorBitVector *res,
+                    const BtorBitVector *bv,
+                    uint32_t upper,
+                    uint32_t lower)
+{
+  assert (res);
+  assert (bv);
+  assert (res != bv);
+  assert (upper >= lower);
+  assert (upper < bv->width);
+  assert (res->width == upper - lower + 1);
+  (void) upper;
+
 #ifdef BTOR_USE_GMP
-  res = btor_bv_new (mm, bw);
   mpz_fdiv_r_2exp (res->val, bv->val, upper + 1);
   mpz_fdiv_q_2exp (res->val, res->val, lower);
 #else
-  uint32_t i, j;
-
-  res = btor_bv_new (mm, bw);
-  for (i = lower, j = 0; i <= upper; i++)
-    btor_bv_set_bit (res, j++, btor_bv_get_bit (bv, i));
+  uint32_t i, j, k, idx;
+  BTOR_BV_TYPE v;
 
+  if (bv->width <= 64)
+  {
+    bv_set_uint64 (res, bv_get_uint64 (bv) >> lower);
+  }
+  else
+  {
+    /* copy limb-wise, limbs are indexed from the LSB via [len - 1 - i] */
+    k = lower % BTOR_BV_TYPE_BW;
+    for (i = 0; i < res->len; i++)
+    {
+      idx = lower / BTOR_BV_TYPE_BW + i;
+      assert (idx < bv->len);
+      v = bv->bits[bv->len - 1 - idx] >> k;
+      if (k && idx + 1 < bv->len)
+        v |= bv->bits[bv->len - 2 - idx] << (BTOR_BV_TYPE_BW - k);
+      res->bits[res->len - 1 - i] = v;
+    }
+    set_rem_bits_to_zero (res);
+  }
   assert (rem_bits_zero_dbg (res));
+#ifndef NDEBUG
+  for (i = lower, j = 0; i <= upper; i++)
+    assert (btor_bv_get_bit (res, j++) == btor_bv_get_bit (bv, i));
+#else
+  (void) j;
+#endif
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -2649,6 +3245,14 @@ btor_bv_sext (BtorMemMgr *mm, const BtorBitVector *bv, uint32_t len)
   }
 #else
   BtorBitVector *tmp;
+  if (bw + len <= 64)
+  {
+    uint64_t x = bv_get_uint64 (bv);
+    res        = btor_bv_new (mm, bw + len);
+    if (x >> (bw - 1)) x |= UINT64_MAX << bw;
+    bv_set_uint64 (res, x);
+    return res;
+  }
   tmp = btor_bv_get_bit (bv, bw - 1) ? btor_bv_ones (mm, len)
                                      : btor_bv_zero (mm, len);
   res = btor_bv_concat (mm, tmp, bv);
@@ -2665,22 +3269,33 @@ btor_bv_uext (BtorMemMgr *mm, const BtorBitVector *bv, uint32_t len)
   assert (bv);
 
   BtorBitVector *res;
-  uint32_t bw;
 
   if (len == 0)
   {
     return btor_bv_copy (mm, bv);
   }
 
-  bw  = bv->width + len;
-  res = btor_bv_new (mm, bw);
+  res = btor_bv_new (mm, bv->width + len);
+  btor_bv_uext_into (res, bv);
+  return res;
+}
+
+void
+btor_bv_uext_into (BtorBitVector *res, const BtorBitVector *bv)
+{
+  assert (res);
+  assert (bv);
+  assert (res->width >= bv->width);
+
+  if (res == bv) return;
 #ifdef BTOR_USE_GMP
   mpz_set (res->val, bv->val);
 #else
+  assert (res->len >= bv->len);
+  memset (res->bits, 0, sizeof (*(res->bits)) * (res->len - bv->len));
   memcpy (
       res->bits + res->len - bv->len, bv->bits, sizeof (*(bv->bits)) * bv->len);
 #endif
-  return res;
 }
 
 BtorBitVector *
@@ -2776,6 +3391,13 @@ btor_bv_is_umulo (BtorMemMgr *mm,
     res = mpz_cmp_ui (mul, 0) != 0;
     mpz_clear (mul);
 #else
+    if (bw <= 32)
+      return (bv_get_uint64 (a) * bv_get_uint64 (b)) >> bw != 0;
+#ifdef BTOR_BV_HAVE_UINT128
+    if (bw <= 64)
+      return ((BtorBvUInt128) bv_get_uint64 (a) * bv_get_uint64 (b)) >> bw
+             != 0;
+#endif
     BtorBitVector *aext, *bext, *mul, *o;
     aext = btor_bv_uext (mm, a, bw);
     bext = btor_bv_uext (mm, b, bw);
@@ -2897,7 +3519,7 @@ btor_bv_mod_inverse (BtorMemMgr *mm, const BtorBitVector *bv)
   bw = bv->width;
 
 #ifdef BTOR_USE_GMP
-  BTOR_NEW (mm, res);
+  BTOR_NEW_TAG (mm, BTOR_MEM_TAG_BV, res);
   res->width = bw;
 #if 1
   if (bw == 1)
@@ -2918,7 +3540,7 @@ btor_bv_mod_inverse (BtorMemMgr *mm, const BtorBitVector *bv)
   uint32_t ebw = bw + 1;
   mpz_t a, b, y, ty, q, yq, r;
 
-  BTOR_NEW (mm, res);
+  BTOR_NEW_TAG (mm, BTOR_MEM_TAG_BV, res);
   res->width = bw;
   mpz_init (res->val);
 
@@ -3040,6 +3662,83 @@ btor_bv_is_special_const (const BtorBitVector *bv)
 
 /*------------------------------------------------------------------------*/
 
+void
+btor_bv_pool_init (BtorMemMgr *mm, BtorBitVectorPool *pool)
+{
+  assert (mm);
+  assert (pool);
+
+  uint32_t i;
+
+  pool->mm = mm;
+  for (i = 0; i <= BTOR_BV_POOL_MAX_LEN; i++) BTOR_INIT_STACK (mm, pool->free[i]);
+}
+
+void
+btor_bv_pool_release (BtorBitVectorPool *pool)
+{
+  assert (pool);
+
+  uint32_t i;
+
+  for (i = 0; i <= BTOR_BV_POOL_MAX_LEN; i++)
+  {
+    while (!BTOR_EMPTY_STACK (pool->free[i]))
+      btor_bv_free (pool->mm, BTOR_POP_STACK (pool->free[i]));
+    BTOR_RELEASE_STACK (pool->free[i]);
+  }
+}
+
+static inline uint32_t
+bv_pool_idx (uint32_t bw)
+{
+#ifdef BTOR_USE_GMP
+  (void) bw;
+  return 0;
+#else
+  return bw / BTOR_BV_TYPE_BW + (bw % BTOR_BV_TYPE_BW > 0);
+#endif
+}
+
+BtorBitVector *
+btor_bv_pool_get (BtorBitVectorPool *pool, uint32_t bw)
+{
+  assert (pool);
+  assert (bw > 0);
+
+  uint32_t idx;
+  BtorBitVector *res;
+
+  idx = bv_pool_idx (bw);
+  if (idx > BTOR_BV_POOL_MAX_LEN || BTOR_EMPTY_STACK (pool->free[idx]))
+    return btor_bv_new (pool->mm, bw);
+
+  res        = BTOR_POP_STACK (pool->free[idx]);
+  res->width = bw;
+  btor_bv_zero_into (res);
+#ifndef BTOR_USE_GMP
+  assert (res->len == idx);
+#endif
+  return res;
+}
+
+void
+btor_bv_pool_put (BtorBitVectorPool *pool, BtorBitVector *bv)
+{
+  assert (pool);
+  assert (bv);
+
+  uint32_t idx;
+
+  idx = bv_pool_idx (bv->width);
+  if (idx > BTOR_BV_POOL_MAX_LEN)
+    btor_bv_free (pool->mm, bv);
+  else
+    BTOR_PUSH_STACK (pool->free[idx], bv);
+}
+
+/*------------------------------------------------------------------------*/
+
 BtorBitVectorTuple *
 btor_bv_new_tuple (BtorMemMgr *mm, uint32_t arity)
 {
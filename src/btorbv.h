@@ -16,7 +16,12 @@
 #include "utils/btorrng.h"
 #include "utils/btorstack.h"
 
+/* Limb type of the non-GMP implementation, 64-bit limbs require __int128. */
+#ifdef BTOR_BV_LIMB64
+#define BTOR_BV_TYPE uint64_t
+#else
 #define BTOR_BV_TYPE uint32_t
+#endif
 #define BTOR_BV_TYPE_BW (sizeof (BTOR_BV_TYPE) * 8)
 
 typedef struct BtorBitVector BtorBitVector;
@@ -388,6 +393,89 @@ BtorBitVector *btor_bv_flipped_bit_range (BtorMemMgr *mm,
 
 /*------------------------------------------------------------------------*/
 
+/**
+ * Destination-passing variants of the operations above.
+ *
+ * The result is written to the given bit-vector 'res', which must have the
+ * bit-width of the result.  Unless noted otherwise, 'res' may be one of the
+ * operands.  No memory is allocated.
+ */
+
+void btor_bv_copy_into (BtorBitVector *res, const BtorBitVector *bv);
+
+void btor_bv_zero_into (BtorBitVector *res);
+void btor_bv_one_into (BtorBitVector *res);
+void btor_bv_ones_into (BtorBitVector *res);
+
+void btor_bv_neg_into (BtorBitVector *res, const BtorBitVector *bv);
+void btor_bv_not_into (BtorBitVector *res, const BtorBitVector *bv);
+void btor_bv_inc_into (BtorBitVector *res, const BtorBitVector *bv);
+void btor_bv_dec_into (BtorBitVector *res, const BtorBitVector *bv);
+
+void btor_bv_add_into (BtorBitVector *res,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+void btor_bv_sub_into (BtorBitVector *res,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+void btor_bv_and_into (BtorBitVector *res,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+void btor_bv_or_into (BtorBitVector *res,
+                      const BtorBitVector *a,
+                      const BtorBitVector *b);
+void btor_bv_xor_into (BtorBitVector *res,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+/* 'res' must not alias 'a' or 'b'. */
+void btor_bv_mul_into (BtorBitVector *res,
+                       const BtorBitVector *a,
+                       const BtorBitVector *b);
+
+void btor_bv_sll_uint64_into (BtorBitVector *res,
+                              const BtorBitVector *a,
+                              uint64_t shift);
+void btor_bv_srl_uint64_into (BtorBitVector *res,
+                              const BtorBitVector *a,
+                              uint64_t shift);
+
+/* 'res' must not alias 'bv'. */
+void btor_bv_slice_into (BtorBitVector *res,
+                         const BtorBitVector *bv,
+                         uint32_t upper,
+                         uint32_t lower);
+/* Zero-extend 'bv' to the bit-width of 'res'. */
+void btor_bv_uext_into (BtorBitVector *res, const BtorBitVector *bv);
+
+/*------------------------------------------------------------------------*/
+
+#define BTOR_BV_POOL_MAX_LEN 8
+
+/**
+ * A pool of scratch bit-vectors for temporary results.
+ *
+ * Bit-vectors returned to the pool are kept on a free list per number of
+ * limbs and handed out again by subsequent requests of a similar bit-width.
+ * Bit-vectors with more than BTOR_BV_POOL_MAX_LEN limbs are not cached.
+ */
+struct BtorBitVectorPool
+{
+  BtorMemMgr *mm;
+  BtorBitVectorPtrStack free[BTOR_BV_POOL_MAX_LEN + 1];
+};
+
+typedef struct BtorBitVectorPool BtorBitVectorPool;
+
+void btor_bv_pool_init (BtorMemMgr *mm, BtorBitVectorPool *pool);
+void btor_bv_pool_release (BtorBitVectorPool *pool);
+
+/* Get a bit-vector of given bit-width, initialized to zero. */
+BtorBitVector *btor_bv_pool_get (BtorBitVectorPool *pool, uint32_t bw);
+/* Return given bit-vector to the pool. */
+void btor_bv_pool_put (BtorBitVectorPool *pool, BtorBitVector *bv);
+
+/*------------------------------------------------------------------------*/
+
 /* Return true if 'bv0' * 'bv1' produces an overflow. */
 bool btor_bv_is_umulo (BtorMemMgr *mm,
                        const BtorBitVector *bv0,
@@ -14,6 +14,7 @@
 #include "btorcore.h"
 #include "btoropt.h"
 #include "btorslv.h"
+#include "btorslvabs.h"
 #include "btorslvaigprop.h"
 #include "btorslvfun.h"
 #include "btorslvprop.h"
@@ -246,6 +247,7 @@ chkclone_stats (Btor *btor, Btor *clone)
   BTOR_CHKCLONE_STATS (muls_normalized);
   BTOR_CHKCLONE_STATS (muls_normalized);
   BTOR_CHKCLONE_STATS (ackermann_constraints);
+  BTOR_CHKCLONE_STATS (ackermann_pruned);
   BTOR_CHKCLONE_STATS (bv_uc_props);
   BTOR_CHKCLONE_STATS (fun_uc_props);
   BTOR_CHKCLONE_STATS (lambdas_merged);
@@ -403,20 +405,28 @@ chkclone_aig_unique_table (Btor *btor, Btor *clone)
 
   for (i = 0; i < btable->size; i++)
     assert (btable->chains[i] == ctable->chains[i]);
+
+  assert (btable->old_size == ctable->old_size);
+  assert (btable->migrated == ctable->migrated);
+  for (i = 0; i < btable->old_size; i++)
+    assert (btable->old_chains[i] == ctable->old_chains[i]);
 }
 
 static inline void
 chkclone_aig_id_table (Btor *btor, Btor *clone)
 {
-  uint32_t i;
-  BtorAIGPtrStack *btable, *ctable;
+  int32_t i;
+  BtorAIGMgr *bamgr, *camgr;
 
-  btable = &btor_get_aig_mgr (btor)->id2aig;
-  ctable = &btor_get_aig_mgr (clone)->id2aig;
-  assert (btable != ctable);
+  bamgr = btor_get_aig_mgr (btor);
+  camgr = btor_get_aig_mgr (clone);
+  assert (bamgr != camgr);
+  assert (bamgr->num_ids == camgr->num_ids);
+  assert (bamgr->num_pages == camgr->num_pages);
 
-  for (i = 0; i < BTOR_COUNT_STACK (*btable); i++)
-    chkclone_aig (btable->start[i], ctable->start[i]);
+  for (i = 0; i < bamgr->num_ids; i++)
+    chkclone_aig (btor_aig_get_by_id (bamgr, i),
+                  btor_aig_get_by_id (camgr, i));
 }
 
 static inline void
@@ -755,6 +765,19 @@ chkclone_node_unique_table (Btor *btor, Btor *clone)
     }
     BTOR_CHKCLONE_EXPID (btable->chains[i], ctable->chains[i]);
   }
+
+  assert (btable->old_size == ctable->old_size);
+  assert (btable->migrated == ctable->migrated);
+  assert (!btable->old_chains == !ctable->old_chains);
+  for (i = 0; i < btable->old_size; i++)
+  {
+    if (!btable->old_chains[i])
+    {
+      assert (!ctable->old_chains[i]);
+      continue;
+    }
+    BTOR_CHKCLONE_EXPID (btable->old_chains[i], ctable->old_chains[i]);
+  }
 }
 
 /*------------------------------------------------------------------------*/
@@ -816,7 +839,7 @@ chkclone_tables (Btor *btor, Btor *clone)
     assert (btor->symbols->count == clone->symbols->count);
     assert (btor->symbols->hash == clone->symbols->hash);
     assert (btor->symbols->cmp == clone->symbols->cmp);
-    assert (!btor->symbols->first || clone->symbols->first);
+    assert (!btor->symbols->count || clone->symbols->count);
     btor_iter_hashptr_init (&pit, btor->symbols);
     btor_iter_hashptr_init (&cpit, clone->symbols);
     while (btor_iter_hashptr_has_next (&pit))
@@ -837,7 +860,7 @@ chkclone_tables (Btor *btor, Btor *clone)
     assert (btor->node2symbol->count == clone->node2symbol->count);
     assert (btor->node2symbol->hash == clone->node2symbol->hash);
     assert (btor->node2symbol->cmp == clone->node2symbol->cmp);
-    assert (!btor->node2symbol->first || clone->node2symbol->first);
+    assert (!btor->node2symbol->count || clone->node2symbol->count);
     btor_iter_hashptr_init (&pit, btor->node2symbol);
     btor_iter_hashptr_init (&cpit, clone->node2symbol);
     while (btor_iter_hashptr_has_next (&pit))
@@ -878,7 +901,7 @@ chkclone_tables (Btor *btor, Btor *clone)
     assert (btor->parameterized->count == clone->parameterized->count);
     assert (btor->parameterized->hash == clone->parameterized->hash);
     assert (btor->parameterized->cmp == clone->parameterized->cmp);
-    assert (!btor->parameterized->first || clone->parameterized->first);
+    assert (!btor->parameterized->count || clone->parameterized->count);
     btor_iter_hashptr_init (&pit, btor->parameterized);
     btor_iter_hashptr_init (&cpit, clone->parameterized);
     while (btor_iter_hashptr_has_next (&pit))
@@ -1045,7 +1068,7 @@ chkclone_slv (Btor *btor, Btor *clone)
       assert (slv->score->count == cslv->score->count);
       assert (slv->score->hash == cslv->score->hash);
       assert (slv->score->cmp == cslv->score->cmp);
-      assert (!slv->score->first || cslv->score->first);
+      assert (!slv->score->count || cslv->score->count);
       if (h == BTOR_JUST_HEUR_BRANCH_MIN_APP)
       {
         btor_iter_hashptr_init (&it, slv->score);
@@ -1084,6 +1107,10 @@ chkclone_slv (Btor *btor, Btor *clone)
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, function_congruence_conflicts);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, beta_reduction_conflicts);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, extensionality_lemmas);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, weakeq_lemmas);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemmas_reused);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemmas_evicted);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, calls);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemmas_size_sum);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_failed_vars);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_assumed_vars);
@@ -1091,6 +1118,7 @@ chkclone_slv (Btor *btor, Btor *clone)
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_assumed_applies);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_failed_eqs);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_assumed_eqs);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_clones);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, eval_exp_calls);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, propagations);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, propagations_down);
@@ -1223,6 +1251,18 @@ chkclone_slv (Btor *btor, Btor *clone)
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, moves);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, restarts);
   }
+  else if (btor->slv->kind == BTOR_ABS_SOLVER_KIND)
+  {
+    BtorAbsSolver *slv  = BTOR_ABS_SOLVER (btor);
+    BtorAbsSolver *cslv = BTOR_ABS_SOLVER (clone);
+
+    chkclone_node_ptr_hash_table (slv->abs, cslv->abs, cmp_data_as_int);
+
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, refinement_iterations);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, abstracted);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, lemmas);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, refined);
+  }
 }
 
 /*------------------------------------------------------------------------*/
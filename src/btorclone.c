@@ -17,6 +17,7 @@
 #include "btormsg.h"
 #include "btorrwcache.h"
 #include "btorsat.h"
+#include "btorslvabs.h"
 #include "btorslvaigprop.h"
 #include "btorslvfun.h"
 #include "btorslvprop.h"
@@ -83,21 +84,6 @@ btor_clone_key_as_bv_tuple (BtorMemMgr *mm, const void *map, const void *t)
   return btor_bv_copy_tuple (mm, (BtorBitVectorTuple *) t);
 }
 
-void *
-btor_clone_key_as_rw_cache_tuple (BtorMemMgr *mm,
-                                  const void *map,
-                                  const void *t)
-{
-  assert (mm);
-  assert (t);
-  (void) map;
-
-  BtorRwCacheTuple *res;
-  BTOR_CNEW (mm, res);
-  memcpy (res, t, sizeof (BtorRwCacheTuple));
-  return res;
-}
-
 void
 btor_clone_data_as_node_ptr (BtorMemMgr *mm,
                              const void *map,
@@ -220,16 +206,16 @@ btor_clone_data_as_int_htable (BtorMemMgr *mm,
 
   table = (BtorIntHashTable *) data->as_ptr;
 
-  res = btor_hashint_table_new (mm);
+  res = btor_hashint_table_new_tag (mm, table->tag);
 
-  BTOR_DELETEN (mm, res->keys, res->size);
-  BTOR_DELETEN (mm, res->hop_info, res->size);
+  BTOR_DELETEN_TAG (mm, res->tag, res->keys, res->size);
+  BTOR_DELETEN_TAG (mm, res->tag, res->hop_info, res->size);
 
   res->size  = table->size;
   res->count = table->count;
-  BTOR_CNEWN (mm, res->keys, res->size);
-  BTOR_CNEWN (mm, res->hop_info, res->size);
-  if (table->data) BTOR_CNEWN (mm, res->data, res->size);
+  BTOR_CNEWN_TAG (mm, res->tag, res->keys, res->size);
+  BTOR_CNEWN_TAG (mm, res->tag, res->hop_info, res->size);
+  if (table->data) BTOR_CNEWN_TAG (mm, res->tag, res->data, res->size);
 
   memcpy (res->keys, table->keys, table->size);
   memcpy (res->hop_info, table->hop_info, table->size);
@@ -507,7 +493,7 @@ clone_exp (Btor *clone,
 
   mm = clone->mm;
 
-  res = btor_mem_malloc (mm, exp->bytes);
+  res = btor_node_alloc (clone, exp->bytes);
   memcpy (res, exp, exp->bytes);
 
   /* ------------------- BTOR_VAR_NODE_STRUCT (all nodes) -----------------> */
@@ -790,6 +776,18 @@ clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
     res->chains[i] = btor_nodemap_mapped (exp_map, table->chains[i]);
     assert (res->chains[i]);
   }
+
+  res->old_size   = table->old_size;
+  res->migrated   = table->migrated;
+  res->old_chains = 0;
+  if (!table->old_chains) return;
+  BTOR_CNEWN (mm, res->old_chains, table->old_size);
+  for (i = table->migrated; i < table->old_size; i++)
+  {
+    if (!table->old_chains[i]) continue;
+    res->old_chains[i] = btor_nodemap_mapped (exp_map, table->old_chains[i]);
+    assert (res->old_chains[i]);
+  }
 }
 
 #define MEM_INT_HASH_TABLE(table)                                 \
@@ -802,10 +800,8 @@ clone_nodes_unique_table (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
                  + (table)->size * sizeof (BtorHashTableData) \
            : 0)
 
-#define MEM_PTR_HASH_TABLE(table)                                             \
-  ((table) ? sizeof (*(table)) + (table)->size * sizeof (BtorPtrHashBucket *) \
-                 + (table)->count * sizeof (BtorPtrHashBucket)                \
-           : 0)
+#define MEM_PTR_HASH_TABLE(table) \
+  ((table) ? btor_hashptr_table_bytes (table) : 0)
 
 #define CHKCLONE_MEM_INT_HASH_TABLE(table, clone)                      \
   do                                                                   \
@@ -884,6 +880,7 @@ clone_aux_btor (Btor *btor,
   size_t allocated;
   BtorNode *cur;
   BtorAIGMgr *amgr;
+  BtorAIGVecDiv *div;
   BtorBVAss *bvass;
   BtorFunAss *funass;
   BtorPtrHashTableIterator cpit, ncpit;
@@ -906,7 +903,9 @@ clone_aux_btor (Btor *btor,
 #endif
   memcpy (clone, btor, sizeof (Btor));
   clone->mm = mm;
+  BTOR_CLRN (clone->node_slabs, BTOR_NODE_NUM_SLABS);
   btor_rng_clone (&btor->rng, &clone->rng);
+  btor_bv_pool_init (mm, &clone->bv_pool);
 
   BTOR_CLR (&clone->cbs);
   btor_opt_clone_opts (btor, clone);
@@ -935,6 +934,7 @@ clone_aux_btor (Btor *btor,
     /* reset */
     clone->btor_sat_btor_called = 0;
     clone->last_sat_result      = 0;
+    clone->unknown_reason       = BTOR_UNKNOWN_REASON_NONE;
     btor_reset_time (clone);
 #ifndef NDEBUG
     /* we need to explicitely reset the pointer to the table, since
@@ -1015,8 +1015,9 @@ clone_aux_btor (Btor *btor,
       clone->avmgr = btor_aigvec_mgr_new (clone);
       assert ((allocated += sizeof (BtorAIGVecMgr) + sizeof (BtorAIGMgr)
                             + sizeof (BtorSATMgr)
-                            /* true and false AIGs */
-                            + 2 * sizeof (BtorAIG *)
+                            /* first AIG page */
+                            + BTOR_AIG_PAGE_SIZE * sizeof (BtorAIG)
+                            + sizeof (BtorAIG *) + sizeof (uint32_t)
                             + sizeof (int32_t)) /* unique table chains */
               == clone->mm->allocated);
     }
@@ -1029,14 +1030,28 @@ clone_aux_btor (Btor *btor,
       allocated +=
           sizeof (BtorAIGVecMgr) + sizeof (BtorAIGMgr)
           + sizeof (BtorSATMgr)
-          /* memory of AIG nodes */
-          + (amgr->cur_num_aigs + amgr->cur_num_aig_vars) * sizeof (BtorAIG)
-          /* children for AND AIGs */
-          + amgr->cur_num_aigs * sizeof (int32_t) * 2
+          /* AIG pages */
+          + amgr->num_pages * BTOR_AIG_PAGE_SIZE * sizeof (BtorAIG)
+          + BTOR_SIZE_STACK (amgr->pages)
+                * (sizeof (BtorAIG *) + sizeof (uint32_t))
           /* unique table chain */
-          + amgr->table.size * sizeof (int32_t)
-          + BTOR_SIZE_STACK (amgr->id2aig) * sizeof (BtorAIG *)
+          + (amgr->table.size + amgr->table.old_size) * sizeof (int32_t)
           + BTOR_SIZE_STACK (amgr->cnfid2aig) * sizeof (int32_t);
+      if (btor->avmgr->div_cache)
+      {
+        allocated += MEM_PTR_HASH_TABLE (btor->avmgr->div_cache);
+        btor_iter_hashptr_init (&cpit, btor->avmgr->div_cache);
+        while (btor_iter_hashptr_has_next (&cpit))
+        {
+          div = btor_iter_hashptr_next (&cpit);
+          allocated += sizeof (BtorAIGVecDiv)
+                       + 2 * (sizeof (BtorAIGVec)
+                              + div->a->width * sizeof (BtorAIG *))
+                       + (!!div->q + !!div->r)
+                             * (sizeof (BtorAIGVec)
+                                + div->a->width * sizeof (BtorAIG *));
+        }
+      }
 #ifdef BTOR_USE_LINGELING
       assert (strcmp (amgr->smgr->name, "Lingeling") == 0
               || strcmp (amgr->smgr->name, "DIMACS Printer") == 0);
@@ -1078,7 +1093,7 @@ clone_aux_btor (Btor *btor,
   assert (allocated == clone->mm->allocated);
 #endif
 
-  emap = btor_nodemap_new (clone);
+  emap = btor_nodemap_new_tag (clone, BTOR_MEM_TAG_CLONE);
   assert ((allocated += sizeof (*emap) + MEM_PTR_HASH_TABLE (emap->table))
           == clone->mm->allocated);
 
@@ -1097,7 +1112,6 @@ clone_aux_btor (Btor *btor,
   for (i = 1; i < BTOR_COUNT_STACK (btor->nodes_id_table); i++)
   {
     if (!(cur = BTOR_PEEK_STACK (btor->nodes_id_table, i))) continue;
-    allocated += cur->bytes;
     if (btor_node_is_bv_const (cur))
     {
       allocated += MEM_BITVEC (btor_node_bv_const_get_bits (cur));
@@ -1111,9 +1125,9 @@ clone_aux_btor (Btor *btor,
     if (btor_node_is_lambda (cur) && btor_node_lambda_get_static_rho (cur))
       allocated += MEM_PTR_HASH_TABLE (btor_node_lambda_get_static_rho (cur));
   }
-  /* Note: hash table is initialized with size 1 */
-  allocated += (emap->table->size - 1) * sizeof (BtorPtrHashBucket *)
-               + emap->table->count * sizeof (BtorPtrHashBucket)
+  allocated += btor_node_slabs_bytes (clone);
+  /* Note: hash table is initialized empty */
+  allocated += MEM_PTR_HASH_TABLE (emap->table) - sizeof (*emap->table)
                + BTOR_SIZE_STACK (btor->nodes_id_table) * sizeof (BtorNode *);
   assert (allocated == clone->mm->allocated);
 #endif
@@ -1126,7 +1140,9 @@ clone_aux_btor (Btor *btor,
   BTORLOG (2,
            "  clone nodes unique table: %.3f s",
            (btor_util_time_stamp () - delta));
-  assert ((allocated += btor->nodes_unique_table.size * sizeof (BtorNode *))
+  assert ((allocated += (btor->nodes_unique_table.size
+                         + btor->nodes_unique_table.old_size)
+                        * sizeof (BtorNode *))
           == clone->mm->allocated);
 
   clone->symbols = btor_hashptr_table_clone (mm,
@@ -1226,6 +1242,12 @@ clone_aux_btor (Btor *btor,
            BTOR_SIZE_STACK (btor->assertions_trail) * sizeof (uint32_t))
           == clone->mm->allocated);
 
+  btor_clone_node_ptr_stack (
+      mm, &btor->assertions_act, &clone->assertions_act, emap, false);
+  assert ((allocated +=
+           BTOR_SIZE_STACK (btor->assertions_act) * sizeof (BtorNode *))
+          == clone->mm->allocated);
+
   if (btor->bv_model)
   {
     clone->bv_model = btor_model_clone_bv (clone, btor->bv_model, false);
@@ -1365,14 +1387,10 @@ clone_aux_btor (Btor *btor,
   assert (allocated == clone->mm->allocated);
 #endif
   BTOR_NEW (mm, clone->rw_cache);
-  clone->rw_cache->btor  = clone;
-  clone->rw_cache->cache = btor_hashptr_table_clone (
-      mm, btor->rw_cache->cache, btor_clone_key_as_rw_cache_tuple, 0, 0, 0);
+  btor_rw_cache_clone (clone, clone->rw_cache, btor->rw_cache);
 #ifndef NDEBUG
-  CHKCLONE_MEM_PTR_HASH_TABLE (btor->rw_cache->cache, clone->rw_cache->cache);
   allocated += sizeof (*btor->rw_cache);
-  allocated += btor->rw_cache->cache->count * sizeof (BtorRwCacheTuple);
-  allocated += MEM_PTR_HASH_TABLE (btor->rw_cache->cache);
+  allocated += btor_rw_cache_bytes (btor->rw_cache);
 #endif
 
   /* move synthesized constraints to unsynthesized if we only clone the exp
@@ -1482,9 +1500,9 @@ clone_aux_btor (Btor *btor,
       {
         assert (BTOR_PEEK_STACK (cslv->moves, i));
         m = BTOR_PEEK_STACK (cslv->moves, i);
-        assert (MEM_PTR_HASH_TABLE (m->cans)
-                == MEM_PTR_HASH_TABLE (BTOR_PEEK_STACK (cslv->moves, i)->cans));
-        allocated += MEM_PTR_HASH_TABLE (m->cans);
+        assert (MEM_INT_HASH_MAP (m->cans)
+                == MEM_INT_HASH_MAP (BTOR_PEEK_STACK (cslv->moves, i)->cans));
+        allocated += MEM_INT_HASH_MAP (m->cans);
         btor_iter_hashint_init (&iit, m->cans);
         while (btor_iter_hashint_has_next (&iit))
           allocated +=
@@ -1495,7 +1513,7 @@ clone_aux_btor (Btor *btor,
       {
         assert (slv->max_cans);
         assert (slv->max_cans->count == cslv->max_cans->count);
-        allocated += MEM_PTR_HASH_TABLE (cslv->max_cans);
+        allocated += MEM_INT_HASH_MAP (cslv->max_cans);
         btor_iter_hashint_init (&iit, cslv->max_cans);
         while (btor_iter_hashint_has_next (&iit))
           allocated +=
@@ -1510,8 +1528,8 @@ clone_aux_btor (Btor *btor,
       CHKCLONE_MEM_INT_HASH_MAP (slv->roots, cslv->roots);
       CHKCLONE_MEM_INT_HASH_MAP (slv->score, cslv->score);
 
-      allocated += sizeof (BtorPropSolver) + MEM_PTR_HASH_TABLE (cslv->roots)
-                   + MEM_PTR_HASH_TABLE (cslv->score);
+      allocated += sizeof (BtorPropSolver) + MEM_INT_HASH_MAP (cslv->roots)
+                   + MEM_INT_HASH_MAP (cslv->score);
     }
     else if (clone->slv->kind == BTOR_AIGPROP_SOLVER_KIND)
     {
@@ -1521,17 +1539,25 @@ clone_aux_btor (Btor *btor,
       if (slv->aprop)
       {
         assert (cslv->aprop);
-        CHKCLONE_MEM_PTR_HASH_TABLE (slv->aprop->roots, cslv->aprop->roots);
-        CHKCLONE_MEM_PTR_HASH_TABLE (slv->aprop->score, cslv->aprop->score);
-        CHKCLONE_MEM_PTR_HASH_TABLE (slv->aprop->model, cslv->aprop->model);
+        CHKCLONE_MEM_INT_HASH_MAP (slv->aprop->roots, cslv->aprop->roots);
+        CHKCLONE_MEM_INT_HASH_MAP (slv->aprop->score, cslv->aprop->score);
+        CHKCLONE_MEM_INT_HASH_MAP (slv->aprop->model, cslv->aprop->model);
         allocated += sizeof (BtorAIGProp)
-                     + MEM_PTR_HASH_TABLE (cslv->aprop->roots)
-                     + MEM_PTR_HASH_TABLE (cslv->aprop->score)
-                     + MEM_PTR_HASH_TABLE (cslv->aprop->model);
+                     + MEM_INT_HASH_MAP (cslv->aprop->roots)
+                     + MEM_INT_HASH_MAP (cslv->aprop->score)
+                     + MEM_INT_HASH_MAP (cslv->aprop->model);
       }
 
       allocated += sizeof (BtorAIGPropSolver);
     }
+    else if (clone->slv->kind == BTOR_ABS_SOLVER_KIND)
+    {
+      BtorAbsSolver *slv  = BTOR_ABS_SOLVER (btor);
+      BtorAbsSolver *cslv = BTOR_ABS_SOLVER (clone);
+
+      CHKCLONE_MEM_PTR_HASH_TABLE (slv->abs, cslv->abs);
+      allocated += sizeof (BtorAbsSolver) + MEM_PTR_HASH_TABLE (cslv->abs);
+    }
 
     assert (allocated == clone->mm->allocated);
   }
@@ -1604,7 +1630,7 @@ btor_clone_recursively_rebuild_sort (Btor *btor, Btor *clone, BtorSortId sort)
   BtorSortIdStack sort_ids;
 
   mm  = btor->mm;
-  map = btor_hashint_map_new (mm);
+  map = btor_hashint_map_new_tag (mm, BTOR_MEM_TAG_CLONE);
 
   s = btor_sort_get_by_id (btor, sort);
 
@@ -1719,7 +1745,7 @@ btor_clone_recursively_rebuild_exp (Btor *btor,
   BtorSortId sort;
 
   mm   = btor->mm;
-  mark = btor_hashint_table_new (mm);
+  mark = btor_hashint_table_new_tag (mm, BTOR_MEM_TAG_CLONE);
 
   /* in some cases we may want to rebuild the expressions with a certain
    * rewrite level */
@@ -1856,6 +1882,9 @@ btor_clone_recursively_rebuild_exp (Btor *btor,
         case BTOR_ARGS_NODE:
           cur_clone = btor_exp_args (clone, e, cur->arity);
           break;
+        case BTOR_UPDATE_NODE:
+          cur_clone = btor_exp_update (clone, e[0], e[1], e[2]);
+          break;
         case BTOR_EXISTS_NODE:
           cur_clone = btor_exp_exists (clone, e[0], e[1]);
           break;
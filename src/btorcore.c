@@ -9,8 +9,12 @@
 #include "btorcore.h"
 
 #include <limits.h>
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
 
 #include "btorabort.h"
+#include "btoraigrw.h"
 #ifndef NDEBUG
 #include "btorchkfailed.h"
 #include "btorchkmodel.h"
@@ -23,6 +27,7 @@
 #include "btormodel.h"
 #include "btoropt.h"
 #include "btorrewrite.h"
+#include "btorslvabs.h"
 #include "btorslvaigprop.h"
 #include "btorslvfun.h"
 #include "btorslvprop.h"
@@ -31,6 +36,7 @@
 #include "btorsubst.h"
 #include "preprocess/btorpreprocess.h"
 #include "preprocess/btorvarsubst.h"
+#include "utils/btoraigmap.h"
 #include "utils/btorhashint.h"
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
@@ -72,14 +78,17 @@
 #define BTOR_COND_INVERT_AIG_NODE(exp, aig) \
   ((BtorAIG *) (((uint32_t long int) (exp) &1ul) ^ ((uint32_t long int) (aig))))
 
-#define BTOR_AIGVEC_NODE(btor, exp)                                     \
-  (btor_node_is_inverted (exp)                                          \
-       ? btor_aigvec_not ((btor)->avmgr, btor_node_real_addr (exp)->av) \
-       : btor_aigvec_copy ((btor)->avmgr, exp->av))
+#define BTOR_AIGVEC_NODE(avmgr, exp)                              \
+  (btor_node_is_inverted (exp)                                    \
+       ? btor_aigvec_not ((avmgr), btor_node_real_addr (exp)->av) \
+       : btor_aigvec_copy ((avmgr), exp->av))
 
 /*------------------------------------------------------------------------*/
 
 static BtorAIG *exp_to_aig (Btor *, BtorNode *);
+#ifdef BTOR_HAVE_PTHREADS
+static void synthesize_independent_constraints (Btor *);
+#endif
 
 /*------------------------------------------------------------------------*/
 
@@ -392,19 +401,19 @@ number_of_ops (Btor *btor)
   return result;
 }
 
-#ifdef BTOR_TIME_STATISTICS
 static double
 percent (double a, double b)
 {
   return b ? 100.0 * a / b : 0.0;
 }
-#endif
 
 void
 btor_print_stats (Btor *btor)
 {
   uint32_t i, num_final_ops;
   uint32_t verbosity;
+  BtorMemTag tag;
+  BtorAIGMgr *amgr;
 
   if (!btor) return;
 
@@ -430,6 +439,21 @@ btor_print_stats (Btor *btor)
               1,
               "%.2f MB allocated for nodes",
               btor->stats.node_bytes_alloc / (double) (1 << 20));
+    for (i = 0; i < BTOR_NODE_NUM_SLABS; i++)
+    {
+      BtorMemSlab *slab = btor->node_slabs[i];
+      if (!slab) continue;
+      BTOR_MSG (btor->msg,
+                1,
+                "  %3zu byte node slab: %lld nodes (%lld max), "
+                "%.1f%% occupancy, %u chunks, %.2f MB",
+                slab->size,
+                slab->cur,
+                slab->max,
+                slab->capacity ? 100.0 * slab->cur / slab->capacity : 0.0,
+                slab->nchunks,
+                slab->bytes / (double) (1 << 20));
+    }
     if (num_final_ops > 0)
       for (i = 1; i < BTOR_NUM_OPS_NODE - 1; i++)
         if (btor->ops[i].cur || btor->ops[i].max)
@@ -494,6 +518,14 @@ btor_print_stats (Btor *btor)
       btor->msg, 1, "%5d add normalizations", btor->stats.adds_normalized);
   BTOR_MSG (
       btor->msg, 1, "%5d mul normalizations", btor->stats.muls_normalized);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d ackermann constraints",
+            btor->stats.ackermann_constraints);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5lld pruned ackermann pairs",
+            btor->stats.ackermann_pruned);
   BTOR_MSG (btor->msg, 1, "%5lld lambdas merged", btor->stats.lambdas_merged);
   BTOR_MSG (btor->msg,
             1,
@@ -513,13 +545,14 @@ btor_print_stats (Btor *btor)
   BTOR_MSG (btor->msg, 1, "  %lld cached (get)", btor->rw_cache->num_get);
   BTOR_MSG (btor->msg, 1, "  %lld updated", btor->rw_cache->num_update);
   BTOR_MSG (btor->msg, 1, "  %lld removed (gc)", btor->rw_cache->num_remove);
+  BTOR_MSG (btor->msg, 1, "  %lld hits", btor->rw_cache->num_hit);
+  BTOR_MSG (btor->msg, 1, "  %lld misses", btor->rw_cache->num_miss);
+  BTOR_MSG (btor->msg, 1, "  %lld evicted", btor->rw_cache->num_evict);
   BTOR_MSG (btor->msg,
             1,
-            "  %.2f MB cache",
-            (btor->rw_cache->cache->count * sizeof (BtorRwCacheTuple)
-             + btor->rw_cache->cache->count * sizeof (BtorPtrHashBucket)
-             + btor->rw_cache->cache->size * sizeof (BtorPtrHashBucket *))
-                / (double) (1 << 20));
+            "  %.2f MB cache (%u entries)",
+            btor_rw_cache_bytes (btor->rw_cache) / (double) (1 << 20),
+            btor->rw_cache->count);
 
 #ifndef NDEBUG
   BtorPtrHashTableIterator it;
@@ -568,6 +601,17 @@ btor_print_stats (Btor *btor)
             1,
             "  %7lld CNF literals",
             btor->avmgr ? btor->avmgr->amgr->num_cnf_literals : 0);
+  if (btor_opt_get (btor, BTOR_OPT_AIG_REWRITE) && btor->avmgr)
+  {
+    amgr = btor->avmgr->amgr;
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7lld AIG ANDs rewritten to %lld ANDs (%.1f%% reduction)",
+              amgr->num_rw_ands_before,
+              amgr->num_rw_ands_after,
+              percent (amgr->num_rw_ands_before - amgr->num_rw_ands_after,
+                       amgr->num_rw_ands_before));
+  }
 
   if (btor->slv) btor->slv->api.print_stats (btor->slv);
 
@@ -662,6 +706,26 @@ btor_print_stats (Btor *btor)
   if (btor->slv) btor->slv->api.print_time_stats (btor->slv);
 #endif
 
+  BTOR_MSG (btor->msg, 1, "");
+  BTOR_MSG (btor->msg, 1, "memory statistics:");
+  for (tag = 0; tag < BTOR_MEM_TAG_NUM; tag++)
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7.1f MB %s (%.1f MB max)",
+              btor_mem_tag_allocated (btor->mm, tag) / (double) (1 << 20),
+              btor_mem_tag_name (tag),
+              btor_mem_tag_maxallocated (btor->mm, tag) / (double) (1 << 20));
+  BTOR_MSG (btor->msg,
+            1,
+            "  %7.1f MB SAT solver (%.1f MB max)",
+            btor->mm->sat_allocated / (double) (1 << 20),
+            btor->mm->sat_maxallocated / (double) (1 << 20));
+  if (btor->mm->hard_limit)
+    BTOR_MSG (btor->msg,
+              1,
+              "  %7u soft memory limit reductions",
+              btor->stats.memory_reductions);
+
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (
       btor->msg, 1, "%.1f MB", btor->mm->maxallocated / (double) (1 << 20));
@@ -692,6 +756,7 @@ btor_new (void)
   btor->avmgr = btor_aigvec_mgr_new (btor);
 
   btor_rng_init (&btor->rng, btor_opt_get (btor, BTOR_OPT_SEED));
+  btor_bv_pool_init (mm, &btor->bv_pool);
 
   btor->bv_assignments  = btor_ass_new_bv_list (mm);
   btor->fun_assignments = btor_ass_new_fun_list (mm);
@@ -765,6 +830,7 @@ btor_new (void)
 
   BTOR_INIT_STACK (mm, btor->assertions);
   BTOR_INIT_STACK (mm, btor->assertions_trail);
+  BTOR_INIT_STACK (mm, btor->assertions_act);
   btor->assertions_cache = btor_hashint_table_new (mm);
 
 #ifndef NDEBUG
@@ -789,6 +855,8 @@ terminate_aux_btor (void *btor)
   Btor *bt;
 
   bt = (Btor *) btor;
+  /* may be called by the SAT solvers of a SAT solver portfolio */
+  if (btor_mem_get_thread_mgr (bt->mm)->hard_limit_reached) return 1;
   if (!bt->cbs.term.fun) return 0;
   if (bt->cbs.term.done) return 1;
   res = ((int32_t (*) (void *)) bt->cbs.term.fun) (bt->cbs.term.state);
@@ -796,15 +864,58 @@ terminate_aux_btor (void *btor)
   return res;
 }
 
+/* Releases memory that is not required for correctness (rewrite cache,
+ * cached udiv/urem results, sparse AIG unique table) if the soft memory
+ * limit has been exceeded.  Must only be called when no rewriting or AIG
+ * construction is in progress. */
+static void
+reduce_memory (Btor *btor)
+{
+  assert (btor);
+
+  size_t allocated;
+
+  if (!btor->mm->soft_limit_reached) return;
+
+  allocated = btor->mm->allocated;
+  btor_rw_cache_reset (btor->rw_cache);
+  btor_aigvec_mgr_reset_div_cache (btor->avmgr);
+  btor_aig_mgr_compact (btor_get_aig_mgr (btor));
+  btor->stats.memory_reductions += 1;
+  BTOR_MSG (btor->msg,
+            2,
+            "soft memory limit exceeded, released %.1f MB",
+            (allocated - btor->mm->allocated) / (double) (1 << 20));
+
+  /* Continue if we are below the hard limit again.  The soft limit flag is
+   * cleared in any case and only set again by the next allocation that
+   * exceeds the soft limit. */
+  btor_mem_check_limit (btor->mm);
+  btor->mm->soft_limit_reached = 0;
+}
+
 int32_t
 btor_terminate (Btor *btor)
 {
   assert (btor);
 
+  reduce_memory (btor);
+  if (btor->mm->hard_limit_reached) return 1;
   if (btor->cbs.term.termfun) return btor->cbs.term.termfun (btor);
   return 0;
 }
 
+void
+btor_set_memory_limit (Btor *btor, uint32_t limit)
+{
+  assert (btor);
+
+  size_t hard_limit;
+
+  hard_limit = (size_t) limit << 20;
+  btor_mem_set_limit (btor->mm, hard_limit / 100 * 80, hard_limit);
+}
+
 void
 btor_set_term (Btor *btor, int32_t (*fun) (void *), void *state)
 {
@@ -901,6 +1012,7 @@ btor_delete (Btor *btor)
   btor_rng_delete (&btor->rng);
 
   if (btor->slv) btor->slv->api.delet (btor->slv);
+  btor_bv_pool_release (&btor->bv_pool);
 
   if (btor->parse_error_msg) btor_mem_freestr (mm, btor->parse_error_msg);
 
@@ -941,6 +1053,9 @@ btor_delete (Btor *btor)
     btor_node_release (btor, BTOR_PEEK_STACK (btor->assertions, i));
   BTOR_RELEASE_STACK (btor->assertions);
   BTOR_RELEASE_STACK (btor->assertions_trail);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->assertions_act); i++)
+    btor_node_release (btor, BTOR_PEEK_STACK (btor->assertions_act, i));
+  BTOR_RELEASE_STACK (btor->assertions_act);
   btor_hashint_table_delete (btor->assertions_cache);
 
   btor_model_delete (btor);
@@ -1021,7 +1136,11 @@ btor_delete (Btor *btor)
   assert (getenv ("BTORLEAK") || getenv ("BTORLEAKEXP") || !node_leak);
 #endif
   BTOR_RELEASE_UNIQUE_TABLE (mm, btor->nodes_unique_table);
+  BTOR_DELETEN (mm,
+                btor->nodes_unique_table.old_chains,
+                btor->nodes_unique_table.old_size);
   BTOR_RELEASE_STACK (btor->nodes_id_table);
+  btor_node_delete_slabs (btor);
 
   assert (getenv ("BTORLEAK") || getenv ("BTORLEAKSORT")
           || btor->sorts_unique_table.num_elements == 0);
@@ -1086,9 +1205,16 @@ btor_process_unsynthesized_constraints (Btor *btor)
   sc   = btor->synthesized_constraints;
   amgr = btor_get_aig_mgr (btor);
 
+#ifdef BTOR_HAVE_PTHREADS
+  /* log messages are not thread-safe */
+  if (uc->count > 1 && btor_opt_get (btor, BTOR_OPT_SYNTH_THREADS) > 1
+      && !btor_opt_get (btor, BTOR_OPT_LOGLEVEL))
+    synthesize_independent_constraints (btor);
+#endif
+
   while (uc->count > 0)
   {
-    bucket = uc->first;
+    bucket = btor_hashptr_table_first (uc);
     assert (bucket);
     cur = (BtorNode *) bucket->key;
 
@@ -1700,6 +1826,9 @@ btor_reset_incremental_usage (Btor *btor)
   reset_functions_with_model (btor);
   btor->valid_assignments = 0;
   btor_model_delete (btor);
+  /* memory may have been released, reevaluate memory limits */
+  reduce_memory (btor);
+  btor_mem_check_limit (btor->mm);
 }
 
 static void
@@ -1811,7 +1940,7 @@ exp_to_cnf_lit (Btor *btor, BtorNode *exp)
       sign *= -1;
     }
 
-    if (!aig->cnf_id) btor_aig_to_sat_tseitin (amgr, aig);
+    btor_aig_to_sat_tseitin (amgr, aig);
 
     res = aig->cnf_id;
     btor_aig_release (amgr, aig);
@@ -1855,6 +1984,38 @@ btor_assume_exp (Btor *btor, BtorNode *exp)
   }
 }
 
+void
+btor_disable_activation_exp (Btor *btor, BtorNode *act)
+{
+  assert (btor);
+  assert (act);
+
+  BtorAIG *aig;
+  BtorSATMgr *smgr;
+
+  BTORLOG (2, "disable activation variable: %s", btor_util_node2string (act));
+
+  /* If 'act' has already been encoded, add the disabling unit directly to
+   * the SAT solver. Asserting its negation below only substitutes 'act' on
+   * the node level, which removes the guarded constraints (and thus
+   * eventually releases their AIGs and CNF ids) but never tells the SAT
+   * solver that the clauses guarded by 'act' are satisfied. Note that 'act'
+   * may already have been substituted during simplification, e.g., if the
+   * constraints guarded by it are inconsistent. */
+  smgr = btor_get_sat_mgr (btor);
+  if (btor_node_is_bv_var (act) && act->av && btor_sat_is_initialized (smgr))
+  {
+    aig = act->av->aigs[0];
+    assert (btor_aig_is_var (aig));
+    if (aig->cnf_id)
+      btor_aig_add_toplevel_to_sat (btor_get_aig_mgr (btor),
+                                    BTOR_INVERT_AIG (aig));
+  }
+
+  btor_assert_exp (btor, btor_node_invert (act));
+  btor_node_release (btor, act);
+}
+
 bool
 btor_is_assumption_exp (Btor *btor, BtorNode *exp)
 {
@@ -2466,19 +2627,19 @@ btor_substitute_node (Btor *btor,
 
 /*------------------------------------------------------------------------*/
 
-/* bit vector skeleton is always encoded, i.e., if btor_node_is_synth is true,
- * then it is also encoded. with option lazy_synthesize enabled,
- * 'btor_synthesize_exp' stops at feq and apply nodes */
-void
-btor_synthesize_exp (Btor *btor,
-                     BtorNode *exp,
-                     BtorPtrHashTable *backannotation)
+/* Synthesizes 'exp' into AIG vectors of 'avmgr'.  Nodes synthesized by
+ * this call are pushed onto 'synthesized' if given. */
+static uint32_t
+synthesize_exp (Btor *btor,
+                BtorAIGVecMgr *avmgr,
+                BtorNode *exp,
+                BtorPtrHashTable *backannotation,
+                BtorNodePtrStack *synthesized)
 {
   BtorNodePtrStack exp_stack;
   BtorNode *cur, *value, *args;
   BtorAIGVec *av0, *av1, *av2;
   BtorMemMgr *mm;
-  BtorAIGVecMgr *avmgr;
   BtorPtrHashBucket *b;
   BtorPtrHashTable *static_rho;
   BtorPtrHashTableIterator it;
@@ -2489,19 +2650,19 @@ btor_synthesize_exp (Btor *btor,
   bool invert_av0 = false;
   bool invert_av1 = false;
   bool invert_av2 = false;
-  double start;
-  bool restart, opt_lazy_synth;
+  bool restart, opt_lazy_synth, opt_aig_rewrite, opt_aig_cnf_pg;
   BtorIntHashTable *cache;
 
   assert (btor);
+  assert (avmgr);
   assert (exp);
 
-  start          = btor_util_time_stamp ();
-  mm             = btor->mm;
-  avmgr          = btor->avmgr;
-  count          = 0;
-  cache          = btor_hashint_table_new (mm);
-  opt_lazy_synth = btor_opt_get (btor, BTOR_OPT_FUN_LAZY_SYNTHESIZE) == 1;
+  mm              = btor->mm;
+  count           = 0;
+  cache           = btor_hashint_table_new (mm);
+  opt_lazy_synth  = btor_opt_get (btor, BTOR_OPT_FUN_LAZY_SYNTHESIZE) == 1;
+  opt_aig_rewrite = btor_opt_get (btor, BTOR_OPT_AIG_REWRITE) == 1;
+  opt_aig_cnf_pg  = btor_opt_get (btor, BTOR_OPT_AIG_CNF_PG) == 1;
 
   BTOR_INIT_STACK (mm, exp_stack);
   BTOR_PUSH_STACK (exp_stack, exp);
@@ -2521,6 +2682,7 @@ btor_synthesize_exp (Btor *btor,
       if (btor_node_is_bv_const (cur))
       {
         cur->av = btor_aigvec_const (avmgr, btor_node_bv_const_get_bits (cur));
+        if (synthesized) BTOR_PUSH_STACK (*synthesized, cur);
         BTORLOG (2, "  synthesized: %s", btor_util_node2string (cur));
         /* no need to call btor_aigvec_to_sat_tseitin here */
       }
@@ -2531,6 +2693,7 @@ btor_synthesize_exp (Btor *btor,
       {
         assert (!cur->parameterized);
         cur->av = btor_aigvec_var (avmgr, btor_node_bv_get_width (btor, cur));
+        if (synthesized) BTOR_PUSH_STACK (*synthesized, cur);
 
         if (btor_node_is_bv_var (cur) && backannotation
             && (name = btor_node_get_symbol (btor, cur)))
@@ -2645,8 +2808,8 @@ btor_synthesize_exp (Btor *btor,
             btor_node_real_addr (cur->e[0]) == btor_node_real_addr (cur->e[1]);
         if (is_same_children_mem)
         {
-          av0 = BTOR_AIGVEC_NODE (btor, cur->e[0]);
-          av1 = BTOR_AIGVEC_NODE (btor, cur->e[1]);
+          av0 = BTOR_AIGVEC_NODE (avmgr, cur->e[0]);
+          av1 = BTOR_AIGVEC_NODE (avmgr, cur->e[1]);
         }
         else
         {
@@ -2702,7 +2865,6 @@ btor_synthesize_exp (Btor *btor,
           if (invert_av0) btor_aigvec_invert (avmgr, av0);
           if (invert_av1) btor_aigvec_invert (avmgr, av1);
         }
-        if (!opt_lazy_synth) btor_aigvec_to_sat_tseitin (avmgr, cur->av);
       }
       else
       {
@@ -2718,9 +2880,9 @@ btor_synthesize_exp (Btor *btor,
                      == btor_node_real_addr (cur->e[2]);
           if (is_same_children_mem)
           {
-            av0 = BTOR_AIGVEC_NODE (btor, cur->e[0]);
-            av1 = BTOR_AIGVEC_NODE (btor, cur->e[1]);
-            av2 = BTOR_AIGVEC_NODE (btor, cur->e[2]);
+            av0 = BTOR_AIGVEC_NODE (avmgr, cur->e[0]);
+            av1 = BTOR_AIGVEC_NODE (avmgr, cur->e[1]);
+            av2 = BTOR_AIGVEC_NODE (avmgr, cur->e[2]);
           }
           else
           {
@@ -2750,12 +2912,36 @@ btor_synthesize_exp (Btor *btor,
         }
       }
       assert (cur->av);
+      if (synthesized) BTOR_PUSH_STACK (*synthesized, cur);
       BTORLOG (2, "  synthesized: %s", btor_util_node2string (cur));
-      btor_aigvec_to_sat_tseitin (avmgr, cur->av);
+      if (opt_aig_rewrite)
+        btor_aig_rewrite (avmgr->amgr, cur->av->aigs, cur->av->width);
+      /* with polarity-aware encoding, AIGs are encoded on demand when they
+       * are added as constraints or assumptions */
+      if (!opt_aig_cnf_pg) btor_aigvec_to_sat_tseitin (avmgr, cur->av);
     }
   }
   BTOR_RELEASE_STACK (exp_stack);
   btor_hashint_table_delete (cache);
+  return count;
+}
+
+/* bit vector skeleton is always encoded, i.e., if btor_node_is_synth is true,
+ * then it is also encoded. with option lazy_synthesize enabled,
+ * 'btor_synthesize_exp' stops at feq and apply nodes */
+void
+btor_synthesize_exp (Btor *btor,
+                     BtorNode *exp,
+                     BtorPtrHashTable *backannotation)
+{
+  assert (btor);
+  assert (exp);
+
+  uint32_t count;
+  double start;
+
+  start = btor_util_time_stamp ();
+  count = synthesize_exp (btor, btor->avmgr, exp, backannotation, 0);
 
   if (count > 0 && btor_opt_get (btor, BTOR_OPT_VERBOSITY) > 3)
     BTOR_MSG (
@@ -2764,6 +2950,308 @@ btor_synthesize_exp (Btor *btor,
   btor->time.synth_exp += btor_util_time_stamp () - start;
 }
 
+/*------------------------------------------------------------------------*/
+#ifdef BTOR_HAVE_PTHREADS
+/*------------------------------------------------------------------------*/
+
+/* Unsynthesized constraints that do not share any expressions other than
+ * constants are grouped into independent jobs, which are bit-blasted on a
+ * pool of threads, each job into its own AIG vector manager.  The resulting
+ * AIG vectors are imported into the AIG vector manager of 'btor' job by job
+ * in the order of the constraints.  Hence, the AIGs and the CNF only depend
+ * on the order of the constraints, not on the number of threads and their
+ * scheduling.  Constraints that reach already synthesized expressions or
+ * function and quantifier terms are left to the sequential synthesis in
+ * btor_process_unsynthesized_constraints. */
+
+struct BtorSynthJob
+{
+  BtorNodePtrStack roots;       /* constraints to be synthesized */
+  BtorNodePtrStack synthesized; /* synthesized nodes in synthesis order */
+  BtorAIGVecMgr *avmgr;         /* job-private AIG vector manager */
+};
+
+typedef struct BtorSynthJob BtorSynthJob;
+
+struct BtorSynthPool
+{
+  Btor *btor;
+  BtorSynthJob *jobs;
+  uint32_t njobs;
+  uint32_t next; /* next job to be picked, updated atomically */
+};
+
+typedef struct BtorSynthPool BtorSynthPool;
+
+struct BtorSynthThread
+{
+  BtorSynthPool *pool;
+  BtorMemMgr *mm; /* thread memory manager, 0 for the calling thread */
+  pthread_t thread;
+};
+
+typedef struct BtorSynthThread BtorSynthThread;
+
+static void *
+synth_thread (void *state)
+{
+  assert (state);
+
+  uint32_t i, j;
+  BtorSynthPool *pool;
+  BtorSynthJob *job;
+
+  pool = ((BtorSynthThread *) state)->pool;
+  btor_mem_set_thread_mgr (((BtorSynthThread *) state)->mm);
+  while ((i = __atomic_fetch_add (&pool->next, 1, __ATOMIC_RELAXED))
+         < pool->njobs)
+  {
+    job        = &pool->jobs[i];
+    job->avmgr = btor_aigvec_mgr_new (pool->btor);
+    for (j = 0; j < BTOR_COUNT_STACK (job->roots); j++)
+      (void) synthesize_exp (pool->btor,
+                             job->avmgr,
+                             BTOR_PEEK_STACK (job->roots, j),
+                             0,
+                             &job->synthesized);
+  }
+  btor_mem_set_thread_mgr (0);
+  return 0;
+}
+
+/* Only pure bit-vector terms are bit-blasted concurrently. */
+static bool
+is_synth_concurrent (BtorNode *exp)
+{
+  exp = btor_node_real_addr (exp);
+  if (exp->parameterized) return false;
+  switch (exp->kind)
+  {
+    case BTOR_BV_CONST_NODE:
+    case BTOR_BV_SLICE_NODE:
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_ULT_NODE:
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE:
+    case BTOR_BV_CONCAT_NODE: return true;
+    case BTOR_VAR_NODE: return btor_node_is_bv_var (exp);
+    case BTOR_COND_NODE: return btor_node_is_bv_cond (exp);
+    default: return false;
+  }
+}
+
+static uint32_t
+find_synth_group (uint32_t *groups, uint32_t i)
+{
+  while (groups[i] != i) i = groups[i] = groups[groups[i]];
+  return i;
+}
+
+static void
+synthesize_independent_constraints (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, j, k, n, njobs, nthreads, nstarted, *groups, *jobidx;
+  bool *serial, opt_aig_cnf_pg;
+  double start, delta;
+  BtorMemMgr *mm;
+  BtorNode *cur;
+  BtorNodePtrStack roots, visit;
+  BtorIntHashTable *owner;
+  BtorHashTableData *d;
+  BtorPtrHashTableIterator it;
+  BtorSynthJob *jobs, *job;
+  BtorSynthPool pool;
+  BtorAIGMap *map;
+  BtorAIGVec *av;
+  BtorAIGMgr *amgr;
+  BtorSynthThread *threads;
+
+  start = btor_util_time_stamp ();
+  mm    = btor->mm;
+
+  BTOR_INIT_STACK (mm, roots);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    if (btor_node_is_synth (btor_node_real_addr (cur))
+        || btor_hashptr_table_get (btor->synthesized_constraints, cur))
+      continue;
+    BTOR_PUSH_STACK (roots, cur);
+  }
+  n = BTOR_COUNT_STACK (roots);
+  if (n < 2)
+  {
+    BTOR_RELEASE_STACK (roots);
+    return;
+  }
+
+  /* Group constraints that share unsynthesized (non-constant) expressions
+   * via union-find on the constraint indices. */
+  BTOR_NEWN (mm, groups, n);
+  BTOR_CNEWN (mm, serial, n);
+  for (i = 0; i < n; i++) groups[i] = i;
+  owner = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, visit);
+  for (i = 0; i < n; i++)
+  {
+    BTOR_PUSH_STACK (visit, BTOR_PEEK_STACK (roots, i));
+    while (!BTOR_EMPTY_STACK (visit))
+    {
+      cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+      if (!is_synth_concurrent (cur))
+      {
+        serial[i] = true;
+        continue;
+      }
+      /* Constants are shared between jobs. Their AIG vectors only consist
+       * of constant AIGs, which are valid in any AIG manager. */
+      if (btor_node_is_bv_const (cur))
+      {
+        if (!cur->av)
+          cur->av = btor_aigvec_const (btor->avmgr,
+                                       btor_node_bv_const_get_bits (cur));
+        continue;
+      }
+      if (btor_node_is_synth (cur))
+      {
+        serial[i] = true;
+        continue;
+      }
+      if ((d = btor_hashint_map_get (owner, cur->id)))
+      {
+        j = find_synth_group (groups, i);
+        k = find_synth_group (groups, d->as_int);
+        if (j < k)
+          groups[k] = j;
+        else
+          groups[j] = k;
+        continue;
+      }
+      btor_hashint_map_add (owner, cur->id)->as_int = i;
+      for (j = 0; j < cur->arity; j++) BTOR_PUSH_STACK (visit, cur->e[j]);
+    }
+  }
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_map_delete (owner);
+  for (i = 0; i < n; i++)
+    if (serial[i]) serial[find_synth_group (groups, i)] = true;
+
+  /* Jobs are numbered in the order of their first constraint. */
+  BTOR_CNEWN (mm, jobidx, n);
+  for (i = 0, njobs = 0; i < n; i++)
+  {
+    j = find_synth_group (groups, i);
+    if (!serial[j] && !jobidx[j]) jobidx[j] = ++njobs;
+  }
+
+  if (njobs > 1)
+  {
+    BTOR_CNEWN (mm, jobs, njobs);
+    for (i = 0; i < njobs; i++)
+    {
+      BTOR_INIT_STACK (mm, jobs[i].roots);
+      BTOR_INIT_STACK (mm, jobs[i].synthesized);
+    }
+    for (i = 0; i < n; i++)
+    {
+      j = find_synth_group (groups, i);
+      if (serial[j]) continue;
+      BTOR_PUSH_STACK (jobs[jobidx[j] - 1].roots, BTOR_PEEK_STACK (roots, i));
+    }
+
+    nthreads = btor_opt_get (btor, BTOR_OPT_SYNTH_THREADS);
+    if (nthreads > njobs) nthreads = njobs;
+    pool.btor  = btor;
+    pool.jobs  = jobs;
+    pool.njobs = njobs;
+    pool.next  = 0;
+    BTOR_CNEWN (mm, threads, nthreads);
+    for (nstarted = 0; nstarted < nthreads; nstarted++)
+    {
+      threads[nstarted].pool = &pool;
+      threads[nstarted].mm   = btor_mem_mgr_new_thread (mm, nthreads);
+      if (pthread_create (
+              &threads[nstarted].thread, 0, synth_thread, &threads[nstarted]))
+      {
+        btor_mem_mgr_delete_thread (threads[nstarted].mm);
+        break;
+      }
+    }
+    if (!nstarted)
+    {
+      /* could not create any thread, bit-blast all jobs on this thread */
+      threads[0].pool = &pool;
+      threads[0].mm   = 0;
+      synth_thread (&threads[0]);
+    }
+    for (i = 0; i < nstarted; i++)
+    {
+      pthread_join (threads[i].thread, 0);
+      btor_mem_mgr_delete_thread (threads[i].mm);
+    }
+    BTOR_DELETEN (mm, threads, nthreads);
+
+    amgr           = btor_get_aig_mgr (btor);
+    opt_aig_cnf_pg = btor_opt_get (btor, BTOR_OPT_AIG_CNF_PG) == 1;
+    for (i = 0; i < njobs; i++)
+    {
+      job = &jobs[i];
+      map = btor_aigmap_new (btor, btor_aigvec_get_aig_mgr (job->avmgr), amgr);
+      for (j = 0; j < BTOR_COUNT_STACK (job->synthesized); j++)
+      {
+        cur = BTOR_PEEK_STACK (job->synthesized, j);
+        av  = btor_aigvec_import (btor->avmgr, map, cur->av);
+        btor_aigvec_release_delete (job->avmgr, cur->av);
+        cur->av = av;
+      }
+      /* The map holds references to the imported AIGs, which would keep
+       * their CNF ids from being released during the encoding. */
+      btor_aigmap_delete (map);
+      for (j = 0; j < BTOR_COUNT_STACK (job->synthesized); j++)
+      {
+        cur = BTOR_PEEK_STACK (job->synthesized, j);
+        /* cf. synthesize_exp */
+        if (btor_node_is_bv_var (cur) || !opt_aig_cnf_pg)
+          btor_aigvec_to_sat_tseitin (btor->avmgr, cur->av);
+      }
+      amgr->num_rw_ands_before +=
+          btor_aigvec_get_aig_mgr (job->avmgr)->num_rw_ands_before;
+      amgr->num_rw_ands_after +=
+          btor_aigvec_get_aig_mgr (job->avmgr)->num_rw_ands_after;
+      btor_aigvec_mgr_delete (job->avmgr);
+      BTOR_RELEASE_STACK (job->roots);
+      BTOR_RELEASE_STACK (job->synthesized);
+    }
+    BTOR_DELETEN (mm, jobs, njobs);
+
+    delta = btor_util_time_stamp () - start;
+    btor->time.synth_exp += delta;
+    BTOR_MSG (btor->msg,
+              1,
+              "bit-blasted %u independent jobs on %u threads in %.2f seconds",
+              njobs,
+              nstarted ? nstarted : 1,
+              delta);
+  }
+
+  BTOR_DELETEN (mm, jobidx, n);
+  BTOR_DELETEN (mm, serial, n);
+  BTOR_DELETEN (mm, groups, n);
+  BTOR_RELEASE_STACK (roots);
+}
+
+/*------------------------------------------------------------------------*/
+#endif
+/*------------------------------------------------------------------------*/
+
 /* forward assumptions to the SAT solver */
 void
 btor_add_again_assumptions (Btor *btor)
@@ -2890,17 +3378,27 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
   if (btor->valid_assignments == 1) btor_reset_incremental_usage (btor);
 
-  /* 'btor->assertions' contains all assertions that were asserted in context
-   * levels > 0 (boolector_push). We assume all these assertions on every
-   * btor_check_sat call since these assumptions are valid until the
-   * corresponding context is popped. */
-  if (BTOR_COUNT_STACK (btor->assertions) > 0)
+  if (btor->mm->hard_limit)
   {
-    assert (BTOR_COUNT_STACK (btor->assertions_trail) > 0);
+    reduce_memory (btor);
+    btor_mem_check_limit (btor->mm);
+    /* terminate the SAT solver when the hard limit is exceeded */
+    if (!btor->cbs.term.termfun) btor_set_term (btor, 0, 0);
+  }
+
+  /* All assertions in context levels > 0 (boolector_push) are added as
+   * constraints guarded by the activation variable of their context level.
+   * We assume all activation variables on every btor_check_sat call since
+   * the guarded constraints are valid until the corresponding context is
+   * popped. */
+  if (BTOR_COUNT_STACK (btor->assertions_act) > 0)
+  {
+    assert (BTOR_COUNT_STACK (btor->assertions_act)
+            == BTOR_COUNT_STACK (btor->assertions_trail));
     uint32_t i;
-    for (i = 0; i < BTOR_COUNT_STACK (btor->assertions); i++)
+    for (i = 0; i < BTOR_COUNT_STACK (btor->assertions_act); i++)
     {
-      btor_assume_exp (btor, BTOR_PEEK_STACK (btor->assertions, i));
+      btor_assume_exp (btor, BTOR_PEEK_STACK (btor->assertions_act, i));
     }
   }
 
@@ -2910,7 +3408,7 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
   Btor *uclone = 0;
   if (check && btor_opt_get (btor, BTOR_OPT_CHK_UNCONSTRAINED)
-      && btor_opt_get (btor, BTOR_OPT_UCOPT)
+      && !btor->mm->hard_limit && btor_opt_get (btor, BTOR_OPT_UCOPT)
       && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
       && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
       && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN)
@@ -2971,7 +3469,11 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
 
   res = btor_simplify (btor);
 
-  if (res != BTOR_RESULT_UNSAT)
+  if (res != BTOR_RESULT_UNSAT && btor->mm->hard_limit_reached)
+  {
+    res = BTOR_RESULT_UNKNOWN;
+  }
+  else if (res != BTOR_RESULT_UNSAT)
   {
     engine = btor_opt_get (btor, BTOR_OPT_ENGINE);
 
@@ -3005,6 +3507,15 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
                    "Quantifiers not supported for -E aigprop");
         btor->slv = btor_new_aigprop_solver (btor);
       }
+      else if (engine == BTOR_ENGINE_ABS && btor->ufs->count == 0
+               && btor->feqs->count == 0)
+      {
+        assert (btor->lambdas->count == 0
+                || btor_opt_get (btor, BTOR_OPT_BETA_REDUCE));
+        BTOR_ABORT(btor->quantifiers->count,
+                   "Quantifiers not supported for -E abs");
+        btor->slv = btor_new_abs_solver (btor);
+      }
       else if ((engine == BTOR_ENGINE_QUANT && btor->quantifiers->count > 0)
                || btor->quantifiers->count > 0)
       {
@@ -3033,6 +3544,14 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
     res = btor->slv->api.sat (btor->slv);
   }
   btor->last_sat_result = res;
+  if (res != BTOR_RESULT_UNKNOWN)
+    btor->unknown_reason = BTOR_UNKNOWN_REASON_NONE;
+  else if (btor->mm->hard_limit_reached)
+    btor->unknown_reason = BTOR_UNKNOWN_REASON_MEMORY;
+  else if (btor->cbs.term.done)
+    btor->unknown_reason = BTOR_UNKNOWN_REASON_TERMINATED;
+  else
+    btor->unknown_reason = BTOR_UNKNOWN_REASON_INCOMPLETE;
   btor->btor_sat_btor_called++;
   btor->valid_assignments = 1;
 
@@ -10,6 +10,7 @@
 #define BTORCORE_H_INCLUDED
 
 #include "btorass.h"
+#include "btorbv.h"
 #include "btormsg.h"
 #include "btornode.h"
 #include "btoropt.h"
@@ -49,11 +50,17 @@
 
 /*------------------------------------------------------------------------*/
 
+/* The unique table is resized incrementally. On enlarging, the current
+ * chains become 'old_chains' and are migrated to the new chains a few at a
+ * time on each insertion. Old chains with index < 'migrated' are empty. */
 struct BtorNodeUniqueTable
 {
   uint32_t size;
   uint32_t num_elements;
   BtorNode **chains;
+  uint32_t old_size;
+  uint32_t migrated;
+  BtorNode **old_chains;
 };
 
 typedef struct BtorNodeUniqueTable BtorNodeUniqueTable;
@@ -95,6 +102,7 @@ struct Btor
 
   BtorNodePtrStack nodes_id_table;
   BtorNodeUniqueTable nodes_unique_table;
+  BtorMemSlab *node_slabs[BTOR_NODE_NUM_SLABS];
   BtorSortUniqueTable sorts_unique_table;
 
   BtorAIGVecMgr *avmgr;
@@ -133,6 +141,7 @@ struct Btor
   uint32_t external_refs;        /* external references (library mode) */
   uint32_t btor_sat_btor_called; /* how often is btor_check_sat been called */
   BtorSolverResult last_sat_result; /* status of last SAT call (SAT/UNSAT) */
+  BtorUnknownReason unknown_reason; /* why last SAT call returned UNKNOWN */
 
   BtorPtrHashTable *varsubst_constraints;
   BtorPtrHashTable *embedded_constraints;
@@ -154,6 +163,8 @@ struct Btor
   BtorIntHashTable *assertions_cache;
   /* saves the number of assertions on each push */
   BtorUIntStack assertions_trail;
+  /* activation variables guarding the assertions of each context level */
+  BtorNodePtrStack assertions_act;
   /* Number of push/pop calls (used for unique symbol prefixes) */
   uint32_t num_push_pop;
 
@@ -171,6 +182,7 @@ struct Btor
 
   BtorMsg *msg;
   BtorRNG rng;
+  BtorBitVectorPool bv_pool; /* scratch bit-vectors */
 
   struct
   {
@@ -191,6 +203,7 @@ struct Btor
     uint32_t ands_normalized;       /* number of and chains normalizations */
     uint32_t muls_normalized;       /* number of mul chains normalizations */
     uint32_t ackermann_constraints;
+    uint_least64_t ackermann_pruned; /* number of pruned ackermann pairs */
     uint_least64_t prop_apply_lambda; /* number of static props over lambdas */
     uint_least64_t prop_apply_update; /* number of static props over updates */
     uint32_t bv_uc_props;
@@ -208,6 +221,7 @@ struct Btor
     BtorPtrHashTable *rw_rules_applied;
 #endif
     uint_least64_t rewrite_synth;
+    uint32_t memory_reductions; /* number of times soft limit was exceeded */
   } stats;
 
   struct
@@ -251,9 +265,13 @@ const char *btor_git_id (const Btor *btor);
 /* Set termination callback. */
 void btor_set_term (Btor *btor, int32_t (*fun) (void *), void *state);
 
-/* Determine if boolector has been terminated via termination callback. */
+/* Determine if boolector has been terminated via termination callback or
+ * the memory limit has been exceeded. */
 int32_t btor_terminate (Btor *btor);
 
+/* Set memory limit (in MB, 0: no limit). */
+void btor_set_memory_limit (Btor *btor, uint32_t limit);
+
 /* Set verbosity message prefix. */
 void btor_set_msg_prefix (Btor *btor, const char *prefix);
 
@@ -272,6 +290,10 @@ void btor_assert_exp (Btor *btor, BtorNode *exp);
 /* Adds assumption. */
 void btor_assume_exp (Btor *btor, BtorNode *exp);
 
+/* Permanently disables all constraints guarded by activation variable 'act'
+ * and releases 'act'. */
+void btor_disable_activation_exp (Btor *btor, BtorNode *act);
+
 /* Determines if expression has been previously assumed. */
 bool btor_is_assumption_exp (Btor *btor, BtorNode *exp);
 
@@ -21,6 +21,16 @@
 /* core                                                                   */
 /*------------------------------------------------------------------------*/
 
+/* Returns the i-th chain of the unique table, where the chains of the old
+ * table (if resizing is in progress) follow the current chains. */
+static BtorNode *
+get_unique_table_chain (const Btor *btor, uint32_t i)
+{
+  const BtorNodeUniqueTable *table = &btor->nodes_unique_table;
+  if (i < table->size) return table->chains[i];
+  return table->old_chains[i - table->size];
+}
+
 bool
 btor_dbg_check_lambdas_static_rho_proxy_free (const Btor *btor)
 {
@@ -54,8 +64,10 @@ btor_dbg_check_unique_table_children_proxy_free (const Btor *btor)
   uint32_t i, j;
   BtorNode *cur;
 
-  for (i = 0; i < btor->nodes_unique_table.size; i++)
-    for (cur = btor->nodes_unique_table.chains[i]; cur; cur = cur->next)
+  for (i = 0; i < btor->nodes_unique_table.size
+                      + btor->nodes_unique_table.old_size;
+       i++)
+    for (cur = get_unique_table_chain (btor, i); cur; cur = cur->next)
       for (j = 0; j < cur->arity; j++)
         if (btor_node_is_proxy (cur->e[j]))
         {
@@ -112,8 +124,10 @@ btor_dbg_check_unique_table_rebuild (const Btor *btor)
   uint32_t i;
   BtorNode *cur;
 
-  for (i = 0; i < btor->nodes_unique_table.size; i++)
-    for (cur = btor->nodes_unique_table.chains[i]; cur; cur = cur->next)
+  for (i = 0; i < btor->nodes_unique_table.size
+                      + btor->nodes_unique_table.old_size;
+       i++)
+    for (cur = get_unique_table_chain (btor, i); cur; cur = cur->next)
     {
       if (cur->rebuild)
       {
@@ -2690,6 +2690,7 @@ btormbt_state_opt (BtorMBT *mbt)
   if (btoropt_engine->forced_by_cl)
   {
     if (btoropt_engine->val == BTOR_ENGINE_AIGPROP
+        || btoropt_engine->val == BTOR_ENGINE_ABS
         || btoropt_engine->val == BTOR_ENGINE_PROP
         || btoropt_engine->val == BTOR_ENGINE_SLS
         || (btoropt_engine->val == BTOR_ENGINE_FUN
@@ -2708,6 +2709,7 @@ btormbt_state_opt (BtorMBT *mbt)
     if (mbt->round.logic == BTORMBT_LOGIC_QF_BV)
     {
       BTOR_PUSH_STACK (stack, BTOR_ENGINE_AIGPROP);
+      BTOR_PUSH_STACK (stack, BTOR_ENGINE_ABS);
       BTOR_PUSH_STACK (stack, BTOR_ENGINE_PROP);
       BTOR_PUSH_STACK (stack, BTOR_ENGINE_SLS);
     }
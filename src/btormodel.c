@@ -56,7 +56,7 @@ btor_model_init_bv (Btor *btor, BtorIntHashTable **bv_model)
 
   if (*bv_model) btor_model_delete_bv (btor, bv_model);
 
-  *bv_model = btor_hashint_map_new (btor->mm);
+  *bv_model = btor_hashint_map_new_tag (btor->mm, BTOR_MEM_TAG_MODEL);
 }
 
 /*------------------------------------------------------------------------*/
@@ -154,9 +154,10 @@ add_to_fun_model (Btor *btor,
     model = btor_hashint_map_get (fun_model, exp->id)->as_ptr;
   else
   {
-    model = btor_hashptr_table_new (btor->mm,
-                                    (BtorHashPtr) btor_bv_hash_tuple,
-                                    (BtorCmpPtr) btor_bv_compare_tuple);
+    model = btor_hashptr_table_new_tag (btor->mm,
+                                        BTOR_MEM_TAG_MODEL,
+                                        (BtorHashPtr) btor_bv_hash_tuple,
+                                        (BtorCmpPtr) btor_bv_compare_tuple);
     btor_node_copy (btor, exp);
     btor_hashint_map_add (fun_model, exp->id)->as_ptr = model;
   }
@@ -395,7 +396,8 @@ recursively_compute_function_model (Btor *btor,
     assert (b);
     default_value = b->data.as_ptr;
 
-    new_model = btor_hashptr_table_new (mm, cur_model->hash, cur_model->cmp);
+    new_model = btor_hashptr_table_new_tag (
+        mm, cur_model->tag, cur_model->hash, cur_model->cmp);
     btor_iter_hashptr_init (&it, cur_model);
     while (btor_iter_hashptr_has_next (&it))
     {
@@ -677,7 +679,7 @@ btor_model_init_fun (Btor *btor, BtorIntHashTable **fun_model)
 
   if (*fun_model) delete_fun_model (btor, fun_model);
 
-  *fun_model = btor_hashint_map_new (btor->mm);
+  *fun_model = btor_hashint_map_new_tag (btor->mm, BTOR_MEM_TAG_MODEL);
 }
 
 /*------------------------------------------------------------------------*/
@@ -804,18 +806,18 @@ btor_model_recursively_compute_assignment (Btor *btor,
 
   mm = btor->mm;
 
-  assigned = btor_hashint_map_new (mm);
+  assigned = btor_hashint_map_new_tag (mm, BTOR_MEM_TAG_MODEL);
 
   /* model cache for parameterized nodes */
-  param_model_cache = btor_hashint_map_new (mm);
+  param_model_cache = btor_hashint_map_new_tag (mm, BTOR_MEM_TAG_MODEL);
 
   /* 'reset_st' remembers the stack position of 'reset' in case a lambda is
    * assigned. when the resp. lambda is unassigned, the 'eval_mark' flag of all
    * parameterized nodes up to the saved position of stack 'reset' will be
    * reset to 0. */
-  reset_st = btor_hashint_map_new (mm);
+  reset_st = btor_hashint_map_new_tag (mm, BTOR_MEM_TAG_MODEL);
 
-  mark = btor_hashint_map_new (mm);
+  mark = btor_hashint_map_new_tag (mm, BTOR_MEM_TAG_MODEL);
   BTOR_INIT_STACK (mm, work_stack);
   BTOR_INIT_STACK (mm, arg_stack);
   BTOR_INIT_STACK (mm, reset);
@@ -36,6 +36,11 @@
   ((table).num_elements >= (table).size \
    && btor_util_log_2 ((table).size) < BTOR_UNIQUE_TABLE_LIMIT)
 
+/* Number of old chains migrated per insertion while resizing. Migration is
+ * complete after old_size / BTOR_UNIQUE_TABLE_MIGRATE insertions, long before
+ * the enlarged table is full again. */
+#define BTOR_UNIQUE_TABLE_MIGRATE 8
+
 /*------------------------------------------------------------------------*/
 
 const char *const g_btor_op2str[BTOR_NUM_OPS_NODE] = {
@@ -414,38 +419,63 @@ hash_binder_exp (Btor *btor,
   return hash;
 }
 
-/* Computes hash value of expresssion by children ids */
+/*------------------------------------------------------------------------*/
+
 static uint32_t
-compute_hash_exp (Btor *btor, BtorNode *exp, uint32_t table_size)
+node_slab_idx (size_t bytes)
 {
-  assert (exp);
-  assert (table_size > 0);
-  assert (btor_util_is_power_of_2 (table_size));
-  assert (btor_node_is_regular (exp));
-  assert (!btor_node_is_bv_var (exp));
-  assert (!btor_node_is_uf (exp));
+  uint32_t res = (bytes + BTOR_NODE_SLAB_ALIGN - 1) / BTOR_NODE_SLAB_ALIGN;
+  assert (res < BTOR_NODE_NUM_SLABS);
+  return res;
+}
 
-  uint32_t hash = 0;
+void *
+btor_node_alloc (Btor *btor, size_t bytes)
+{
+  assert (btor);
+  assert (bytes <= UINT8_MAX);
 
-  if (btor_node_is_bv_const (exp))
-    hash = btor_bv_hash (btor_node_bv_const_get_bits (exp));
-  /* hash for lambdas is computed once during creation. afterwards, we always
-   * have to use the saved hash value since hashing of lambdas requires all
-   * parameterized nodes and their inputs (cf. hash_binder_exp), which may
-   * change at some point. */
-  else if (btor_node_is_lambda (exp))
-    hash = btor_hashptr_table_get (exp->btor->lambdas, (BtorNode *) exp)
-               ->data.as_int;
-  else if (btor_node_is_quantifier (exp))
-    hash = btor_hashptr_table_get (exp->btor->quantifiers, exp)->data.as_int;
-  else if (exp->kind == BTOR_BV_SLICE_NODE)
-    hash = hash_slice_exp (exp->e[0],
-                           btor_node_bv_slice_get_upper (exp),
-                           btor_node_bv_slice_get_lower (exp));
-  else
-    hash = hash_bv_exp (btor, exp->kind, exp->arity, exp->e);
-  hash &= table_size - 1;
-  return hash;
+  uint32_t idx;
+  BtorMemSlab *slab;
+
+  idx  = node_slab_idx (bytes);
+  slab = btor->node_slabs[idx];
+  if (!slab)
+  {
+    slab = btor_mem_slab_new (
+        btor->mm, BTOR_MEM_TAG_NODE, idx * BTOR_NODE_SLAB_ALIGN);
+    btor->node_slabs[idx] = slab;
+  }
+  return btor_mem_slab_alloc (slab);
+}
+
+void
+btor_node_delete_slabs (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i;
+
+  for (i = 0; i < BTOR_NODE_NUM_SLABS; i++)
+  {
+    if (!btor->node_slabs[i]) continue;
+    btor_mem_slab_delete (btor->node_slabs[i]);
+    btor->node_slabs[i] = 0;
+  }
+}
+
+size_t
+btor_node_slabs_bytes (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i;
+  size_t res;
+
+  for (i = 0, res = 0; i < BTOR_NODE_NUM_SLABS; i++)
+    if (btor->node_slabs[i])
+      res += sizeof (BtorMemSlab) + btor->node_slabs[i]->bytes;
+  return res;
 }
 
 /*------------------------------------------------------------------------*/
@@ -477,39 +507,87 @@ setup_node_and_add_to_id_table (Btor *btor, void *ptr)
   if (btor_node_is_apply (exp)) exp->apply_below = 1;
 }
 
-/* Enlarges unique table and rehashes expressions. */
+/* Returns the chain that holds expressions with given hash value. */
+static inline BtorNode **
+get_nodes_unique_table_chain (BtorNodeUniqueTable *table, uint32_t hash)
+{
+  uint32_t i;
+
+  if (table->old_chains)
+  {
+    i = hash & (table->old_size - 1);
+    if (i >= table->migrated) return table->old_chains + i;
+  }
+  return table->chains + (hash & (table->size - 1));
+}
+
+/* Moves at most 'n' old chains to the new chains, using the cached hash
+ * values of the expressions. */
 static void
-enlarge_nodes_unique_table (Btor *btor)
+migrate_nodes_unique_table (Btor *btor, uint32_t n)
 {
   assert (btor);
 
-  BtorMemMgr *mm;
-  uint32_t size, new_size, i;
   uint32_t hash;
-  BtorNode *cur, *temp, **new_chains;
+  BtorNode *cur, *temp;
+  BtorNodeUniqueTable *table;
+
+  table = &btor->nodes_unique_table;
+  assert (table->old_chains);
 
-  mm       = btor->mm;
-  size     = btor->nodes_unique_table.size;
-  new_size = size ? 2 * size : 1;
-  BTOR_CNEWN (mm, new_chains, new_size);
-  for (i = 0; i < size; i++)
+  for (; n > 0 && table->migrated < table->old_size; n--, table->migrated++)
   {
-    cur = btor->nodes_unique_table.chains[i];
+    cur = table->old_chains[table->migrated];
+    table->old_chains[table->migrated] = 0;
     while (cur)
     {
       assert (btor_node_is_regular (cur));
       assert (!btor_node_is_bv_var (cur));
       assert (!btor_node_is_uf (cur));
-      temp             = cur->next;
-      hash             = compute_hash_exp (btor, cur, new_size);
-      cur->next        = new_chains[hash];
-      new_chains[hash] = cur;
-      cur              = temp;
+      temp                = cur->next;
+      hash                = cur->hash & (table->size - 1);
+      cur->next           = table->chains[hash];
+      table->chains[hash] = cur;
+      cur                 = temp;
     }
   }
-  BTOR_DELETEN (mm, btor->nodes_unique_table.chains, size);
-  btor->nodes_unique_table.size   = new_size;
-  btor->nodes_unique_table.chains = new_chains;
+
+  if (table->migrated == table->old_size)
+  {
+    BTOR_DELETEN (btor->mm, table->old_chains, table->old_size);
+    table->old_chains = 0;
+    table->old_size   = 0;
+    table->migrated   = 0;
+  }
+}
+
+/* Enlarges unique table if necessary and migrates some of the old chains.
+ * Returns true if chains have been modified, i.e., a previous lookup has to
+ * be repeated. */
+static bool
+update_nodes_unique_table (Btor *btor)
+{
+  assert (btor);
+
+  BtorNodeUniqueTable *table;
+
+  table = &btor->nodes_unique_table;
+
+  if (BTOR_FULL_UNIQUE_TABLE (*table))
+  {
+    if (table->old_chains) migrate_nodes_unique_table (btor, UINT32_MAX);
+    assert (!table->old_chains);
+    table->old_chains = table->chains;
+    table->old_size   = table->size;
+    table->migrated   = 0;
+    table->size *= 2;
+    BTOR_CNEWN (btor->mm, table->chains, table->size);
+  }
+  else if (!table->old_chains)
+    return false;
+
+  migrate_nodes_unique_table (btor, BTOR_UNIQUE_TABLE_MIGRATE);
+  return true;
 }
 
 static void
@@ -518,17 +596,16 @@ remove_from_nodes_unique_table_exp (Btor *btor, BtorNode *exp)
   assert (exp);
   assert (btor_node_is_regular (exp));
 
-  uint32_t hash;
-  BtorNode *cur, *prev;
+  BtorNode *cur, *prev, **chain;
 
   if (!exp->unique) return;
 
   assert (btor);
   assert (btor->nodes_unique_table.num_elements > 0);
 
-  hash = compute_hash_exp (btor, exp, btor->nodes_unique_table.size);
-  prev = 0;
-  cur  = btor->nodes_unique_table.chains[hash];
+  chain = get_nodes_unique_table_chain (&btor->nodes_unique_table, exp->hash);
+  prev  = 0;
+  cur   = *chain;
 
   while (cur != exp)
   {
@@ -539,7 +616,7 @@ remove_from_nodes_unique_table_exp (Btor *btor, BtorNode *exp)
   }
   assert (cur);
   if (!prev)
-    btor->nodes_unique_table.chains[hash] = cur->next;
+    *chain = cur->next;
   else
     prev->next = cur->next;
 
@@ -880,17 +957,14 @@ really_deallocate_exp (Btor *btor, BtorNode *exp)
   assert (BTOR_PEEK_STACK (btor->nodes_id_table, exp->id) == exp);
   BTOR_POKE_STACK (btor->nodes_id_table, exp->id, 0);
 
-  BtorMemMgr *mm;
-
-  mm = btor->mm;
-
   set_kind (btor, exp, BTOR_INVALID_NODE);
 
   assert (btor_node_get_sort_id (exp));
   btor_sort_release (btor, btor_node_get_sort_id (exp));
   btor_node_set_sort_id (exp, 0);
 
-  btor_mem_free (mm, exp, exp->bytes);
+  assert (btor->node_slabs[node_slab_idx (exp->bytes)]);
+  btor_mem_slab_free (btor->node_slabs[node_slab_idx (exp->bytes)], exp);
 }
 
 static void
@@ -1480,7 +1554,7 @@ sort_bv_exp (Btor *btor, BtorNodeKind kind, BtorNode *e[])
 
 /* Search for constant expression in hash table. Returns 0 if not found. */
 static BtorNode **
-find_const_exp (Btor *btor, BtorBitVector *bits)
+find_const_exp (Btor *btor, BtorBitVector *bits, uint32_t *const_hash)
 {
   assert (btor);
   assert (bits);
@@ -1489,8 +1563,8 @@ find_const_exp (Btor *btor, BtorBitVector *bits)
   uint32_t hash;
 
   hash = btor_bv_hash (bits);
-  hash &= btor->nodes_unique_table.size - 1;
-  result = btor->nodes_unique_table.chains + hash;
+  if (const_hash) *const_hash = hash;
+  result = get_nodes_unique_table_chain (&btor->nodes_unique_table, hash);
   cur    = *result;
   while (cur)
   {
@@ -1510,7 +1584,11 @@ find_const_exp (Btor *btor, BtorBitVector *bits)
 
 /* Search for slice expression in hash table. Returns 0 if not found. */
 static BtorNode **
-find_slice_exp (Btor *btor, BtorNode *e0, uint32_t upper, uint32_t lower)
+find_slice_exp (Btor *btor,
+                BtorNode *e0,
+                uint32_t upper,
+                uint32_t lower,
+                uint32_t *slice_hash)
 {
   assert (btor);
   assert (e0);
@@ -1520,8 +1598,8 @@ find_slice_exp (Btor *btor, BtorNode *e0, uint32_t upper, uint32_t lower)
   uint32_t hash;
 
   hash = hash_slice_exp (e0, upper, lower);
-  hash &= btor->nodes_unique_table.size - 1;
-  result = btor->nodes_unique_table.chains + hash;
+  if (slice_hash) *slice_hash = hash;
+  result = get_nodes_unique_table_chain (&btor->nodes_unique_table, hash);
   cur    = *result;
   while (cur)
   {
@@ -1540,7 +1618,11 @@ find_slice_exp (Btor *btor, BtorNode *e0, uint32_t upper, uint32_t lower)
 }
 
 static BtorNode **
-find_bv_exp (Btor *btor, BtorNodeKind kind, BtorNode *e[], uint32_t arity)
+find_bv_exp (Btor *btor,
+             BtorNodeKind kind,
+             BtorNode *e[],
+             uint32_t arity,
+             uint32_t *bv_hash)
 {
   bool equal;
   uint32_t i;
@@ -1552,9 +1634,9 @@ find_bv_exp (Btor *btor, BtorNodeKind kind, BtorNode *e[], uint32_t arity)
 
   sort_bv_exp (btor, kind, e);
   hash = hash_bv_exp (btor, kind, arity, e);
-  hash &= btor->nodes_unique_table.size - 1;
+  if (bv_hash) *bv_hash = hash;
 
-  result = btor->nodes_unique_table.chains + hash;
+  result = get_nodes_unique_table_chain (&btor->nodes_unique_table, hash);
   cur    = *result;
   while (cur)
   {
@@ -1616,8 +1698,7 @@ find_binder_exp (Btor *btor,
            hash);
 
   if (binder_hash) *binder_hash = hash;
-  hash &= btor->nodes_unique_table.size - 1;
-  result = btor->nodes_unique_table.chains + hash;
+  result = get_nodes_unique_table_chain (&btor->nodes_unique_table, hash);
   cur    = *result;
   while (cur)
   {
@@ -1782,7 +1863,8 @@ compare_binder_exp (Btor *btor,
         result = *find_slice_exp (btor,
                                   e[0],
                                   btor_node_bv_slice_get_upper (real_cur),
-                                  btor_node_bv_slice_get_lower (real_cur));
+                                  btor_node_bv_slice_get_lower (real_cur),
+                                  0);
       }
       else if (btor_node_is_param (real_cur))
       {
@@ -1794,7 +1876,7 @@ compare_binder_exp (Btor *btor,
       else
       {
         assert (!btor_node_is_binder (real_cur));
-        result = *find_bv_exp (btor, real_cur->kind, e, real_cur->arity);
+        result = *find_bv_exp (btor, real_cur->kind, e, real_cur->arity, 0);
       }
 
       if (!result)
@@ -1830,7 +1912,7 @@ find_exp (Btor *btor,
           BtorNodeKind kind,
           BtorNode *e[],
           uint32_t arity,
-          uint32_t *binder_hash,
+          uint32_t *hash,
           BtorIntHashTable *params)
 {
   assert (btor);
@@ -1844,11 +1926,9 @@ find_exp (Btor *btor,
 
   if (kind == BTOR_LAMBDA_NODE || kind == BTOR_FORALL_NODE
       || kind == BTOR_EXISTS_NODE)
-    return find_binder_exp (btor, kind, e[0], e[1], binder_hash, params, 0);
-  else if (binder_hash)
-    *binder_hash = 0;
+    return find_binder_exp (btor, kind, e[0], e[1], hash, params, 0);
 
-  return find_bv_exp (btor, kind, e, arity);
+  return find_bv_exp (btor, kind, e, arity, hash);
 }
 
 /*------------------------------------------------------------------------*/
@@ -1861,7 +1941,7 @@ new_const_exp_node (Btor *btor, BtorBitVector *bits)
 
   BtorBVConstNode *exp;
 
-  BTOR_CNEW (btor->mm, exp);
+  exp = btor_node_alloc (btor, sizeof *exp);
   set_kind (btor, (BtorNode *) exp, BTOR_BV_CONST_NODE);
   exp->bytes = sizeof *exp;
   btor_node_set_sort_id ((BtorNode *) exp,
@@ -1884,7 +1964,7 @@ new_slice_exp_node (Btor *btor, BtorNode *e0, uint32_t upper, uint32_t lower)
 
   BtorBVSliceNode *exp = 0;
 
-  BTOR_CNEW (btor->mm, exp);
+  exp = btor_node_alloc (btor, sizeof *exp);
   set_kind (btor, (BtorNode *) exp, BTOR_BV_SLICE_NODE);
   exp->bytes = sizeof *exp;
   exp->arity = 1;
@@ -1918,7 +1998,7 @@ new_lambda_exp_node (Btor *btor, BtorNode *e_param, BtorNode *e_exp)
 
   BTOR_INIT_STACK (btor->mm, param_sorts);
 
-  BTOR_CNEW (btor->mm, lambda_exp);
+  lambda_exp = btor_node_alloc (btor, sizeof *lambda_exp);
   set_kind (btor, (BtorNode *) lambda_exp, BTOR_LAMBDA_NODE);
   lambda_exp->bytes        = sizeof *lambda_exp;
   lambda_exp->arity        = 2;
@@ -1999,7 +2079,7 @@ new_quantifier_exp_node (Btor *btor,
 
   BtorBinderNode *res;
 
-  BTOR_CNEW (btor->mm, res);
+  res = btor_node_alloc (btor, sizeof *res);
   set_kind (btor, (BtorNode *) res, kind);
   res->bytes            = sizeof *res;
   res->arity            = 2;
@@ -2047,7 +2127,7 @@ new_args_exp_node (Btor *btor, uint32_t arity, BtorNode *e[])
   for (i = 0; i < arity; i++) assert (e[i]);
 #endif
 
-  BTOR_CNEW (btor->mm, exp);
+  exp = btor_node_alloc (btor, sizeof *exp);
   set_kind (btor, (BtorNode *) exp, BTOR_ARGS_NODE);
   exp->bytes = sizeof (*exp);
   exp->arity = arity;
@@ -2106,7 +2186,7 @@ new_node (Btor *btor, BtorNodeKind kind, uint32_t arity, BtorNode *e[])
   }
 #endif
 
-  BTOR_CNEW (btor->mm, exp);
+  exp = btor_node_alloc (btor, sizeof *exp);
   set_kind (btor, (BtorNode *) exp, kind);
   exp->bytes = sizeof (*exp);
   exp->arity = arity;
@@ -2168,7 +2248,7 @@ create_exp (Btor *btor, BtorNodeKind kind, uint32_t arity, BtorNode *e[])
   assert (e);
 
   uint32_t i;
-  uint32_t binder_hash;
+  uint32_t hash;
   BtorNode **lookup, *simp_e[3], *simp;
   BtorIntHashTable *params = 0;
 
@@ -2183,26 +2263,22 @@ create_exp (Btor *btor, BtorNodeKind kind, uint32_t arity, BtorNode *e[])
       || kind == BTOR_FORALL_NODE || kind == BTOR_EXISTS_NODE)
     params = btor_hashint_table_new (btor->mm);
 
-  lookup = find_exp (btor, kind, simp_e, arity, &binder_hash, params);
+  lookup = find_exp (btor, kind, simp_e, arity, &hash, params);
   if (!*lookup)
   {
-    if (BTOR_FULL_UNIQUE_TABLE (btor->nodes_unique_table))
-    {
-      enlarge_nodes_unique_table (btor);
-      lookup = find_exp (btor, kind, simp_e, arity, &binder_hash, 0);
-    }
+    if (update_nodes_unique_table (btor))
+      lookup = find_exp (btor, kind, simp_e, arity, &hash, 0);
 
     switch (kind)
     {
       case BTOR_LAMBDA_NODE:
         assert (arity == 2);
         *lookup = new_lambda_exp_node (btor, simp_e[0], simp_e[1]);
-        btor_hashptr_table_get (btor->lambdas, *lookup)->data.as_int =
-            binder_hash;
+        btor_hashptr_table_get (btor->lambdas, *lookup)->data.as_int = hash;
         BTORLOG (2,
                  "new lambda: %s (hash: %u, param: %u)",
                  btor_util_node2string (*lookup),
-                 binder_hash,
+                 hash,
                  (*lookup)->parameterized);
         break;
       case BTOR_FORALL_NODE:
@@ -2210,7 +2286,7 @@ create_exp (Btor *btor, BtorNodeKind kind, uint32_t arity, BtorNode *e[])
         assert (arity == 2);
         *lookup = new_quantifier_exp_node (btor, kind, e[0], e[1]);
         btor_hashptr_table_get (btor->quantifiers, *lookup)->data.as_int =
-            binder_hash;
+            hash;
         break;
       case BTOR_ARGS_NODE:
         *lookup = new_args_exp_node (btor, arity, simp_e);
@@ -2234,6 +2310,7 @@ create_exp (Btor *btor, BtorNodeKind kind, uint32_t arity, BtorNode *e[])
     assert (btor->nodes_unique_table.num_elements < INT32_MAX);
     btor->nodes_unique_table.num_elements++;
     (*lookup)->unique = 1;
+    (*lookup)->hash   = hash;
   }
   else
   {
@@ -2260,6 +2337,7 @@ btor_node_create_bv_const (Btor *btor, const BtorBitVector *bits)
   assert (bits);
 
   bool inv;
+  uint32_t hash;
   BtorBitVector *lookupbits;
   BtorNode **lookup;
 
@@ -2275,18 +2353,16 @@ btor_node_create_bv_const (Btor *btor, const BtorBitVector *bits)
     inv        = false;
   }
 
-  lookup = find_const_exp (btor, lookupbits);
+  lookup = find_const_exp (btor, lookupbits, &hash);
   if (!*lookup)
   {
-    if (BTOR_FULL_UNIQUE_TABLE (btor->nodes_unique_table))
-    {
-      enlarge_nodes_unique_table (btor);
-      lookup = find_const_exp (btor, lookupbits);
-    }
+    if (update_nodes_unique_table (btor))
+      lookup = find_const_exp (btor, lookupbits, 0);
     *lookup = new_const_exp_node (btor, lookupbits);
     assert (btor->nodes_unique_table.num_elements < INT32_MAX);
     btor->nodes_unique_table.num_elements += 1;
     (*lookup)->unique = 1;
+    (*lookup)->hash   = hash;
   }
   else
     inc_exp_ref_counter (btor, *lookup);
@@ -2309,7 +2385,7 @@ btor_node_create_var (Btor *btor, BtorSortId sort, const char *symbol)
 
   BtorBVVarNode *exp;
 
-  BTOR_CNEW (btor->mm, exp);
+  exp = btor_node_alloc (btor, sizeof *exp);
   set_kind (btor, (BtorNode *) exp, BTOR_VAR_NODE);
   exp->bytes = sizeof *exp;
   setup_node_and_add_to_id_table (btor, exp);
@@ -2332,7 +2408,7 @@ btor_node_create_uf (Btor *btor, BtorSortId sort, const char *symbol)
   assert (btor_sort_is_bv (btor, btor_sort_fun_get_codomain (btor, sort))
           || btor_sort_is_bool (btor, btor_sort_fun_get_codomain (btor, sort)));
 
-  BTOR_CNEW (btor->mm, exp);
+  exp = btor_node_alloc (btor, sizeof *exp);
   set_kind (btor, (BtorNode *) exp, BTOR_UF_NODE);
   exp->bytes = sizeof (*exp);
   btor_node_set_sort_id ((BtorNode *) exp, btor_sort_copy (btor, sort));
@@ -2352,7 +2428,7 @@ btor_node_create_param (Btor *btor, BtorSortId sort, const char *symbol)
 
   BtorParamNode *exp;
 
-  BTOR_CNEW (btor->mm, exp);
+  exp = btor_node_alloc (btor, sizeof *exp);
   set_kind (btor, (BtorNode *) exp, BTOR_PARAM_NODE);
   exp->bytes         = sizeof *exp;
   exp->parameterized = 1;
@@ -2370,6 +2446,7 @@ unary_exp_slice_exp (Btor *btor, BtorNode *exp, uint32_t upper, uint32_t lower)
   assert (btor == btor_node_real_addr (exp)->btor);
 
   bool inv;
+  uint32_t hash;
   BtorNode **lookup;
 
   exp = btor_simplify_exp (btor, exp);
@@ -2387,18 +2464,16 @@ unary_exp_slice_exp (Btor *btor, BtorNode *exp, uint32_t upper, uint32_t lower)
   else
     inv = false;
 
-  lookup = find_slice_exp (btor, exp, upper, lower);
+  lookup = find_slice_exp (btor, exp, upper, lower, &hash);
   if (!*lookup)
   {
-    if (BTOR_FULL_UNIQUE_TABLE (btor->nodes_unique_table))
-    {
-      enlarge_nodes_unique_table (btor);
-      lookup = find_slice_exp (btor, exp, upper, lower);
-    }
+    if (update_nodes_unique_table (btor))
+      lookup = find_slice_exp (btor, exp, upper, lower, 0);
     *lookup = new_slice_exp_node (btor, exp, upper, lower);
     assert (btor->nodes_unique_table.num_elements < INT32_MAX);
     btor->nodes_unique_table.num_elements++;
     (*lookup)->unique = 1;
+    (*lookup)->hash   = hash;
   }
   else
     inc_exp_ref_counter (btor, *lookup);
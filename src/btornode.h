@@ -97,6 +97,7 @@ extern const char *const g_btor_op2str[BTOR_NUM_OPS_NODE];
     uint32_t ext_refs;            /* external references counter */        \
     uint32_t parents;             /* number of parents */                  \
     BtorSortId sort_id;           /* sort id */                            \
+    uint32_t hash;                /* hash value in unique table */         \
     union                                                                  \
     {                                                                      \
       BtorAIGVec *av;        /* synthesized AIG vector */                  \
@@ -580,6 +581,23 @@ btor_node_get_tag (const BtorNode *exp)
 
 /*========================================================================*/
 
+/* Node memory is allocated from per-size-class slabs, indexed by the node
+ * size rounded up to a multiple of BTOR_NODE_SLAB_ALIGN (see
+ * Btor::node_slabs). */
+#define BTOR_NODE_SLAB_ALIGN 8
+#define BTOR_NODE_NUM_SLABS (UINT8_MAX / BTOR_NODE_SLAB_ALIGN + 2)
+
+/* Allocate zero-initialized memory for a node of size 'bytes'. */
+void *btor_node_alloc (Btor *btor, size_t bytes);
+
+/* Release all node slabs (and thus all node memory) of 'btor'. */
+void btor_node_delete_slabs (Btor *btor);
+
+/* Get the number of bytes allocated for node slabs. */
+size_t btor_node_slabs_bytes (Btor *btor);
+
+/*------------------------------------------------------------------------*/
+
 /* Copies expression (increments reference counter). */
 BtorNode *btor_node_copy (Btor *btor, BtorNode *exp);
 
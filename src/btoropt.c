@@ -300,6 +300,11 @@ btor_opt_init_opts (Btor *btor)
                 "quant",
                 BTOR_ENGINE_QUANT,
                 "use the quantifier engine (BV only)");
+  add_opt_help (mm,
+                opts,
+                "abs",
+                BTOR_ENGINE_ABS,
+                "use the abstraction refinement engine (QF_BV only)");
   btor->options[BTOR_OPT_ENGINE].options = opts;
 
   init_opt (btor,
@@ -340,6 +345,16 @@ btor_opt_init_opts (Btor *btor)
                 BTOR_SAT_ENGINE_PICOSAT,
                 "use picosat as back end SAT solver");
   btor->options[BTOR_OPT_SAT_ENGINE].options = opts;
+  init_opt (btor,
+            BTOR_OPT_SAT_ENGINE_PORTFOLIO,
+            false,
+            true,
+            "sat-engine-portfolio",
+            0,
+            0,
+            0,
+            1,
+            "race all configured SAT solvers on separate threads");
 
   init_opt (btor,
             BTOR_OPT_AUTO_CLEANUP,
@@ -413,6 +428,27 @@ btor_opt_init_opts (Btor *btor)
             0,
             3,
             "rewrite level");
+  init_opt (btor,
+            BTOR_OPT_RW_CACHE_SIZE,
+            false,
+            false,
+            "rw-cache-size",
+            0,
+            64,
+            0,
+            1u << 16,
+            "memory budget of the rewrite cache in MB");
+  init_opt (btor,
+            BTOR_OPT_MEMORY_LIMIT,
+            false,
+            false,
+            "memory-limit",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "memory limit in MB (0: no limit, SAT solver memory only counted "
+            "for Lingeling and PicoSAT)");
   init_opt (btor,
             BTOR_OPT_SKELETON_PREPROC,
             false,
@@ -433,6 +469,16 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "add ackermann constraints");
+  init_opt (btor,
+            BTOR_OPT_ACKERMANN_PRUNE,
+            false,
+            true,
+            "ackermannize-prune",
+            0,
+            1,
+            0,
+            1,
+            "prune ackermann constraints for provably distinct arguments");
   init_opt (btor,
             BTOR_OPT_BETA_REDUCE,
             false,
@@ -515,6 +561,101 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "normalize addition operators");
+  init_opt (btor,
+            BTOR_OPT_AIG_REWRITE,
+            false,
+            true,
+            "aig-rewrite",
+            0,
+            0,
+            0,
+            1,
+            "rewrite AIGs before CNF encoding");
+  init_opt (btor,
+            BTOR_OPT_AIG_CNF_PG,
+            false,
+            true,
+            "aig-cnf-pg",
+            0,
+            0,
+            0,
+            1,
+            "polarity-aware (Plaisted-Greenbaum) CNF encoding");
+  init_opt (btor,
+            BTOR_OPT_AIG_CNF_NARY,
+            false,
+            true,
+            "aig-cnf-nary",
+            0,
+            0,
+            0,
+            1,
+            "encode trees of AND gates as n-ary AND gates");
+  init_opt (btor,
+            BTOR_OPT_SYNTH_THREADS,
+            false,
+            false,
+            "synth-threads",
+            0,
+            0,
+            0,
+            64,
+            "number of threads for bit-blasting independent constraints");
+  init_opt (btor,
+            BTOR_OPT_MUL_ENC,
+            false,
+            false,
+            "mul-enc",
+            0,
+            BTOR_MUL_ENC_DFLT,
+            BTOR_MUL_ENC_MIN,
+            BTOR_MUL_ENC_MAX,
+            "encoding of multiplications");
+  opts = btor_hashptr_table_new (
+      btor->mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmpoptval);
+  add_opt_help (
+      mm, opts, "array", BTOR_MUL_ENC_ARRAY, "shift-and-add array multiplier");
+  add_opt_help (mm,
+                opts,
+                "booth",
+                BTOR_MUL_ENC_BOOTH,
+                "radix-4 Booth multiplier with Dadda tree");
+  add_opt_help (
+      mm, opts, "wallace", BTOR_MUL_ENC_WALLACE, "Wallace tree multiplier");
+  add_opt_help (mm, opts, "dadda", BTOR_MUL_ENC_DADDA, "Dadda tree multiplier");
+  btor->options[BTOR_OPT_MUL_ENC].options = opts;
+
+  init_opt (btor,
+            BTOR_OPT_MUL_CSD,
+            false,
+            true,
+            "mul-csd",
+            0,
+            0,
+            0,
+            1,
+            "canonical signed digit encoding of constant multiplications");
+  init_opt (btor,
+            BTOR_OPT_DIV_ENC,
+            false,
+            false,
+            "div-enc",
+            0,
+            BTOR_DIV_ENC_DFLT,
+            BTOR_DIV_ENC_MIN,
+            BTOR_DIV_ENC_MAX,
+            "encoding of unsigned divisions and remainders");
+  opts = btor_hashptr_table_new (
+      btor->mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmpoptval);
+  add_opt_help (
+      mm, opts, "restoring", BTOR_DIV_ENC_RESTORING, "restoring array divider");
+  add_opt_help (mm,
+                opts,
+                "nonrestoring",
+                BTOR_DIV_ENC_NONRESTORING,
+                "non-restoring array divider");
+  btor->options[BTOR_OPT_DIV_ENC].options = opts;
+
   init_opt (btor,
             BTOR_OPT_NORMALIZE,
             false,
@@ -666,6 +807,27 @@ btor_opt_init_opts (Btor *btor)
                 "generate lemmas for all conflicts");
   btor->options[BTOR_OPT_FUN_EAGER_LEMMAS].options  = opts;
 
+  init_opt (btor,
+            BTOR_OPT_FUN_LEMMA_REUSE,
+            false,
+            false,
+            "fun-lemma-reuse",
+            0,
+            10000,
+            0,
+            UINT32_MAX,
+            "maximum number of assumed lemmas kept for re-use");
+  init_opt (btor,
+            BTOR_OPT_FUN_WEAKEQ,
+            false,
+            true,
+            "fun-weakeq",
+            0,
+            0,
+            0,
+            1,
+            "check array equalities via weak equivalences");
+
   init_opt (btor,
             BTOR_OPT_FUN_STORE_LAMBDAS,
             false,
@@ -1130,6 +1292,28 @@ btor_opt_init_opts (Btor *btor)
             1,
             "use bandit scheme for constraint selection");
 
+  /* ABS engine ----------------------------------------------------------- */
+  init_opt (btor,
+            BTOR_OPT_ABS_MIN_WIDTH,
+            false,
+            false,
+            "abs-min-width",
+            0,
+            16,
+            1,
+            UINT32_MAX,
+            "minimum bit-width of abstracted mul, udiv and urem nodes");
+  init_opt (btor,
+            BTOR_OPT_ABS_LEMMAS,
+            false,
+            false,
+            "abs-lemmas",
+            0,
+            2,
+            0,
+            UINT32_MAX,
+            "number of lemmas per abstracted node before bit-blasting it");
+
   /* QUANT engine ----------------------------------------------------------- */
   init_opt (btor,
             BTOR_OPT_QUANT_DER,
@@ -1672,6 +1856,24 @@ btor_opt_set (Btor *btor, const BtorOption opt, uint32_t val)
               "to clone/fork Lingeling");
   }
 #endif
+#ifndef BTOR_HAVE_PTHREADS
+  else if (opt == BTOR_OPT_SAT_ENGINE_PORTFOLIO)
+  {
+    val = oldval;
+    BTOR_MSG (btor->msg,
+              1,
+              "pthreads not available, will not set option to enable SAT "
+              "solver portfolio");
+  }
+  else if (opt == BTOR_OPT_SYNTH_THREADS)
+  {
+    val = oldval;
+    BTOR_MSG (btor->msg,
+              1,
+              "pthreads not available, will not set option to bit-blast "
+              "on multiple threads");
+  }
+#endif
 #ifndef NDEBUG
   else if (opt == BTOR_OPT_INCREMENTAL)
   {
@@ -1701,6 +1903,18 @@ btor_opt_set (Btor *btor, const BtorOption opt, uint32_t val)
   if (val > o->max) val = o->max;
   if (val < o->min) val = o->min;
   o->val = val;
+
+  /* apply new memory budget of the rewrite cache */
+  if (opt == BTOR_OPT_RW_CACHE_SIZE && val != oldval && btor->rw_cache)
+  {
+    btor_rw_cache_reset (btor->rw_cache);
+  }
+
+  /* apply new memory limit */
+  if (opt == BTOR_OPT_MEMORY_LIMIT && val != oldval)
+  {
+    btor_set_memory_limit (btor, val);
+  }
 }
 
 void
@@ -78,7 +78,7 @@ typedef struct BtorOptHelp BtorOptHelp;
 extern const char *const g_btor_se_name[BTOR_SAT_ENGINE_MAX + 1];
 
 #define BTOR_ENGINE_MIN BTOR_ENGINE_FUN
-#define BTOR_ENGINE_MAX BTOR_ENGINE_QUANT
+#define BTOR_ENGINE_MAX BTOR_ENGINE_ABS
 #define BTOR_ENGINE_DFLT BTOR_ENGINE_FUN
 
 #define BTOR_INPUT_FORMAT_MIN BTOR_INPUT_FORMAT_NONE
@@ -125,6 +125,14 @@ extern const char *const g_btor_se_name[BTOR_SAT_ENGINE_MAX + 1];
 #define BTOR_BETA_REDUCE_MAX BTOR_BETA_REDUCE_ALL
 #define BTOR_BETA_REDUCE_DFLT BTOR_BETA_REDUCE_NONE
 
+#define BTOR_MUL_ENC_MIN BTOR_MUL_ENC_ARRAY
+#define BTOR_MUL_ENC_MAX BTOR_MUL_ENC_DADDA
+#define BTOR_MUL_ENC_DFLT BTOR_MUL_ENC_ARRAY
+
+#define BTOR_DIV_ENC_MIN BTOR_DIV_ENC_RESTORING
+#define BTOR_DIV_ENC_MAX BTOR_DIV_ENC_NONRESTORING
+#define BTOR_DIV_ENC_DFLT BTOR_DIV_ENC_RESTORING
+
 /*------------------------------------------------------------------------*/
 
 void btor_opt_init_opts (Btor *btor);
@@ -198,10 +198,7 @@ select_path_ult (Btor *btor,
   assert (bve);
 
   int32_t eidx;
-  BtorBitVector *bvmax;
-  BtorMemMgr *mm;
 
-  mm   = btor->mm;
   eidx = select_path_non_const (ult);
 
   if (eidx == -1)
@@ -209,15 +206,13 @@ select_path_ult (Btor *btor,
     if (btor_opt_get (btor, BTOR_OPT_PROP_PATH_SEL)
         == BTOR_PROP_PATH_SEL_ESSENTIAL)
     {
-      bvmax = btor_bv_ones (mm, btor_bv_get_width (bve[0]));
       if (btor_bv_is_one (bvult))
       {
         /* 1...1 < bve[1] */
-        if (!btor_bv_compare (bve[0], bvmax)) eidx = 0;
+        if (btor_bv_is_ones (bve[0])) eidx = 0;
         /* bve[0] < 0 */
         if (btor_bv_is_zero (bve[1])) eidx = eidx == -1 ? 1 : -1;
       }
-      btor_bv_free (mm, bvmax);
     }
     if (eidx == -1) eidx = select_path_random (btor, ult);
   }
@@ -225,6 +220,7 @@ select_path_ult (Btor *btor,
   assert (eidx >= 0);
 #ifndef NBTORLOG
   char *a;
+  BtorMemMgr *mm = btor->mm;
   BTORLOG (2, "");
   BTORLOG (2, "select path: %s", btor_util_node2string (ult));
   a = btor_bv_to_char (mm, bve[0]);
@@ -520,8 +516,8 @@ select_path_udiv (Btor *btor,
   assert (bvudiv);
   assert (bve);
 
-  int32_t eidx, cmp_udiv_max;
-  BtorBitVector *bvmax, *up, *lo, *tmp;
+  int32_t eidx;
+  BtorBitVector *up, *lo, *tmp;
   BtorMemMgr *mm;
 
   mm   = btor->mm;
@@ -532,42 +528,38 @@ select_path_udiv (Btor *btor,
     if (btor_opt_get (btor, BTOR_OPT_PROP_PATH_SEL)
         == BTOR_PROP_PATH_SEL_ESSENTIAL)
     {
-      bvmax        = btor_bv_ones (mm, btor_bv_get_width (bve[0]));
-      cmp_udiv_max = btor_bv_compare (bvudiv, bvmax);
-
       /* bve[0] / bve[1] = 1...1 -> choose e[1]
        *   + 1...1 / 0 = 1...1
        *   + 1...1 / 1 = 1...1
        *   + x...x / 0 = 1...1 */
-      if (!cmp_udiv_max)
+      if (btor_bv_is_ones (bvudiv))
         eidx = 1;
       else
       {
         /* 1...1 / e[0] = 0 -> choose e[0] */
-        if (btor_bv_is_zero (bvudiv) && !btor_bv_compare (bve[0], bvmax))
+        if (btor_bv_is_zero (bvudiv) && btor_bv_is_ones (bve[0]))
           eidx = 0;
         /* bve[0] < bvudiv -> choose e[0] */
         else if (btor_bv_compare (bve[0], bvudiv) < 0)
           eidx = 0;
         else
         {
+          lo = btor_bv_pool_get (&btor->bv_pool, btor_bv_get_width (bvudiv));
+          btor_bv_inc_into (lo, bvudiv);
           up  = btor_bv_udiv (mm, bve[0], bvudiv);
-          lo  = btor_bv_inc (mm, bvudiv);
           tmp = btor_bv_udiv (mm, bve[0], lo);
-          btor_bv_free (mm, lo);
-          lo = btor_bv_inc (mm, tmp);
+          btor_bv_inc_into (lo, tmp);
 
           if (btor_bv_compare (lo, up) > 0) eidx = 0;
           btor_bv_free (mm, up);
-          btor_bv_free (mm, lo);
           btor_bv_free (mm, tmp);
+          btor_bv_pool_put (&btor->bv_pool, lo);
         }
 
         /* e[0] / 0 != 1...1 -> choose e[1] */
         if (btor_bv_is_zero (bve[1]) || btor_bv_is_umulo (mm, bve[1], bvudiv))
           eidx = eidx == -1 ? 1 : -1;
       }
-      btor_bv_free (mm, bvmax);
     }
     if (eidx == -1) eidx = select_path_random (btor, udiv);
   }
@@ -601,10 +593,9 @@ select_path_urem (Btor *btor,
   assert (bve);
 
   int32_t eidx;
-  BtorBitVector *bvmax, *sub, *tmp;
-  BtorMemMgr *mm;
+  uint32_t bw;
+  BtorBitVector *sub, *tmp;
 
-  mm   = btor->mm;
   eidx = select_path_non_const (urem);
 
   if (eidx == -1)
@@ -612,15 +603,17 @@ select_path_urem (Btor *btor,
     if (btor_opt_get (btor, BTOR_OPT_PROP_PATH_SEL)
         == BTOR_PROP_PATH_SEL_ESSENTIAL)
     {
-      bvmax = btor_bv_ones (mm, btor_bv_get_width (bve[0]));
-      sub   = btor_bv_sub (mm, bve[0], bvurem);
-      tmp   = btor_bv_dec (mm, bve[0]);
+      bw  = btor_bv_get_width (bve[0]);
+      sub = btor_bv_pool_get (&btor->bv_pool, bw);
+      tmp = btor_bv_pool_get (&btor->bv_pool, bw);
+      btor_bv_sub_into (sub, bve[0], bvurem);
+      btor_bv_dec_into (tmp, bve[0]);
 
       /* bvurem = 1...1 -> bve[0] = 1...1 and bve[1] = 0...0 */
-      if (!btor_bv_compare (bvurem, bvmax))
+      if (btor_bv_is_ones (bvurem))
       {
         if (!btor_bv_is_zero (bve[1])) eidx = 1;
-        if (btor_bv_compare (bve[0], bvmax)) eidx = eidx == -1 ? 0 : -1;
+        if (!btor_bv_is_ones (bve[0])) eidx = eidx == -1 ? 0 : -1;
       }
       /* bvurem > 0 and bve[1] = 1 */
       else if (!btor_bv_is_zero (bvurem) && btor_bv_is_one (bve[1]))
@@ -644,9 +637,8 @@ select_path_urem (Btor *btor,
         eidx = 0;
       }
 
-      btor_bv_free (mm, tmp);
-      btor_bv_free (mm, bvmax);
-      btor_bv_free (mm, sub);
+      btor_bv_pool_put (&btor->bv_pool, tmp);
+      btor_bv_pool_put (&btor->bv_pool, sub);
     }
 
     if (eidx == -1) eidx = select_path_random (btor, urem);
@@ -655,6 +647,7 @@ select_path_urem (Btor *btor,
   assert (eidx >= 0);
 #ifndef NBTORLOG
   char *a;
+  BtorMemMgr *mm = btor->mm;
   BTORLOG (2, "");
   BTORLOG (2, "select path: %s", btor_util_node2string (urem));
   a = btor_bv_to_char (mm, bve[0]);
@@ -1033,7 +1026,7 @@ cons_ult_bv (Btor *btor,
 
   bool isult;
   uint32_t bw;
-  BtorBitVector *bvmax, *zero, *tmp, *res;
+  BtorBitVector *lo, *up, *res;
   BtorMemMgr *mm;
 
   (void) ult;
@@ -1049,31 +1042,34 @@ cons_ult_bv (Btor *btor,
   mm    = btor->mm;
   bw    = btor_bv_get_width (bve);
   isult = !btor_bv_is_zero (bvult);
-  zero  = btor_bv_new (mm, bw);
-  bvmax = btor_bv_ones (mm, bw);
 
   if (eidx && isult)
   {
     /* bve < res = 1  ->  res > 0 */
-    tmp = btor_bv_one (mm, bw);
-    res = btor_bv_new_random_range (mm, &btor->rng, bw, tmp, bvmax);
-    btor_bv_free (mm, tmp);
+    lo = btor_bv_pool_get (&btor->bv_pool, bw);
+    up = btor_bv_pool_get (&btor->bv_pool, bw);
+    btor_bv_one_into (lo);
+    btor_bv_ones_into (up);
+    res = btor_bv_new_random_range (mm, &btor->rng, bw, lo, up);
+    btor_bv_pool_put (&btor->bv_pool, lo);
+    btor_bv_pool_put (&btor->bv_pool, up);
   }
   else if (!eidx && isult)
   {
     /* res < bve = 1  ->  0 <= res < 1...1 */
-    tmp = btor_bv_dec (mm, bvmax);
-    res = btor_bv_new_random_range (mm, &btor->rng, bw, zero, tmp);
-    btor_bv_free (mm, tmp);
+    lo = btor_bv_pool_get (&btor->bv_pool, bw);
+    up = btor_bv_pool_get (&btor->bv_pool, bw);
+    btor_bv_ones_into (up);
+    btor_bv_dec_into (up, up);
+    res = btor_bv_new_random_range (mm, &btor->rng, bw, lo, up);
+    btor_bv_pool_put (&btor->bv_pool, lo);
+    btor_bv_pool_put (&btor->bv_pool, up);
   }
   else
   {
     res = btor_bv_new_random (mm, &btor->rng, bw);
   }
 
-  btor_bv_free (mm, bvmax);
-  btor_bv_free (mm, zero);
-
   return res;
 }
 
@@ -1207,7 +1203,7 @@ cons_mul_bv (Btor *btor,
   assert (!btor_node_is_bv_const (mul->e[eidx]));
 
   uint32_t r, bw, ctz_res, ctz_bvmul;
-  BtorBitVector *res, *tmp;
+  BtorBitVector *res;
   BtorMemMgr *mm;
 
   (void) mul;
@@ -1251,21 +1247,11 @@ cons_mul_bv (Btor *btor,
         btor_bv_set_bit (
             res, btor_rng_pick_rand (&btor->rng, 0, ctz_bvmul - 1), 1);
       }
-      /* choose res as bvmul / 2^n with prob 0.1
-       * (note: bw not necessarily power of 2 -> do not use srl) */
+      /* choose res as bvmul / 2^n with prob 0.1 */
       else if (btor_rng_pick_with_prob (&btor->rng, 100))
       {
-        btor_bv_free (mm, res);
-        if ((r = btor_rng_pick_rand (&btor->rng, 0, ctz_bvmul)))
-        {
-          tmp = btor_bv_slice (mm, bvmul, bw - 1, r);
-          res = btor_bv_uext (mm, tmp, r);
-          btor_bv_free (mm, tmp);
-        }
-        else
-        {
-          res = btor_bv_copy (mm, bvmul);
-        }
+        r = btor_rng_pick_rand (&btor->rng, 0, ctz_bvmul);
+        btor_bv_srl_uint64_into (res, bvmul, r);
       }
       /* choose random value with ctz(bvmul) >= ctz(res) with prob 0.8 */
       else
@@ -1298,14 +1284,16 @@ cons_udiv_bv (Btor *btor,
   assert (!btor_node_is_bv_const (udiv->e[eidx]));
 
   uint32_t bw;
-  BtorBitVector *res, *tmp, *tmpbve, *zero, *one, *bvmax;
+  BtorBitVector *res, *tmp, *tmpbve, *one, *bvmax;
   BtorMemMgr *mm;
 
   mm    = btor->mm;
   bw    = btor_bv_get_width (bvudiv);
-  zero  = btor_bv_new (mm, bw);
-  one   = btor_bv_one (mm, bw);
-  bvmax = btor_bv_ones (mm, bw);
+  one   = btor_bv_pool_get (&btor->bv_pool, bw);
+  bvmax = btor_bv_pool_get (&btor->bv_pool, bw);
+  tmp   = btor_bv_pool_get (&btor->bv_pool, bw);
+  btor_bv_one_into (one);
+  btor_bv_ones_into (bvmax);
 
   (void) udiv;
   (void) bve;
@@ -1322,7 +1310,7 @@ cons_udiv_bv (Btor *btor,
   {
     /* -> bvudiv = 1...1 then res = 0 or res = 1
      * -> else choose res s.t. res * bvudiv does not overflow */
-    if (!btor_bv_compare (bvudiv, bvmax))
+    if (btor_bv_is_ones (bvudiv))
       res =
           btor_bv_uint64_to_bv (mm, btor_rng_pick_rand (&btor->rng, 0, 1), bw);
     else
@@ -1330,10 +1318,9 @@ cons_udiv_bv (Btor *btor,
       res = btor_bv_new_random_range (mm, &btor->rng, bw, one, bvmax);
       while (btor_bv_is_umulo (mm, res, bvudiv))
       {
-        tmp = btor_bv_sub (mm, res, one);
+        btor_bv_dec_into (tmp, res);
         btor_bv_free (mm, res);
         res = btor_bv_new_random_range (mm, &btor->rng, bw, one, tmp);
-        btor_bv_free (mm, tmp);
       }
     }
   }
@@ -1344,11 +1331,11 @@ cons_udiv_bv (Btor *btor,
      * -> else choose tmpbve s.t. res = tmpbve * bvudiv does not overflow */
     if (btor_bv_is_zero (bvudiv))
     {
-      tmp = btor_bv_dec (mm, bvmax);
-      res = btor_bv_new_random_range (mm, &btor->rng, bw, zero, tmp);
-      btor_bv_free (mm, tmp);
+      /* tmp = 0, bvmax = 1...10 */
+      btor_bv_dec_into (bvmax, bvmax);
+      res = btor_bv_new_random_range (mm, &btor->rng, bw, tmp, bvmax);
     }
-    else if (!btor_bv_compare (bvudiv, bvmax))
+    else if (btor_bv_is_ones (bvudiv))
     {
       res = btor_bv_new_random (mm, &btor->rng, bw);
     }
@@ -1357,19 +1344,18 @@ cons_udiv_bv (Btor *btor,
       tmpbve = btor_bv_new_random_range (mm, &btor->rng, bw, one, bvmax);
       while (btor_bv_is_umulo (mm, tmpbve, bvudiv))
       {
-        tmp = btor_bv_sub (mm, tmpbve, one);
+        btor_bv_dec_into (tmp, tmpbve);
         btor_bv_free (mm, tmpbve);
         tmpbve = btor_bv_new_random_range (mm, &btor->rng, bw, one, tmp);
-        btor_bv_free (mm, tmp);
       }
       res = btor_bv_mul (mm, tmpbve, bvudiv);
       btor_bv_free (mm, tmpbve);
     }
   }
 
-  btor_bv_free (mm, one);
-  btor_bv_free (mm, zero);
-  btor_bv_free (mm, bvmax);
+  btor_bv_pool_put (&btor->bv_pool, one);
+  btor_bv_pool_put (&btor->bv_pool, bvmax);
+  btor_bv_pool_put (&btor->bv_pool, tmp);
   return res;
 }
 
@@ -1403,40 +1389,34 @@ cons_urem_bv (Btor *btor,
 #endif
     BTOR_PROP_SOLVER (btor)->stats.props_cons += 1;
   }
-  mm    = btor->mm;
-  bw    = btor_bv_get_width (bvurem);
-  bvmax = btor_bv_ones (mm, bw);
+  mm = btor->mm;
+  bw = btor_bv_get_width (bvurem);
 
-  if (eidx)
+  /* bvurem = 1...1  ->  res = 0 (eidx = 1) or res = 1...1 (eidx = 0) */
+  if (btor_bv_is_ones (bvurem))
   {
-    /* bvurem = 1...1  ->  res = 0 */
-    if (!btor_bv_compare (bvurem, bvmax))
-    {
-      res = btor_bv_new (mm, bw);
-    }
-    /* else res > bvurem */
-    else
-    {
-      tmp = btor_bv_inc (mm, bvurem);
-      res = btor_bv_new_random_range (mm, &btor->rng, bw, tmp, bvmax);
-      btor_bv_free (mm, tmp);
-    }
+    res = eidx ? btor_bv_new (mm, bw) : btor_bv_copy (mm, bvurem);
   }
   else
   {
-    /* bvurem = 1...1  ->  res = 1...1 */
-    if (!btor_bv_compare (bvurem, bvmax))
+    bvmax = btor_bv_pool_get (&btor->bv_pool, bw);
+    btor_bv_ones_into (bvmax);
+    /* res > bvurem */
+    if (eidx)
     {
-      res = btor_bv_copy (mm, bvmax);
+      tmp = btor_bv_pool_get (&btor->bv_pool, bw);
+      btor_bv_inc_into (tmp, bvurem);
+      res = btor_bv_new_random_range (mm, &btor->rng, bw, tmp, bvmax);
+      btor_bv_pool_put (&btor->bv_pool, tmp);
     }
-    /* else res >= bvurem */
+    /* res >= bvurem */
     else
     {
       res = btor_bv_new_random_range (mm, &btor->rng, bw, bvurem, bvmax);
     }
+    btor_bv_pool_put (&btor->bv_pool, bvmax);
   }
 
-  btor_bv_free (mm, bvmax);
   return res;
 }
 
@@ -1925,7 +1905,7 @@ inv_ult_bv (Btor *btor,
   bool isult;
   uint32_t bw;
   BtorNode *e;
-  BtorBitVector *res, *zero, *one, *bvmax, *tmp;
+  BtorBitVector *res, *zero, *bvmax, *tmp;
   BtorMemMgr *mm;
 #ifndef NDEBUG
   bool is_inv = true;
@@ -1944,16 +1924,17 @@ inv_ult_bv (Btor *btor,
   assert (e);
 
   bw    = btor_bv_get_width (bve);
-  zero  = btor_bv_new (mm, bw);
-  one   = btor_bv_one (mm, bw);
-  bvmax = btor_bv_ones (mm, bw);
+  zero  = btor_bv_pool_get (&btor->bv_pool, bw);
+  bvmax = btor_bv_pool_get (&btor->bv_pool, bw);
+  tmp   = btor_bv_pool_get (&btor->bv_pool, bw);
+  btor_bv_ones_into (bvmax);
   isult = !btor_bv_is_zero (bvult);
 
   res = 0;
 
   if (eidx)
   {
-    if (!btor_bv_compare (bve, bvmax) && isult)
+    if (btor_bv_is_ones (bve) && isult)
     {
     BVULT_CONF:
       /* CONFLICT: 1...1 < e[1] --------------------------------------------- */
@@ -1972,9 +1953,8 @@ inv_ult_bv (Btor *btor,
       else
       {
         /* bve < e[1] ------------------------------------------------------- */
-        tmp = btor_bv_add (mm, bve, one);
+        btor_bv_inc_into (tmp, bve);
         res = btor_bv_new_random_range (mm, &btor->rng, bw, tmp, bvmax);
-        btor_bv_free (mm, tmp);
       }
     }
   }
@@ -1995,9 +1975,8 @@ inv_ult_bv (Btor *btor,
       else
       {
         /* e[0] < bve ------------------------------------------------------- */
-        tmp = btor_bv_sub (mm, bve, one);
+        btor_bv_dec_into (tmp, bve);
         res = btor_bv_new_random_range (mm, &btor->rng, bw, zero, tmp);
-        btor_bv_free (mm, tmp);
       }
     }
   }
@@ -2007,9 +1986,9 @@ inv_ult_bv (Btor *btor,
     check_result_binary_dbg (
         btor, btor_bv_ult, ult, bve, bvult, res, eidx, "<");
 #endif
-  btor_bv_free (mm, zero);
-  btor_bv_free (mm, one);
-  btor_bv_free (mm, bvmax);
+  btor_bv_pool_put (&btor->bv_pool, zero);
+  btor_bv_pool_put (&btor->bv_pool, bvmax);
+  btor_bv_pool_put (&btor->bv_pool, tmp);
   return res;
 }
 
@@ -2452,15 +2431,12 @@ inv_mul_bv (Btor *btor,
         else
         {
           /* res = bvmul >> n with all bits shifted in set randomly
-           * (note: bw is not necessarily power of 2 -> do not use srl)
            * ---------------------------------------------------------------- */
-          tmp = btor_bv_slice (mm, bvmul, bw - 1, ispow2_bve);
-          res = btor_bv_uext (mm, tmp, ispow2_bve);
+          res = btor_bv_srl_uint64 (mm, bvmul, ispow2_bve);
           assert (btor_bv_get_width (res) == bw);
           for (i = 0; i < (uint32_t) ispow2_bve; i++)
             btor_bv_set_bit (
                 res, bw - 1 - i, btor_rng_pick_rand (&btor->rng, 0, 1));
-          btor_bv_free (mm, tmp);
         }
       }
       else
@@ -2477,28 +2453,21 @@ inv_mul_bv (Btor *btor,
         else
         {
           /* c' = bvmul >> n (with all bits shifted in set randomly)
-           * (note: bw is not necessarily power of 2 -> do not use srl)
            * -> res = c' * m^-1 (with m^-1 the mod inverse of m, m odd)
            * ---------------------------------------------------------------- */
-          tmp = btor_bv_slice (mm, bvmul, bw - 1, j);
-          res = btor_bv_uext (mm, tmp, j);
-          assert (btor_bv_get_width (res) == bw);
-          btor_bv_free (mm, tmp);
-
-          tmp  = btor_bv_slice (mm, bve, bw - 1, j);
-          tmp2 = btor_bv_uext (mm, tmp, j);
-          assert (btor_bv_get_width (tmp2) == bw);
+          tmp  = btor_bv_pool_get (&btor->bv_pool, bw);
+          tmp2 = btor_bv_pool_get (&btor->bv_pool, bw);
+          btor_bv_srl_uint64_into (tmp, bvmul, j);
+          btor_bv_srl_uint64_into (tmp2, bve, j);
           assert (btor_bv_get_bit (tmp2, 0));
           inv = btor_bv_mod_inverse (mm, tmp2);
-          btor_bv_free (mm, tmp);
-          btor_bv_free (mm, tmp2);
-          tmp = res;
           res = btor_bv_mul (mm, tmp, inv);
           /* choose one of all possible values */
           for (i = 0; i < j; i++)
             btor_bv_set_bit (
                 res, bw - 1 - i, btor_rng_pick_rand (&btor->rng, 0, 1));
-          btor_bv_free (mm, tmp);
+          btor_bv_pool_put (&btor->bv_pool, tmp);
+          btor_bv_pool_put (&btor->bv_pool, tmp2);
           btor_bv_free (mm, inv);
         }
       }
@@ -2538,7 +2507,7 @@ inv_udiv_bv (Btor *btor,
 
   uint32_t bw;
   BtorNode *e;
-  BtorBitVector *res, *lo, *up, *one, *bvmax, *tmp;
+  BtorBitVector *res, *lo, *up, *one, *bvmax, *tmp, *rem;
   BtorMemMgr *mm;
   BtorRNG *rng;
 #ifndef NDEBUG
@@ -2559,8 +2528,11 @@ inv_udiv_bv (Btor *btor,
   assert (e);
   bw = btor_bv_get_width (bve);
 
-  one   = btor_bv_one (mm, bw);
-  bvmax = btor_bv_ones (mm, bw); /* 2^bw - 1 */
+  one   = btor_bv_pool_get (&btor->bv_pool, bw);
+  bvmax = btor_bv_pool_get (&btor->bv_pool, bw);
+  tmp   = btor_bv_pool_get (&btor->bv_pool, bw);
+  btor_bv_one_into (one);
+  btor_bv_ones_into (bvmax); /* 2^bw - 1 */
 
   res = 0;
 
@@ -2606,9 +2578,8 @@ inv_udiv_bv (Btor *btor,
       else if (btor_bv_compare (bve, bvmax))
       {
         /* bvudiv = 0 and 0 < bve < 2^bw - 1 -> choose random e[1] > bve ---- */
-        tmp = btor_bv_inc (mm, bve);
+        btor_bv_inc_into (tmp, bve);
         res = btor_bv_new_random_range (mm, rng, bw, tmp, bvmax);
-        btor_bv_free (mm, tmp);
       }
       else
       {
@@ -2631,10 +2602,10 @@ inv_udiv_bv (Btor *btor,
       /* if bvudiv is a divisor of bve, choose e[1] = bve / bvudiv
        * with prob = 0.5 and a bve s.t. bve / e[1] = bvudiv otherwise
        * -------------------------------------------------------------------- */
-      tmp = btor_bv_urem (mm, bve, bvudiv);
-      if (btor_bv_is_zero (tmp) && btor_rng_pick_with_prob (rng, 500))
+      rem = btor_bv_urem (mm, bve, bvudiv);
+      if (btor_bv_is_zero (rem) && btor_rng_pick_with_prob (rng, 500))
       {
-        btor_bv_free (mm, tmp);
+        btor_bv_free (mm, rem);
         res = btor_bv_udiv (mm, bve, bvudiv);
       }
       else
@@ -2647,14 +2618,11 @@ inv_udiv_bv (Btor *btor,
          * up = bve / bvudiv
          * lo = bve / (bvudiv + 1) + 1
          * if lo > up -> conflict */
-        btor_bv_free (mm, tmp);
-        up  = btor_bv_udiv (mm, bve, bvudiv); /* upper bound */
-        tmp = btor_bv_inc (mm, bvudiv);
-        lo  = btor_bv_udiv (mm, bve, tmp); /* lower bound (excl.) */
-        btor_bv_free (mm, tmp);
-        tmp = lo;
-        lo  = btor_bv_inc (mm, tmp); /* lower bound (incl.) */
-        btor_bv_free (mm, tmp);
+        btor_bv_free (mm, rem);
+        up = btor_bv_udiv (mm, bve, bvudiv); /* upper bound */
+        btor_bv_inc_into (tmp, bvudiv);
+        lo = btor_bv_udiv (mm, bve, tmp); /* lower bound (excl.) */
+        btor_bv_inc_into (lo, lo);        /* lower bound (incl.) */
 
         if (btor_bv_compare (lo, up) > 0)
         {
@@ -2737,33 +2705,32 @@ inv_udiv_bv (Btor *btor,
            *      if bve * (bvudiv + 1) does not overflow
            *      else 2^bw - 1
            * lo = bve * bvudiv */
-          lo  = btor_bv_mul (mm, bve, bvudiv);
-          tmp = btor_bv_inc (mm, bvudiv);
+          lo = btor_bv_pool_get (&btor->bv_pool, bw);
+          up = btor_bv_pool_get (&btor->bv_pool, bw);
+          btor_bv_mul_into (lo, bve, bvudiv);
+          btor_bv_inc_into (tmp, bvudiv);
           if (btor_bv_is_umulo (mm, bve, tmp))
           {
-            btor_bv_free (mm, tmp);
-            up = btor_bv_copy (mm, bvmax);
+            btor_bv_copy_into (up, bvmax);
           }
           else
           {
-            up = btor_bv_mul (mm, bve, tmp);
-            btor_bv_free (mm, tmp);
-            tmp = btor_bv_dec (mm, up);
-            btor_bv_free (mm, up);
-            up = tmp;
+            btor_bv_mul_into (up, bve, tmp);
+            btor_bv_dec_into (up, up);
           }
 
           res = btor_bv_new_random_range (mm, &btor->rng, bw, lo, up);
 
-          btor_bv_free (mm, up);
-          btor_bv_free (mm, lo);
+          btor_bv_pool_put (&btor->bv_pool, up);
+          btor_bv_pool_put (&btor->bv_pool, lo);
         }
       }
     }
   }
 
-  btor_bv_free (mm, bvmax);
-  btor_bv_free (mm, one);
+  btor_bv_pool_put (&btor->bv_pool, bvmax);
+  btor_bv_pool_put (&btor->bv_pool, one);
+  btor_bv_pool_put (&btor->bv_pool, tmp);
 #ifndef NDEBUG
   if (is_inv)
     check_result_binary_dbg (
@@ -2818,8 +2785,10 @@ inv_urem_bv (Btor *btor,
 
   bw = btor_bv_get_width (bvurem);
 
-  bvmax = btor_bv_ones (mm, bw); /* 2^bw - 1 */
-  one   = btor_bv_one (mm, bw);
+  bvmax = btor_bv_pool_get (&btor->bv_pool, bw);
+  one   = btor_bv_pool_get (&btor->bv_pool, bw);
+  btor_bv_ones_into (bvmax); /* 2^bw - 1 */
+  btor_bv_one_into (one);
 
   res = 0;
 
@@ -3097,8 +3066,8 @@ inv_urem_bv (Btor *btor,
     }
   }
 
-  btor_bv_free (mm, one);
-  btor_bv_free (mm, bvmax);
+  btor_bv_pool_put (&btor->bv_pool, one);
+  btor_bv_pool_put (&btor->bv_pool, bvmax);
 
 #ifndef NDEBUG
   if (is_inv)
@@ -3500,7 +3469,7 @@ btor_proputils_select_move_prop (Btor *btor,
   int32_t i, nconst;
   uint64_t nprops;
   BtorNode *cur, *real_cur;
-  BtorBitVector *bve[3], *bvcur, *bvenew, *tmp;
+  BtorBitVector *bve[3], *bvcur, *bvenew;
   int32_t (*select_path) (
       Btor *, BtorNode *, BtorBitVector *, BtorBitVector **);
   BtorBitVector *(*compute_value) (
@@ -3537,12 +3506,7 @@ btor_proputils_select_move_prop (Btor *btor,
       nprops += 1;
       assert (!btor_node_is_bv_const (cur));
 
-      if (btor_node_is_inverted (cur))
-      {
-        tmp   = bvcur;
-        bvcur = btor_bv_not (btor->mm, tmp);
-        btor_bv_free (btor->mm, tmp);
-      }
+      if (btor_node_is_inverted (cur)) btor_bv_not_into (bvcur, bvcur);
 
       /* check if all paths are const, if yes -> conflict */
       for (i = 0, nconst = 0; i < real_cur->arity; i++)
@@ -9,32 +9,26 @@
 #include "btorrwcache.h"
 #include "btorcore.h"
 
+/* Initial number of sets, the cache is allocated on the first insertion. */
+#define BTOR_RW_CACHE_INIT_SETS 64
+/* Upper limit for the number of sets, independent of the budget. */
+#define BTOR_RW_CACHE_MAX_SETS (1u << 28)
+
 static uint32_t hash_primes[] = {
     333444569u, 76891121u, 456790003u, 2654435761u};
 
-static int32_t
-compare_rw_cache_tuple (const BtorRwCacheTuple *t0, const BtorRwCacheTuple *t1)
-{
-  assert (t0);
-  assert (t1);
-
-  if (t0->kind == t1->kind && t0->n[0] == t1->n[0] && t0->n[1] == t1->n[1]
-      && t0->n[2] == t1->n[2])
-  {
-    return 0;
-  }
-  return 1;
-}
-
 static uint32_t
-hash_rw_cache_tuple (const BtorRwCacheTuple *t)
+hash_rw_cache_tuple (BtorNodeKind kind,
+                     int32_t nid0,
+                     int32_t nid1,
+                     int32_t nid2)
 {
   uint32_t hash;
-  hash = hash_primes[0] * (uint32_t) t->kind;
-  hash += hash_primes[1] * (uint32_t) t->n[0];
-  hash += hash_primes[2] * (uint32_t) t->n[1];
-  hash += hash_primes[3] * (uint32_t) t->n[2];
-  return hash;
+  hash = hash_primes[0] * (uint32_t) kind;
+  hash += hash_primes[1] * (uint32_t) nid0;
+  hash += hash_primes[2] * (uint32_t) nid1;
+  hash += hash_primes[3] * (uint32_t) nid2;
+  return hash ^ (hash >> 16);
 }
 
 static bool
@@ -48,6 +42,91 @@ is_valid_node (Btor *btor, int32_t id)
   return true;
 }
 
+static inline BtorRwCacheTuple *
+get_set (const BtorRwCache *rwc,
+         BtorNodeKind kind,
+         int32_t nid0,
+         int32_t nid1,
+         int32_t nid2)
+{
+  uint32_t h = hash_rw_cache_tuple (kind, nid0, nid1, nid2);
+  return rwc->cache + (size_t) (h & (rwc->num_sets - 1)) * BTOR_RW_CACHE_WAYS;
+}
+
+/* Insert 't' as most recently used entry of 'set', the least recently used
+ * entry is dropped if the set is full. */
+static inline void
+insert_front (BtorRwCacheTuple *set, const BtorRwCacheTuple *t)
+{
+  memmove (set + 1, set, (BTOR_RW_CACHE_WAYS - 1) * sizeof (*set));
+  set[0] = *t;
+}
+
+/* Find cache entry and mark it as most recently used. */
+static BtorRwCacheTuple *
+find (BtorRwCache *rwc,
+      BtorNodeKind kind,
+      int32_t nid0,
+      int32_t nid1,
+      int32_t nid2)
+{
+  uint32_t i;
+  BtorRwCacheTuple *set, t;
+
+  if (!rwc->num_sets) return 0;
+
+  set = get_set (rwc, kind, nid0, nid1, nid2);
+  for (i = 0; i < BTOR_RW_CACHE_WAYS && set[i].result; i++)
+  {
+    if (set[i].kind == kind && set[i].n[0] == nid0 && set[i].n[1] == nid1
+        && set[i].n[2] == nid2)
+    {
+      if (i > 0)
+      {
+        t = set[i];
+        memmove (set + 1, set, i * sizeof (*set));
+        set[0] = t;
+      }
+      return set;
+    }
+  }
+  return 0;
+}
+
+/* Double the number of sets.  Every new set receives the entries of exactly
+ * one old set, hence no entries are evicted. */
+static void
+enlarge (BtorRwCache *rwc)
+{
+  uint32_t i, j, old_num_sets;
+  BtorRwCacheTuple *old_cache, *t;
+
+  old_num_sets = rwc->num_sets;
+  old_cache    = rwc->cache;
+
+  rwc->num_sets = old_num_sets ? 2 * old_num_sets : BTOR_RW_CACHE_INIT_SETS;
+  if (rwc->num_sets > rwc->max_sets) rwc->num_sets = rwc->max_sets;
+  BTOR_CNEWN_TAG (rwc->btor->mm,
+                  BTOR_MEM_TAG_RWCACHE,
+                  rwc->cache,
+                  (size_t) rwc->num_sets * BTOR_RW_CACHE_WAYS);
+
+  for (i = 0; i < old_num_sets; i++)
+  {
+    /* insert from least to most recently used to preserve order */
+    for (j = BTOR_RW_CACHE_WAYS; j-- > 0;)
+    {
+      t = old_cache + (size_t) i * BTOR_RW_CACHE_WAYS + j;
+      if (!t->result) continue;
+      insert_front (get_set (rwc, t->kind, t->n[0], t->n[1], t->n[2]), t);
+    }
+  }
+  BTOR_DELETEN_TAG (rwc->btor->mm,
+                    BTOR_MEM_TAG_RWCACHE,
+                    old_cache,
+                    (size_t) old_num_sets * BTOR_RW_CACHE_WAYS);
+}
+
 int32_t
 btor_rw_cache_get (BtorRwCache *rwc,
                    BtorNodeKind kind,
@@ -65,13 +144,13 @@ btor_rw_cache_get (BtorRwCache *rwc,
   }
 #endif
 
-  BtorRwCacheTuple t   = {.kind = kind, .n = {nid0, nid1, nid2}};
-  BtorPtrHashBucket *b = btor_hashptr_table_get (rwc->cache, &t);
-  if (b)
+  BtorRwCacheTuple *cached = find (rwc, kind, nid0, nid1, nid2);
+  if (cached)
   {
-    BtorRwCacheTuple *cached = b->key;
+    rwc->num_hit++;
     return cached->result;
   }
+  rwc->num_miss++;
   return 0;
 }
 
@@ -105,34 +184,49 @@ btor_rw_cache_add (BtorRwCache *rwc,
     return;
   }
 
-  int32_t cached_result_id;
-  if ((cached_result_id = btor_rw_cache_get (rwc, kind, nid0, nid1, nid2)))
+  /* caching disabled */
+  if (!rwc->max_sets) return;
+
+  BtorRwCacheTuple *cached, *set;
+  if ((cached = find (rwc, kind, nid0, nid1, nid2)))
   {
-    /* This can only happen if the node corresponding to cached_result_id does
+    /* This can only happen if the node corresponding to cached->result does
      * not exist anymore (= deallocated). */
-    if (cached_result_id != result)
+    if (cached->result != result)
     {
-      assert (btor_node_get_by_id (rwc->btor, cached_result_id) == 0);
-      BtorRwCacheTuple t   = {.kind = kind, .n = {nid0, nid1, nid2}};
-      BtorPtrHashBucket *b = btor_hashptr_table_get (rwc->cache, &t);
-      assert (b);
-      BtorRwCacheTuple *cached = b->key;
-      cached->result           = result;  // Update the result
+      assert (btor_node_get_by_id (rwc->btor, cached->result) == 0);
+      cached->result = result;  // Update the result
       rwc->num_update++;
     }
     return;
   }
 
-  BtorRwCacheTuple *t;
-  BTOR_CNEW (rwc->btor->mm, t);
-  t->kind   = kind;
-  t->n[0]   = nid0;
-  t->n[1]   = nid1;
-  t->n[2]   = nid2;
-  t->result = result;
-  rwc->num_add++;
+  if (!rwc->num_sets) enlarge (rwc);
+  set = get_set (rwc, kind, nid0, nid1, nid2);
 
-  btor_hashptr_table_add (rwc->cache, t);
+  /* Set is full, grow cache once while within budget (entries colliding in
+   * a set may share more low hash bits, growing until they are spread over
+   * several sets could exhaust the budget on a few entries), and evict the
+   * least recently used entry of the set if it is still full. */
+  if (set[BTOR_RW_CACHE_WAYS - 1].result)
+  {
+    if (rwc->num_sets < rwc->max_sets)
+    {
+      enlarge (rwc);
+      set = get_set (rwc, kind, nid0, nid1, nid2);
+    }
+    if (set[BTOR_RW_CACHE_WAYS - 1].result)
+    {
+      rwc->num_evict++;
+      rwc->count--;
+    }
+  }
+
+  BtorRwCacheTuple t = {
+      .kind = kind, .n = {nid0, nid1, nid2}, .result = result};
+  insert_front (set, &t);
+  rwc->count++;
+  rwc->num_add++;
 
   if (rwc->num_add % 100000 == 0)
   {
@@ -144,31 +238,68 @@ void
 btor_rw_cache_init (BtorRwCache *rwc, Btor *btor)
 {
   assert (rwc);
-  rwc->btor       = btor;
-  rwc->cache      = btor_hashptr_table_new (btor->mm,
-                                       (BtorHashPtr) hash_rw_cache_tuple,
-                                       (BtorCmpPtr) compare_rw_cache_tuple);
+
+  size_t budget;
+
+  rwc->btor     = btor;
+  rwc->cache    = 0;
+  rwc->num_sets = 0;
+  rwc->count    = 0;
+
+  budget = (size_t) btor_opt_get (btor, BTOR_OPT_RW_CACHE_SIZE) << 20;
+  budget /= BTOR_RW_CACHE_WAYS * sizeof (BtorRwCacheTuple);
+  if (budget > BTOR_RW_CACHE_MAX_SETS) budget = BTOR_RW_CACHE_MAX_SETS;
+  /* round down to power of 2 */
+  rwc->max_sets = budget ? 1 : 0;
+  while (rwc->max_sets && 2 * (size_t) rwc->max_sets <= budget)
+    rwc->max_sets *= 2;
+
   rwc->num_add    = 0;
   rwc->num_get    = 0;
   rwc->num_update = 0;
   rwc->num_remove = 0;
+  rwc->num_hit    = 0;
+  rwc->num_miss   = 0;
+  rwc->num_evict  = 0;
 }
 
 void
 btor_rw_cache_delete (BtorRwCache *rwc)
 {
   assert (rwc);
+  BTOR_DELETEN_TAG (rwc->btor->mm,
+                    BTOR_MEM_TAG_RWCACHE,
+                    rwc->cache,
+                    (size_t) rwc->num_sets * BTOR_RW_CACHE_WAYS);
+  rwc->cache    = 0;
+  rwc->num_sets = 0;
+  rwc->count    = 0;
+}
 
-  BtorPtrHashTableIterator it;
-  BtorRwCacheTuple *t;
+void
+btor_rw_cache_clone (Btor *clone, BtorRwCache *res, const BtorRwCache *rwc)
+{
+  assert (clone);
+  assert (res);
+  assert (rwc);
 
-  btor_iter_hashptr_init (&it, rwc->cache);
-  while (btor_iter_hashptr_has_next (&it))
+  size_t n = (size_t) rwc->num_sets * BTOR_RW_CACHE_WAYS;
+
+  *res      = *rwc;
+  res->btor = clone;
+  if (n)
   {
-    t = btor_iter_hashptr_next (&it);
-    BTOR_DELETE (rwc->btor->mm, t);
+    BTOR_NEWN_TAG (clone->mm, BTOR_MEM_TAG_RWCACHE, res->cache, n);
+    memcpy (res->cache, rwc->cache, n * sizeof (*res->cache));
   }
-  btor_hashptr_table_delete (rwc->cache);
+}
+
+size_t
+btor_rw_cache_bytes (const BtorRwCache *rwc)
+{
+  assert (rwc);
+  return (size_t) rwc->num_sets * BTOR_RW_CACHE_WAYS
+         * sizeof (BtorRwCacheTuple);
 }
 
 void
@@ -176,64 +307,80 @@ btor_rw_cache_reset (BtorRwCache *rwc)
 {
   assert (rwc);
   assert (rwc->btor->mm);
-  assert (rwc->cache);
 
+  uint64_t num_add, num_get, num_update, num_remove, num_hit, num_miss;
+  uint64_t num_evict;
   Btor *btor = rwc->btor;
+
+  num_add    = rwc->num_add;
+  num_get    = rwc->num_get;
+  num_update = rwc->num_update;
+  num_remove = rwc->num_remove;
+  num_hit    = rwc->num_hit;
+  num_miss   = rwc->num_miss;
+  num_evict  = rwc->num_evict;
   btor_rw_cache_delete (rwc);
   btor_rw_cache_init (rwc, btor);
+  rwc->num_add    = num_add;
+  rwc->num_get    = num_get;
+  rwc->num_update = num_update;
+  rwc->num_remove = num_remove;
+  rwc->num_hit    = num_hit;
+  rwc->num_miss   = num_miss;
+  rwc->num_evict  = num_evict;
 }
 
 void
 btor_rw_cache_gc (BtorRwCache *rwc)
 {
   assert (rwc->btor->mm);
-  assert (rwc->cache);
 
   bool remove;
-  BtorPtrHashTableIterator it;
-  BtorRwCacheTuple *t;
+  uint32_t i, j, k;
+  BtorRwCacheTuple *set, *t;
   BtorNodeKind kind;
 
-  Btor *btor            = rwc->btor;
-  BtorPtrHashTable *old = rwc->cache;
-
-  rwc->cache = btor_hashptr_table_new (btor->mm, old->hash, old->cmp);
+  Btor *btor = rwc->btor;
 
   /* We remove all cache entries that store invalid children node ids. An
    * invalid node is either a node that does not exist anymore (deallocated) or
    * if the node id belongs to a proxy node. Proxy nodes are never used to
    * query the cache and are therefore useless cache entries. */
-  btor_iter_hashptr_init (&it, old);
-  while (btor_iter_hashptr_has_next (&it))
+  for (i = 0; i < rwc->num_sets; i++)
   {
-    t = btor_iter_hashptr_next (&it);
-    kind = t->kind;
+    set = rwc->cache + (size_t) i * BTOR_RW_CACHE_WAYS;
+    for (j = k = 0; j < BTOR_RW_CACHE_WAYS && set[j].result; j++)
+    {
+      t    = set + j;
+      kind = t->kind;
 
-    remove = !is_valid_node (btor, t->n[0]);
+      remove = !is_valid_node (btor, t->n[0]);
 
-    if (!remove && kind != BTOR_BV_SLICE_NODE)
-    {
-      if (t->n[1])
+      if (!remove && kind != BTOR_BV_SLICE_NODE)
+      {
+        if (t->n[1])
+        {
+          remove = remove || !is_valid_node (btor, t->n[1]);
+        }
+        if (!remove && t->n[2])
+        {
+          remove = remove || !is_valid_node (btor, t->n[2]);
+        }
+
+        remove = remove || !btor_node_get_by_id (btor, t->result);
+      }
+
+      if (remove)
       {
-        remove = remove || !is_valid_node (btor, t->n[1]);
+        rwc->count--;
+        rwc->num_remove++;
       }
-      if (!remove && t->n[2])
+      else
       {
-        remove = remove || !is_valid_node (btor, t->n[2]);
+        /* keep order of remaining entries */
+        set[k++] = *t;
       }
-
-      remove = remove || !btor_node_get_by_id (btor, t->result);
-    }
-
-    if (remove)
-    {
-      BTOR_DELETE (btor->mm, t);
-      rwc->num_remove++;
-    }
-    else
-    {
-      btor_hashptr_table_add (rwc->cache, t);
     }
+    for (; k < j; k++) BTOR_CLR (set + k);
   }
-  btor_hashptr_table_delete (old);
 }
@@ -10,7 +10,6 @@
 #define BTORRWCACHE_H_INCLUDED
 
 #include "btornode.h"
-#include "utils/btorhashptr.h"
 
 /* Cache entry that stores the result of rewriting a node with kind 'kind' and
  * it's children 'n'.
@@ -25,16 +24,29 @@ struct BtorRwCacheTuple
 
 typedef struct BtorRwCacheTuple BtorRwCacheTuple;
 
-/* Stores all cache entries and some statistics. Note that the statistics are
- * not reset if btor_rw_cache_reset() or btor_rw_cache_gc() is called. */
+/* Number of entries per set. */
+#define BTOR_RW_CACHE_WAYS 4
+
+/* Set-associative cache of inline tuples.  The entries of a set are ordered
+ * from most to least recently used, unused entries (result 0) are at the end
+ * of a set.  The number of sets grows up to the memory budget given by
+ * BTOR_OPT_RW_CACHE_SIZE, beyond that the least recently used entry of a set
+ * is evicted.  Note that the statistics are not reset if
+ * btor_rw_cache_reset() or btor_rw_cache_gc() is called. */
 struct BtorRwCache
 {
   Btor *btor;
-  BtorPtrHashTable *cache;  /* Hash table of BtorRwCacheTuple. */
-  uint64_t num_add;         /* Number of cached rewrite rules. */
-  uint64_t num_get;         /* Number of cache checks. */
-  uint64_t num_update;      /* Number of updated cache entries. */
-  uint64_t num_remove;      /* Number of removed cache entries (GC). */
+  BtorRwCacheTuple *cache; /* num_sets * BTOR_RW_CACHE_WAYS entries */
+  uint32_t num_sets;       /* Number of sets (power of 2). */
+  uint32_t max_sets;       /* Maximum number of sets within budget. */
+  uint32_t count;          /* Number of used entries. */
+  uint64_t num_add;        /* Number of cached rewrite rules. */
+  uint64_t num_get;        /* Number of cache hits with a valid result. */
+  uint64_t num_update;     /* Number of updated cache entries. */
+  uint64_t num_remove;     /* Number of removed cache entries (GC). */
+  uint64_t num_hit;        /* Number of successful cache lookups. */
+  uint64_t num_miss;       /* Number of failed cache lookups. */
+  uint64_t num_evict;      /* Number of evicted cache entries. */
 };
 
 typedef struct BtorRwCache BtorRwCache;
@@ -60,6 +72,14 @@ void btor_rw_cache_init (BtorRwCache *cache, Btor *mm);
 /* Delete the rewrite cache. */
 void btor_rw_cache_delete (BtorRwCache *cache);
 
+/* Initialize 'cache' of 'clone' as a copy of rewrite cache 'rwc'. */
+void btor_rw_cache_clone (Btor *clone,
+                          BtorRwCache *cache,
+                          const BtorRwCache *rwc);
+
+/* Get the number of bytes allocated for the cache entries. */
+size_t btor_rw_cache_bytes (const BtorRwCache *cache);
+
 /* Reset the rewrite cache. */
 void btor_rw_cache_reset (BtorRwCache *cache);
 
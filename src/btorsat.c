@@ -23,6 +23,10 @@
 #include "sat/btorpicosat.h"
 #include "utils/btorutil.h"
 
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
 /*------------------------------------------------------------------------*/
 
 #if !defined(BTOR_USE_LINGELING) && !defined(BTOR_USE_PICOSAT)  \
@@ -32,6 +36,9 @@
 #endif
 
 static bool enable_dimacs_printer (BtorSATMgr *smgr);
+#ifdef BTOR_HAVE_PTHREADS
+static bool enable_portfolio (BtorSATMgr *smgr);
+#endif
 
 /*------------------------------------------------------------------------*/
 /* wrapper functions for SAT solver API                                   */
@@ -112,6 +119,12 @@ melt (BtorSATMgr *smgr, int32_t lit)
   // TODO: else case warning?
 }
 
+static inline void
+phase (BtorSATMgr *smgr, int32_t lit)
+{
+  if (smgr->api.phase) smgr->api.phase (smgr, lit);
+}
+
 static inline int32_t
 repr (BtorSATMgr *smgr, int32_t lit)
 {
@@ -287,33 +300,46 @@ btor_sat_set_output (BtorSATMgr *smgr, FILE *output)
   btor_mem_free (smgr->btor->mm, prefix, strlen (smgr->name) + 4);
 }
 
-void
-btor_sat_enable_solver (BtorSATMgr *smgr)
+static bool
+enable_engine (BtorSATMgr *smgr, uint32_t engine)
 {
-  assert (smgr);
-
-  uint32_t opt;
-
-  opt = btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE);
-  switch (opt)
+  switch (engine)
   {
 #ifdef BTOR_USE_LINGELING
-    case BTOR_SAT_ENGINE_LINGELING: btor_sat_enable_lingeling (smgr); break;
+    case BTOR_SAT_ENGINE_LINGELING: return btor_sat_enable_lingeling (smgr);
 #endif
 #ifdef BTOR_USE_PICOSAT
-    case BTOR_SAT_ENGINE_PICOSAT: btor_sat_enable_picosat (smgr); break;
+    case BTOR_SAT_ENGINE_PICOSAT: return btor_sat_enable_picosat (smgr);
 #endif
 #ifdef BTOR_USE_MINISAT
-    case BTOR_SAT_ENGINE_MINISAT: btor_sat_enable_minisat (smgr); break;
+    case BTOR_SAT_ENGINE_MINISAT: return btor_sat_enable_minisat (smgr);
 #endif
 #ifdef BTOR_USE_CADICAL
-    case BTOR_SAT_ENGINE_CADICAL: btor_sat_enable_cadical (smgr); break;
+    case BTOR_SAT_ENGINE_CADICAL: return btor_sat_enable_cadical (smgr);
 #endif
 #ifdef BTOR_USE_CMS
-    case BTOR_SAT_ENGINE_CMS: btor_sat_enable_cms (smgr); break;
+    case BTOR_SAT_ENGINE_CMS: return btor_sat_enable_cms (smgr);
 #endif
-    default: BTOR_ABORT (1, "no sat solver configured");
+    default: return false;
+  }
+}
+
+void
+btor_sat_enable_solver (BtorSATMgr *smgr)
+{
+  assert (smgr);
+
+  uint32_t opt;
+
+  opt = btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE);
+  BTOR_ABORT (!enable_engine (smgr, opt), "no sat solver configured");
+
+#ifdef BTOR_HAVE_PTHREADS
+  if (btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE_PORTFOLIO))
+  {
+    enable_portfolio (smgr);
   }
+#endif
 
   BTOR_MSG (smgr->btor->msg,
             1,
@@ -476,6 +502,16 @@ btor_sat_failed (BtorSATMgr *smgr, int32_t lit)
   return failed (smgr, lit);
 }
 
+void
+btor_sat_phase (BtorSATMgr *smgr, int32_t lit)
+{
+  assert (smgr != NULL);
+  assert (smgr->initialized);
+  assert (lit);
+  assert (abs (lit) <= smgr->maxvar);
+  phase (smgr, lit);
+}
+
 /*------------------------------------------------------------------------*/
 /* DIMACS printer                                                         */
 /*------------------------------------------------------------------------*/
@@ -697,6 +733,13 @@ dimacs_printer_melt (BtorSATMgr *smgr, int32_t lit)
   melt (wrapped_smgr, lit);
 }
 
+static void
+dimacs_printer_phase (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCnfPrinter *printer = (BtorCnfPrinter *) smgr->solver;
+  phase (printer->smgr, lit);
+}
+
 /*------------------------------------------------------------------------*/
 
 /* The DIMACS printer is a SAT manager that wraps the currently configured SAT
@@ -728,6 +771,7 @@ enable_dimacs_printer (BtorSATMgr *smgr)
   smgr->api.inc_max_var      = dimacs_printer_inc_max_var;
   smgr->api.init             = dimacs_printer_init;
   smgr->api.melt             = dimacs_printer_melt;
+  smgr->api.phase            = dimacs_printer_phase;
   smgr->api.repr             = dimacs_printer_repr;
   smgr->api.reset            = dimacs_printer_reset;
   smgr->api.sat              = dimacs_printer_sat;
@@ -744,3 +788,415 @@ enable_dimacs_printer (BtorSATMgr *smgr)
 
   return true;
 }
+
+/*------------------------------------------------------------------------*/
+/* SAT solver portfolio                                                   */
+/*------------------------------------------------------------------------*/
+
+#ifdef BTOR_HAVE_PTHREADS
+
+struct BtorSATPortfolio
+{
+  BtorSATMgr *members[BTOR_SAT_ENGINE_MAX + 1];
+  uint32_t wins[BTOR_SAT_ENGINE_MAX + 1]; /* number of decided SAT calls */
+  uint32_t nmembers;
+  int32_t winner; /* member that decided the last SAT call, -1 if none */
+  bool decided;   /* true if a member decided the current SAT call */
+  pthread_mutex_t mutex; /* protects 'decided', 'winner' and 'term' */
+  struct
+  {
+    int32_t (*fun) (void *); /* termination callback of the portfolio */
+    void *state;
+  } term;
+};
+
+typedef struct BtorSATPortfolio BtorSATPortfolio;
+
+struct BtorSATPortfolioJob
+{
+  BtorSATPortfolio *portfolio;
+  BtorMemMgr *mm; /* thread memory manager, 0 for the calling thread */
+  uint32_t idx;
+  int32_t limit;
+  int32_t result;
+};
+
+typedef struct BtorSATPortfolioJob BtorSATPortfolioJob;
+
+static BtorSATMgr *
+portfolio_get_winner (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  assert (portfolio->winner >= 0);
+  return portfolio->members[portfolio->winner];
+}
+
+/* Termination callback of the members, terminates all members as soon as
+ * one member decided the current SAT call.  The termination callback of the
+ * portfolio is not required to be thread-safe and hence only called by one
+ * member at a time. */
+static int32_t
+portfolio_terminate (void *state)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) state;
+  int32_t res;
+
+  pthread_mutex_lock (&portfolio->mutex);
+  res = portfolio->decided
+        || (portfolio->term.fun && portfolio->term.fun (portfolio->term.state));
+  pthread_mutex_unlock (&portfolio->mutex);
+  return res;
+}
+
+static void *
+portfolio_init (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  BtorSATMgr *member;
+  uint32_t i;
+
+  for (i = 0; i < portfolio->nmembers; i++)
+  {
+    member = portfolio->members[i];
+    BTOR_MSG (smgr->btor->msg, 1, "initialized %s", member->name);
+    init_flags (member);
+    member->solver = init (member);
+    btor_sat_mgr_set_term (member, portfolio_terminate, portfolio);
+    setterm (member);
+  }
+  return portfolio;
+}
+
+static void
+portfolio_add (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  uint32_t i;
+  for (i = 0; i < portfolio->nmembers; i++) add (portfolio->members[i], lit);
+}
+
+static void
+portfolio_assume (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  uint32_t i;
+  for (i = 0; i < portfolio->nmembers; i++)
+    assume (portfolio->members[i], lit);
+}
+
+static int32_t
+portfolio_deref (BtorSATMgr *smgr, int32_t lit)
+{
+  return deref (portfolio_get_winner (smgr), lit);
+}
+
+static int32_t
+portfolio_failed (BtorSATMgr *smgr, int32_t lit)
+{
+  return failed (portfolio_get_winner (smgr), lit);
+}
+
+static int32_t
+portfolio_fixed (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  if (portfolio->winner < 0) return 0;
+  return fixed (portfolio_get_winner (smgr), lit);
+}
+
+static int32_t
+portfolio_repr (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  if (portfolio->winner < 0) return lit;
+  return repr (portfolio_get_winner (smgr), lit);
+}
+
+static void
+portfolio_enable_verbosity (BtorSATMgr *smgr, int32_t level)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  uint32_t i;
+  for (i = 0; i < portfolio->nmembers; i++)
+    enable_verbosity (portfolio->members[i], level);
+}
+
+/* All members must agree on the CNF indices. */
+static int32_t
+portfolio_inc_max_var (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  BtorSATMgr *member;
+  int32_t res, var;
+  uint32_t i;
+
+  res = 0;
+  for (i = 0; i < portfolio->nmembers; i++)
+  {
+    member               = portfolio->members[i];
+    member->inc_required = smgr->inc_required;
+    member->maxvar       = smgr->maxvar;
+    var                  = inc_max_var (member);
+    assert (!res || res == var);
+    res = var;
+  }
+  return res;
+}
+
+static void
+portfolio_melt (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  BtorSATMgr *member;
+  uint32_t i;
+
+  for (i = 0; i < portfolio->nmembers; i++)
+  {
+    member               = portfolio->members[i];
+    member->inc_required = smgr->inc_required;
+    melt (member, lit);
+  }
+}
+
+static void
+portfolio_phase (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  uint32_t i;
+  for (i = 0; i < portfolio->nmembers; i++)
+    phase (portfolio->members[i], lit);
+}
+
+static void
+portfolio_reset (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  uint32_t i;
+
+  for (i = 0; i < portfolio->nmembers; i++)
+    btor_sat_mgr_delete (portfolio->members[i]);
+  pthread_mutex_destroy (&portfolio->mutex);
+  BTOR_DELETE (smgr->btor->mm, portfolio);
+  smgr->solver = 0;
+}
+
+static void *
+portfolio_thread (void *state)
+{
+  BtorSATPortfolioJob *job    = (BtorSATPortfolioJob *) state;
+  BtorSATPortfolio *portfolio = job->portfolio;
+
+  btor_mem_set_thread_mgr (job->mm);
+  job->result = sat (portfolio->members[job->idx], job->limit);
+  if (job->result)
+  {
+    pthread_mutex_lock (&portfolio->mutex);
+    if (!portfolio->decided)
+    {
+      portfolio->decided = true;
+      portfolio->winner  = job->idx;
+    }
+    pthread_mutex_unlock (&portfolio->mutex);
+  }
+  btor_mem_set_thread_mgr (0);
+  return 0;
+}
+
+static int32_t
+portfolio_sat (BtorSATMgr *smgr, int32_t limit)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  BtorSATPortfolioJob jobs[BTOR_SAT_ENGINE_MAX + 1];
+  pthread_t threads[BTOR_SAT_ENGINE_MAX + 1];
+  BtorSATMgr *member;
+  BtorMemMgr *mm;
+  uint32_t i;
+
+  mm                 = smgr->btor->mm;
+  portfolio->decided = false;
+  portfolio->winner  = -1;
+  for (i = 0; i < portfolio->nmembers; i++)
+  {
+    member               = portfolio->members[i];
+    member->inc_required = smgr->inc_required;
+    member->satcalls     = smgr->satcalls;
+    jobs[i].portfolio    = portfolio;
+    jobs[i].mm           = btor_mem_mgr_new_thread (mm, portfolio->nmembers);
+    jobs[i].idx          = i;
+    jobs[i].limit        = limit;
+    jobs[i].result       = 0;
+    if (pthread_create (&threads[i], 0, portfolio_thread, &jobs[i]))
+    {
+      /* run the member on this thread instead, it is terminated as soon
+       * as a member on another thread decides the SAT call */
+      btor_mem_mgr_delete_thread (jobs[i].mm);
+      jobs[i].mm = 0;
+      portfolio_thread (&jobs[i]);
+    }
+  }
+  for (i = 0; i < portfolio->nmembers; i++)
+  {
+    if (!jobs[i].mm) continue;
+    pthread_join (threads[i], 0);
+    btor_mem_mgr_delete_thread (jobs[i].mm);
+  }
+
+  if (portfolio->winner < 0) return 0;
+  portfolio->wins[portfolio->winner] += 1;
+  BTOR_MSG (smgr->btor->msg,
+            2,
+            "%s decided SAT call %d",
+            portfolio->members[portfolio->winner]->name,
+            smgr->satcalls);
+  return jobs[portfolio->winner].result;
+}
+
+static void
+portfolio_set_output (BtorSATMgr *smgr, FILE *output)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  uint32_t i;
+  for (i = 0; i < portfolio->nmembers; i++)
+    set_output (portfolio->members[i], output);
+}
+
+static void
+portfolio_set_prefix (BtorSATMgr *smgr, const char *prefix)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  uint32_t i;
+  for (i = 0; i < portfolio->nmembers; i++)
+    set_prefix (portfolio->members[i], prefix);
+}
+
+static void
+portfolio_stats (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  uint32_t i;
+
+  for (i = 0; i < portfolio->nmembers; i++)
+  {
+    stats (portfolio->members[i]);
+    BTOR_MSG (smgr->btor->msg,
+              1,
+              "%s decided %u of %d SAT calls",
+              portfolio->members[i]->name,
+              portfolio->wins[i],
+              smgr->satcalls);
+  }
+}
+
+static void
+portfolio_setterm (BtorSATMgr *smgr)
+{
+  BtorSATPortfolio *portfolio = (BtorSATPortfolio *) smgr->solver;
+  BtorSATMgr *member;
+  uint32_t i;
+
+  portfolio->term.fun   = smgr->term.fun;
+  portfolio->term.state = smgr->term.state;
+  for (i = 0; i < portfolio->nmembers; i++)
+  {
+    member = portfolio->members[i];
+    btor_sat_mgr_set_term (member, portfolio_terminate, portfolio);
+    setterm (member);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+/* The SAT solver portfolio is a SAT manager that wraps one SAT manager for
+ * every configured SAT solver that supports termination, starting with the
+ * currently enabled SAT solver.  Clauses and assumptions are forwarded to
+ * all members, SAT calls are raced on separate threads.  The first member
+ * that decides a SAT call terminates all other members and answers all
+ * queries about the model and failed assumptions until the next SAT call.
+ * Returns false (and leaves 'smgr' untouched) if less than two SAT solvers
+ * support termination. */
+static bool
+enable_portfolio (BtorSATMgr *smgr)
+{
+  assert (smgr);
+  assert (smgr->name);
+
+  BtorSATPortfolio *portfolio;
+  BtorSATMgr *member;
+  BtorMemMgr *mm;
+  bool have_restore, have_assume, have_failed;
+  uint32_t i, engine, engines[BTOR_SAT_ENGINE_MAX + 1];
+
+  mm = smgr->btor->mm;
+  BTOR_CNEW (mm, portfolio);
+
+  engines[0] = btor_opt_get (smgr->btor, BTOR_OPT_SAT_ENGINE);
+  for (i = 1, engine = 0; engine <= BTOR_SAT_ENGINE_MAX; engine++)
+    if (engine != engines[0]) engines[i++] = engine;
+
+  have_restore = false;
+  have_assume  = true;
+  have_failed  = true;
+  for (i = 0; i <= BTOR_SAT_ENGINE_MAX; i++)
+  {
+    member = btor_sat_mgr_new (smgr->btor);
+    if (!enable_engine (member, engines[i]) || !member->api.setterm)
+    {
+      btor_sat_mgr_delete (member);
+      continue;
+    }
+    have_restore |= member->have_restore;
+    have_assume &= member->api.assume != 0;
+    have_failed &= member->api.failed != 0;
+    portfolio->members[portfolio->nmembers++] = member;
+  }
+
+  if (portfolio->nmembers < 2)
+  {
+    BTOR_MSG (smgr->btor->msg,
+              1,
+              "SAT solver portfolio requires at least two SAT solvers that "
+              "support termination, using %s",
+              smgr->name);
+    for (i = 0; i < portfolio->nmembers; i++)
+      btor_sat_mgr_delete (portfolio->members[i]);
+    BTOR_DELETE (mm, portfolio);
+    return false;
+  }
+
+  pthread_mutex_init (&portfolio->mutex, 0);
+  portfolio->winner = -1;
+
+  /* Clear API */
+  memset (&smgr->api, 0, sizeof (smgr->api));
+
+  smgr->solver               = portfolio;
+  smgr->name                 = "Portfolio";
+  smgr->have_restore         = have_restore;
+  smgr->api.add              = portfolio_add;
+  smgr->api.deref            = portfolio_deref;
+  smgr->api.enable_verbosity = portfolio_enable_verbosity;
+  smgr->api.fixed            = portfolio_fixed;
+  smgr->api.inc_max_var      = portfolio_inc_max_var;
+  smgr->api.init             = portfolio_init;
+  smgr->api.melt             = portfolio_melt;
+  smgr->api.phase            = portfolio_phase;
+  smgr->api.repr             = portfolio_repr;
+  smgr->api.reset            = portfolio_reset;
+  smgr->api.sat              = portfolio_sat;
+  smgr->api.set_output       = portfolio_set_output;
+  smgr->api.set_prefix       = portfolio_set_prefix;
+  smgr->api.stats            = portfolio_stats;
+  smgr->api.setterm          = portfolio_setterm;
+  smgr->api.assume           = have_assume ? portfolio_assume : 0;
+  smgr->api.failed           = have_failed ? portfolio_failed : 0;
+
+  for (i = 0; i < portfolio->nmembers; i++)
+    BTOR_MSG (smgr->btor->msg,
+              1,
+              "SAT solver portfolio member %s",
+              portfolio->members[i]->name);
+
+  return true;
+}
+
+#endif
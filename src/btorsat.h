@@ -63,6 +63,8 @@ struct BtorSATMgr
     int32_t (*inc_max_var) (BtorSATMgr *);
     void *(*init) (BtorSATMgr *); /* required */
     void (*melt) (BtorSATMgr *, int32_t);
+    /* sets the preferred decision phase of a variable to the given literal */
+    void (*phase) (BtorSATMgr *, int32_t);
     int32_t (*repr) (BtorSATMgr *, int32_t);
     void (*reset) (BtorSATMgr *);           /* required */
     int32_t (*sat) (BtorSATMgr *, int32_t); /* required */
@@ -148,6 +150,12 @@ void btor_sat_assume (BtorSATMgr *smgr, int32_t lit);
  */
 int32_t btor_sat_failed (BtorSATMgr *smgr, int32_t lit);
 
+/* Sets the preferred decision phase of the variable of 'lit' such that 'lit'
+ * is assigned to true if the SAT solver decides on it.
+ * Ignored if the SAT solver does not support this.
+ */
+void btor_sat_phase (BtorSATMgr *smgr, int32_t lit);
+
 /* Solves the SAT instance.
  * limit < 0 -> no limit.
  */
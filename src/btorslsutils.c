@@ -64,23 +64,19 @@ hamming_distance (Btor *btor, BtorBitVector *bv1, BtorBitVector *bv2)
 #endif
 
   uint32_t res, bw;
-  BtorBitVector *bv, *bvdec = 0, *zero, *ones, *tmp;
+  BtorBitVector *bv, *bvdec;
 
-  bw   = btor_bv_get_width (bv1);
-  zero = btor_bv_new (btor->mm, bw);
-  ones = btor_bv_ones (btor->mm, bw);
-  bv   = btor_bv_xor (btor->mm, bv1, bv2);
+  bw    = btor_bv_get_width (bv1);
+  bv    = btor_bv_pool_get (&btor->bv_pool, bw);
+  bvdec = btor_bv_pool_get (&btor->bv_pool, bw);
+  btor_bv_xor_into (bv, bv1, bv2);
   for (res = 0; !btor_bv_is_zero (bv); res++)
   {
-    bvdec = btor_bv_add (btor->mm, bv, ones);
-    tmp   = bv;
-    bv    = btor_bv_and (btor->mm, bv, bvdec);
-    btor_bv_free (btor->mm, tmp);
-    btor_bv_free (btor->mm, bvdec);
+    btor_bv_dec_into (bvdec, bv);
+    btor_bv_and_into (bv, bv, bvdec);
   }
-  btor_bv_free (btor->mm, bv);
-  btor_bv_free (btor->mm, ones);
-  btor_bv_free (btor->mm, zero);
+  btor_bv_pool_put (&btor->bv_pool, bv);
+  btor_bv_pool_put (&btor->bv_pool, bvdec);
   return res;
 }
 
@@ -105,8 +101,9 @@ min_flip (Btor *btor, BtorBitVector *bv1, BtorBitVector *bv2)
     res = hamming_distance (btor, bv1, bv2);
   else
   {
-    tmp = btor_bv_copy (btor->mm, bv1);
-    bw  = btor_bv_get_width (tmp);
+    bw  = btor_bv_get_width (bv1);
+    tmp = btor_bv_pool_get (&btor->bv_pool, bw);
+    btor_bv_copy_into (tmp, bv1);
     for (res = 0, i = 0, j = bw - 1; i < bw; i++, j--)
     {
       if (!btor_bv_get_bit (tmp, j)) continue;
@@ -115,7 +112,7 @@ min_flip (Btor *btor, BtorBitVector *bv1, BtorBitVector *bv2)
       if (btor_bv_compare (tmp, bv2) < 0) break;
     }
     if (btor_bv_is_zero (bv2)) res += 1;
-    btor_bv_free (btor->mm, tmp);
+    btor_bv_pool_put (&btor->bv_pool, tmp);
   }
   assert (res <= btor_bv_get_width (bv1));
   return res;
@@ -134,8 +131,9 @@ min_flip_inv (Btor *btor, BtorBitVector *bv1, BtorBitVector *bv2)
   uint32_t i, j, res, bw;
   BtorBitVector *tmp;
 
-  tmp = btor_bv_copy (btor->mm, bv1);
-  bw  = btor_bv_get_width (tmp);
+  bw  = btor_bv_get_width (bv1);
+  tmp = btor_bv_pool_get (&btor->bv_pool, bw);
+  btor_bv_copy_into (tmp, bv1);
   for (res = 0, i = 0, j = bw - 1; i < bw; i++, j--)
   {
     if (btor_bv_get_bit (tmp, j)) continue;
@@ -143,7 +141,7 @@ min_flip_inv (Btor *btor, BtorBitVector *bv1, BtorBitVector *bv2)
     btor_bv_set_bit (tmp, j, 1);
     if (btor_bv_compare (tmp, bv2) >= 0) break;
   }
-  btor_bv_free (btor->mm, tmp);
+  btor_bv_pool_put (&btor->bv_pool, tmp);
   return res;
 }
 
@@ -23,6 +23,7 @@ enum BtorSolverKind
   BTOR_PROP_SOLVER_KIND,
   BTOR_AIGPROP_SOLVER_KIND,
   BTOR_QUANT_SOLVER_KIND,
+  BTOR_ABS_SOLVER_KIND,
 };
 typedef enum BtorSolverKind BtorSolverKind;
 
@@ -0,0 +1,677 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+/* Abstraction refinement engine for QF_BV.  Wide multiplications, unsigned
+ * divisions and remainders are not bit-blasted but replaced by fresh AIG
+ * variables, constrained by a few cheap axioms only.  If the SAT solver
+ * finds a model, every abstracted node is checked against the value of its
+ * operator for the assignment of its children.  For an inconsistent node we
+ * first add a lemma fixing its value for the current values of its children
+ * and bit-blast it once it has been refined too often. */
+
+#include "btorslvabs.h"
+#include "btorabort.h"
+#include "btoraigrw.h"
+#include "btoraigvec.h"
+#include "btorclone.h"
+#include "btorcore.h"
+#include "btordbg.h"
+#include "btorlog.h"
+#include "btormodel.h"
+#include "btoropt.h"
+#include "btorprintmodel.h"
+#include "utils/btorhashint.h"
+#include "utils/btorhashptr.h"
+#include "utils/btorstack.h"
+#include "utils/btorutil.h"
+
+/*------------------------------------------------------------------------*/
+
+static BtorAbsSolver *
+clone_abs_solver (Btor *clone, BtorAbsSolver *slv, BtorNodeMap *exp_map)
+{
+  assert (clone);
+  assert (slv);
+  assert (slv->kind == BTOR_ABS_SOLVER_KIND);
+  assert (exp_map);
+
+  BtorAbsSolver *res;
+
+  BTOR_NEW (clone->mm, res);
+  memcpy (res, slv, sizeof (BtorAbsSolver));
+  res->btor = clone;
+  res->abs  = btor_hashptr_table_clone (clone->mm,
+                                       slv->abs,
+                                       btor_clone_key_as_node,
+                                       btor_clone_data_as_int,
+                                       exp_map,
+                                       0);
+  return res;
+}
+
+static void
+delete_abs_solver (BtorAbsSolver *slv)
+{
+  assert (slv);
+  assert (slv->kind == BTOR_ABS_SOLVER_KIND);
+  assert (slv->btor);
+  assert (slv->btor->slv == (BtorSolver *) slv);
+
+  Btor *btor;
+  BtorPtrHashTableIterator it;
+
+  btor = slv->btor;
+  btor_iter_hashptr_init (&it, slv->abs);
+  while (btor_iter_hashptr_has_next (&it))
+    btor_node_release (btor, btor_iter_hashptr_next (&it));
+  btor_hashptr_table_delete (slv->abs);
+  BTOR_DELETE (btor->mm, slv);
+  btor->slv = 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+is_abstractable (Btor *btor, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  if (btor_node_bv_get_width (btor, exp)
+      < btor_opt_get (btor, BTOR_OPT_ABS_MIN_WIDTH))
+    return false;
+  /* multiplications with a constant are cheap to bit-blast */
+  if (btor_node_is_bv_mul (exp))
+    return !btor_node_is_bv_const (exp->e[0])
+           && !btor_node_is_bv_const (exp->e[1]);
+  return btor_node_is_bv_udiv (exp) || btor_node_is_bv_urem (exp);
+}
+
+/* Returns a copy of the AIG vector of 'exp', inverted if 'exp' is
+ * inverted. */
+static BtorAIGVec *
+get_aigvec (Btor *btor, BtorNode *exp)
+{
+  BtorNode *real_exp;
+
+  real_exp = btor_node_real_addr (exp);
+  assert (real_exp->av);
+  return btor_node_is_inverted (exp)
+             ? btor_aigvec_not (btor->avmgr, real_exp->av)
+             : btor_aigvec_copy (btor->avmgr, real_exp->av);
+}
+
+/* Returns the current SAT assignment of the AIG vector of 'exp'. */
+static BtorBitVector *
+get_assignment (Btor *btor, BtorNode *exp)
+{
+  uint32_t i, j, width;
+  int32_t bit;
+  BtorAIGMgr *amgr;
+  BtorAIGVec *av;
+  BtorBitVector *res;
+
+  amgr  = btor_get_aig_mgr (btor);
+  av    = btor_node_real_addr (exp)->av;
+  width = av->width;
+  res   = btor_bv_new (btor->mm, width);
+  for (i = 0, j = width - 1; i < width; i++, j--)
+  {
+    bit = btor_aig_get_assignment (amgr, av->aigs[j]);
+    if (btor_node_is_inverted (exp)) bit = -bit;
+    btor_bv_set_bit (res, i, bit == 1 ? 1 : 0);
+  }
+  return res;
+}
+
+static BtorBitVector *
+eval_abstracted (Btor *btor, BtorNode *exp, BtorBitVector *a, BtorBitVector *b)
+{
+  if (btor_node_is_bv_mul (exp)) return btor_bv_mul (btor->mm, a, b);
+  if (btor_node_is_bv_udiv (exp)) return btor_bv_udiv (btor->mm, a, b);
+  assert (btor_node_is_bv_urem (exp));
+  return btor_bv_urem (btor->mm, a, b);
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Returns an AIG for av == bits, releases 'av'. */
+static BtorAIG *
+eq_const_aig (Btor *btor, BtorAIGVec *av, BtorBitVector *bits)
+{
+  BtorAIG *res;
+  BtorAIGVec *c, *eq;
+
+  c   = btor_aigvec_const (btor->avmgr, bits);
+  eq  = btor_aigvec_eq (btor->avmgr, av, c);
+  res = btor_aig_copy (btor_get_aig_mgr (btor), eq->aigs[0]);
+  btor_aigvec_release_delete (btor->avmgr, eq);
+  btor_aigvec_release_delete (btor->avmgr, c);
+  btor_aigvec_release_delete (btor->avmgr, av);
+  return res;
+}
+
+/* Returns an AIG for av0 == av1, releases 'av0' and 'av1'. */
+static BtorAIG *
+eq_aig (Btor *btor, BtorAIGVec *av0, BtorAIGVec *av1)
+{
+  BtorAIG *res;
+  BtorAIGVec *eq;
+
+  eq  = btor_aigvec_eq (btor->avmgr, av0, av1);
+  res = btor_aig_copy (btor_get_aig_mgr (btor), eq->aigs[0]);
+  btor_aigvec_release_delete (btor->avmgr, eq);
+  btor_aigvec_release_delete (btor->avmgr, av0);
+  btor_aigvec_release_delete (btor->avmgr, av1);
+  return res;
+}
+
+/* Returns an AIG for av0 < av1, releases 'av0' and 'av1'. */
+static BtorAIG *
+ult_aig (Btor *btor, BtorAIGVec *av0, BtorAIGVec *av1)
+{
+  BtorAIG *res;
+  BtorAIGVec *ult;
+
+  ult = btor_aigvec_ult (btor->avmgr, av0, av1);
+  res = btor_aig_copy (btor_get_aig_mgr (btor), ult->aigs[0]);
+  btor_aigvec_release_delete (btor->avmgr, ult);
+  btor_aigvec_release_delete (btor->avmgr, av0);
+  btor_aigvec_release_delete (btor->avmgr, av1);
+  return res;
+}
+
+/* Adds the clause ~premise | conclusion, releases 'premise' and
+ * 'conclusion'.  Since AIGs are simplified w.r.t. literals fixed by the SAT
+ * solver, a refinement may simplify to false, i.e., the formula is unsat. */
+static void
+add_implication (Btor *btor, BtorAIG *premise, BtorAIG *conclusion)
+{
+  BtorAIGMgr *amgr;
+  BtorAIG *aig;
+
+  amgr = btor_get_aig_mgr (btor);
+  aig  = btor_aig_or (amgr, BTOR_INVERT_AIG (premise), conclusion);
+  if (aig == BTOR_AIG_FALSE)
+    btor->found_constraint_false = true;
+  else
+    btor_aig_add_toplevel_to_sat (amgr, aig);
+  btor_aig_release (amgr, aig);
+  btor_aig_release (amgr, premise);
+  btor_aig_release (amgr, conclusion);
+}
+
+/* Cheap axioms for abstracted node 'exp' = e[0] op e[1]. */
+static void
+add_axioms (Btor *btor, BtorNode *exp)
+{
+  uint32_t width, n;
+  BtorAIG *a0, *b0, *a1, *b1;
+  BtorAIGMgr *amgr;
+  BtorBitVector *zero, *one, *ones;
+  BtorNode *e0, *e1;
+
+  amgr  = btor_get_aig_mgr (btor);
+  width = btor_node_bv_get_width (btor, exp);
+  n     = width - 1;
+  e0    = exp->e[0];
+  e1    = exp->e[1];
+  zero  = btor_bv_new (btor->mm, width);
+  one   = btor_bv_one (btor->mm, width);
+  ones  = btor_bv_ones (btor->mm, width);
+
+  if (btor_node_is_bv_mul (exp))
+  {
+    /* e0 = 0 | e1 = 0 -> exp = 0 */
+    a0 = eq_const_aig (btor, get_aigvec (btor, e0), zero);
+    b0 = eq_const_aig (btor, get_aigvec (btor, e1), zero);
+    add_implication (btor,
+                     btor_aig_or (amgr, a0, b0),
+                     eq_const_aig (btor, get_aigvec (btor, exp), zero));
+    btor_aig_release (amgr, a0);
+    btor_aig_release (amgr, b0);
+    /* e0 = 1 -> exp = e1, e1 = 1 -> exp = e0 */
+    add_implication (
+        btor,
+        eq_const_aig (btor, get_aigvec (btor, e0), one),
+        eq_aig (btor, get_aigvec (btor, exp), get_aigvec (btor, e1)));
+    add_implication (
+        btor,
+        eq_const_aig (btor, get_aigvec (btor, e1), one),
+        eq_aig (btor, get_aigvec (btor, exp), get_aigvec (btor, e0)));
+    /* the LSB of a product is the conjunction of the LSBs of its factors */
+    a1 = btor_node_real_addr (e0)->av->aigs[n];
+    if (btor_node_is_inverted (e0)) a1 = BTOR_INVERT_AIG (a1);
+    b1 = btor_node_real_addr (e1)->av->aigs[n];
+    if (btor_node_is_inverted (e1)) b1 = BTOR_INVERT_AIG (b1);
+    a0 = btor_aig_and (amgr, a1, b1);
+    add_implication (btor,
+                     btor_aig_copy (amgr, BTOR_AIG_TRUE),
+                     btor_aig_eq (amgr, exp->av->aigs[n], a0));
+    btor_aig_release (amgr, a0);
+  }
+  else if (btor_node_is_bv_udiv (exp))
+  {
+    /* e1 = 0 -> exp = ~0 */
+    add_implication (btor,
+                     eq_const_aig (btor, get_aigvec (btor, e1), zero),
+                     eq_const_aig (btor, get_aigvec (btor, exp), ones));
+    /* e1 = 1 -> exp = e0 */
+    add_implication (
+        btor,
+        eq_const_aig (btor, get_aigvec (btor, e1), one),
+        eq_aig (btor, get_aigvec (btor, exp), get_aigvec (btor, e0)));
+    /* e1 != 0 -> exp <= e0 */
+    add_implication (
+        btor,
+        BTOR_INVERT_AIG (eq_const_aig (btor, get_aigvec (btor, e1), zero)),
+        BTOR_INVERT_AIG (
+            ult_aig (btor, get_aigvec (btor, e0), get_aigvec (btor, exp))));
+  }
+  else
+  {
+    assert (btor_node_is_bv_urem (exp));
+    /* e1 = 0 -> exp = e0 */
+    add_implication (
+        btor,
+        eq_const_aig (btor, get_aigvec (btor, e1), zero),
+        eq_aig (btor, get_aigvec (btor, exp), get_aigvec (btor, e0)));
+    /* e1 != 0 -> exp < e1 */
+    add_implication (
+        btor,
+        BTOR_INVERT_AIG (eq_const_aig (btor, get_aigvec (btor, e1), zero)),
+        ult_aig (btor, get_aigvec (btor, exp), get_aigvec (btor, e1)));
+    /* exp <= e0 */
+    add_implication (
+        btor,
+        btor_aig_copy (amgr, BTOR_AIG_TRUE),
+        BTOR_INVERT_AIG (
+            ult_aig (btor, get_aigvec (btor, e0), get_aigvec (btor, exp))));
+  }
+
+  btor_bv_free (btor->mm, zero);
+  btor_bv_free (btor->mm, one);
+  btor_bv_free (btor->mm, ones);
+}
+
+/* Replace wide mul, udiv and urem nodes in the cones of all constraints and
+ * assumptions that are not synthesized yet with fresh AIG vectors.  Since
+ * 'btor_synthesize_exp' stops at synthesized nodes, abstracted nodes are
+ * treated as inputs during bit-blasting. */
+static void
+abstract_exps (BtorAbsSolver *slv)
+{
+  uint32_t i, j;
+  Btor *btor;
+  BtorNode *cur;
+  BtorNodePtrStack stack, abs;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *cache;
+
+  btor = slv->btor;
+
+  BTOR_INIT_STACK (btor->mm, stack);
+  BTOR_INIT_STACK (btor->mm, abs);
+  cache = btor_hashint_table_new (btor->mm);
+
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (stack, btor_iter_hashptr_next (&it));
+
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (stack));
+    if (btor_node_is_synth (cur)
+        || btor_hashint_table_contains (cache, cur->id))
+      continue;
+    btor_hashint_table_add (cache, cur->id);
+
+    if (is_abstractable (btor, cur))
+    {
+      cur->av =
+          btor_aigvec_var (btor->avmgr, btor_node_bv_get_width (btor, cur));
+      btor_aigvec_to_sat_tseitin (btor->avmgr, cur->av);
+      btor_hashptr_table_add (slv->abs, btor_node_copy (btor, cur));
+      BTOR_PUSH_STACK (abs, cur);
+      slv->stats.abstracted += 1;
+      BTORLOG (2, "abstract: %s", btor_util_node2string (cur));
+    }
+
+    for (j = 0; j < cur->arity; j++) BTOR_PUSH_STACK (stack, cur->e[j]);
+  }
+
+  /* all abstracted nodes have an AIG vector now, synthesize and encode
+   * their children, we need their assignments for the consistency check */
+  for (i = 0; i < BTOR_COUNT_STACK (abs); i++)
+  {
+    cur = BTOR_PEEK_STACK (abs, i);
+    for (j = 0; j < cur->arity; j++)
+    {
+      btor_synthesize_exp (btor, cur->e[j], 0);
+      btor_aigvec_to_sat_tseitin (btor->avmgr,
+                                  btor_node_real_addr (cur->e[j])->av);
+    }
+    add_axioms (btor, cur);
+  }
+
+  btor_hashint_table_delete (cache);
+  BTOR_RELEASE_STACK (abs);
+  BTOR_RELEASE_STACK (stack);
+}
+
+/* Bit-blast abstracted node 'exp' and constrain its AIG vector to be equal
+ * to the resulting circuit. */
+static void
+refine_by_bit_blasting (Btor *btor, BtorNode *exp)
+{
+  BtorAIGVec *av0, *av1, *av;
+  BtorAIGMgr *amgr;
+
+  amgr = btor_get_aig_mgr (btor);
+  av0  = get_aigvec (btor, exp->e[0]);
+  av1  = get_aigvec (btor, exp->e[1]);
+  if (btor_node_is_bv_mul (exp))
+    av = btor_aigvec_mul (btor->avmgr, av0, av1);
+  else if (btor_node_is_bv_udiv (exp))
+    av = btor_aigvec_udiv (btor->avmgr, av0, av1);
+  else
+  {
+    assert (btor_node_is_bv_urem (exp));
+    av = btor_aigvec_urem (btor->avmgr, av0, av1);
+  }
+  btor_aigvec_release_delete (btor->avmgr, av0);
+  btor_aigvec_release_delete (btor->avmgr, av1);
+  if (btor_opt_get (btor, BTOR_OPT_AIG_REWRITE))
+    btor_aig_rewrite (amgr, av->aigs, av->width);
+  add_implication (btor,
+                   btor_aig_copy (amgr, BTOR_AIG_TRUE),
+                   eq_aig (btor, av, get_aigvec (btor, exp)));
+}
+
+/* Check all abstracted nodes against the current SAT model and refine the
+ * inconsistent ones.  Returns the number of refined nodes. */
+static uint32_t
+check_and_refine (BtorAbsSolver *slv)
+{
+  uint32_t res, max_lemmas;
+  double start;
+  Btor *btor;
+  BtorNode *cur;
+  BtorPtrHashBucket *b;
+  BtorPtrHashTableIterator it;
+  BtorBitVector *a0, *a1, *val, *exp_val;
+  BtorNodePtrStack refine;
+  BtorAIGMgr *amgr;
+  BtorAIG *aig0, *aig1;
+
+  btor       = slv->btor;
+  amgr       = btor_get_aig_mgr (btor);
+  max_lemmas = btor_opt_get (btor, BTOR_OPT_ABS_LEMMAS);
+  BTOR_INIT_STACK (btor->mm, refine);
+
+  start = btor_util_time_stamp ();
+  btor_iter_hashptr_init (&it, slv->abs);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    assert (btor_node_is_regular (cur));
+    assert (cur->av);
+    a0      = get_assignment (btor, cur->e[0]);
+    a1      = get_assignment (btor, cur->e[1]);
+    val     = get_assignment (btor, cur);
+    exp_val = eval_abstracted (btor, cur, a0, a1);
+    if (btor_bv_compare (val, exp_val)) BTOR_PUSH_STACK (refine, cur);
+    btor_bv_free (btor->mm, a0);
+    btor_bv_free (btor->mm, a1);
+    btor_bv_free (btor->mm, val);
+    btor_bv_free (btor->mm, exp_val);
+  }
+  slv->time.check += btor_util_time_stamp () - start;
+
+  /* the SAT model is invalidated by adding clauses, hence collect first */
+  start = btor_util_time_stamp ();
+  for (res = 0; res < BTOR_COUNT_STACK (refine); res++)
+  {
+    cur = BTOR_PEEK_STACK (refine, res);
+    b   = btor_hashptr_table_get (slv->abs, cur);
+    assert (b);
+    if ((uint32_t) b->data.as_int < max_lemmas)
+    {
+      /* e[0] = a0 & e[1] = a1 -> cur = a0 op a1 */
+      a0      = get_assignment (btor, cur->e[0]);
+      a1      = get_assignment (btor, cur->e[1]);
+      exp_val = eval_abstracted (btor, cur, a0, a1);
+      aig0 = eq_const_aig (btor, get_aigvec (btor, cur->e[0]), a0);
+      aig1 = eq_const_aig (btor, get_aigvec (btor, cur->e[1]), a1);
+      add_implication (btor,
+                       btor_aig_and (amgr, aig0, aig1),
+                       eq_const_aig (btor, get_aigvec (btor, cur), exp_val));
+      btor_aig_release (amgr, aig0);
+      btor_aig_release (amgr, aig1);
+      btor_bv_free (btor->mm, a0);
+      btor_bv_free (btor->mm, a1);
+      btor_bv_free (btor->mm, exp_val);
+      b->data.as_int += 1;
+      slv->stats.lemmas += 1;
+      BTORLOG (2, "lemma for: %s", btor_util_node2string (cur));
+    }
+    else
+    {
+      BTORLOG (2, "bit-blast: %s", btor_util_node2string (cur));
+      refine_by_bit_blasting (btor, cur);
+      btor_hashptr_table_remove (slv->abs, cur, 0, 0);
+      btor_node_release (btor, cur);
+      slv->stats.refined += 1;
+    }
+  }
+  slv->time.refine += btor_util_time_stamp () - start;
+
+  BTOR_RELEASE_STACK (refine);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static BtorSolverResult
+timed_sat_sat (BtorAbsSolver *slv)
+{
+  double start;
+  Btor *btor;
+  BtorAIGMgr *amgr;
+  BtorSolverResult res;
+
+  btor = slv->btor;
+  amgr = btor_get_aig_mgr (btor);
+  BTOR_MSG (btor->msg,
+            1,
+            "%u abstracted, %u AIG vars, %u AIG ands, %u CNF vars, %u CNF "
+            "clauses",
+            slv->abs->count,
+            amgr->cur_num_aig_vars,
+            amgr->cur_num_aigs,
+            amgr->num_cnf_vars,
+            amgr->num_cnf_clauses);
+  start = btor_util_time_stamp ();
+  res   = btor_sat_check_sat (btor_get_sat_mgr (btor), -1);
+  slv->time.sat += btor_util_time_stamp () - start;
+  return res;
+}
+
+static BtorSolverResult
+sat_abs_solver (BtorAbsSolver *slv)
+{
+  assert (slv);
+  assert (slv->kind == BTOR_ABS_SOLVER_KIND);
+  assert (slv->btor);
+  assert (slv->btor->slv == (BtorSolver *) slv);
+
+  BtorSolverResult result;
+  BtorSATMgr *smgr;
+  Btor *btor;
+
+  btor = slv->btor;
+  assert (!btor->inconsistent);
+
+  BTOR_ABORT (btor->ufs->count != 0 || btor->feqs->count != 0
+                  || (!btor_opt_get (btor, BTOR_OPT_BETA_REDUCE)
+                      && btor->lambdas->count != 0),
+              "abs engine supports QF_BV only");
+
+  smgr = btor_get_sat_mgr (btor);
+  if (!btor_sat_is_initialized (smgr))
+  {
+    btor_sat_enable_solver (smgr);
+    btor_sat_init (smgr);
+  }
+  /* refinement requires incremental SAT solving */
+  BTOR_ABORT (!btor_sat_mgr_has_incremental_support (smgr),
+              "selected SAT solver '%s' does not support incremental mode",
+              smgr->name);
+
+  while (true)
+  {
+    if (btor_terminate (btor))
+    {
+      result = BTOR_RESULT_UNKNOWN;
+      break;
+    }
+
+    abstract_exps (slv);
+    if (btor->found_constraint_false)
+    {
+      result = BTOR_RESULT_UNSAT;
+      break;
+    }
+    btor_process_unsynthesized_constraints (btor);
+    if (btor->found_constraint_false)
+    {
+      result = BTOR_RESULT_UNSAT;
+      break;
+    }
+    assert (btor->unsynthesized_constraints->count == 0);
+    assert (btor_dbg_check_all_hash_tables_proxy_free (btor));
+    assert (btor_dbg_check_all_hash_tables_simp_free (btor));
+
+    /* bit-blasting may have exceeded the memory limit */
+    if (btor_terminate (btor))
+    {
+      result = BTOR_RESULT_UNKNOWN;
+      break;
+    }
+
+    btor_add_again_assumptions (btor);
+    result = timed_sat_sat (slv);
+    if (result != BTOR_RESULT_SAT) break;
+
+    if (!check_and_refine (slv)) break;
+    slv->stats.refinement_iterations += 1;
+  }
+
+  return result;
+}
+
+static void
+generate_model_abs_solver (BtorAbsSolver *slv,
+                           bool model_for_all_nodes,
+                           bool reset)
+{
+  assert (slv);
+  assert (slv->kind == BTOR_ABS_SOLVER_KIND);
+  assert (slv->btor);
+  assert (slv->btor->slv == (BtorSolver *) slv);
+
+  (void) reset;
+
+  btor_model_init_bv (slv->btor, &slv->btor->bv_model);
+  btor_model_init_fun (slv->btor, &slv->btor->fun_model);
+  btor_model_generate (slv->btor,
+                       slv->btor->bv_model,
+                       slv->btor->fun_model,
+                       model_for_all_nodes);
+}
+
+static void
+print_stats_abs_solver (BtorAbsSolver *slv)
+{
+  assert (slv);
+  assert (slv->kind == BTOR_ABS_SOLVER_KIND);
+  assert (slv->btor);
+  assert (slv->btor->slv == (BtorSolver *) slv);
+
+  Btor *btor;
+
+  btor = slv->btor;
+
+  BTOR_MSG (btor->msg, 1, "");
+  BTOR_MSG (btor->msg, 1, "abstraction refinement statistics:");
+  BTOR_MSG (btor->msg,
+            1,
+            "%4u refinement iterations",
+            slv->stats.refinement_iterations);
+  BTOR_MSG (btor->msg, 1, "%4u abstracted nodes", slv->stats.abstracted);
+  BTOR_MSG (btor->msg, 1, "%4u lemmas", slv->stats.lemmas);
+  BTOR_MSG (btor->msg, 1, "%4u bit-blasted nodes", slv->stats.refined);
+}
+
+static void
+print_time_stats_abs_solver (BtorAbsSolver *slv)
+{
+  assert (slv);
+  assert (slv->kind == BTOR_ABS_SOLVER_KIND);
+  assert (slv->btor);
+  assert (slv->btor->slv == (BtorSolver *) slv);
+
+  Btor *btor;
+
+  btor = slv->btor;
+
+  BTOR_MSG (btor->msg, 1, "");
+  BTOR_MSG (btor->msg,
+            1,
+            "%.2f seconds consistency checking",
+            slv->time.check);
+  BTOR_MSG (btor->msg, 1, "%.2f seconds refinement", slv->time.refine);
+  BTOR_MSG (btor->msg, 1, "%.2f seconds in pure SAT solving", slv->time.sat);
+  BTOR_MSG (btor->msg, 1, "");
+}
+
+static void
+print_model_abs_solver (BtorAbsSolver *slv, const char *format, FILE *file)
+{
+  btor_print_model_aufbv (slv->btor, format, file);
+}
+
+BtorSolver *
+btor_new_abs_solver (Btor *btor)
+{
+  assert (btor);
+
+  BtorAbsSolver *slv;
+
+  BTOR_CNEW (btor->mm, slv);
+
+  slv->kind = BTOR_ABS_SOLVER_KIND;
+  slv->btor = btor;
+
+  slv->api.clone          = (BtorSolverClone) clone_abs_solver;
+  slv->api.delet          = (BtorSolverDelete) delete_abs_solver;
+  slv->api.sat            = (BtorSolverSat) sat_abs_solver;
+  slv->api.generate_model = (BtorSolverGenerateModel) generate_model_abs_solver;
+  slv->api.print_stats    = (BtorSolverPrintStats) print_stats_abs_solver;
+  slv->api.print_time_stats =
+      (BtorSolverPrintTimeStats) print_time_stats_abs_solver;
+  slv->api.print_model = (BtorSolverPrintModel) print_model_abs_solver;
+
+  slv->abs = btor_hashptr_table_new (btor->mm,
+                                     (BtorHashPtr) btor_node_hash_by_id,
+                                     (BtorCmpPtr) btor_node_compare_by_id);
+
+  BTOR_MSG (btor->msg, 1, "enabled abs engine");
+
+  return (BtorSolver *) slv;
+}
@@ -0,0 +1,46 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORSLVABS_H_INCLUDED
+#define BTORSLVABS_H_INCLUDED
+
+#include "btorslv.h"
+#include "utils/btorhashptr.h"
+
+#define BTOR_ABS_SOLVER(btor) ((BtorAbsSolver *) (btor)->slv)
+
+struct BtorAbsSolver
+{
+  BTOR_SOLVER_STRUCT;
+
+  /* abstracted mul, udiv and urem nodes, data.as_int is the number of
+   * lemmas added for the node */
+  BtorPtrHashTable *abs;
+
+  /* statistics */
+  struct
+  {
+    uint32_t refinement_iterations;
+    uint32_t abstracted;
+    uint32_t lemmas;
+    uint32_t refined;
+  } stats;
+
+  struct
+  {
+    double sat;
+    double check;
+    double refine;
+  } time;
+};
+
+typedef struct BtorAbsSolver BtorAbsSolver;
+
+BtorSolver *btor_new_abs_solver (Btor *btor);
+
+#endif
@@ -30,6 +30,10 @@
 
 /*------------------------------------------------------------------------*/
 
+static void delete_dual_prop_clone (BtorFunSolver *);
+
+/*------------------------------------------------------------------------*/
+
 static BtorFunSolver *
 clone_fun_solver (Btor *clone, BtorFunSolver *slv, BtorNodeMap *exp_map)
 {
@@ -54,6 +58,10 @@ clone_fun_solver (Btor *clone, BtorFunSolver *slv, BtorNodeMap *exp_map)
   btor_clone_node_ptr_stack (
       clone->mm, &slv->cur_lemmas, &res->cur_lemmas, exp_map, false);
 
+  /* the dual prop clone is rebuilt on demand */
+  res->dp_clone   = 0;
+  res->dp_exp_map = 0;
+
   if (slv->score)
   {
     h = btor_opt_get (btor, BTOR_OPT_FUN_JUST_HEURISTIC);
@@ -112,6 +120,8 @@ delete_fun_solver (BtorFunSolver *slv)
 
   btor = slv->btor;
 
+  delete_dual_prop_clone (slv);
+
   btor_iter_hashptr_init (&it, slv->lemmas);
   while (btor_iter_hashptr_has_next (&it))
     btor_node_release (btor, btor_iter_hashptr_next (&it));
@@ -273,6 +283,50 @@ timed_sat_sat (Btor *btor, int32_t limit)
   return res;
 }
 
+/* Use the current bit-vector model (of the local search presolver) as
+ * preferred decision phases of the bit-blasted inputs, such that the SAT
+ * solver starts its search close to that assignment. */
+static void
+set_phase_hints (Btor *btor)
+{
+  assert (btor);
+  assert (btor->bv_model);
+
+  uint32_t i, width, n;
+  int32_t lit;
+  BtorNode *var;
+  BtorAIG *aig;
+  BtorSATMgr *smgr;
+  BtorHashTableData *d;
+  BtorBitVector *bv;
+  BtorPtrHashTableIterator it;
+
+  smgr = btor_get_sat_mgr (btor);
+  n    = 0;
+  btor_iter_hashptr_init (&it, btor->bv_vars);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    var = btor_iter_hashptr_next (&it);
+    /* not bit-blasted */
+    if (!var->av) continue;
+    d = btor_hashint_map_get (btor->bv_model, var->id);
+    if (!d) continue;
+    bv    = d->as_ptr;
+    width = var->av->width;
+    assert (width == btor_bv_get_width (bv));
+    for (i = 0; i < width; i++)
+    {
+      aig = var->av->aigs[i];
+      if (!btor_aig_is_var (aig) || !aig->cnf_id) continue;
+      /* aigs[0] is the most significant bit */
+      lit = btor_bv_get_bit (bv, width - 1 - i) ? aig->cnf_id : -aig->cnf_id;
+      btor_sat_phase (smgr, lit);
+      n++;
+    }
+  }
+  BTOR_MSG (btor->msg, 1, "set %u phase hints from local search model", n);
+}
+
 static bool
 has_bv_assignment (Btor *btor, BtorNode *exp)
 {
@@ -331,29 +385,22 @@ get_bv_assignment (Btor *btor, BtorNode *exp)
 /*------------------------------------------------------------------------*/
 
 static Btor *
-new_exp_layer_clone_for_dual_prop (Btor *btor,
-                                   BtorNodeMap **exp_map,
-                                   BtorNode **root)
+new_exp_layer_clone_for_dual_prop (Btor *btor, BtorNodeMap **exp_map)
 {
   assert (btor);
   assert (btor->slv);
   assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
   assert (exp_map);
-  assert (root);
 
   double start;
   Btor *clone;
-  BtorNode *cur, *and;
+  BtorNode *cur;
   BtorPtrHashTableIterator it;
 
-  /* empty formula */
-  if (btor->unsynthesized_constraints->count == 0) return 0;
-
   start = btor_util_time_stamp ();
   clone = btor_clone_exp_layer (btor, exp_map, true);
   assert (!clone->synthesized_constraints->count);
   assert (clone->embedded_constraints->count == 0);
-  assert (clone->unsynthesized_constraints->count);
 
   btor_opt_set (clone, BTOR_OPT_MODEL_GEN, 0);
   btor_opt_set (clone, BTOR_OPT_INCREMENTAL, 1);
@@ -365,28 +412,15 @@ new_exp_layer_clone_for_dual_prop (Btor *btor,
   btor_opt_set_str (clone, BTOR_OPT_SAT_ENGINE, "plain=1");
   configure_sat_mgr (clone);
 
+  /* constraints and assumptions are conjoined to the root of each call */
   btor_iter_hashptr_init (&it, clone->unsynthesized_constraints);
   btor_iter_hashptr_queue (&it, clone->assumptions);
   while (btor_iter_hashptr_has_next (&it))
   {
     cur                                   = btor_iter_hashptr_next (&it);
     btor_node_real_addr (cur)->constraint = 0;
-    if (!*root)
-    {
-      *root = btor_node_copy (clone, cur);
-    }
-    else
-    {
-      and = btor_exp_bv_and (clone, *root, cur);
-      btor_node_release (clone, *root);
-      *root = and;
-    }
+    btor_node_release (clone, cur);
   }
-
-  btor_iter_hashptr_init (&it, clone->unsynthesized_constraints);
-  btor_iter_hashptr_queue (&it, clone->assumptions);
-  while (btor_iter_hashptr_has_next (&it))
-    btor_node_release (clone, btor_iter_hashptr_next (&it));
   btor_hashptr_table_delete (clone->unsynthesized_constraints);
   btor_hashptr_table_delete (clone->assumptions);
   clone->unsynthesized_constraints =
@@ -403,6 +437,159 @@ new_exp_layer_clone_for_dual_prop (Btor *btor,
   return clone;
 }
 
+static void
+delete_dual_prop_clone (BtorFunSolver *slv)
+{
+  assert (slv);
+
+  if (!slv->dp_clone) return;
+  assert (slv->dp_exp_map);
+  btor_nodemap_delete (slv->dp_exp_map);
+  btor_delete (slv->dp_clone);
+  slv->dp_clone   = 0;
+  slv->dp_exp_map = 0;
+}
+
+/* Collect the ids of all expressions reachable from the current constraints
+ * and assumptions. */
+static BtorIntHashTable *
+mark_dual_prop_reachable (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *mark;
+  BtorPtrHashTableIterator it;
+
+  mark = btor_hashint_table_new (btor->mm);
+  BTOR_INIT_STACK (btor->mm, visit);
+  btor_iter_hashptr_init (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    BTOR_PUSH_STACK (visit, btor_iter_hashptr_next (&it));
+    while (!BTOR_EMPTY_STACK (visit))
+    {
+      cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+      if (btor_hashint_table_contains (mark, cur->id)) continue;
+      btor_hashint_table_add (mark, cur->id);
+      for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+    }
+  }
+  BTOR_RELEASE_STACK (visit);
+  return mark;
+}
+
+/* Get the number of mapped expressions that are not reachable from the
+ * current constraints and assumptions.  The expression map keeps them alive
+ * (in both instances) even if they are not referenced otherwise anymore,
+ * e.g., after popping a scope. */
+static uint32_t
+count_unreachable_dual_prop (BtorNodeMap *exp_map, BtorIntHashTable *mark)
+{
+  assert (exp_map);
+  assert (mark);
+
+  uint32_t res;
+  BtorNode *cur;
+  BtorNodeMapIterator it;
+
+  res = 0;
+  btor_iter_nodemap_init (&it, exp_map);
+  while (btor_iter_nodemap_has_next (&it))
+  {
+    cur = btor_iter_nodemap_next (&it);
+    if (!btor_hashint_table_contains (mark, btor_node_real_addr (cur)->id))
+      res++;
+  }
+  return res;
+}
+
+/* Get the dual prop clone of the current sat call and the conjunction of the
+ * current constraints and assumptions in the clone.  The clone is kept alive
+ * across incremental calls.  Constraints and inputs added since the last call
+ * are cloned on demand.  Constraints of popped scopes stay part of the root
+ * as guarded constraints until the activation variable of their scope has
+ * been substituted, and remain in the expression map afterwards.  Hence, the
+ * clone is rebuilt from scratch once the mapped expressions that became
+ * unreachable since it was built outnumber the reachable ones. */
+static BtorNode *
+sync_dual_prop_clone (BtorFunSolver *slv)
+{
+  assert (slv);
+
+  double start;
+  uint32_t unreachable, count;
+  Btor *btor, *clone;
+  BtorNode *root, *cur, *and;
+  BtorNodeMap *exp_map;
+  BtorIntHashTable *mark;
+  BtorPtrHashTableIterator it;
+
+  btor = slv->btor;
+
+  /* empty formula */
+  if (btor->synthesized_constraints->count == 0
+      && btor->unsynthesized_constraints->count == 0
+      && btor->assumptions->count == 0)
+    return 0;
+
+  start = btor_util_time_stamp ();
+  mark  = mark_dual_prop_reachable (btor);
+  if (slv->dp_clone)
+  {
+    unreachable = count_unreachable_dual_prop (slv->dp_exp_map, mark);
+    count       = slv->dp_exp_map->table->count;
+    assert (unreachable <= count);
+    if (unreachable - BTOR_MIN_UTIL (unreachable, slv->dp_unreachable)
+        > count - unreachable)
+      delete_dual_prop_clone (slv);
+  }
+  slv->time.search_init_apps_clone_sync += btor_util_time_stamp () - start;
+
+  if (!slv->dp_clone)
+  {
+    slv->dp_clone = new_exp_layer_clone_for_dual_prop (btor, &slv->dp_exp_map);
+    slv->stats.dp_clones++;
+    /* expressions that are not reachable when the clone is built, e.g.,
+     * expressions held by the user, are not counted as stale */
+    slv->dp_unreachable = count_unreachable_dual_prop (slv->dp_exp_map, mark);
+  }
+  btor_hashint_table_delete (mark);
+
+  start   = btor_util_time_stamp ();
+  clone   = slv->dp_clone;
+  exp_map = slv->dp_exp_map;
+  root    = 0;
+
+  btor_iter_hashptr_init (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    /* rebuild with rewrite level 0 (as we want the exact expression) */
+    cur = btor_clone_recursively_rebuild_exp (
+        btor, clone, btor_iter_hashptr_next (&it), exp_map, 0);
+    if (!root)
+    {
+      root = cur;
+    }
+    else
+    {
+      and = btor_exp_bv_and (clone, root, cur);
+      btor_node_release (clone, root);
+      btor_node_release (clone, cur);
+      root = and;
+    }
+  }
+
+  slv->time.search_init_apps_clone_sync += btor_util_time_stamp () - start;
+  return root;
+}
+
 static void
 assume_inputs (Btor *btor,
                Btor *clone,
@@ -2004,6 +2191,390 @@ generate_table (Btor *btor, BtorNode *fun, BtorNode **base_array)
   return table;
 }
 
+/*------------------------------------------------------------------------*/
+
+/* Weak equivalence graph (Christ and Hoenicke, "Weakly Equivalent Arrays")
+ * over the arrays connected to array equalities that are true under the
+ * current model.  Edges connect both sides of a true array equality, an array
+ * conditional and its branch selected under the current model, and a store
+ * (update) and the array it updates.  Store edges are labeled with the updated
+ * index.  Two arrays are weakly equivalent on index i if they are connected by
+ * a path without a store edge that updates i under the current model, and
+ * must hence agree on the value at i.  Reads of the arrays (and the values
+ * written by the stores) that violate this yield a read-over-weakeq lemma,
+ * with the edge labels along the path as premises. */
+
+struct BtorWeakEqNode
+{
+  BtorNode *array;
+  BtorIntStack adj;        /* adjacent nodes */
+  BtorNodePtrStack labels; /* labels of the edges to the adjacent nodes */
+  uint32_t search;         /* last search that reached this node */
+  int32_t source;          /* read the last search started from */
+  int32_t pred;            /* predecessor in the last search */
+  BtorNode *pred_label;    /* label of the edge to the predecessor */
+};
+
+typedef struct BtorWeakEqNode BtorWeakEqNode;
+
+BTOR_DECLARE_STACK (BtorWeakEqNode, BtorWeakEqNode);
+
+struct BtorWeakEqRead
+{
+  int32_t node;    /* read array */
+  BtorNode *args;  /* read index */
+  BtorNode *value; /* read apply or value written by a store */
+  int32_t group;   /* index group w.r.t. the current model */
+};
+
+typedef struct BtorWeakEqRead BtorWeakEqRead;
+
+BTOR_DECLARE_STACK (BtorWeakEqRead, BtorWeakEqRead);
+
+static int32_t
+compare_weakeq_reads_qsort (const void *p1, const void *p2)
+{
+  const BtorWeakEqRead *r1 = p1, *r2 = p2;
+  if (r1->group != r2->group) return r1->group - r2->group;
+  return r1->node - r2->node;
+}
+
+static int32_t
+get_weakeq_node (Btor *btor,
+                 BtorNode *array,
+                 BtorWeakEqNodeStack *nodes,
+                 BtorIntHashTable *node_map,
+                 BtorNodePtrStack *visit)
+{
+  BtorHashTableData *d;
+  BtorWeakEqNode node;
+
+  array = btor_node_get_simplified (btor, array);
+  assert (btor_node_is_regular (array));
+  assert (btor_node_is_fun (array));
+
+  if ((d = btor_hashint_map_get (node_map, array->id))) return d->as_int;
+
+  memset (&node, 0, sizeof (node));
+  node.array = array;
+  BTOR_INIT_STACK (btor->mm, node.adj);
+  BTOR_INIT_STACK (btor->mm, node.labels);
+  BTOR_PUSH_STACK (*nodes, node);
+  btor_hashint_map_add (node_map, array->id)->as_int =
+      BTOR_COUNT_STACK (*nodes) - 1;
+  BTOR_PUSH_STACK (*visit, array);
+  return BTOR_COUNT_STACK (*nodes) - 1;
+}
+
+static void
+add_weakeq_edge (BtorWeakEqNodeStack *nodes,
+                 int32_t n0,
+                 int32_t n1,
+                 BtorNode *label)
+{
+  BTOR_PUSH_STACK (nodes->start[n0].adj, n1);
+  BTOR_PUSH_STACK (nodes->start[n0].labels, label);
+  BTOR_PUSH_STACK (nodes->start[n1].adj, n0);
+  BTOR_PUSH_STACK (nodes->start[n1].labels, label);
+}
+
+static void
+build_weakeq_graph (Btor *btor,
+                    BtorWeakEqNodeStack *nodes,
+                    BtorWeakEqReadStack *reads)
+{
+  int32_t n, m;
+  bool is_true;
+  BtorMemMgr *mm;
+  BtorNode *cur, *par, *cond;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *feqs, *node_map;
+  BtorBitVector *bv;
+  BtorNodeIterator it;
+  BtorPtrHashTableIterator hit;
+  BtorWeakEqRead read;
+
+  mm       = btor->mm;
+  feqs     = btor_hashint_table_new (mm);
+  node_map = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, visit);
+
+  btor_iter_hashptr_init (&hit, btor->feqs);
+  while (btor_iter_hashptr_has_next (&hit))
+    BTOR_PUSH_STACK (visit, btor_iter_hashptr_next (&hit));
+
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_get_simplified (btor, BTOR_POP_STACK (visit));
+
+    if (!btor_node_is_regular (cur) || cur->parameterized) continue;
+
+    if (btor_node_is_fun_eq (cur))
+    {
+      if (btor_hashint_table_contains (feqs, cur->id)) continue;
+      btor_hashint_table_add (feqs, cur->id);
+      bv      = get_bv_assignment (btor, cur);
+      is_true = btor_bv_is_true (bv);
+      btor_bv_free (mm, bv);
+      if (!is_true) continue;
+      n = get_weakeq_node (btor, cur->e[0], nodes, node_map, &visit);
+      m = get_weakeq_node (btor, cur->e[1], nodes, node_map, &visit);
+      add_weakeq_edge (nodes, n, m, cur);
+      continue;
+    }
+
+    assert (btor_node_is_fun (cur));
+    n = btor_hashint_map_get (node_map, cur->id)->as_int;
+
+    if (btor_node_is_update (cur))
+    {
+      m = get_weakeq_node (btor, cur->e[0], nodes, node_map, &visit);
+      add_weakeq_edge (nodes, n, m, cur->e[1]);
+      read.node  = n;
+      read.args  = cur->e[1];
+      read.value = btor_node_get_simplified (btor, cur->e[2]);
+      BTOR_PUSH_STACK (*reads, read);
+    }
+    else if (btor_node_is_fun_cond (cur))
+    {
+      bv      = get_bv_assignment (btor, cur->e[0]);
+      is_true = btor_bv_is_true (bv);
+      btor_bv_free (mm, bv);
+      m = get_weakeq_node (
+          btor, is_true ? cur->e[1] : cur->e[2], nodes, node_map, &visit);
+      cond = is_true ? cur->e[0] : btor_node_invert (cur->e[0]);
+      add_weakeq_edge (nodes, n, m, cond);
+    }
+
+    /* equalities, stores and conditionals over 'cur', and reads of 'cur' */
+    btor_iter_parent_init (&it, cur);
+    while (btor_iter_parent_has_next (&it))
+    {
+      par = btor_iter_parent_next (&it);
+      if (par->parameterized) continue;
+      if (btor_node_is_fun_eq (par))
+        BTOR_PUSH_STACK (visit, par);
+      else if ((btor_node_is_update (par) && par->e[0] == cur)
+               || btor_node_is_fun_cond (par))
+        (void) get_weakeq_node (btor, par, nodes, node_map, &visit);
+      else if (btor_node_is_apply (par) && par->e[0] == cur
+               && btor_node_is_synth (par))
+      {
+        read.node  = n;
+        read.args  = par->e[1];
+        read.value = par;
+        BTOR_PUSH_STACK (*reads, read);
+      }
+    }
+  }
+
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (feqs);
+  btor_hashint_map_delete (node_map);
+}
+
+/* Search all arrays weakly equivalent to the array of 'read' on the index of
+ * 'read'.  Breadth-first to get short paths and hence small lemmas. */
+static void
+search_weakeq (BtorWeakEqNodeStack *nodes,
+               BtorWeakEqRead *reads,
+               int32_t read,
+               uint32_t search,
+               BtorIntStack *queue)
+{
+  uint32_t i, j;
+  int32_t n, m;
+  BtorNode *label;
+  BtorWeakEqNode *node;
+
+  n                      = reads[read].node;
+  nodes->start[n].search = search;
+  nodes->start[n].source = read;
+  nodes->start[n].pred   = -1;
+  BTOR_RESET_STACK (*queue);
+  BTOR_PUSH_STACK (*queue, n);
+
+  for (i = 0; i < BTOR_COUNT_STACK (*queue); i++)
+  {
+    node = nodes->start + BTOR_PEEK_STACK (*queue, i);
+    for (j = 0; j < BTOR_COUNT_STACK (node->adj); j++)
+    {
+      m     = BTOR_PEEK_STACK (node->adj, j);
+      label = BTOR_PEEK_STACK (node->labels, j);
+      if (nodes->start[m].search == search) continue;
+      /* store on the index of 'read' */
+      if (btor_node_is_args (label)
+          && compare_args_assignments (label, reads[read].args) == 0)
+        continue;
+      nodes->start[m].search     = search;
+      nodes->start[m].source     = read;
+      nodes->start[m].pred       = node - nodes->start;
+      nodes->start[m].pred_label = label;
+      BTOR_PUSH_STACK (*queue, m);
+    }
+  }
+}
+
+static bool
+add_weakeq_lemma (Btor *btor,
+                  BtorWeakEqNodeStack *nodes,
+                  BtorWeakEqRead *read0,
+                  BtorWeakEqRead *read1)
+{
+  bool added = false;
+  int32_t n;
+  uint32_t i, lemma_size;
+  BtorNode *tmp, *and, *con, *lemma;
+  BtorNodePtrStack path, prem;
+  BtorMemMgr *mm;
+  BtorFunSolver *slv;
+
+  mm  = btor->mm;
+  slv = BTOR_FUN_SOLVER (btor);
+  BTOR_INIT_STACK (mm, path);
+  BTOR_INIT_STACK (mm, prem);
+
+  /* edge labels on the path from 'read1' back to 'read0' */
+  for (n = read1->node; n != read0->node; n = nodes->start[n].pred)
+  {
+    assert (n >= 0);
+    BTOR_PUSH_STACK (path, nodes->start[n].pred_label);
+  }
+  lemma_size = BTOR_COUNT_STACK (path) + 1;
+
+  tmp = mk_premise (btor, read0->args, path.start, BTOR_COUNT_STACK (path));
+  if (tmp) BTOR_PUSH_STACK (prem, tmp);
+  if (read0->args != read1->args)
+    BTOR_PUSH_STACK (prem, mk_equal_args (btor, read0->args, read1->args));
+
+  con = btor_exp_eq (btor, read0->value, read1->value);
+  if (BTOR_EMPTY_STACK (prem))
+    lemma = btor_node_copy (btor, con);
+  else
+  {
+    and   = btor_exp_bv_and_n (btor, prem.start, BTOR_COUNT_STACK (prem));
+    lemma = btor_exp_implies (btor, and, con);
+    btor_node_release (btor, and);
+  }
+
+  if (!btor_hashptr_table_get (slv->lemmas, lemma))
+  {
+    btor_hashptr_table_add (slv->lemmas, btor_node_copy (btor, lemma));
+    BTOR_PUSH_STACK (slv->cur_lemmas, lemma);
+    slv->stats.weakeq_lemmas++;
+    slv->stats.lod_refinements++;
+    slv->stats.lemmas_size_sum += lemma_size;
+    if (lemma_size >= BTOR_SIZE_STACK (slv->stats.lemmas_size))
+      BTOR_FIT_STACK (slv->stats.lemmas_size, lemma_size);
+    slv->stats.lemmas_size.start[lemma_size] += 1;
+    BTORLOG (1,
+             "  %s, %s",
+             btor_util_node2string (read0->value),
+             btor_util_node2string (read1->value));
+    added = true;
+  }
+  btor_node_release (btor, lemma);
+  btor_node_release (btor, con);
+
+  for (i = 0; i < BTOR_COUNT_STACK (prem); i++)
+    btor_node_release (btor, BTOR_PEEK_STACK (prem, i));
+  BTOR_RELEASE_STACK (prem);
+  BTOR_RELEASE_STACK (path);
+  return added;
+}
+
+/* Check reads of weakly equivalent arrays for conflicts and add a
+ * read-over-weakeq lemma for each conflict.  Returns the number of lemmas
+ * added. */
+static uint32_t
+add_weakeq_lemmas (Btor *btor)
+{
+  assert (btor);
+  assert (btor->slv);
+  assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
+
+  uint32_t i, j, k, search, first_search, num_lemmas = 0;
+  int32_t n, source;
+  BtorMemMgr *mm;
+  BtorWeakEqNodeStack nodes;
+  BtorWeakEqReadStack reads;
+  BtorWeakEqRead *read;
+  BtorIntStack queue;
+  BtorPtrHashTable *groups;
+  BtorPtrHashBucket *b;
+
+  BTORLOG (1, "");
+  BTORLOG (1, "*** %s", __FUNCTION__);
+
+  mm = btor->mm;
+  BTOR_INIT_STACK (mm, nodes);
+  BTOR_INIT_STACK (mm, reads);
+  BTOR_INIT_STACK (mm, queue);
+
+  build_weakeq_graph (btor, &nodes, &reads);
+
+  /* group reads by the value of their index */
+  groups = btor_hashptr_table_new (mm,
+                                   (BtorHashPtr) hash_args_assignment,
+                                   (BtorCmpPtr) compare_args_assignments);
+  for (i = 0; i < BTOR_COUNT_STACK (reads); i++)
+  {
+    read = reads.start + i;
+    if (!(b = btor_hashptr_table_get (groups, read->args)))
+    {
+      b              = btor_hashptr_table_add (groups, read->args);
+      b->data.as_int = groups->count;
+    }
+    read->group = b->data.as_int;
+  }
+  btor_hashptr_table_delete (groups);
+  qsort (reads.start,
+         BTOR_COUNT_STACK (reads),
+         sizeof (BtorWeakEqRead),
+         compare_weakeq_reads_qsort);
+
+  /* Per group, search the arrays weakly equivalent on the group index from
+   * each read not reached yet, and compare the reads reached against the
+   * read the search started from. */
+  search = 0;
+  for (i = 0; i < BTOR_COUNT_STACK (reads); i = j)
+  {
+    for (j = i; j < BTOR_COUNT_STACK (reads)
+                && reads.start[j].group == reads.start[i].group;
+         j++)
+      ;
+    if (j - i < 2) continue;
+
+    first_search = search + 1;
+    for (k = i; k < j; k++)
+    {
+      n = reads.start[k].node;
+      if (nodes.start[n].search < first_search)
+      {
+        search_weakeq (&nodes, reads.start, k, ++search, &queue);
+        continue;
+      }
+      source = nodes.start[n].source;
+      if (equal_bv_assignments (reads.start[source].value,
+                                reads.start[k].value))
+        continue;
+      if (add_weakeq_lemma (
+              btor, &nodes, reads.start + source, reads.start + k))
+        num_lemmas++;
+    }
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (nodes); i++)
+  {
+    BTOR_RELEASE_STACK (nodes.start[i].adj);
+    BTOR_RELEASE_STACK (nodes.start[i].labels);
+  }
+  BTOR_RELEASE_STACK (nodes);
+  BTOR_RELEASE_STACK (reads);
+  BTOR_RELEASE_STACK (queue);
+  return num_lemmas;
+}
+
 static void
 add_extensionality_lemmas (Btor *btor)
 {
@@ -2026,12 +2597,20 @@ add_extensionality_lemmas (Btor *btor)
   BtorFunSolver *slv;
 
   start = btor_util_time_stamp ();
+  slv   = BTOR_FUN_SOLVER (btor);
+
+  /* Conflicts between existing reads of weakly equivalent arrays yield
+   * smaller lemmas, check these first. */
+  if (btor_opt_get (btor, BTOR_OPT_FUN_WEAKEQ) && add_weakeq_lemmas (btor) > 0)
+  {
+    slv->time.check_extensionality += btor_util_time_stamp () - start;
+    return;
+  }
 
   BTORLOG (1, "");
   BTORLOG (1, "*** %s", __FUNCTION__);
 
-  slv = BTOR_FUN_SOLVER (btor);
-  mm  = btor->mm;
+  mm = btor->mm;
   BTOR_INIT_STACK (mm, feqs);
   BTOR_INIT_STACK (mm, const_arrays);
 
@@ -2405,6 +2984,120 @@ reset_lemma_cache (BtorFunSolver *slv)
                                         (BtorCmpPtr) btor_node_compare_by_id);
 }
 
+/* Returns true if all function applications of 'lemma' occur in the cone
+ * of influence of the current formula, which is given by 'reachable'. */
+static bool
+is_relevant_lemma (Btor *btor, BtorIntHashTable *reachable, BtorNode *lemma)
+{
+  bool res;
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *cache;
+
+  res   = true;
+  cache = btor_hashint_table_new (btor->mm);
+  BTOR_INIT_STACK (btor->mm, visit);
+  BTOR_PUSH_STACK (visit, lemma);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (reachable, cur->id)
+        || btor_hashint_table_contains (cache, cur->id))
+      continue;
+    if (btor_node_is_apply (cur))
+    {
+      res = false;
+      break;
+    }
+    btor_hashint_table_add (cache, cur->id);
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (cache);
+  return res;
+}
+
+/* Lemmas are valid in the theory of arrays/functions.  If lemmas are assumed
+ * rather than asserted, they are not part of the formula in subsequent
+ * calls.  Instead of rediscovering them, lemmas of previous calls that are
+ * still relevant for the current formula are assumed again.  The cache keeps
+ * at most BTOR_OPT_FUN_LEMMA_REUSE lemmas, the oldest lemmas are evicted
+ * first. */
+static void
+reuse_lemmas (BtorFunSolver *slv)
+{
+  uint32_t i, max, num_evict, num_reused;
+  Btor *btor;
+  BtorNode *cur, *lemma;
+  BtorNodePtrStack visit, lemmas;
+  BtorIntHashTable *reachable;
+  BtorPtrHashTableIterator it;
+
+  btor = slv->btor;
+  max  = btor_opt_get (btor, BTOR_OPT_FUN_LEMMA_REUSE);
+  if (!max)
+  {
+    reset_lemma_cache (slv);
+    return;
+  }
+  if (slv->lemmas->count == 0) return;
+
+  /* collect cone of influence of the current formula */
+  reachable = btor_hashint_table_new (btor->mm);
+  BTOR_INIT_STACK (btor->mm, visit);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->embedded_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (visit, btor_iter_hashptr_next (&it));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (reachable, cur->id)) continue;
+    btor_hashint_table_add (reachable, cur->id);
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  BTOR_RELEASE_STACK (visit);
+
+  /* lemmas are stored in insertion order, the cache takes over the
+   * references of the stored lemmas */
+  BTOR_INIT_STACK (btor->mm, lemmas);
+  btor_iter_hashptr_init (&it, slv->lemmas);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (lemmas, btor_iter_hashptr_next (&it));
+  btor_hashptr_table_delete (slv->lemmas);
+  slv->lemmas = btor_hashptr_table_new (btor->mm,
+                                        (BtorHashPtr) btor_node_hash_by_id,
+                                        (BtorCmpPtr) btor_node_compare_by_id);
+
+  num_evict  = BTOR_COUNT_STACK (lemmas) > max ? BTOR_COUNT_STACK (lemmas) - max
+                                               : 0;
+  num_reused = 0;
+  for (i = 0; i < BTOR_COUNT_STACK (lemmas); i++)
+  {
+    cur   = BTOR_PEEK_STACK (lemmas, i);
+    lemma = btor_simplify_exp (btor, cur);
+    if (i < num_evict)
+      slv->stats.lemmas_evicted++;
+    else if (!btor_node_is_bv_const (lemma)
+             && is_relevant_lemma (btor, reachable, lemma)
+             && !btor_hashptr_table_get (slv->lemmas, lemma))
+    {
+      btor_hashptr_table_add (slv->lemmas, btor_node_copy (btor, lemma));
+      btor_assume_exp (btor, lemma);
+      num_reused++;
+    }
+    btor_node_release (btor, cur);
+  }
+  BTOR_RELEASE_STACK (lemmas);
+  btor_hashint_table_delete (reachable);
+
+  slv->stats.lemmas_reused += num_reused;
+  BTOR_MSG (btor->msg, 1, "re-used %u lemmas of previous calls", num_reused);
+}
+
 static BtorSolverResult
 sat_fun_solver (BtorFunSolver *slv)
 {
@@ -2414,7 +3107,7 @@ sat_fun_solver (BtorFunSolver *slv)
   assert (slv->btor->slv == (BtorSolver *) slv);
 
   uint32_t i;
-  bool done;
+  bool done, phase_hints;
   BtorSolverResult result;
   Btor *btor, *clone;
   BtorNode *clone_root, *lemma;
@@ -2430,9 +3123,10 @@ sat_fun_solver (BtorFunSolver *slv)
   BTOR_INIT_STACK (btor->mm, init_apps);
   init_apps_cache = btor_hashint_table_new (btor->mm);
 
-  clone      = 0;
-  clone_root = 0;
-  exp_map    = 0;
+  clone       = 0;
+  clone_root  = 0;
+  exp_map     = 0;
+  phase_hints = false;
 
   if ((btor_opt_get (btor, BTOR_OPT_FUN_PREPROP)
        || btor_opt_get (btor, BTOR_OPT_FUN_PRESLS))
@@ -2475,8 +3169,8 @@ sat_fun_solver (BtorFunSolver *slv)
                 result == BTOR_RESULT_SAT ? "'sat'" : "'unsat'");
       goto DONE;
     }
-    /* reset */
-    btor_model_delete (btor);
+    /* keep the model of the presolver as phase hints for the SAT solver */
+    phase_hints = true;
   }
 
   if (btor_terminate (btor))
@@ -2488,14 +3182,20 @@ sat_fun_solver (BtorFunSolver *slv)
 
   configure_sat_mgr (btor);
 
-  if (slv->assume_lemmas) reset_lemma_cache (slv);
+  slv->stats.calls++;
+  if (slv->assume_lemmas) reuse_lemmas (slv);
 
   if (btor->feqs->count > 0) add_function_inequality_constraints (btor);
 
   /* initialize dual prop clone */
   if (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP))
   {
-    clone = new_exp_layer_clone_for_dual_prop (btor, &exp_map, &clone_root);
+    clone_root = sync_dual_prop_clone (slv);
+    if (clone_root)
+    {
+      clone   = slv->dp_clone;
+      exp_map = slv->dp_exp_map;
+    }
   }
 
   while (true)
@@ -2518,6 +3218,16 @@ sat_fun_solver (BtorFunSolver *slv)
     assert (btor_dbg_check_all_hash_tables_proxy_free (btor));
     assert (btor_dbg_check_all_hash_tables_simp_free (btor));
 
+    /* bit-blasting may have exceeded the memory limit */
+    if (btor_terminate (btor)) goto UNKNOWN;
+
+    if (phase_hints)
+    {
+      set_phase_hints (btor);
+      btor_model_delete (btor);
+      phase_hints = false;
+    }
+
     /* make SAT call on bv skeleton */
     btor_add_again_assumptions (btor);
     result = timed_sat_sat (btor, slv->sat_limit);
@@ -2527,6 +3237,7 @@ sat_fun_solver (BtorFunSolver *slv)
     else if (result == BTOR_RESULT_UNKNOWN)
     {
       assert (slv->sat_limit > -1 || btor->cbs.term.done
+              || btor->mm->hard_limit_reached
               || btor_opt_get (btor, BTOR_OPT_PRINT_DIMACS));
       goto DONE;
     }
@@ -2574,16 +3285,16 @@ sat_fun_solver (BtorFunSolver *slv)
   }
 
 DONE:
+  if (phase_hints) btor_model_delete (btor);
   BTOR_RELEASE_STACK (init_apps);
   btor_hashint_table_delete (init_apps_cache);
 
   if (clone)
   {
     assert (exp_map);
-    btor_nodemap_delete (exp_map);
     btor_node_release (clone, clone_root);
-    btor_delete (clone);
   }
+  if (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL)) delete_dual_prop_clone (slv);
   return result;
 }
 
@@ -2650,6 +3361,11 @@ print_stats_fun_solver (BtorFunSolver *slv)
                 1,
                 "  %4d extensionality lemmas",
                 slv->stats.extensionality_lemmas);
+      if (btor_opt_get (btor, BTOR_OPT_FUN_WEAKEQ))
+        BTOR_MSG (btor->msg,
+                  1,
+                  "  %4d read-over-weakeq lemmas",
+                  slv->stats.weakeq_lemmas);
       BTOR_MSG (btor->msg,
                 1,
                 "  %.1f average lemma size",
@@ -2665,6 +3381,23 @@ print_stats_fun_solver (BtorFunSolver *slv)
                   i);
       }
     }
+    BTOR_MSG (btor->msg,
+              1,
+              "%.1f refinement iterations per call",
+              BTOR_AVERAGE_UTIL (slv->stats.refinement_iterations,
+                                 slv->stats.calls));
+    if (slv->stats.lemmas_reused || slv->stats.lemmas_evicted)
+    {
+      BTOR_MSG (btor->msg,
+                1,
+                "%4d lemmas re-used (%.1f%% of all lemmas)",
+                slv->stats.lemmas_reused,
+                100 * BTOR_AVERAGE_UTIL (slv->stats.lemmas_reused,
+                                         slv->stats.lemmas_reused
+                                             + slv->stats.lod_refinements));
+      BTOR_MSG (
+          btor->msg, 1, "%4d lemmas evicted", slv->stats.lemmas_evicted);
+    }
   }
 
   BTOR_MSG (btor->msg, 1, "");
@@ -2690,6 +3423,7 @@ print_stats_fun_solver (BtorFunSolver *slv)
               "%d/%d dual prop. applies (failed/assumed)",
               slv->stats.dp_failed_applies,
               slv->stats.dp_assumed_applies);
+    BTOR_MSG (btor->msg, 1, "%7d dual prop. clones", slv->stats.dp_clones);
   }
 }
 
@@ -2734,6 +3468,10 @@ print_time_stats_fun_solver (BtorFunSolver *slv)
               1,
               "    %.2f seconds cloning",
               slv->time.search_init_apps_cloning);
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds clone maintenance",
+              slv->time.search_init_apps_clone_sync);
     BTOR_MSG (btor->msg,
               1,
               "    %.2f seconds SAT solving",
@@ -12,6 +12,7 @@
 #include "btornode.h"
 #include "btorslv.h"
 #include "utils/btorhashptr.h"
+#include "utils/btornodemap.h"
 
 #define BTOR_FUN_SOLVER(btor) ((BtorFunSolver *) (btor)->slv)
 
@@ -29,6 +30,11 @@ struct BtorFunSolver
   int32_t sat_limit;
   bool assume_lemmas;
 
+  /* dual propagation clone, kept alive across incremental calls */
+  Btor *dp_clone;
+  BtorNodeMap *dp_exp_map;
+  uint32_t dp_unreachable; /* unreachable mapped expressions after cloning */
+
   struct
   {
     uint32_t lod_refinements; /* number of lemmas on demand refinements */
@@ -37,6 +43,10 @@ struct BtorFunSolver
     uint32_t function_congruence_conflicts;
     uint32_t beta_reduction_conflicts;
     uint32_t extensionality_lemmas;
+    uint32_t weakeq_lemmas; /* number of read-over-weakeq lemmas */
+    uint32_t lemmas_reused;  /* number of lemmas re-used from previous calls */
+    uint32_t lemmas_evicted; /* number of lemmas evicted from the cache */
+    uint32_t calls;          /* number of sat calls */
 
     BtorUIntStack lemmas_size;      /* distribution of n-size lemmas */
     uint_least64_t lemmas_size_sum; /* sum of the size of all added lemmas */
@@ -49,6 +59,7 @@ struct BtorFunSolver
     uint32_t dp_assumed_applies;
     uint32_t dp_failed_eqs;
     uint32_t dp_assumed_eqs;
+    uint32_t dp_clones; /* number of times the dual prop clone was built */
 
     uint_least64_t eval_exp_calls;
     uint_least64_t propagations;
@@ -63,6 +74,7 @@ struct BtorFunSolver
     double search_init_apps_compute_scores;
     double search_init_apps_compute_scores_merge_applies;
     double search_init_apps_cloning;
+    double search_init_apps_clone_sync;
     double search_init_apps_sat;
     double search_init_apps_collect_var_apps;
     double search_init_apps_collect_fa;
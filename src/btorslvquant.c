@@ -178,7 +178,7 @@ flat_model_get_value (FlatModel *flat_model,
     }
     else
     {
-      b = flat_model->model->first;
+      b = btor_hashptr_table_first (flat_model->model);
       assert (b);
       t   = b->data.as_ptr;
       res = t->bv[i];
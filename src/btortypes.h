@@ -21,6 +21,17 @@ enum BtorSolverResult
 
 typedef enum BtorSolverResult BtorSolverResult;
 
+/* Reason for the last SAT call returning BTOR_RESULT_UNKNOWN. */
+enum BtorUnknownReason
+{
+  BTOR_UNKNOWN_REASON_NONE,       /* last result is not unknown */
+  BTOR_UNKNOWN_REASON_INCOMPLETE, /* incomplete engine or lod/sat limit */
+  BTOR_UNKNOWN_REASON_TERMINATED, /* termination callback */
+  BTOR_UNKNOWN_REASON_MEMORY,     /* memory limit exceeded */
+};
+
+typedef enum BtorUnknownReason BtorUnknownReason;
+
 /* public API types */
 typedef struct BoolectorNode BoolectorNode;
 
@@ -141,6 +152,9 @@ enum BtorOption
         bit-blasted formula (the AIG layer)
       * BTOR_ENGINE_QUANT:
         the quantifier engine (BV only)
+      * BTOR_ENGINE_ABS:
+        the abstraction refinement QF_BV engine, abstracts wide
+        multiplications, divisions and remainders and refines them lazily
   */
   BTOR_OPT_ENGINE,
 
@@ -164,6 +178,18 @@ enum BtorOption
   */
   BTOR_OPT_SAT_ENGINE,
 
+  /*!
+    * **BTOR_OPT_SAT_ENGINE_PORTFOLIO**
+
+      | Enable (``value``: 1) or disable (``value``: 0) racing all configured
+        SAT solvers that can be terminated on separate threads.
+      | Every SAT call is forwarded to all solvers, the first solver that
+        decides the call provides the model and the failed assumptions, all
+        other solvers are terminated.
+      | Requires pthreads.
+  */
+  BTOR_OPT_SAT_ENGINE_PORTFOLIO,
+
   /*!
     * **BTOR_OPT_AUTO_CLEANUP**
 
@@ -236,6 +262,32 @@ enum BtorOption
   */
   BTOR_OPT_REWRITE_LEVEL,
 
+  /*!
+    * **BTOR_OPT_RW_CACHE_SIZE**
+
+      | Set the memory budget (``value``: MB) of the rewrite cache.
+      | The rewrite cache grows up to the given size, beyond that the least
+        recently used entries are evicted. A value of 0 disables the
+        rewrite cache.
+  */
+  BTOR_OPT_RW_CACHE_SIZE,
+
+  /*!
+    * **BTOR_OPT_MEMORY_LIMIT**
+
+      | Set a limit (``value``: MB) on the memory used by Boolector,
+        including the memory of the SAT solver (if supported).
+        A value of 0 disables the limit.
+      | Only the memory of Lingeling and PicoSAT is counted, the memory of
+        CaDiCaL, CryptoMiniSat and MiniSat is not.
+      | When 80% of the limit are exceeded, caches are released.
+        When the limit is exceeded, the current SAT call terminates and
+        returns ``BOOLECTOR_UNKNOWN``, and boolector_get_unknown_reason
+        returns ``BOOLECTOR_UNKNOWN_REASON_MEMORY``. The instance can still
+        be used incrementally afterwards.
+  */
+  BTOR_OPT_MEMORY_LIMIT,
+
   /*!
     * **BTOR_OPT_SKELETON_PREPROC**
 
@@ -252,6 +304,17 @@ enum BtorOption
   */
   BTOR_OPT_ACKERMANN,
 
+  /*!
+    * **BTOR_OPT_ACKERMANN_PRUNE**
+
+      | Enable (``value``: 1) or disable (``value``: 0) pruning of pairs of
+        function applications with provably distinct arguments (distinct
+        constants, disjoint known bits) when adding Ackermann constraints.
+      | Only effective if Ackermann constraints are enabled (see
+        BTOR_OPT_ACKERMANN).
+  */
+  BTOR_OPT_ACKERMANN_PRUNE,
+
   /*!
     * **BTOR_OPT_BETA_REDUCE**
 
@@ -316,6 +379,81 @@ enum BtorOption
   */
   BTOR_OPT_NORMALIZE_ADD,
 
+  /*!
+    * **BTOR_OPT_AIG_REWRITE**
+
+      Enable (``value``: 1) or disable (``value``: 0) cut-based rewriting
+      of AIGs before they are translated to CNF.
+  */
+  BTOR_OPT_AIG_REWRITE,
+
+  /*!
+    * **BTOR_OPT_AIG_CNF_PG**
+
+      | Enable (``value``: 1) or disable (``value``: 0) polarity-aware
+        (Plaisted-Greenbaum) CNF encoding of constraints.
+      | If enabled, only the clauses of a gate definition that are required
+        by the polarities in which the gate occurs are generated.
+        Definitions are completed on demand in incremental mode.
+  */
+  BTOR_OPT_AIG_CNF_PG,
+
+  /*!
+    * **BTOR_OPT_AIG_CNF_NARY**
+
+      Enable (``value``: 1) or disable (``value``: 0) encoding of trees of
+      non-shared AND gates as one n-ary AND gate.
+  */
+  BTOR_OPT_AIG_CNF_NARY,
+
+  /*!
+    * **BTOR_OPT_SYNTH_THREADS**
+
+      | Set the number of threads used for bit-blasting independent
+        constraints (``value``: 0 or 1 disables concurrent bit-blasting).
+      | Constraints are independent if they do not share any expressions
+        other than constants. The bit-blasted formula is the same for any
+        number of threads greater than one.
+  */
+  BTOR_OPT_SYNTH_THREADS,
+
+  /*!
+    * **BTOR_OPT_MUL_ENC**
+
+      Select the circuit used for bit-blasting multiplications.
+
+      * BTOR_MUL_ENC_ARRAY [default]:
+        shift-and-add array multiplier
+      * BTOR_MUL_ENC_BOOTH:
+        radix-4 Booth multiplier with a Dadda tree
+      * BTOR_MUL_ENC_WALLACE:
+        Wallace tree multiplier
+      * BTOR_MUL_ENC_DADDA:
+        Dadda tree multiplier
+  */
+  BTOR_OPT_MUL_ENC,
+
+  /*!
+    * **BTOR_OPT_MUL_CSD**
+
+      Enable (``value``: 1) or disable (``value``: 0) the canonical signed
+      digit encoding of multiplications with a constant operand.
+  */
+  BTOR_OPT_MUL_CSD,
+
+  /*!
+    * **BTOR_OPT_DIV_ENC**
+
+      Select the circuit used for bit-blasting unsigned divisions and
+      remainders.
+
+      * BTOR_DIV_ENC_RESTORING [default]:
+        restoring array divider
+      * BTOR_DIV_ENC_NONRESTORING:
+        non-restoring array divider
+  */
+  BTOR_OPT_DIV_ENC,
+
   /* --------------------------------------------------------------------- */
   /*!
     **Fun Engine Options:**
@@ -407,6 +545,30 @@ enum BtorOption
   */
   BTOR_OPT_FUN_EAGER_LEMMAS,
 
+  /*!
+    * **BTOR_OPT_FUN_LEMMA_REUSE**
+
+      | Set the maximum number of lemmas that are kept for re-use in
+        subsequent calls if lemmas are assumed rather than asserted, e.g.,
+        by the quantifier engine (``value``: 0 disables re-use).
+      | Lemmas whose function applications still occur in the formula are
+        assumed again instead of being rediscovered.
+  */
+  BTOR_OPT_FUN_LEMMA_REUSE,
+
+  /*!
+    * **BTOR_OPT_FUN_WEAKEQ**
+
+      | Enable (``value``: 1) or disable (``value``: 0) checking array
+        equalities via a weak equivalence graph over array equalities,
+        array conditionals and stores.
+      | Reads of weakly equivalent arrays with conflicting values yield
+        read-over-weak-equivalence lemmas. Instantiations of the
+        extensionality axiom are only generated if there are no such
+        conflicts.
+  */
+  BTOR_OPT_FUN_WEAKEQ,
+
   BTOR_OPT_FUN_STORE_LAMBDAS,
 
   /*!
@@ -766,6 +928,31 @@ enum BtorOption
   */
   BTOR_OPT_AIGPROP_USE_BANDIT,
 
+  /* --------------------------------------------------------------------- */
+  /*!
+    **ABS Engine Options**:
+   */
+  /* --------------------------------------------------------------------- */
+
+  /*!
+    * **BTOR_OPT_ABS_MIN_WIDTH**
+
+      | Set the minimum bit-width of multiplications, unsigned divisions and
+        unsigned remainders that are abstracted.
+      | Narrower nodes are bit-blasted eagerly.
+  */
+  BTOR_OPT_ABS_MIN_WIDTH,
+
+  /*!
+    * **BTOR_OPT_ABS_LEMMAS**
+
+      | Set the number of lemmas added for an abstracted node before it is
+        bit-blasted.
+      | A lemma fixes the value of the node for the current values of its
+        operands.
+  */
+  BTOR_OPT_ABS_LEMMAS,
+
   /* QUANT engine ------------------------------------------------------- */
   /*!
     * **BTOR_OPT_QUANT_SYNTH**
@@ -887,6 +1074,7 @@ enum BtorOptEngine
   BTOR_ENGINE_PROP,
   BTOR_ENGINE_AIGPROP,
   BTOR_ENGINE_QUANT,
+  BTOR_ENGINE_ABS,
 };
 typedef enum BtorOptEngine BtorOptEngine;
 
@@ -986,6 +1174,22 @@ enum BtorOptBetaReduceMode
 };
 typedef enum BtorOptBetaReduceMode BtorOptBetaReduceMode;
 
+enum BtorOptMulEnc
+{
+  BTOR_MUL_ENC_ARRAY,
+  BTOR_MUL_ENC_BOOTH,
+  BTOR_MUL_ENC_WALLACE,
+  BTOR_MUL_ENC_DADDA,
+};
+typedef enum BtorOptMulEnc BtorOptMulEnc;
+
+enum BtorOptDivEnc
+{
+  BTOR_DIV_ENC_RESTORING,
+  BTOR_DIV_ENC_NONRESTORING,
+};
+typedef enum BtorOptDivEnc BtorOptDivEnc;
+
 /* --------------------------------------------------------------------- */
 
 /* Callback function to be executed on abort, primarily intended to be used for
@@ -411,7 +411,7 @@ hmap_clear (BtorPtrHashTable *hmap)
 
   BtorPtrHashBucket *bucket;
 
-  for (bucket = hmap->first; bucket; bucket = hmap->first)
+  while ((bucket = btor_hashptr_table_first (hmap)))
   {
     char *key = (char *) bucket->key;
     btor_hashptr_table_remove (hmap, key, NULL, NULL);
@@ -733,6 +733,14 @@ NEXT:
       PARSE_ARGS0 (tok);
       boolector_print_stats (btor);
     }
+    else if (!strcmp (tok, "get_mem_allocated"))
+    {
+      PARSE_ARGS1 (tok, str);
+      /* memory usage depends on the build, do not check the result */
+      (void) boolector_get_mem_allocated (
+          btor, strcmp (arg1_str, "(null)") ? arg1_str : 0);
+      exp_ret = RET_SKIP;
+    }
     else if (!strcmp (tok, "assert"))
     {
       PARSE_ARGS1 (tok, str);
@@ -771,6 +779,12 @@ NEXT:
       ret_int = boolector_limited_sat (btor, arg1_int, arg2_int);
       exp_ret = g_btorunt->ignore_sat ? RET_SKIP : RET_INT;
     }
+    else if (!strcmp (tok, "get_unknown_reason"))
+    {
+      PARSE_ARGS0 (tok);
+      ret_int = boolector_get_unknown_reason (btor);
+      exp_ret = g_btorunt->ignore_sat ? RET_SKIP : RET_INT;
+    }
     else if (!strcmp (tok, "simplify"))
     {
       PARSE_ARGS0 (tok);
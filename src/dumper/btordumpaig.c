@@ -206,6 +206,7 @@ btor_dumpaig_dump_seq (BtorAIGMgr *amgr,
   BtorPtrHashTable *table, *latches;
   BtorAIG *aig, *left, *right;
   BtorPtrHashBucket *p, *b;
+  BtorPtrHashTableIterator it;
   int32_t M, I, L, O, A, i, l;
   BtorAIGPtrStack stack;
   unsigned char ch;
@@ -359,8 +360,10 @@ btor_dumpaig_dump_seq (BtorAIGMgr *amgr,
   /* Only need to print inputs in non binary mode.
    */
   i = 0;
-  for (p = table->first; p; p = p->next)
+  btor_iter_hashptr_init (&it, table);
+  while (btor_iter_hashptr_has_next (&it))
   {
+    p   = it.bucket;
     aig = p->key;
 
     assert (aig);
@@ -368,6 +371,8 @@ btor_dumpaig_dump_seq (BtorAIGMgr *amgr,
 
     if (!btor_aig_is_var (aig)) break;
 
+    (void) btor_iter_hashptr_next (&it);
+
     if (btor_hashptr_table_get (latches, aig)) continue;
 
     if (!is_binary) fprintf (file, "%d\n", 2 * p->data.as_int);
@@ -391,9 +396,10 @@ btor_dumpaig_dump_seq (BtorAIGMgr *amgr,
 
   /* And finally all the AND gates.
    */
-  while (p)
+  while (btor_iter_hashptr_has_next (&it))
   {
-    aig = p->key;
+    p   = it.bucket;
+    aig = btor_iter_hashptr_next (&it);
 
     assert (aig);
     assert (!BTOR_IS_INVERTED_AIG (aig));
@@ -433,8 +439,6 @@ btor_dumpaig_dump_seq (BtorAIGMgr *amgr,
     }
     else
       fprintf (file, "%u %u %u\n", aig_id, left_id, right_id);
-
-    p = p->next;
   }
 
   /* If we have back annotation add a symbol table.
@@ -442,9 +446,10 @@ btor_dumpaig_dump_seq (BtorAIGMgr *amgr,
   i = l = 0;
   if (backannotation)
   {
-    for (p = table->first; p; p = p->next)
+    btor_iter_hashptr_init (&it, table);
+    while (btor_iter_hashptr_has_next (&it))
     {
-      aig = p->key;
+      aig = btor_iter_hashptr_next (&it);
       if (!btor_aig_is_var (aig)) break;
 
       b = btor_hashptr_table_get (backannotation, aig);
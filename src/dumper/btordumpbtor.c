@@ -489,8 +489,8 @@ bdcnode (BtorDumpContext *bdc, BtorNode *node, FILE *file)
     assert (btor_node_fun_get_arity (bdc->btor, node) == 1);
     rho = btor_node_lambda_get_static_rho (node);
     assert (rho->count == 1);
-    index = rho->first->key;
-    value = rho->first->data.as_ptr;
+    index = btor_hashptr_table_first (rho)->key;
+    value = btor_hashptr_table_first (rho)->data.as_ptr;
     assert (value);
     assert (btor_node_is_regular (index));
     assert (btor_node_is_args (index));
@@ -438,7 +438,8 @@ static void
 release_smt_nodes (BtorSMTParser *parser)
 {
   while (parser->nodes && parser->nodes->count)
-    recursively_delete_smt_node (parser, parser->nodes->first->key);
+    recursively_delete_smt_node (parser,
+                                 btor_hashptr_table_first (parser->nodes)->key);
 }
 
 static void
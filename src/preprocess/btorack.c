@@ -8,30 +8,387 @@
 
 #include "preprocess/btorack.h"
 
+#include "btorbv.h"
 #include "btorcore.h"
 #include "btorexp.h"
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
 
+/*------------------------------------------------------------------------*/
+
+/* Known bits of a bit-vector term.  Bits not set in 'mask' are unknown,
+ * bits of 'value' not set in 'mask' are 0. */
+struct BtorAckBits
+{
+  BtorBitVector *mask;
+  BtorBitVector *value;
+};
+
+typedef struct BtorAckBits BtorAckBits;
+
+/* Known bits of the argument tuple of a function application. */
+struct BtorAckApply
+{
+  BtorNode *apply;
+  BtorBitVectorTuple *mask;
+  BtorBitVectorTuple *value;
+  bool ground; /* all argument bits are known */
+};
+
+typedef struct BtorAckApply BtorAckApply;
+
+/* Get (a copy of) the known bits of 'exp', which are already computed for
+ * its real address. */
+static void
+get_known_bits (BtorMemMgr *mm,
+                BtorIntHashTable *bits,
+                BtorNode *exp,
+                BtorBitVector **mask,
+                BtorBitVector **value)
+{
+  BtorAckBits *b;
+  BtorBitVector *tmp;
+
+  b = btor_hashint_map_get (bits, btor_node_real_addr (exp)->id)->as_ptr;
+  *mask = btor_bv_copy (mm, b->mask);
+  if (btor_node_is_inverted (exp))
+  {
+    tmp    = btor_bv_not (mm, b->value);
+    *value = btor_bv_and (mm, tmp, b->mask);
+    btor_bv_free (mm, tmp);
+  }
+  else
+    *value = btor_bv_copy (mm, b->value);
+}
+
+/* Light-weight forward propagation of known bits over constants, slices,
+ * concatenations, ANDs and if-then-else terms.  Results are cached in
+ * 'bits' for the real addresses of the visited nodes. */
+static void
+compute_known_bits (Btor *btor, BtorIntHashTable *bits, BtorNode *exp)
+{
+  uint32_t i, width;
+  BtorMemMgr *mm;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *visited;
+  BtorBitVector *m[3], *v[3], *tmp0, *tmp1;
+  BtorAckBits *b;
+
+  mm      = btor->mm;
+  visited = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_PUSH_STACK (visit, btor_node_real_addr (exp));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_POP_STACK (visit);
+    assert (btor_node_is_regular (cur));
+
+    if (btor_hashint_map_contains (bits, cur->id)) continue;
+
+    if (!btor_hashint_table_contains (visited, cur->id)
+        && (btor_node_is_bv_slice (cur) || btor_node_is_bv_concat (cur)
+            || btor_node_is_bv_and (cur) || btor_node_is_bv_cond (cur)))
+    {
+      btor_hashint_table_add (visited, cur->id);
+      BTOR_PUSH_STACK (visit, cur);
+      /* the condition of an if-then-else is not needed */
+      for (i = btor_node_is_bv_cond (cur) ? 1 : 0; i < cur->arity; i++)
+        BTOR_PUSH_STACK (visit, btor_node_real_addr (cur->e[i]));
+      continue;
+    }
+
+    BTOR_NEW (mm, b);
+    width = btor_node_bv_get_width (btor, cur);
+    if (btor_node_is_bv_const (cur))
+    {
+      b->mask  = btor_bv_ones (mm, width);
+      b->value = btor_bv_copy (mm, btor_node_bv_const_get_bits (cur));
+    }
+    else if (btor_node_is_bv_slice (cur))
+    {
+      get_known_bits (mm, bits, cur->e[0], &m[0], &v[0]);
+      b->mask  = btor_bv_slice (mm,
+                               m[0],
+                               btor_node_bv_slice_get_upper (cur),
+                               btor_node_bv_slice_get_lower (cur));
+      b->value = btor_bv_slice (mm,
+                                v[0],
+                                btor_node_bv_slice_get_upper (cur),
+                                btor_node_bv_slice_get_lower (cur));
+      btor_bv_free (mm, m[0]);
+      btor_bv_free (mm, v[0]);
+    }
+    else if (btor_node_is_bv_concat (cur))
+    {
+      get_known_bits (mm, bits, cur->e[0], &m[0], &v[0]);
+      get_known_bits (mm, bits, cur->e[1], &m[1], &v[1]);
+      b->mask  = btor_bv_concat (mm, m[0], m[1]);
+      b->value = btor_bv_concat (mm, v[0], v[1]);
+      for (i = 0; i < 2; i++)
+      {
+        btor_bv_free (mm, m[i]);
+        btor_bv_free (mm, v[i]);
+      }
+    }
+    else if (btor_node_is_bv_and (cur))
+    {
+      /* a bit is known if it is 0 in one operand or 1 in both operands */
+      get_known_bits (mm, bits, cur->e[0], &m[0], &v[0]);
+      get_known_bits (mm, bits, cur->e[1], &m[1], &v[1]);
+      b->value = btor_bv_and (mm, v[0], v[1]);
+      tmp0     = btor_bv_xor (mm, m[0], v[0]);
+      tmp1     = btor_bv_xor (mm, m[1], v[1]);
+      m[2]     = btor_bv_or (mm, tmp0, tmp1);
+      b->mask  = btor_bv_or (mm, m[2], b->value);
+      btor_bv_free (mm, tmp0);
+      btor_bv_free (mm, tmp1);
+      btor_bv_free (mm, m[2]);
+      for (i = 0; i < 2; i++)
+      {
+        btor_bv_free (mm, m[i]);
+        btor_bv_free (mm, v[i]);
+      }
+    }
+    else if (btor_node_is_bv_cond (cur))
+    {
+      /* a bit is known if it is known and equal in both branches */
+      get_known_bits (mm, bits, cur->e[1], &m[1], &v[1]);
+      get_known_bits (mm, bits, cur->e[2], &m[2], &v[2]);
+      tmp0     = btor_bv_xor (mm, v[1], v[2]);
+      tmp1     = btor_bv_not (mm, tmp0);
+      m[0]     = btor_bv_and (mm, m[1], m[2]);
+      b->mask  = btor_bv_and (mm, m[0], tmp1);
+      b->value = btor_bv_and (mm, v[1], b->mask);
+      btor_bv_free (mm, tmp0);
+      btor_bv_free (mm, tmp1);
+      btor_bv_free (mm, m[0]);
+      for (i = 1; i < 3; i++)
+      {
+        btor_bv_free (mm, m[i]);
+        btor_bv_free (mm, v[i]);
+      }
+    }
+    else
+    {
+      b->mask  = btor_bv_zero (mm, width);
+      b->value = btor_bv_zero (mm, width);
+    }
+    btor_hashint_map_add (bits, cur->id)->as_ptr = b;
+  }
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (visited);
+}
+
+static void
+delete_known_bits (BtorMemMgr *mm, BtorIntHashTable *bits)
+{
+  size_t i;
+  BtorAckBits *b;
+
+  for (i = 0; i < bits->size; i++)
+  {
+    if (!bits->keys[i]) continue;
+    b = bits->data[i].as_ptr;
+    btor_bv_free (mm, b->mask);
+    btor_bv_free (mm, b->value);
+    BTOR_DELETE (mm, b);
+  }
+  btor_hashint_map_delete (bits);
+}
+
+/* Returns true if the argument tuples of 'a' and 'b' are provably distinct,
+ * i.e., if some argument bit is known in both and differs. */
+static bool
+is_distinct_args (BtorAckApply *a, BtorAckApply *b)
+{
+  assert (a->mask->arity == b->mask->arity);
+
+  uint32_t i, j, width;
+  BtorBitVector *ma, *va, *mb, *vb;
+
+  for (i = 0; i < a->mask->arity; i++)
+  {
+    ma    = a->mask->bv[i];
+    va    = a->value->bv[i];
+    mb    = b->mask->bv[i];
+    vb    = b->value->bv[i];
+    width = btor_bv_get_width (ma);
+    for (j = 0; j < width; j++)
+    {
+      if (btor_bv_get_bit (ma, j) && btor_bv_get_bit (mb, j)
+          && btor_bv_get_bit (va, j) != btor_bv_get_bit (vb, j))
+        return true;
+    }
+  }
+  return false;
+}
+
+static int32_t
+compare_ack_apply_values (const void *p1, const void *p2)
+{
+  BtorAckApply *a = (BtorAckApply *) p1;
+  BtorAckApply *b = (BtorAckApply *) p2;
+  return btor_bv_compare_tuple (a->value, b->value);
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+add_ackermann_constraint (Btor *btor, BtorNode *app_i, BtorNode *app_j)
+{
+  BtorNode *p, *c, *imp, *a_i, *a_j, *eq, *tmp;
+  BtorArgsIterator ait_i, ait_j;
+
+  p = 0;
+  assert (btor_node_get_sort_id (app_i->e[1])
+          == btor_node_get_sort_id (app_j->e[1]));
+  btor_iter_args_init (&ait_i, app_i->e[1]);
+  btor_iter_args_init (&ait_j, app_j->e[1]);
+  while (btor_iter_args_has_next (&ait_i))
+  {
+    a_i = btor_iter_args_next (&ait_i);
+    a_j = btor_iter_args_next (&ait_j);
+    /* argument equalities are shared between pairs via the unique table */
+    eq = btor_exp_eq (btor, a_i, a_j);
+
+    if (!p)
+      p = eq;
+    else
+    {
+      tmp = p;
+      p   = btor_exp_bv_and (btor, tmp, eq);
+      btor_node_release (btor, tmp);
+      btor_node_release (btor, eq);
+    }
+  }
+  c   = btor_exp_eq (btor, app_i, app_j);
+  imp = btor_exp_implies (btor, p, c);
+  btor->stats.ackermann_constraints++;
+  btor_assert_exp (btor, imp);
+  btor_node_release (btor, p);
+  btor_node_release (btor, c);
+  btor_node_release (btor, imp);
+}
+
+/* Add Ackermann constraints for the applications 'applies' of one function
+ * symbol, pruning pairs with provably distinct argument tuples.  Ground
+ * applications (all argument bits known) are partitioned by their argument
+ * values: applications in different classes are distinct, applications in
+ * the same class are congruent to the first application of the class.
+ * Returns the number of added constraints. */
+static uint32_t
+add_pruned_ackermann_constraints (Btor *btor,
+                                  BtorNodePtrStack *applies,
+                                  BtorIntHashTable *bits)
+{
+  uint32_t i, j, k, n, nargs, num_constraints = 0;
+  uint_least64_t num_pairs;
+  BtorMemMgr *mm;
+  BtorNode *app, *arg;
+  BtorArgsIterator ait;
+  BtorAckApply *apps, *a, *b;
+  BtorBitVector *mask, *value;
+
+  mm    = btor->mm;
+  n     = BTOR_COUNT_STACK (*applies);
+  nargs = btor_node_args_get_arity (btor, BTOR_PEEK_STACK (*applies, 0)->e[1]);
+  BTOR_CNEWN (mm, apps, n);
+  for (i = 0; i < n; i++)
+  {
+    app           = BTOR_PEEK_STACK (*applies, i);
+    a             = &apps[i];
+    a->apply      = app;
+    a->mask       = btor_bv_new_tuple (mm, nargs);
+    a->value      = btor_bv_new_tuple (mm, nargs);
+    a->ground     = true;
+    btor_iter_args_init (&ait, app->e[1]);
+    for (j = 0; btor_iter_args_has_next (&ait); j++)
+    {
+      arg = btor_iter_args_next (&ait);
+      compute_known_bits (btor, bits, arg);
+      get_known_bits (mm, bits, arg, &mask, &value);
+      if (!btor_bv_is_ones (mask)) a->ground = false;
+      btor_bv_add_to_tuple (mm, a->mask, mask, j);
+      btor_bv_add_to_tuple (mm, a->value, value, j);
+      btor_bv_free (mm, mask);
+      btor_bv_free (mm, value);
+    }
+  }
+
+  /* move ground applications to the front, sorted by argument values */
+  for (i = 0, j = 0; j < n; j++)
+  {
+    if (!apps[j].ground) continue;
+    if (i != j)
+    {
+      BtorAckApply tmp = apps[i];
+      apps[i]          = apps[j];
+      apps[j]          = tmp;
+    }
+    i++;
+  }
+  k = i;
+  qsort (apps, k, sizeof (BtorAckApply), compare_ack_apply_values);
+
+  for (i = 1, j = 0; i < k; i++)
+  {
+    if (compare_ack_apply_values (&apps[j], &apps[i]))
+      j = i;
+    else
+    {
+      add_ackermann_constraint (btor, apps[j].apply, apps[i].apply);
+      num_constraints++;
+    }
+  }
+
+  for (i = k; i < n; i++)
+  {
+    a = &apps[i];
+    for (j = 0; j < i; j++)
+    {
+      b = &apps[j];
+      if (is_distinct_args (a, b)) continue;
+      add_ackermann_constraint (btor, b->apply, a->apply);
+      num_constraints++;
+    }
+  }
+
+  num_pairs = (uint_least64_t) n * (n - 1) / 2;
+  btor->stats.ackermann_pruned += num_pairs - num_constraints;
+
+  for (i = 0; i < n; i++)
+  {
+    btor_bv_free_tuple (mm, apps[i].mask);
+    btor_bv_free_tuple (mm, apps[i].value);
+  }
+  BTOR_DELETEN (mm, apps, n);
+  return num_constraints;
+}
+
 void
 btor_add_ackermann_constraints (Btor *btor)
 {
   assert (btor);
 
   uint32_t i, j, num_constraints = 0;
+  uint_least64_t num_pruned;
   double start, delta;
-  BtorNode *uf, *app_i, *app_j, *p, *c, *imp, *a_i, *a_j, *eq, *tmp;
+  BtorNode *uf, *app_i, *app_j;
   BtorNode *cur;
-  BtorArgsIterator ait_i, ait_j;
   BtorNodeIterator nit;
   BtorPtrHashTableIterator it;
   BtorNodePtrStack applies, visit;
-  BtorIntHashTable *cache;
+  BtorIntHashTable *cache, *bits;
   BtorMemMgr *mm;
+  bool opt_prune;
 
-  start = btor_util_time_stamp ();
-  mm    = btor->mm;
-  cache = btor_hashint_table_new (mm);
+  start      = btor_util_time_stamp ();
+  mm         = btor->mm;
+  cache      = btor_hashint_table_new (mm);
+  bits       = btor_hashint_map_new (mm);
+  opt_prune  = btor_opt_get (btor, BTOR_OPT_ACKERMANN_PRUNE) == 1;
+  num_pruned = btor->stats.ackermann_pruned;
   BTOR_INIT_STACK (mm, visit);
 
   btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
@@ -66,51 +423,35 @@ btor_add_ackermann_constraints (Btor *btor)
       BTOR_PUSH_STACK (applies, app_i);
     }
 
+    if (opt_prune && BTOR_COUNT_STACK (applies) > 1)
+    {
+      num_constraints +=
+          add_pruned_ackermann_constraints (btor, &applies, bits);
+      BTOR_RELEASE_STACK (applies);
+      continue;
+    }
+
     for (i = 0; i < BTOR_COUNT_STACK (applies); i++)
     {
       app_i = BTOR_PEEK_STACK (applies, i);
       for (j = i + 1; j < BTOR_COUNT_STACK (applies); j++)
       {
         app_j = BTOR_PEEK_STACK (applies, j);
-        p     = 0;
-        assert (btor_node_get_sort_id (app_i->e[1])
-                == btor_node_get_sort_id (app_j->e[1]));
-        btor_iter_args_init (&ait_i, app_i->e[1]);
-        btor_iter_args_init (&ait_j, app_j->e[1]);
-        while (btor_iter_args_has_next (&ait_i))
-        {
-          a_i = btor_iter_args_next (&ait_i);
-          a_j = btor_iter_args_next (&ait_j);
-          eq  = btor_exp_eq (btor, a_i, a_j);
-
-          if (!p)
-            p = eq;
-          else
-          {
-            tmp = p;
-            p   = btor_exp_bv_and (btor, tmp, eq);
-            btor_node_release (btor, tmp);
-            btor_node_release (btor, eq);
-          }
-        }
-        c   = btor_exp_eq (btor, app_i, app_j);
-        imp = btor_exp_implies (btor, p, c);
-        btor->stats.ackermann_constraints++;
+        add_ackermann_constraint (btor, app_i, app_j);
         num_constraints++;
-        btor_assert_exp (btor, imp);
-        btor_node_release (btor, p);
-        btor_node_release (btor, c);
-        btor_node_release (btor, imp);
       }
     }
     BTOR_RELEASE_STACK (applies);
   }
+  delete_known_bits (mm, bits);
   btor_hashint_table_delete (cache);
   delta = btor_util_time_stamp () - start;
   BTOR_MSG (btor->msg,
             1,
-            "added %d ackermann constraints in %.3f seconds",
+            "added %d ackermann constraints (%llu pairs pruned) in %.3f "
+            "seconds",
             num_constraints,
+            (unsigned long long) (btor->stats.ackermann_pruned - num_pruned),
             delta);
   btor->time.ack += delta;
 }
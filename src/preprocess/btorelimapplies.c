@@ -63,9 +63,10 @@ btor_eliminate_applies (Btor *btor)
 
   start     = btor_util_time_stamp ();
   round     = 1;
-  cache     = btor_hashptr_table_new (btor->mm,
-                                  (BtorHashPtr) btor_node_pair_hash,
-                                  (BtorCmpPtr) btor_node_pair_compare);
+  cache     = btor_hashptr_table_new_tag (btor->mm,
+                                      BTOR_MEM_TAG_BETA,
+                                      (BtorHashPtr) btor_node_pair_hash,
+                                      (BtorCmpPtr) btor_node_pair_compare);
   app_cache = btor_hashint_table_new (btor->mm);
   BTOR_INIT_STACK (btor->mm, lambdas);
 
@@ -177,14 +177,15 @@ prep_leafs (Btor *btor, BtorPtrHashTable *t, BtorNodePtrStack *leafs)
   BtorNode *cur, *coeff, *leaf;
   BtorSortId sort_id;
 
-  sort_id        = btor_node_get_sort_id (t->first->key);
+  sort_id        = btor_node_get_sort_id (btor_hashptr_table_first (t)->key);
   BtorNode *zero = btor_exp_bv_zero (btor, sort_id);
 
   // printf("*** prep\n");
   btor_iter_hashptr_init (&it, t);
   while (btor_iter_hashptr_has_next (&it))
   {
-    assert (!btor_node_is_bv_const (it.cur) || t->first->key == it.cur);
+    assert (!btor_node_is_bv_const (it.cur)
+            || btor_hashptr_table_first (t)->key == it.cur);
     b     = it.bucket;
     coeff = b->data.as_ptr;
     cur   = btor_iter_hashptr_next (&it);
@@ -201,7 +202,7 @@ prep_leafs (Btor *btor, BtorPtrHashTable *t, BtorNodePtrStack *leafs)
 
 #ifndef NDEBUG
     /* all leafs have been normalized to a positive coefficient */
-    if (cur != t->first->key)
+    if (cur != btor_hashptr_table_first (t)->key)
     {
       BtorNode *gtz = btor_exp_bv_sgt (btor, coeff, zero);
       assert (gtz == btor->true_exp);
@@ -238,7 +239,7 @@ normalize_coeffs (Btor *btor,
 
   BtorNode *zero = btor_exp_bv_zero (btor, sort_id);
 
-  assert (btor_node_is_bv_const (lhs->first->key));
+  assert (btor_node_is_bv_const (btor_hashptr_table_first (lhs)->key));
 
   // printf ("*** normalize coeffs\n");
   btor_iter_hashptr_init (&it, lhs);
@@ -330,7 +331,7 @@ normalize_coeffs (Btor *btor,
     if (btor_node_is_inverted (cur))
     {
       c1 = blhs->data.as_ptr;
-      c2 = lhs->first->data.as_ptr;
+      c2 = btor_hashptr_table_first (lhs)->data.as_ptr;
 
       lt         = btor_exp_bv_sgte (btor, c2, c1);
       bool is_lt = lt == btor->true_exp;
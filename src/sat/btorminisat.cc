@@ -21,6 +21,10 @@
 #include <cassert>
 #include <cstdio>
 #include <cstring>
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#include <ctime>
+#endif
 
 extern "C" {
 
@@ -32,6 +36,53 @@ using namespace Minisat;
 
 /*------------------------------------------------------------------------*/
 
+#ifdef BTOR_HAVE_PTHREADS
+/* MiniSat does not poll a termination callback.  While solving, a watcher
+ * thread polls it every BTOR_MINISAT_TERM_POLL_MS milliseconds and
+ * interrupts the solver. */
+#define BTOR_MINISAT_TERM_POLL_MS 10
+
+struct BtorMiniSATWatcher
+{
+  Solver* solver;
+  int32_t (*term) (void*);
+  void* state;
+  bool done; /* solving finished, protected by 'mutex' */
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  pthread_t thread;
+};
+
+static void*
+watch_term (void* arg)
+{
+  BtorMiniSATWatcher* watcher = (BtorMiniSATWatcher*) arg;
+  struct timespec ts;
+
+  pthread_mutex_lock (&watcher->mutex);
+  while (!watcher->done)
+  {
+    if (watcher->term (watcher->state))
+    {
+      watcher->solver->interrupt ();
+      break;
+    }
+    clock_gettime (CLOCK_REALTIME, &ts);
+    ts.tv_nsec += BTOR_MINISAT_TERM_POLL_MS * 1000000L;
+    if (ts.tv_nsec >= 1000000000L)
+    {
+      ts.tv_sec += 1;
+      ts.tv_nsec -= 1000000000L;
+    }
+    pthread_cond_timedwait (&watcher->cond, &watcher->mutex, &ts);
+  }
+  pthread_mutex_unlock (&watcher->mutex);
+  return 0;
+}
+#endif
+
+/*------------------------------------------------------------------------*/
+
 class BtorMiniSAT : public SimpSolver
 {
   vec<Lit> assumptions, clause;
@@ -91,16 +142,58 @@ class BtorMiniSAT : public SimpSolver
 
   unsigned long long calls;
 
-  int32_t sat (bool simp)
+  int32_t sat (bool simp, int32_t (*term) (void*), void* state)
   {
+    lbool res;
+
     calls++;
     reset ();
-    lbool res = solveLimited (assumptions, simp);
+#ifdef BTOR_HAVE_PTHREADS
+    BtorMiniSATWatcher watcher;
+    bool watching = false;
+    if (term)
+    {
+      watcher.solver = this;
+      watcher.term   = term;
+      watcher.state  = state;
+      watcher.done   = false;
+      pthread_mutex_init (&watcher.mutex, 0);
+      pthread_cond_init (&watcher.cond, 0);
+      /* if the watcher cannot be started, solve without termination */
+      watching = !pthread_create (&watcher.thread, 0, watch_term, &watcher);
+    }
+#else
+    (void) term;
+    (void) state;
+#endif
+    res = solveLimited (assumptions, simp);
+#ifdef BTOR_HAVE_PTHREADS
+    if (term)
+    {
+      if (watching)
+      {
+        pthread_mutex_lock (&watcher.mutex);
+        watcher.done = true;
+        pthread_cond_signal (&watcher.cond);
+        pthread_mutex_unlock (&watcher.mutex);
+        pthread_join (watcher.thread, 0);
+      }
+      pthread_cond_destroy (&watcher.cond);
+      pthread_mutex_destroy (&watcher.mutex);
+      clearInterrupt ();
+    }
+#endif
     assumptions.clear ();
     nomodel = res != l_True;
     return res == l_Undef ? 0 : (res == l_True ? 10 : 20);
   }
 
+  void phase (int32_t lit)
+  {
+    /* MiniSat picks the negative literal if the user polarity is l_True */
+    setPolarity (var (import (lit)), lit < 0 ? l_True : l_False);
+  }
+
   int32_t failed (int32_t lit)
   {
     if (!fmap) ana ();
@@ -156,7 +249,7 @@ sat (BtorSATMgr* smgr, int32_t limit)
     solver->budgetOff ();
   else
     solver->setConfBudget (limit);
-  return solver->sat (!smgr->inc_required);
+  return solver->sat (!smgr->inc_required, smgr->term.fun, smgr->term.state);
 }
 
 static int32_t
@@ -226,6 +319,22 @@ stats (BtorSATMgr* smgr)
   fflush (stdout);
 }
 
+static void
+phase (BtorSATMgr* smgr, int32_t lit)
+{
+  BtorMiniSAT* solver = (BtorMiniSAT*) smgr->solver;
+  solver->phase (lit);
+}
+
+#ifdef BTOR_HAVE_PTHREADS
+static void
+setterm (BtorSATMgr* smgr)
+{
+  /* termination callback is polled by a watcher thread in 'sat' */
+  (void) smgr;
+}
+#endif
+
 /*------------------------------------------------------------------------*/
 
 bool
@@ -247,12 +356,16 @@ btor_sat_enable_minisat (BtorSATMgr* smgr)
   smgr->api.fixed            = fixed;
   smgr->api.inc_max_var      = inc_max_var;
   smgr->api.init             = init;
+  smgr->api.phase            = phase;
   smgr->api.repr             = 0;
   smgr->api.reset            = reset;
   smgr->api.sat              = sat;
   smgr->api.set_output       = 0;
   smgr->api.set_prefix       = 0;
   smgr->api.stats            = stats;
+#ifdef BTOR_HAVE_PTHREADS
+  smgr->api.setterm = setterm;
+#endif
   return true;
 }
 };
@@ -94,6 +94,18 @@ fixed (BtorSATMgr *smgr, int32_t lit)
   return picosat_deref_toplevel (smgr->solver, lit);
 }
 
+static void
+phase (BtorSATMgr *smgr, int32_t lit)
+{
+  picosat_set_default_phase_lit (smgr->solver, lit, 1);
+}
+
+static void
+setterm (BtorSATMgr *smgr)
+{
+  picosat_set_interrupt (smgr->solver, smgr->term.state, smgr->term.fun);
+}
+
 /*------------------------------------------------------------------------*/
 
 static void
@@ -130,12 +142,14 @@ btor_sat_enable_picosat (BtorSATMgr *smgr)
   smgr->api.inc_max_var      = inc_max_var;
   smgr->api.init             = init;
   smgr->api.melt             = 0;
+  smgr->api.phase            = phase;
   smgr->api.repr             = 0;
   smgr->api.reset            = reset;
   smgr->api.sat              = sat;
   smgr->api.set_output       = set_output;
   smgr->api.set_prefix       = set_prefix;
   smgr->api.stats            = stats;
+  smgr->api.setterm          = setterm;
   return true;
 }
 /*------------------------------------------------------------------------*/
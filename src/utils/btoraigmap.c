@@ -9,6 +9,7 @@
 #include "utils/btoraigmap.h"
 #include "btorcore.h"
 #include "utils/btorhashptr.h"
+#include "utils/btorstack.h"
 
 /*------------------------------------------------------------------------*/
 
@@ -71,6 +72,85 @@ btor_aigmap_map (BtorAIGMap *map, BtorAIG *src, BtorAIG *dst)
   bucket->data.as_ptr = btor_aig_copy (map->amgr_dst, dst);
 }
 
+/* Note: btor_aigmap_mapped can not distinguish unmapped AIGs from AIGs
+ * mapped to BTOR_AIG_FALSE. */
+static BtorAIG *
+get_imported (BtorAIGMap *map, BtorAIG *aig, bool *imported)
+{
+  BtorPtrHashBucket *bucket;
+  BtorAIG *res;
+
+  if (btor_aig_is_const (aig))
+  {
+    *imported = true;
+    return aig;
+  }
+  bucket    = btor_hashptr_table_get (map->table, BTOR_REAL_ADDR_AIG (aig));
+  *imported = bucket != 0;
+  if (!bucket) return 0;
+  res = bucket->data.as_ptr;
+  return BTOR_IS_INVERTED_AIG (aig) ? BTOR_INVERT_AIG (res) : res;
+}
+
+BtorAIG *
+btor_aigmap_import (BtorAIGMap *map, BtorAIG *src)
+{
+  assert (map);
+
+  bool imported, imported_left, imported_right;
+  BtorAIG *cur, *left, *right, *res;
+  BtorAIGPtrStack stack;
+
+  res = get_imported (map, src, &imported);
+  if (imported) return btor_aig_copy (map->amgr_dst, res);
+
+  BTOR_INIT_STACK (map->btor->mm, stack);
+  BTOR_PUSH_STACK (stack, BTOR_REAL_ADDR_AIG (src));
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_TOP_STACK (stack);
+    assert (!BTOR_IS_INVERTED_AIG (cur));
+    (void) get_imported (map, cur, &imported);
+    if (imported)
+    {
+      (void) BTOR_POP_STACK (stack);
+      continue;
+    }
+
+    if (btor_aig_is_var (cur))
+      res = btor_aig_var (map->amgr_dst);
+    else
+    {
+      assert (btor_aig_is_and (cur));
+      left  = btor_aig_get_left_child (map->amgr_src, cur);
+      right = btor_aig_get_right_child (map->amgr_src, cur);
+      left  = get_imported (map, left, &imported_left);
+      right = get_imported (map, right, &imported_right);
+      if (!imported_left || !imported_right)
+      {
+        if (!imported_left)
+          BTOR_PUSH_STACK (
+              stack,
+              BTOR_REAL_ADDR_AIG (btor_aig_get_left_child (map->amgr_src, cur)));
+        if (!imported_right)
+          BTOR_PUSH_STACK (stack,
+                           BTOR_REAL_ADDR_AIG (
+                               btor_aig_get_right_child (map->amgr_src, cur)));
+        continue;
+      }
+      res = btor_aig_and (map->amgr_dst, left, right);
+    }
+    (void) BTOR_POP_STACK (stack);
+    btor_aigmap_map (map, cur, res);
+    btor_aig_release (map->amgr_dst, res);
+  }
+  BTOR_RELEASE_STACK (stack);
+
+  res = get_imported (map, src, &imported);
+  assert (imported);
+  return btor_aig_copy (map->amgr_dst, res);
+}
+
 void
 btor_aigmap_delete (BtorAIGMap *map)
 {
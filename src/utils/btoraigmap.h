@@ -33,6 +33,10 @@ typedef struct BtorAIGMap BtorAIGMap;
 BtorAIGMap *btor_aigmap_new (Btor *, BtorAIGMgr *, BtorAIGMgr *);
 BtorAIG *btor_aigmap_mapped (BtorAIGMap *, BtorAIG *);
 void btor_aigmap_map (BtorAIGMap *, BtorAIG *src, BtorAIG *dst);
+/* Rebuild 'src' (and its cone) in the destination AIG manager and map it.
+ * AIG variables without mapping are mapped to fresh variables.  Returns a
+ * new reference to the destination AIG. */
+BtorAIG *btor_aigmap_import (BtorAIGMap *, BtorAIG *src);
 void btor_aigmap_delete (BtorAIGMap *);
 
 /*------------------------------------------------------------------------*/
@@ -196,9 +196,10 @@ resize (BtorIntHashTable *t)
 #endif
   assert (old_size > 0);
   new_size = initsize ((pow2size (old_size)) * 2);
-  BTOR_CNEWN (t->mm, t->keys, new_size);
-  BTOR_CNEWN (t->mm, t->hop_info, new_size);
-  if (old_data) BTOR_CNEWN (t->mm, t->data, new_size);
+  BTOR_CNEWN_TAG (t->mm, t->tag, t->keys, new_size);
+  BTOR_CNEWN_TAG (t->mm, t->tag, t->hop_info, new_size);
+  if (old_data)
+    BTOR_CNEWN_TAG (t->mm, t->tag, t->data, new_size);
   t->count = 0;
   t->size  = new_size;
 
@@ -212,34 +213,42 @@ resize (BtorIntHashTable *t)
     assert (new_pos < new_size);
   }
 
-  BTOR_DELETEN (t->mm, old_keys, old_size);
-  BTOR_DELETEN (t->mm, old_hop_info, old_size);
-  if (old_data) BTOR_DELETEN (t->mm, old_data, old_size);
+  BTOR_DELETEN_TAG (t->mm, t->tag, old_keys, old_size);
+  BTOR_DELETEN_TAG (t->mm, t->tag, old_hop_info, old_size);
+  if (old_data)
+    BTOR_DELETEN_TAG (t->mm, t->tag, old_data, old_size);
   assert (old_count == t->count);
 }
 
 /*------------------------------------------------------------------------*/
 
 BtorIntHashTable *
-btor_hashint_table_new (BtorMemMgr *mm)
+btor_hashint_table_new_tag (BtorMemMgr *mm, BtorMemTag tag)
 {
   BtorIntHashTable *res;
 
-  BTOR_CNEW (mm, res);
+  BTOR_CNEW_TAG (mm, tag, res);
   res->mm   = mm;
+  res->tag  = tag;
   res->size = initsize (HOP_RANGE);
-  BTOR_CNEWN (mm, res->keys, res->size);
-  BTOR_CNEWN (mm, res->hop_info, res->size);
+  BTOR_CNEWN_TAG (mm, tag, res->keys, res->size);
+  BTOR_CNEWN_TAG (mm, tag, res->hop_info, res->size);
   return res;
 }
 
+BtorIntHashTable *
+btor_hashint_table_new (BtorMemMgr *mm)
+{
+  return btor_hashint_table_new_tag (mm, BTOR_MEM_TAG_HASH);
+}
+
 void
 btor_hashint_table_delete (BtorIntHashTable *t)
 {
   assert (!t->data);
-  BTOR_DELETEN (t->mm, t->keys, t->size);
-  BTOR_DELETEN (t->mm, t->hop_info, t->size);
-  BTOR_DELETE (t->mm, t);
+  BTOR_DELETEN_TAG (t->mm, t->tag, t->keys, t->size);
+  BTOR_DELETEN_TAG (t->mm, t->tag, t->hop_info, t->size);
+  BTOR_DELETE_TAG (t->mm, t->tag, t);
 }
 
 size_t
@@ -321,7 +330,7 @@ btor_hashint_table_clone (BtorMemMgr *mm, BtorIntHashTable *table)
 
   if (!table) return NULL;
 
-  res = btor_hashint_table_new (mm);
+  res = btor_hashint_table_new_tag (mm, table->tag);
   while (res->size < table->size) resize (res);
   assert (res->size == table->size);
   memcpy (res->keys, table->keys, table->size * sizeof (*table->keys));
@@ -334,15 +343,21 @@ btor_hashint_table_clone (BtorMemMgr *mm, BtorIntHashTable *table)
 /* map functions */
 
 BtorIntHashTable *
-btor_hashint_map_new (BtorMemMgr *mm)
+btor_hashint_map_new_tag (BtorMemMgr *mm, BtorMemTag tag)
 {
   BtorIntHashTable *res;
 
-  res = btor_hashint_table_new (mm);
-  BTOR_CNEWN (mm, res->data, res->size);
+  res = btor_hashint_table_new_tag (mm, tag);
+  BTOR_CNEWN_TAG (mm, tag, res->data, res->size);
   return res;
 }
 
+BtorIntHashTable *
+btor_hashint_map_new (BtorMemMgr *mm)
+{
+  return btor_hashint_map_new_tag (mm, BTOR_MEM_TAG_HASH);
+}
+
 bool
 btor_hashint_map_contains (BtorIntHashTable *t, int32_t key)
 {
@@ -393,7 +408,7 @@ btor_hashint_map_delete (BtorIntHashTable *t)
 {
   assert (t->data);
 
-  BTOR_DELETEN (t->mm, t->data, t->size);
+  BTOR_DELETEN_TAG (t->mm, t->tag, t->data, t->size);
   t->data = 0;
   btor_hashint_table_delete (t);
 }
@@ -412,7 +427,7 @@ btor_hashint_map_clone (BtorMemMgr *mm,
   if (!table) return NULL;
 
   res = btor_hashint_table_clone (mm, table);
-  BTOR_CNEWN (mm, res->data, res->size);
+  BTOR_CNEWN_TAG (mm, res->tag, res->data, res->size);
   if (cdata)
   {
     for (i = 0; i < res->size; i++)
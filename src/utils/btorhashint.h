@@ -19,6 +19,7 @@
 struct BtorIntHashTable
 {
   BtorMemMgr *mm;
+  BtorMemTag tag; /* allocation category */
   size_t count;
   size_t size;
   int32_t *keys;
@@ -35,6 +36,10 @@ typedef struct BtorIntHashTable BtorIntHashTable;
 /* Create new int32_t hash table. */
 BtorIntHashTable *btor_hashint_table_new (BtorMemMgr *);
 
+/* Create new int32_t hash table, memory is accounted for in category 'tag'
+ * (BTOR_MEM_TAG_HASH for btor_hashint_table_new). */
+BtorIntHashTable *btor_hashint_table_new_tag (BtorMemMgr *, BtorMemTag tag);
+
 /* Free int32_t hash table. */
 void btor_hashint_table_delete (BtorIntHashTable *);
 
@@ -66,6 +71,8 @@ BtorIntHashTable *btor_hashint_table_clone (BtorMemMgr *mm,
 
 BtorIntHashTable *btor_hashint_map_new (BtorMemMgr *);
 
+BtorIntHashTable *btor_hashint_map_new_tag (BtorMemMgr *, BtorMemTag tag);
+
 bool btor_hashint_map_contains (BtorIntHashTable *, int32_t key);
 
 void btor_hashint_map_remove (BtorIntHashTable *,
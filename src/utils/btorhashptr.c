@@ -8,6 +8,14 @@
 
 #include "utils/btorhashptr.h"
 
+/* Entry of the index table, 'pos' is the position of the bucket + 1 (0 if
+ * the slot is empty), 'hash' is the full hash value of its key. */
+struct BtorPtrHashSlot
+{
+  uint32_t pos;
+  uint32_t hash;
+};
+
 static uint32_t
 btor_hash_ptr (const void *p)
 {
@@ -20,54 +28,139 @@ btor_compare_ptr (const void *p, const void *q)
   return ((uintptr_t) p) != ((uintptr_t) q);
 }
 
+/*------------------------------------------------------------------------*/
+
+static inline uint32_t
+page_size (uint32_t page)
+{
+  return BTOR_PTR_HASH_PAGE_SIZE << page;
+}
+
+/* Number of buckets that fit into the first 'num_pages' pages. */
+static inline uint32_t
+pages_capacity (uint32_t num_pages)
+{
+  return ((1u << num_pages) - 1) << BTOR_PTR_HASH_PAGE_BITS;
+}
+
+static inline BtorPtrHashBucket *
+get_bucket (const BtorPtrHashTable *p2iht, uint32_t pos)
+{
+  uint32_t page;
+
+  assert (pos < p2iht->end);
+  page = 31 - __builtin_clz ((pos >> BTOR_PTR_HASH_PAGE_BITS) + 1);
+  assert (page < p2iht->num_pages);
+  return p2iht->pages[page] + (pos - pages_capacity (page));
+}
+
+static void
+add_page (BtorPtrHashTable *p2iht)
+{
+  uint32_t n = p2iht->num_pages;
+
+  BTOR_REALLOC_TAG (p2iht->mm, p2iht->tag, p2iht->pages, n, n + 1);
+  BTOR_NEWN_TAG (p2iht->mm, p2iht->tag, p2iht->pages[n], page_size (n));
+  p2iht->num_pages = n + 1;
+}
+
+static void
+insert_slot (BtorPtrHashTable *p2iht, uint32_t pos, uint32_t hash)
+{
+  uint32_t i, mask;
+
+  mask = p2iht->size - 1;
+  for (i = hash & mask; p2iht->table[i].pos; i = (i + 1) & mask)
+    ;
+  p2iht->table[i].pos  = pos;
+  p2iht->table[i].hash = hash;
+}
+
 static void
 btor_enlarge_ptr_hash_table (BtorPtrHashTable *p2iht)
 {
-  BtorPtrHashBucket *p, *chain, **old_table, **new_table;
-  uint32_t old_size, new_size, i, h;
-  BtorHashPtr hash;
+  BtorPtrHashSlot *old_table;
+  uint32_t old_size, new_size, i;
 
   old_size  = p2iht->size;
   old_table = p2iht->table;
 
-  new_size = old_size ? 2 * old_size : 1;
-  BTOR_CNEWN (p2iht->mm, new_table, new_size);
-
-  hash = p2iht->hash;
+  new_size = old_size ? 2 * old_size : 4;
+  BTOR_CNEWN_TAG (p2iht->mm, p2iht->tag, p2iht->table, new_size);
+  p2iht->size = new_size;
 
   for (i = 0; i < old_size; i++)
-    for (p = old_table[i]; p; p = chain)
-    {
-      chain = p->chain;
-      h     = hash (p->key);
-      h &= new_size - 1;
-      p->chain     = new_table[h];
-      new_table[h] = p;
-    }
-
-  BTOR_DELETEN (p2iht->mm, old_table, old_size);
-
-  p2iht->size  = new_size;
-  p2iht->table = new_table;
+    if (old_table[i].pos)
+      insert_slot (p2iht, old_table[i].pos, old_table[i].hash);
+
+  BTOR_DELETEN_TAG (p2iht->mm, p2iht->tag, old_table, old_size);
 }
 
+/* Get position of the slot that refers to 'key' in the index table, or
+ * 'size' if 'key' is not in the table. */
+static uint32_t
+find_slot (const BtorPtrHashTable *p2iht, const void *key, uint32_t hash)
+{
+  BtorPtrHashSlot *s;
+  uint32_t i, mask;
+
+  mask = p2iht->size - 1;
+  for (i = hash & mask;; i = (i + 1) & mask)
+  {
+    s = p2iht->table + i;
+    if (!s->pos) return p2iht->size;
+    if (s->hash == hash
+        && !p2iht->cmp (get_bucket (p2iht, s->pos - 1)->key, key))
+      return i;
+  }
+}
+
+/* Remove slot 'i' from the index table by shifting back subsequent slots of
+ * the same probe sequence (no tombstones required for linear probing). */
+static void
+remove_slot (BtorPtrHashTable *p2iht, uint32_t i)
+{
+  uint32_t j, k, mask;
+
+  mask = p2iht->size - 1;
+  for (j = (i + 1) & mask; p2iht->table[j].pos; j = (j + 1) & mask)
+  {
+    k = p2iht->table[j].hash & mask;
+    /* keep slot j if its home position k is cyclically within (i, j] */
+    if (i <= j ? (i < k && k <= j) : (i < k || k <= j)) continue;
+    p2iht->table[i] = p2iht->table[j];
+    i               = j;
+  }
+  p2iht->table[i].pos = 0;
+}
+
+/*------------------------------------------------------------------------*/
+
 BtorPtrHashTable *
-btor_hashptr_table_new (BtorMemMgr *mm, BtorHashPtr hash, BtorCmpPtr cmp)
+btor_hashptr_table_new_tag (BtorMemMgr *mm,
+                            BtorMemTag tag,
+                            BtorHashPtr hash,
+                            BtorCmpPtr cmp)
 {
   BtorPtrHashTable *res;
 
-  BTOR_NEW (mm, res);
+  BTOR_NEW_TAG (mm, tag, res);
   BTOR_CLR (res);
 
   res->mm   = mm;
+  res->tag  = tag;
   res->hash = hash ? hash : btor_hash_ptr;
   res->cmp  = cmp ? cmp : btor_compare_ptr;
 
-  btor_enlarge_ptr_hash_table (res);
-
   return res;
 }
 
+BtorPtrHashTable *
+btor_hashptr_table_new (BtorMemMgr *mm, BtorHashPtr hash, BtorCmpPtr cmp)
+{
+  return btor_hashptr_table_new_tag (mm, BTOR_MEM_TAG_HASH, hash, cmp);
+}
+
 BtorPtrHashTable *
 btor_hashptr_table_clone (BtorMemMgr *mm,
                           BtorPtrHashTable *table,
@@ -86,9 +179,14 @@ btor_hashptr_table_clone (BtorMemMgr *mm,
 
   if (!table) return NULL;
 
-  res = btor_hashptr_table_new (mm, table->hash, table->cmp);
-  while (res->size < table->size) btor_enlarge_ptr_hash_table (res);
-  assert (res->size == table->size);
+  res = btor_hashptr_table_new_tag (mm, table->tag, table->hash, table->cmp);
+  /* mirror index table and pages, no enlarging required while adding */
+  if (table->size)
+  {
+    BTOR_CNEWN_TAG (mm, res->tag, res->table, table->size);
+    res->size = table->size;
+  }
+  while (res->num_pages < table->num_pages) add_page (res);
 
   btor_iter_hashptr_init (&it, table);
   while (btor_iter_hashptr_has_next (&it))
@@ -106,6 +204,8 @@ btor_hashptr_table_clone (BtorMemMgr *mm,
   }
 
   assert (table->count == res->count);
+  assert (table->size == res->size);
+  assert (table->num_pages == res->num_pages);
 
   return res;
 }
@@ -113,84 +213,93 @@ btor_hashptr_table_clone (BtorMemMgr *mm,
 void
 btor_hashptr_table_delete (BtorPtrHashTable *p2iht)
 {
-  BtorPtrHashBucket *p, *next;
-
-  for (p = p2iht->first; p; p = next)
-  {
-    next = p->next;
-    BTOR_DELETE (p2iht->mm, p);
-  }
-
-  BTOR_DELETEN (p2iht->mm, p2iht->table, p2iht->size);
-  BTOR_DELETE (p2iht->mm, p2iht);
+  uint32_t i;
+
+  for (i = 0; i < p2iht->num_pages; i++)
+    BTOR_DELETEN_TAG (
+        p2iht->mm, p2iht->tag, p2iht->pages[i], page_size (i));
+  BTOR_DELETEN_TAG (
+      p2iht->mm, p2iht->tag, p2iht->pages, p2iht->num_pages);
+  BTOR_DELETEN_TAG (p2iht->mm, p2iht->tag, p2iht->table, p2iht->size);
+  BTOR_DELETE_TAG (p2iht->mm, p2iht->tag, p2iht);
 }
 
 BtorPtrHashBucket *
 btor_hashptr_table_get (BtorPtrHashTable *p2iht, const void *key)
 {
-  BtorPtrHashBucket *res, **p, *b;
-  uint32_t i, h;
-
-  assert (p2iht->size > 0);
+  uint32_t i;
 
-  res = 0;
-  h   = p2iht->hash (key);
-  h &= p2iht->size - 1;
+  if (!p2iht->count) return 0;
 
-  for (i = 0, p = p2iht->table + h; i < p2iht->count; i++, p = &b->chain)
-  {
-    if (!(b = *p)) break;
-    if (!p2iht->cmp (b->key, key))
-    {
-      res = b;
-      break;
-    }
-  }
-
-  return res;
+  i = find_slot (p2iht, key, p2iht->hash (key));
+  if (i == p2iht->size) return 0;
+  return get_bucket (p2iht, p2iht->table[i].pos - 1);
 }
 
-static BtorPtrHashBucket **
-btor_findpos_in_ptr_hash_table_pos (BtorPtrHashTable *p2iht, void *key)
+BtorPtrHashBucket *
+btor_hashptr_table_add (BtorPtrHashTable *p2iht, void *key)
 {
-  BtorPtrHashBucket **p, *b;
-  uint32_t h;
+  BtorPtrHashBucket *res;
+  uint32_t h, pos;
 
-  if (p2iht->count == p2iht->size) btor_enlarge_ptr_hash_table (p2iht);
+  assert (key);
 
-  assert (p2iht->size > 0);
+  /* keep load factor <= 3/4 */
+  if (4 * (p2iht->count + 1) > 3 * p2iht->size)
+    btor_enlarge_ptr_hash_table (p2iht);
 
   h = p2iht->hash (key);
-  h &= p2iht->size - 1;
+  assert (find_slot (p2iht, key, h) == p2iht->size);
 
-  for (p = p2iht->table + h; (b = *p) && p2iht->cmp (b->key, key);
-       p = &b->chain)
-    ;
+  /* reuse the position of a removed bucket if possible */
+  if (p2iht->free)
+  {
+    pos         = p2iht->free - 1;
+    res         = get_bucket (p2iht, pos);
+    p2iht->free = res->next;
+  }
+  else
+  {
+    if (p2iht->end == pages_capacity (p2iht->num_pages)) add_page (p2iht);
+    pos = p2iht->end++;
+    res = get_bucket (p2iht, pos);
+  }
+  insert_slot (p2iht, pos + 1, h);
+  p2iht->count++;
 
-  return p;
+  BTOR_CLR (res);
+  res->key  = key;
+  res->prev = p2iht->last;
+  if (p2iht->last)
+    get_bucket (p2iht, p2iht->last - 1)->next = pos + 1;
+  else
+    p2iht->first = pos + 1;
+  p2iht->last = pos + 1;
+
+  return res;
 }
 
 BtorPtrHashBucket *
-btor_hashptr_table_add (BtorPtrHashTable *p2iht, void *key)
+btor_hashptr_table_first (const BtorPtrHashTable *table)
 {
-  BtorPtrHashBucket **p, *res;
-  p = btor_findpos_in_ptr_hash_table_pos (p2iht, key);
-  assert (!*p);
-  BTOR_CNEW (p2iht->mm, res);
-  res->key = key;
-  *p       = res;
-  p2iht->count++;
-
-  res->prev = p2iht->last;
-
-  if (p2iht->first)
-    p2iht->last->next = res;
-  else
-    p2iht->first = res;
+  assert (table);
+  return table->first ? get_bucket (table, table->first - 1) : 0;
+}
 
-  p2iht->last = res;
+BtorPtrHashBucket *
+btor_hashptr_table_last (const BtorPtrHashTable *table)
+{
+  assert (table);
+  return table->last ? get_bucket (table, table->last - 1) : 0;
+}
 
-  return res;
+size_t
+btor_hashptr_table_bytes (const BtorPtrHashTable *table)
+{
+  assert (table);
+  return sizeof (*table) + table->size * sizeof (BtorPtrHashSlot)
+         + table->num_pages * sizeof (BtorPtrHashBucket *)
+         + pages_capacity (table->num_pages) * sizeof (BtorPtrHashBucket);
 }
 
 /*
@@ -218,49 +327,68 @@ btor_hashptr_table_remove (BtorPtrHashTable *table,
                            void **stored_key_ptr,
                            BtorHashTableData *stored_data_ptr)
 {
-  BtorPtrHashBucket **p, *bucket;
+  BtorPtrHashBucket *bucket;
+  uint32_t i, pos;
+
+  assert (table->count > 0);
 
-  p      = btor_findpos_in_ptr_hash_table_pos (table, key);
-  bucket = *p;
+  i = find_slot (table, key, table->hash (key));
+  assert (i < table->size);
+  pos    = table->table[i].pos - 1;
+  bucket = get_bucket (table, pos);
+  remove_slot (table, i);
+  table->count--;
 
-  assert (bucket);
-  *p = bucket->chain;
+  if (stored_key_ptr) *stored_key_ptr = bucket->key;
+
+  if (stored_data_ptr) *stored_data_ptr = bucket->data;
 
   if (bucket->prev)
-    bucket->prev->next = bucket->next;
+    get_bucket (table, bucket->prev - 1)->next = bucket->next;
   else
     table->first = bucket->next;
-
   if (bucket->next)
-    bucket->next->prev = bucket->prev;
+    get_bucket (table, bucket->next - 1)->prev = bucket->prev;
   else
     table->last = bucket->prev;
 
-  assert (table->count > 0);
-  table->count--;
-
-  if (stored_key_ptr) *stored_key_ptr = bucket->key;
-
-  if (stored_data_ptr) *stored_data_ptr = bucket->data;
-
-  BTOR_DELETE (table->mm, bucket);
+  bucket->key = 0;
+  if (!table->count)
+  {
+    table->end  = 0;
+    table->free = 0;
+  }
+  else
+  {
+    bucket->next = table->free;
+    table->free  = pos + 1;
+  }
 }
 
 /*------------------------------------------------------------------------*/
 /* iterators     		                                          */
 /*------------------------------------------------------------------------*/
 
+/* Get the first (last if reversed) bucket of 't'. */
+static BtorPtrHashBucket *
+iter_hashptr_start (const BtorPtrHashTableIterator *it,
+                    const BtorPtrHashTable *t)
+{
+  uint32_t pos = it->reversed ? t->last : t->first;
+  return pos ? get_bucket (t, pos - 1) : 0;
+}
+
 void
 btor_iter_hashptr_init (BtorPtrHashTableIterator *it, const BtorPtrHashTable *t)
 {
   assert (it);
   assert (t);
 
-  it->bucket                  = t->first;
-  it->cur                     = it->bucket ? it->bucket->key : 0;
   it->reversed                = false;
   it->num_queued              = 0;
   it->pos                     = 0;
+  it->bucket                  = iter_hashptr_start (it, t);
+  it->cur                     = it->bucket ? it->bucket->key : 0;
   it->stack[it->num_queued++] = t;
 }
 
@@ -271,11 +399,11 @@ btor_iter_hashptr_init_reversed (BtorPtrHashTableIterator *it,
   assert (it);
   assert (t);
 
-  it->bucket                  = t->last;
-  it->cur                     = it->bucket ? it->bucket->key : 0;
   it->reversed                = true;
   it->num_queued              = 0;
   it->pos                     = 0;
+  it->bucket                  = iter_hashptr_start (it, t);
+  it->cur                     = it->bucket ? it->bucket->key : 0;
   it->stack[it->num_queued++] = t;
 }
 
@@ -290,7 +418,7 @@ btor_iter_hashptr_queue (BtorPtrHashTableIterator *it,
   /* if initial table is empty, initialize with queued table */
   if (!it->bucket)
   {
-    it->bucket = it->reversed ? t->last : t->first;
+    it->bucket = iter_hashptr_start (it, t);
     it->cur    = it->bucket ? it->bucket->key : 0;
     it->pos += 1;
   }
@@ -312,16 +440,19 @@ btor_iter_hashptr_next (BtorPtrHashTableIterator *it)
   assert (it->cur);
 
   void *res;
-  res = it->cur;
-  if (it->bucket)
-    it->bucket = it->reversed ? it->bucket->prev : it->bucket->next;
+  const BtorPtrHashTable *t;
+  uint32_t pos;
+
+  res        = it->cur;
+  t          = it->stack[it->pos];
+  pos        = it->reversed ? it->bucket->prev : it->bucket->next;
+  it->bucket = pos ? get_bucket (t, pos - 1) : 0;
 
   while (!it->bucket)
   {
     it->pos += 1;
     if (it->pos >= it->num_queued) break;
-    it->bucket =
-        it->reversed ? it->stack[it->pos]->last : it->stack[it->pos]->first;
+    it->bucket = iter_hashptr_start (it, it->stack[it->pos]);
   }
 
   it->cur = it->bucket ? it->bucket->key : 0;
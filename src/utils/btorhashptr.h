@@ -20,6 +20,7 @@
 
 typedef struct BtorPtrHashTable BtorPtrHashTable;
 typedef struct BtorPtrHashBucket BtorPtrHashBucket;
+typedef struct BtorPtrHashSlot BtorPtrHashSlot;
 
 typedef void *(*BtorCloneKeyPtr) (BtorMemMgr *mm,
                                   const void *map,
@@ -29,35 +30,40 @@ typedef void (*BtorCloneDataPtr) (BtorMemMgr *mm,
                                   BtorHashTableData *data,
                                   BtorHashTableData *cloned_data);
 
+/* Buckets are stored in pages of geometrically increasing size (page i holds
+ * BTOR_PTR_HASH_PAGE_SIZE << i buckets) and are never moved.  Their
+ * insertion order is kept in a doubly linked list of positions.  The
+ * position of a removed bucket is reused by subsequent insertions, hence
+ * pointers to a bucket stay valid until the bucket is removed. */
+#define BTOR_PTR_HASH_PAGE_BITS 3
+#define BTOR_PTR_HASH_PAGE_SIZE (1u << BTOR_PTR_HASH_PAGE_BITS)
+
 struct BtorPtrHashBucket
 {
-  /* public:
-   */
   void *key;
-
   BtorHashTableData data;
-
-  BtorPtrHashBucket *next; /* chronologically */
-  BtorPtrHashBucket *prev; /* chronologically */
-
-  /* private:
-   */
-  BtorPtrHashBucket *chain; /* collision chain */
+  uint32_t prev; /* position + 1 of chronologically previous bucket */
+  uint32_t next; /* position + 1 of next bucket (next free if removed) */
 };
 
 struct BtorPtrHashTable
 {
   BtorMemMgr *mm;
+  BtorMemTag tag; /* allocation category */
 
-  uint32_t size;
-  uint32_t count;
-  BtorPtrHashBucket **table;
+  uint32_t size;          /* size of the index table (power of 2 or 0) */
+  uint32_t count;         /* number of buckets */
+  BtorPtrHashSlot *table; /* index table, open addressing */
 
   BtorHashPtr hash;
   BtorCmpPtr cmp;
 
-  BtorPtrHashBucket *first; /* chronologically */
-  BtorPtrHashBucket *last;  /* chronologically */
+  BtorPtrHashBucket **pages;
+  uint32_t num_pages;
+  uint32_t end;   /* number of used positions (live or removed) */
+  uint32_t first; /* position + 1 of the chronologically first bucket */
+  uint32_t last;  /* position + 1 of the chronologically last bucket */
+  uint32_t free;  /* position + 1 of the first removed bucket */
 };
 
 /*------------------------------------------------------------------------*/
@@ -66,6 +72,13 @@ BtorPtrHashTable *btor_hashptr_table_new (BtorMemMgr *,
                                           BtorHashPtr,
                                           BtorCmpPtr);
 
+/* Create new hash table, memory is accounted for in category 'tag'
+ * (BTOR_MEM_TAG_HASH for btor_hashptr_table_new). */
+BtorPtrHashTable *btor_hashptr_table_new_tag (BtorMemMgr *,
+                                              BtorMemTag tag,
+                                              BtorHashPtr,
+                                              BtorCmpPtr);
+
 /* Clone hash table. 'ckey' is a function mapping key to cloned key,
  * 'cdata' is a function mapping data to cloned data (note: as_ptr vs.
  * as_int!). 'key_map' represents a map mapping key to cloned key values.
@@ -87,15 +100,22 @@ BtorPtrHashBucket *btor_hashptr_table_add (BtorPtrHashTable *p2iht, void *key);
 /* Remove from hash table the bucket with the key.  The key has to be an
  * element of the hash table.  If 'stored_data_ptr' is non zero, then data
  * to which the given key was mapped is copied to this location.   The same
- * applies to 'stored_key_ptr'.  If you traverse/iterate a hash table
- * through the chronological chains, then you can remove elements while
- * traversing the hash table.
+ * applies to 'stored_key_ptr'.  If you iterate a hash table with an
+ * iterator, then you can remove already visited elements while traversing
+ * the hash table.
  */
 void btor_hashptr_table_remove (BtorPtrHashTable *,
                                 void *key,
                                 void **stored_key_ptr,
                                 BtorHashTableData *stored_data_ptr);
 
+/* Get the chronologically first and last bucket, 0 if the table is empty. */
+BtorPtrHashBucket *btor_hashptr_table_first (const BtorPtrHashTable *table);
+BtorPtrHashBucket *btor_hashptr_table_last (const BtorPtrHashTable *table);
+
+/* Get the number of bytes allocated for the given table. */
+size_t btor_hashptr_table_bytes (const BtorPtrHashTable *table);
+
 uint32_t btor_hash_str (const void *str);
 
 #define btor_compare_str ((BtorCmpPtr) strcmp)
@@ -18,10 +18,27 @@
 
 /*------------------------------------------------------------------------*/
 
+/* Memory limits are never enforced by failing an allocation.  We only flag
+ * that a limit has been exceeded and leave it to the client to react at a
+ * point where it is safe to do so (cf. 'btor_mem_set_limit'). */
+#define CHECK_LIMIT()                                                         \
+  do                                                                          \
+  {                                                                           \
+    if (mm->soft_limit && mm->allocated + mm->sat_allocated > mm->soft_limit) \
+    {                                                                         \
+      mm->soft_limit_reached = 1;                                             \
+      if (mm->allocated + mm->sat_allocated > mm->hard_limit)                 \
+        mm->hard_limit_reached = 1;                                           \
+    }                                                                         \
+  } while (0)
+
 #define ADJUST()                                                            \
   do                                                                        \
   {                                                                         \
     if (mm->maxallocated < mm->allocated) mm->maxallocated = mm->allocated; \
+    if (mm->tag_maxallocated[tag] < mm->tag_allocated[tag])                 \
+      mm->tag_maxallocated[tag] = mm->tag_allocated[tag];                   \
+    CHECK_LIMIT ();                                                         \
   } while (0)
 
 #define SAT_ADJUST()                              \
@@ -29,6 +46,21 @@
   {                                               \
     if (mm->sat_maxallocated < mm->sat_allocated) \
       mm->sat_maxallocated = mm->sat_allocated;   \
+    CHECK_LIMIT ();                               \
+  } while (0)
+
+/* Worker threads account their allocations in a private memory manager
+ * rather than in the shared one (cf. 'btor_mem_mgr_new_thread'). */
+#ifdef BTOR_HAVE_PTHREADS
+static __thread BtorMemMgr *thread_mm;
+#else
+static BtorMemMgr *thread_mm;
+#endif
+
+#define THREAD_MM()                                           \
+  do                                                          \
+  {                                                           \
+    if (thread_mm && thread_mm->parent == mm) mm = thread_mm; \
   } while (0)
 
 /*------------------------------------------------------------------------*/
@@ -54,35 +86,41 @@
 BtorMemMgr *
 btor_mem_mgr_new (void)
 {
-  BtorMemMgr *mm = (BtorMemMgr *) malloc (sizeof (BtorMemMgr));
+  BtorMemMgr *mm = (BtorMemMgr *) calloc (1, sizeof (BtorMemMgr));
   BTOR_ABORT (!mm, "out of memory in 'btor_mem_mgr_new'");
-  mm->allocated        = 0;
-  mm->maxallocated     = 0;
-  mm->sat_allocated    = 0;
-  mm->sat_maxallocated = 0;
   return mm;
 }
 
 void *
-btor_mem_malloc (BtorMemMgr *mm, size_t size)
+btor_mem_malloc_tag (BtorMemMgr *mm, BtorMemTag tag, size_t size)
 {
   void *result;
   if (!size) return 0;
   assert (mm);
+  THREAD_MM ();
+  assert (tag < BTOR_MEM_TAG_NUM);
   result = malloc (size);
   BTOR_ABORT (!result, "out of memory in 'btor_mem_malloc'");
   mm->allocated += size;
+  mm->tag_allocated[tag] += size;
   ADJUST ();
   BTOR_LOG_MEM ("%p malloc %10ld\n", result, size);
   return result;
 }
 
+void *
+btor_mem_malloc (BtorMemMgr *mm, size_t size)
+{
+  return btor_mem_malloc_tag (mm, BTOR_MEM_TAG_OTHER, size);
+}
+
 void *
 btor_mem_sat_malloc (BtorMemMgr *mm, size_t size)
 {
   void *result;
   if (!size) return 0;
   assert (mm);
+  THREAD_MM ();
   result = malloc (size);
   BTOR_ABORT (!result, "out of memory in 'btor_mem_sat_malloc'");
   mm->sat_allocated += size;
@@ -91,27 +129,43 @@ btor_mem_sat_malloc (BtorMemMgr *mm, size_t size)
 }
 
 void *
-btor_mem_realloc (BtorMemMgr *mm, void *p, size_t old_size, size_t new_size)
+btor_mem_realloc_tag (BtorMemMgr *mm,
+                      BtorMemTag tag,
+                      void *p,
+                      size_t old_size,
+                      size_t new_size)
 {
   void *result;
   assert (mm);
+  THREAD_MM ();
+  assert (tag < BTOR_MEM_TAG_NUM);
   assert (!p == !old_size);
   assert (mm->allocated >= old_size);
+  assert (mm->tag_allocated[tag] >= old_size);
   BTOR_LOG_MEM ("%p free   %10ld (realloc)\n", p, old_size);
   result = realloc (p, new_size);
   BTOR_ABORT (!result, "out of memory in 'btor_mem_realloc'");
   mm->allocated -= old_size;
   mm->allocated += new_size;
+  mm->tag_allocated[tag] -= old_size;
+  mm->tag_allocated[tag] += new_size;
   ADJUST ();
   BTOR_LOG_MEM ("%p malloc %10ld (realloc)\n", result, new_size);
   return result;
 }
 
+void *
+btor_mem_realloc (BtorMemMgr *mm, void *p, size_t old_size, size_t new_size)
+{
+  return btor_mem_realloc_tag (mm, BTOR_MEM_TAG_OTHER, p, old_size, new_size);
+}
+
 void *
 btor_mem_sat_realloc (BtorMemMgr *mm, void *p, size_t old_size, size_t new_size)
 {
   void *result;
   assert (mm);
+  THREAD_MM ();
   assert (!p == !old_size);
   assert (mm->sat_allocated >= old_size);
   result = realloc (p, new_size);
@@ -123,38 +177,288 @@ btor_mem_sat_realloc (BtorMemMgr *mm, void *p, size_t old_size, size_t new_size)
 }
 
 void *
-btor_mem_calloc (BtorMemMgr *mm, size_t nobj, size_t size)
+btor_mem_calloc_tag (BtorMemMgr *mm, BtorMemTag tag, size_t nobj, size_t size)
 {
   size_t bytes = nobj * size;
   void *result;
   assert (mm);
+  THREAD_MM ();
+  assert (tag < BTOR_MEM_TAG_NUM);
   result = calloc (nobj, size);
   BTOR_ABORT (!result, "out of memory in 'btor_mem_calloc'");
   mm->allocated += bytes;
+  mm->tag_allocated[tag] += bytes;
   ADJUST ();
   BTOR_LOG_MEM ("%p malloc %10ld (calloc)\n", result, bytes);
   return result;
 }
 
+void *
+btor_mem_calloc (BtorMemMgr *mm, size_t nobj, size_t size)
+{
+  return btor_mem_calloc_tag (mm, BTOR_MEM_TAG_OTHER, nobj, size);
+}
+
 void
-btor_mem_free (BtorMemMgr *mm, void *p, size_t freed)
+btor_mem_free_tag (BtorMemMgr *mm, BtorMemTag tag, void *p, size_t freed)
 {
   assert (mm);
+  THREAD_MM ();
+  assert (tag < BTOR_MEM_TAG_NUM);
   assert (!p == !freed);
   assert (mm->allocated >= freed);
+  assert (mm->tag_allocated[tag] >= freed);
   mm->allocated -= freed;
+  mm->tag_allocated[tag] -= freed;
   BTOR_LOG_MEM ("%p free   %10ld\n", p, freed);
   free (p);
 }
 
+void
+btor_mem_free (BtorMemMgr *mm, void *p, size_t freed)
+{
+  btor_mem_free_tag (mm, BTOR_MEM_TAG_OTHER, p, freed);
+}
+
+size_t
+btor_mem_tag_allocated (const BtorMemMgr *mm, BtorMemTag tag)
+{
+  assert (mm);
+  assert (tag < BTOR_MEM_TAG_NUM);
+  return mm->tag_allocated[tag];
+}
+
+size_t
+btor_mem_tag_maxallocated (const BtorMemMgr *mm, BtorMemTag tag)
+{
+  assert (mm);
+  assert (tag < BTOR_MEM_TAG_NUM);
+  return mm->tag_maxallocated[tag];
+}
+
+const char *
+btor_mem_tag_name (BtorMemTag tag)
+{
+  static const char *const names[BTOR_MEM_TAG_NUM] = {
+      "other", "nodes", "AIGs", "AIG vectors", "bit-vectors", "hash tables",
+      "rewrite cache", "beta reduction", "models", "clones"};
+  assert (tag < BTOR_MEM_TAG_NUM);
+  return names[tag];
+}
+
+void
+btor_mem_set_limit (BtorMemMgr *mm, size_t soft_limit, size_t hard_limit)
+{
+  assert (mm);
+  assert (!soft_limit == !hard_limit);
+  assert (soft_limit <= hard_limit);
+  mm->soft_limit = soft_limit;
+  mm->hard_limit = hard_limit;
+  btor_mem_check_limit (mm);
+}
+
+void
+btor_mem_check_limit (BtorMemMgr *mm)
+{
+  assert (mm);
+  mm->soft_limit_reached = 0;
+  mm->hard_limit_reached = 0;
+  CHECK_LIMIT ();
+}
+
+BtorMemMgr *
+btor_mem_mgr_new_thread (BtorMemMgr *mm, uint32_t nthreads)
+{
+  assert (mm);
+  assert (!mm->parent);
+  assert (nthreads > 0);
+
+  BtorMemMgr *res;
+  size_t allocated;
+  uint32_t tag;
+
+  res = (BtorMemMgr *) malloc (2 * sizeof (BtorMemMgr));
+  BTOR_ABORT (!res, "out of memory in 'btor_mem_mgr_new_thread'");
+  res[0]      = *mm;
+  res[1]      = *mm;
+  res->parent = mm;
+  res->base   = res + 1;
+  /* track the peak of this thread only */
+  res->maxallocated     = res->allocated;
+  res->sat_maxallocated = res->sat_allocated;
+  for (tag = 0; tag < BTOR_MEM_TAG_NUM; tag++)
+    res->tag_maxallocated[tag] = res->tag_allocated[tag];
+  /* every thread gets an equal share of the remaining budget */
+  allocated = mm->allocated + mm->sat_allocated;
+  if (mm->soft_limit > allocated)
+    res->soft_limit = allocated + (mm->soft_limit - allocated) / nthreads;
+  if (mm->hard_limit > allocated)
+    res->hard_limit = allocated + (mm->hard_limit - allocated) / nthreads;
+  return res;
+}
+
+#define MERGE_COUNTER(cur, max)                                          \
+  do                                                                     \
+  {                                                                      \
+    if (mm->max < mm->cur + (tmm->max - tmm->base->cur))                 \
+      mm->max = mm->cur + (tmm->max - tmm->base->cur);                   \
+    mm->cur += tmm->cur - tmm->base->cur;                                \
+  } while (0)
+
+void
+btor_mem_mgr_delete_thread (BtorMemMgr *tmm)
+{
+  assert (tmm);
+  assert (tmm->parent);
+  assert (thread_mm != tmm);
+
+  BtorMemMgr *mm;
+  uint32_t tag;
+
+  mm = tmm->parent;
+  MERGE_COUNTER (allocated, maxallocated);
+  MERGE_COUNTER (sat_allocated, sat_maxallocated);
+  for (tag = 0; tag < BTOR_MEM_TAG_NUM; tag++)
+    MERGE_COUNTER (tag_allocated[tag], tag_maxallocated[tag]);
+  if (tmm->soft_limit_reached) mm->soft_limit_reached = 1;
+  if (tmm->hard_limit_reached) mm->hard_limit_reached = 1;
+  CHECK_LIMIT ();
+  free (tmm);
+}
+
+void
+btor_mem_set_thread_mgr (BtorMemMgr *tmm)
+{
+  assert (!tmm || tmm->parent);
+  thread_mm = tmm;
+}
+
+BtorMemMgr *
+btor_mem_get_thread_mgr (BtorMemMgr *mm)
+{
+  assert (mm);
+  THREAD_MM ();
+  return mm;
+}
+
 void
 btor_mem_sat_free (BtorMemMgr *mm, void *p, size_t freed)
 {
   assert (mm);
+  THREAD_MM ();
   if (p) mm->sat_allocated -= freed;
   free (p);
 }
 
+/*------------------------------------------------------------------------*/
+
+/* Every chunk starts with a header that links it to the previously allocated
+ * chunk and stores its size.  Chunk sizes double (starting with
+ * BTOR_MEM_SLAB_MIN_OBJS objects) up to BTOR_MEM_SLAB_MAX_OBJS objects, which
+ * keeps the overhead for small instances (and clones) low. */
+
+#define BTOR_MEM_SLAB_MIN_OBJS 16
+#define BTOR_MEM_SLAB_MAX_OBJS 4096
+
+struct BtorMemSlabChunk
+{
+  struct BtorMemSlabChunk *next;
+  size_t bytes;
+};
+
+typedef struct BtorMemSlabChunk BtorMemSlabChunk;
+
+BtorMemSlab *
+btor_mem_slab_new (BtorMemMgr *mm, BtorMemTag tag, size_t size)
+{
+  assert (mm);
+  assert (size >= sizeof (void *));
+
+  BtorMemSlab *res;
+
+  res       = btor_mem_calloc_tag (mm, tag, 1, sizeof (BtorMemSlab));
+  res->mm   = mm;
+  res->tag  = tag;
+  res->size = size;
+  return res;
+}
+
+void
+btor_mem_slab_delete (BtorMemSlab *slab)
+{
+  assert (slab);
+
+  BtorMemSlabChunk *chunk, *next;
+
+  for (chunk = slab->chunks; chunk; chunk = next)
+  {
+    next = chunk->next;
+    btor_mem_free_tag (slab->mm, slab->tag, chunk, chunk->bytes);
+  }
+  btor_mem_free_tag (slab->mm, slab->tag, slab, sizeof (BtorMemSlab));
+}
+
+static void
+new_slab_chunk (BtorMemSlab *slab)
+{
+  assert (slab);
+
+  uint_least64_t nobjs;
+  size_t bytes;
+  BtorMemSlabChunk *chunk;
+
+  nobjs = slab->capacity ? slab->capacity : BTOR_MEM_SLAB_MIN_OBJS;
+  if (nobjs > BTOR_MEM_SLAB_MAX_OBJS) nobjs = BTOR_MEM_SLAB_MAX_OBJS;
+  bytes        = sizeof (BtorMemSlabChunk) + nobjs * slab->size;
+  chunk        = btor_mem_malloc_tag (slab->mm, slab->tag, bytes);
+  chunk->next  = slab->chunks;
+  chunk->bytes = bytes;
+  slab->chunks = chunk;
+  slab->top    = (char *) (chunk + 1);
+  slab->end    = slab->top + nobjs * slab->size;
+  slab->nchunks += 1;
+  slab->bytes += bytes;
+  slab->capacity += nobjs;
+}
+
+void *
+btor_mem_slab_alloc (BtorMemSlab *slab)
+{
+  assert (slab);
+
+  void *res;
+
+  if (slab->free_list)
+  {
+    res             = slab->free_list;
+    slab->free_list = *(void **) res;
+  }
+  else
+  {
+    if (slab->top == slab->end) new_slab_chunk (slab);
+    res = slab->top;
+    slab->top += slab->size;
+  }
+  memset (res, 0, slab->size);
+  slab->cur += 1;
+  if (slab->cur > slab->max) slab->max = slab->cur;
+  return res;
+}
+
+void
+btor_mem_slab_free (BtorMemSlab *slab, void *p)
+{
+  assert (slab);
+  assert (p);
+  assert (slab->cur > 0);
+
+  *(void **) p    = slab->free_list;
+  slab->free_list = p;
+  slab->cur -= 1;
+}
+
+/*------------------------------------------------------------------------*/
+
 char *
 btor_mem_strdup (BtorMemMgr *mm, const char *str)
 {
@@ -63,17 +63,104 @@
     (n) = internaln;                          \
   } while (0)
 
+/* Tagged variants, memory is accounted for in category 'tag'.  Memory must
+ * be released with the same tag it was allocated with. */
+
+#define BTOR_NEWN_TAG(mm, tag, ptr, nelems)     \
+  do                                            \
+  {                                             \
+    (ptr) = (typeof(ptr)) btor_mem_malloc_tag ( \
+        (mm), (tag), (nelems) * sizeof *(ptr)); \
+  } while (0)
+
+#define BTOR_CNEWN_TAG(mm, tag, ptr, nelems)    \
+  do                                            \
+  {                                             \
+    (ptr) = (typeof(ptr)) btor_mem_calloc_tag ( \
+        (mm), (tag), (nelems), sizeof *(ptr));  \
+  } while (0)
+
+#define BTOR_DELETEN_TAG(mm, tag, ptr, nelems)                        \
+  do                                                                  \
+  {                                                                   \
+    btor_mem_free_tag ((mm), (tag), (ptr), (nelems) * sizeof *(ptr)); \
+  } while (0)
+
+#define BTOR_REALLOC_TAG(mm, tag, p, o, n)                           \
+  do                                                                 \
+  {                                                                  \
+    (p) = (typeof(p)) btor_mem_realloc_tag (                         \
+        (mm), (tag), (p), ((o) * sizeof *(p)), ((n) * sizeof *(p))); \
+  } while (0)
+
+#define BTOR_NEW_TAG(mm, tag, ptr) BTOR_NEWN_TAG ((mm), (tag), (ptr), 1)
+
+#define BTOR_CNEW_TAG(mm, tag, ptr) BTOR_CNEWN_TAG ((mm), (tag), (ptr), 1)
+
+#define BTOR_DELETE_TAG(mm, tag, ptr) BTOR_DELETEN_TAG ((mm), (tag), (ptr), 1)
+
 /*------------------------------------------------------------------------*/
 
+/* Allocation categories.  Memory allocated via the untagged functions and
+ * macros is accounted for in BTOR_MEM_TAG_OTHER.  SAT solver memory is
+ * tracked separately (cf. 'sat_allocated'). */
+enum BtorMemTag
+{
+  BTOR_MEM_TAG_OTHER,
+  BTOR_MEM_TAG_NODE,    /* expression nodes */
+  BTOR_MEM_TAG_AIG,     /* AIGs and AIG unique table */
+  BTOR_MEM_TAG_AIGVEC,  /* AIG vectors */
+  BTOR_MEM_TAG_BV,      /* bit-vectors */
+  BTOR_MEM_TAG_HASH,    /* hash tables */
+  BTOR_MEM_TAG_RWCACHE, /* rewrite cache */
+  BTOR_MEM_TAG_BETA,    /* beta reduction caches */
+  BTOR_MEM_TAG_MODEL,   /* models and model generation */
+  BTOR_MEM_TAG_CLONE,   /* node maps of clones */
+  BTOR_MEM_TAG_NUM
+};
+
+typedef enum BtorMemTag BtorMemTag;
+
+typedef struct BtorMemMgr BtorMemMgr;
+
 struct BtorMemMgr
 {
   size_t allocated;
   size_t maxallocated;
   size_t sat_allocated;
   size_t sat_maxallocated;
+  size_t tag_allocated[BTOR_MEM_TAG_NUM];
+  size_t tag_maxallocated[BTOR_MEM_TAG_NUM];
+  size_t soft_limit;               /* 0: no limit */
+  size_t hard_limit;               /* 0: no limit */
+  uint8_t soft_limit_reached : 1;  /* sticky until 'btor_mem_check_limit' */
+  uint8_t hard_limit_reached : 1;  /* sticky until 'btor_mem_check_limit' */
+  BtorMemMgr *parent; /* shared manager of a thread manager, 0 otherwise */
+  BtorMemMgr *base;   /* counters of 'parent' when the thread manager was
+                         created */
 };
 
-typedef struct BtorMemMgr BtorMemMgr;
+/* Fixed-size object allocator.  Objects are carved out of chunks obtained
+ * via 'btor_mem_malloc' (and hence accounted for in the memory manager) and
+ * recycled through a free list.  All chunks are released at once when the
+ * slab is deleted. */
+struct BtorMemSlab
+{
+  BtorMemMgr *mm;
+  BtorMemTag tag;   /* allocation category of chunks */
+  size_t size;      /* size of a single object in bytes */
+  void *free_list;  /* released objects, linked through their first word */
+  void *chunks;     /* list of allocated chunks */
+  char *top;        /* next unused object in the most recent chunk */
+  char *end;        /* end of the most recent chunk */
+  uint32_t nchunks; /* number of allocated chunks */
+  size_t bytes;     /* bytes allocated for chunks */
+  uint_least64_t capacity; /* number of objects in all chunks */
+  uint_least64_t cur;      /* number of objects currently in use */
+  uint_least64_t max;      /* maximum number of objects in use */
+};
+
+typedef struct BtorMemSlab BtorMemSlab;
 
 /*------------------------------------------------------------------------*/
 
@@ -95,6 +182,68 @@ void *btor_mem_calloc (BtorMemMgr *mm, size_t nobj, size_t size);
 
 void btor_mem_free (BtorMemMgr *mm, void *p, size_t freed);
 
+void *btor_mem_malloc_tag (BtorMemMgr *mm, BtorMemTag tag, size_t size);
+
+void *btor_mem_realloc_tag (
+    BtorMemMgr *mm, BtorMemTag tag, void *, size_t oldsz, size_t newsz);
+
+void *btor_mem_calloc_tag (BtorMemMgr *mm,
+                           BtorMemTag tag,
+                           size_t nobj,
+                           size_t size);
+
+void btor_mem_free_tag (BtorMemMgr *mm, BtorMemTag tag, void *p, size_t freed);
+
+/* Get the number of bytes currently allocated in category 'tag'. */
+size_t btor_mem_tag_allocated (const BtorMemMgr *mm, BtorMemTag tag);
+
+/* Get the maximum number of bytes allocated in category 'tag'. */
+size_t btor_mem_tag_maxallocated (const BtorMemMgr *mm, BtorMemTag tag);
+
+/* Get the name of category 'tag'. */
+const char *btor_mem_tag_name (BtorMemTag tag);
+
+/* Set soft and hard limit on the total number of bytes allocated (including
+ * SAT solver memory), 0 disables the limits.  Allocations never fail when
+ * a limit is exceeded, they only set 'soft_limit_reached' and
+ * 'hard_limit_reached', respectively. */
+void btor_mem_set_limit (BtorMemMgr *mm, size_t soft_limit, size_t hard_limit);
+
+/* Recompute 'soft_limit_reached' and 'hard_limit_reached' from the number of
+ * bytes currently allocated, e.g., after memory has been released. */
+void btor_mem_check_limit (BtorMemMgr *mm);
+
+/* Memory managers are not thread-safe.  A worker thread accounts its
+ * allocations on 'mm' in a thread manager created by
+ * 'btor_mem_mgr_new_thread' (before the thread is started) and installed
+ * via 'btor_mem_set_thread_mgr' (in the thread).  The thread manager starts
+ * with the counters of 'mm' and an equal share of the remaining budget of
+ * the limits of 'mm' among 'nthreads' threads.  After the thread has been
+ * joined, 'btor_mem_mgr_delete_thread' merges the counters into 'mm'. */
+BtorMemMgr *btor_mem_mgr_new_thread (BtorMemMgr *mm, uint32_t nthreads);
+
+void btor_mem_mgr_delete_thread (BtorMemMgr *tmm);
+
+/* Install thread manager 'tmm' for the calling thread, 0 to uninstall. */
+void btor_mem_set_thread_mgr (BtorMemMgr *tmm);
+
+/* Get the manager that accounts for allocations on 'mm' in the calling
+ * thread, e.g., to check whether a limit has been reached. */
+BtorMemMgr *btor_mem_get_thread_mgr (BtorMemMgr *mm);
+
+/* Create slab allocator for objects of 'size' bytes, accounted for in
+ * category 'tag'. */
+BtorMemSlab *btor_mem_slab_new (BtorMemMgr *mm, BtorMemTag tag, size_t size);
+
+/* Release all chunks of 'slab' (including objects still in use). */
+void btor_mem_slab_delete (BtorMemSlab *slab);
+
+/* Allocate zero-initialized object. */
+void *btor_mem_slab_alloc (BtorMemSlab *slab);
+
+/* Put object back onto the free list of 'slab'. */
+void btor_mem_slab_free (BtorMemSlab *slab, void *p);
+
 char *btor_mem_strdup (BtorMemMgr *mm, const char *str);
 
 void btor_mem_freestr (BtorMemMgr *mm, char *str);
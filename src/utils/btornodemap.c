@@ -13,20 +13,28 @@
 /*------------------------------------------------------------------------*/
 
 BtorNodeMap *
-btor_nodemap_new (Btor *btor)
+btor_nodemap_new_tag (Btor *btor, BtorMemTag tag)
 {
   BtorNodeMap *res;
 
   assert (btor);
 
-  BTOR_NEW (btor->mm, res);
+  BTOR_NEW_TAG (btor->mm, tag, res);
   res->btor  = btor;
-  res->table = btor_hashptr_table_new (btor->mm,
-                                       (BtorHashPtr) btor_node_hash_by_id,
-                                       (BtorCmpPtr) btor_node_compare_by_id);
+  res->table =
+      btor_hashptr_table_new_tag (btor->mm,
+                                  tag,
+                                  (BtorHashPtr) btor_node_hash_by_id,
+                                  (BtorCmpPtr) btor_node_compare_by_id);
   return res;
 }
 
+BtorNodeMap *
+btor_nodemap_new (Btor *btor)
+{
+  return btor_nodemap_new_tag (btor, BTOR_MEM_TAG_HASH);
+}
+
 void
 btor_nodemap_delete (BtorNodeMap *map)
 {
@@ -35,6 +43,7 @@ btor_nodemap_delete (BtorNodeMap *map)
   BtorPtrHashTableIterator it;
   BtorNode *src;
   BtorNode *dst;
+  BtorMemTag tag;
 
   btor_iter_hashptr_init (&it, map->table);
   while (btor_iter_hashptr_has_next (&it))
@@ -44,8 +53,9 @@ btor_nodemap_delete (BtorNodeMap *map)
     src = btor_iter_hashptr_next (&it);
     btor_node_release (btor_node_real_addr (src)->btor, src);
   }
+  tag = map->table->tag;
   btor_hashptr_table_delete (map->table);
-  BTOR_DELETE (map->btor->mm, map);
+  BTOR_DELETE_TAG (map->btor->mm, tag, map);
 }
 
 BtorNode *
@@ -31,6 +31,8 @@ typedef struct BtorNodeMap BtorNodeMap;
 /*------------------------------------------------------------------------*/
 
 BtorNodeMap *btor_nodemap_new (Btor *btor);
+/* Memory of the map is accounted for in category 'tag'. */
+BtorNodeMap *btor_nodemap_new_tag (Btor *btor, BtorMemTag tag);
 BtorNode *btor_nodemap_mapped (BtorNodeMap *map, const BtorNode *node);
 void btor_nodemap_map (BtorNodeMap *map, BtorNode *src, BtorNode *dst);
 void btor_nodemap_delete (BtorNodeMap *map);
@@ -0,0 +1,5 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 32))
+(assert (not (= (bvmul x #x00000002) (bvadd x x))))
+(check-sat)
+(exit)
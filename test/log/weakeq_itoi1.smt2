@@ -0,0 +1,13 @@
+(set-logic QF_ABV)
+(declare-fun a () (Array (_ BitVec 32) (_ BitVec 32)))
+(declare-fun b () (Array (_ BitVec 32) (_ BitVec 32)))
+(declare-fun i () (_ BitVec 32))
+(declare-fun j () (_ BitVec 32))
+(assert
+  (=
+    (store (store (store (store a i i) (bvadd i #x00000001) (bvadd i #x00000001)) (bvadd i #x00000002) (bvadd i #x00000002)) (bvadd i #x00000003) (bvadd i #x00000003))
+    (store (store (store (store b (bvadd i #x00000003) (bvadd i #x00000003)) (bvadd i #x00000002) (bvadd i #x00000002)) (bvadd i #x00000001) (bvadd i #x00000001)) i i)))
+(assert (bvuge (bvsub j i) #x00000004))
+(assert (distinct (select a j) (select b j)))
+(check-sat)
+(exit)
@@ -0,0 +1,12 @@
+(set-logic QF_ABV)
+(declare-fun a () (Array (_ BitVec 32) (_ BitVec 8)))
+(declare-fun b () (Array (_ BitVec 32) (_ BitVec 8)))
+(declare-fun i () (_ BitVec 32))
+(declare-fun j () (_ BitVec 32))
+(declare-fun k () (_ BitVec 32))
+(declare-fun s () (Array (_ BitVec 32) (_ BitVec 8)))
+(assert (= (store (store (store (store a i (select s k)) (bvadd i #x00000001) (select s (bvadd k #x00000001))) (bvadd i #x00000002) (select s (bvadd k #x00000002))) (bvadd i #x00000003) (select s (bvadd k #x00000003))) (store (store (store (store b i (select s k)) (bvadd i #x00000001) (select s (bvadd k #x00000001))) (bvadd i #x00000002) (select s (bvadd k #x00000002))) (bvadd i #x00000003) (select s (bvadd k #x00000003)))))
+(assert (bvult (bvsub j i) #x00000004))
+(assert (distinct (select a j) (select b j)))
+(check-sat)
+(exit)
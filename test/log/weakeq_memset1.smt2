@@ -0,0 +1,11 @@
+(set-logic QF_ABV)
+(declare-fun a () (Array (_ BitVec 32) (_ BitVec 8)))
+(declare-fun b () (Array (_ BitVec 32) (_ BitVec 8)))
+(declare-fun i () (_ BitVec 32))
+(declare-fun j () (_ BitVec 32))
+(declare-fun v () (_ BitVec 8))
+(assert (= (store (store (store (store a i v) (bvadd i #x00000001) v) (bvadd i #x00000002) v) (bvadd i #x00000003) v) (store (store (store (store b i v) (bvadd i #x00000001) v) (bvadd i #x00000002) v) (bvadd i #x00000003) v)))
+(assert (bvuge (bvsub j i) #x00000004))
+(assert (distinct (select a j) (select b j)))
+(check-sat)
+(exit)
@@ -0,0 +1,13 @@
+(set-logic QF_ABV)
+(declare-fun a () (Array (_ BitVec 32) (_ BitVec 8)))
+(declare-fun b () (Array (_ BitVec 32) (_ BitVec 8)))
+(declare-fun i () (_ BitVec 32))
+(declare-fun j () (_ BitVec 32))
+(declare-fun c () (Array (_ BitVec 32) (_ BitVec 8)))
+(declare-fun v () (_ BitVec 8))
+(assert (or (= (store a i v) b) (= a c)))
+(assert (distinct i j))
+(assert (distinct (select a j) (select b j)))
+(assert (distinct (select a j) (select c j)))
+(check-sat)
+(exit)
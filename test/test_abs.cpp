@@ -0,0 +1,127 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btoropt.h"
+#include "utils/btorutil.h"
+}
+
+class TestAbs : public TestBoolector
+{
+ protected:
+  static constexpr uint32_t TEST_ABS_BW = 4;
+
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_ENGINE, BTOR_ENGINE_ABS);
+    boolector_set_opt (d_btor, BTOR_OPT_ABS_MIN_WIDTH, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  }
+
+  /* Check for all values a, b that x = a, y = b implies btorfun (x, y) =
+   * func (a, b) under assumptions. */
+  void test_abs (uint32_t (*func) (uint32_t, uint32_t),
+                 BoolectorNode *(*btorfun) (Btor *,
+                                            BoolectorNode *,
+                                            BoolectorNode *),
+                 uint32_t lemmas)
+  {
+    uint32_t a, b, max;
+    BoolectorSort sort;
+    BoolectorNode *x, *y, *r, *ca, *cb, *cr, *eqa, *eqb, *eqr, *neqr;
+
+    boolector_set_opt (d_btor, BTOR_OPT_ABS_LEMMAS, lemmas);
+
+    max  = btor_util_pow_2 (TEST_ABS_BW);
+    sort = boolector_bitvec_sort (d_btor, TEST_ABS_BW);
+    x    = boolector_var (d_btor, sort, "x");
+    y    = boolector_var (d_btor, sort, "y");
+    r    = btorfun (d_btor, x, y);
+
+    for (a = 0; a < max; a++)
+    {
+      for (b = 0; b < max; b++)
+      {
+        ca   = boolector_unsigned_int (d_btor, a, sort);
+        cb   = boolector_unsigned_int (d_btor, b, sort);
+        cr   = boolector_unsigned_int (d_btor, func (a, b) % max, sort);
+        eqa  = boolector_eq (d_btor, x, ca);
+        eqb  = boolector_eq (d_btor, y, cb);
+        eqr  = boolector_eq (d_btor, r, cr);
+        neqr = boolector_not (d_btor, eqr);
+
+        boolector_assume (d_btor, eqa);
+        boolector_assume (d_btor, eqb);
+        ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+        boolector_assume (d_btor, eqa);
+        boolector_assume (d_btor, eqb);
+        boolector_assume (d_btor, neqr);
+        ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+        boolector_release (d_btor, ca);
+        boolector_release (d_btor, cb);
+        boolector_release (d_btor, cr);
+        boolector_release (d_btor, eqa);
+        boolector_release (d_btor, eqb);
+        boolector_release (d_btor, eqr);
+        boolector_release (d_btor, neqr);
+      }
+    }
+
+    boolector_release (d_btor, x);
+    boolector_release (d_btor, y);
+    boolector_release (d_btor, r);
+    boolector_release_sort (d_btor, sort);
+  }
+
+  static uint32_t mul (uint32_t x, uint32_t y) { return x * y; }
+
+  static uint32_t udiv (uint32_t x, uint32_t y)
+  {
+    return y == 0 ? btor_util_pow_2 (TEST_ABS_BW) - 1 : x / y;
+  }
+
+  static uint32_t urem (uint32_t x, uint32_t y) { return y == 0 ? x : x % y; }
+};
+
+TEST_F (TestAbs, mul) { test_abs (mul, boolector_mul, 1000); }
+
+TEST_F (TestAbs, mul_bit_blast) { test_abs (mul, boolector_mul, 0); }
+
+TEST_F (TestAbs, udiv) { test_abs (udiv, boolector_udiv, 1000); }
+
+TEST_F (TestAbs, udiv_bit_blast) { test_abs (udiv, boolector_udiv, 0); }
+
+TEST_F (TestAbs, urem) { test_abs (urem, boolector_urem, 1000); }
+
+TEST_F (TestAbs, urem_bit_blast) { test_abs (urem, boolector_urem, 0); }
+
+TEST_F (TestAbs, sqrt)
+{
+  BoolectorSort sort;
+  BoolectorNode *x, *xx, *c, *eq;
+
+  /* squares of odd numbers are 1 modulo 8 */
+  sort = boolector_bitvec_sort (d_btor, 3);
+  x    = boolector_var (d_btor, sort, "x");
+  xx   = boolector_mul (d_btor, x, x);
+  c    = boolector_unsigned_int (d_btor, 5, sort);
+  eq   = boolector_eq (d_btor, xx, c);
+  boolector_assert (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, xx);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, eq);
+  boolector_release_sort (d_btor, sort);
+}
@@ -0,0 +1,84 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btorexp.h"
+#include "preprocess/btorack.h"
+}
+
+class TestAck : public TestBtor
+{
+ protected:
+  /* Assert f (i) != 255 for f (0), ..., f (7), f (x) and f (1111 :: x[3:0])
+   * with an uninterpreted function f. */
+  void add_applies ()
+  {
+    BtorSortId s4, s8, tup, fs;
+    BtorNode *f, *x, *arg, *app, *ff, *lo, *c, *ne;
+    uint32_t i;
+
+    s4  = btor_sort_bv (d_btor, 4);
+    s8  = btor_sort_bv (d_btor, 8);
+    tup = btor_sort_tuple (d_btor, &s8, 1);
+    fs  = btor_sort_fun (d_btor, tup, s8);
+    f   = btor_exp_uf (d_btor, fs, 0);
+    x   = btor_exp_var (d_btor, s8, 0);
+    c   = btor_exp_bv_unsigned (d_btor, 255, s8);
+    for (i = 0; i < 10; i++)
+    {
+      if (i < 8)
+        arg = btor_exp_bv_unsigned (d_btor, i, s8);
+      else if (i == 8)
+        arg = btor_node_copy (d_btor, x);
+      else
+      {
+        ff  = btor_exp_bv_unsigned (d_btor, 15, s4);
+        lo  = btor_exp_bv_slice (d_btor, x, 3, 0);
+        arg = btor_exp_bv_concat (d_btor, ff, lo);
+        btor_node_release (d_btor, ff);
+        btor_node_release (d_btor, lo);
+      }
+      app = btor_exp_apply_n (d_btor, f, &arg, 1);
+      ne  = btor_exp_ne (d_btor, app, c);
+      btor_assert_exp (d_btor, ne);
+      btor_node_release (d_btor, ne);
+      btor_node_release (d_btor, app);
+      btor_node_release (d_btor, arg);
+    }
+    btor_node_release (d_btor, c);
+    btor_node_release (d_btor, x);
+    btor_node_release (d_btor, f);
+    btor_sort_release (d_btor, fs);
+    btor_sort_release (d_btor, tup);
+    btor_sort_release (d_btor, s8);
+    btor_sort_release (d_btor, s4);
+  }
+};
+
+TEST_F (TestAck, all_pairs)
+{
+  btor_opt_set (d_btor, BTOR_OPT_ACKERMANN_PRUNE, 0);
+  add_applies ();
+  btor_add_ackermann_constraints (d_btor);
+  ASSERT_EQ (d_btor->stats.ackermann_constraints, 45u);
+  ASSERT_EQ (d_btor->stats.ackermann_pruned, 0u);
+}
+
+TEST_F (TestAck, prune)
+{
+  add_applies ();
+  btor_add_ackermann_constraints (d_btor);
+  /* f (x) is paired with all other applications, the remaining pairs have
+   * distinct arguments */
+  ASSERT_EQ (d_btor->stats.ackermann_constraints, 9u);
+  ASSERT_EQ (d_btor->stats.ackermann_pruned, 36u);
+  ASSERT_EQ (btor_check_sat (d_btor, -1, -1), BTOR_RESULT_SAT);
+}
@@ -9,9 +9,14 @@
 
 extern "C" {
 #include "btoraig.h"
+#include "btoraigrw.h"
+#include "btorcore.h"
 #include "dumper/btordumpaig.h"
 }
 
+#include <unordered_set>
+#include <vector>
+
 class TestAig : public TestBtor
 {
  protected:
@@ -35,6 +40,61 @@ class TestAig : public TestBtor
     btor_aig_release (amgr, aig5);
     btor_aig_mgr_delete (amgr);
   }
+
+  /* Evaluate 'aig' under the assignment 'bits' to 'vars'. */
+  bool eval (BtorAIGMgr *amgr,
+             BtorAIG *aig,
+             BtorAIG **vars,
+             uint32_t nvars,
+             uint32_t bits)
+  {
+    bool res = true;
+    BtorAIG *real;
+
+    if (aig == BTOR_AIG_FALSE) return false;
+    if (aig == BTOR_AIG_TRUE) return true;
+    real = BTOR_REAL_ADDR_AIG (aig);
+    if (btor_aig_is_var (real))
+    {
+      for (uint32_t i = 0; i < nvars; i++)
+        if (vars[i] == real) res = (bits >> i) & 1;
+    }
+    else
+      res = eval (amgr,
+                  btor_aig_get_left_child (amgr, real),
+                  vars,
+                  nvars,
+                  bits)
+            && eval (amgr,
+                     btor_aig_get_right_child (amgr, real),
+                     vars,
+                     nvars,
+                     bits);
+    return BTOR_IS_INVERTED_AIG (aig) ? !res : res;
+  }
+
+  /* Count ANDs in the cones of 'aigs'. */
+  uint32_t count_ands (BtorAIGMgr *amgr, BtorAIG **aigs, uint32_t naigs)
+  {
+    std::unordered_set<BtorAIG *> cache;
+    std::vector<BtorAIG *> stack;
+    BtorAIG *cur;
+
+    for (uint32_t i = 0; i < naigs; i++)
+      if (!btor_aig_is_const (aigs[i]))
+        stack.push_back (BTOR_REAL_ADDR_AIG (aigs[i]));
+    while (!stack.empty ())
+    {
+      cur = stack.back ();
+      stack.pop_back ();
+      if (!btor_aig_is_and (cur) || !cache.insert (cur).second) continue;
+      stack.push_back (
+          BTOR_REAL_ADDR_AIG (btor_aig_get_left_child (amgr, cur)));
+      stack.push_back (
+          BTOR_REAL_ADDR_AIG (btor_aig_get_right_child (amgr, cur)));
+    }
+    return cache.size ();
+  }
 };
 
 TEST_F (TestAig, new_delete_aig_mgr)
@@ -119,6 +179,39 @@ TEST_F (TestAig, cond)
   btor_aig_mgr_delete (amgr);
 }
 
+TEST_F (TestAig, unique_table_resize)
+{
+  const uint32_t n = 64;
+  uint32_t i, j;
+  bool resizing    = false;
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorAIG *vars[n], *ands[n][n];
+
+  for (i = 0; i < n; i++) vars[i] = btor_aig_var (amgr);
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++)
+    {
+      ands[i][j] = btor_aig_and (amgr, vars[i], BTOR_INVERT_AIG (vars[j]));
+      if (amgr->table.old_chains) resizing = true;
+    }
+  ASSERT_TRUE (resizing);
+
+  /* AIGs are found regardless of whether their chain has been migrated */
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++)
+    {
+      BtorAIG *aig = btor_aig_and (amgr, vars[i], BTOR_INVERT_AIG (vars[j]));
+      ASSERT_EQ (aig, ands[i][j]);
+      btor_aig_release (amgr, aig);
+    }
+
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++) btor_aig_release (amgr, ands[i][j]);
+  for (i = 0; i < n; i++) btor_aig_release (amgr, vars[i]);
+  ASSERT_EQ (amgr->table.num_elements, 0u);
+  btor_aig_mgr_delete (amgr);
+}
+
 TEST_F (TestAig, aig_to_sat)
 {
   BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
@@ -143,3 +236,197 @@ TEST_F (TestAig, aig_to_sat)
   btor_aig_release (amgr, and3);
   btor_aig_mgr_delete (amgr);
 }
+
+TEST_F (TestAig, pages)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorAIG *var     = btor_aig_var (amgr);
+  BtorAIG *aig, *tmp, *v;
+  int32_t id;
+  uint32_t i;
+
+  ASSERT_EQ (amgr->num_pages, 1u);
+  aig = btor_aig_copy (amgr, var);
+  for (i = 0; i < 2 * BTOR_AIG_PAGE_SIZE; i++)
+  {
+    v   = btor_aig_var (amgr);
+    tmp = btor_aig_and (amgr, aig, v);
+    btor_aig_release (amgr, v);
+    btor_aig_release (amgr, aig);
+    aig = tmp;
+  }
+  ASSERT_EQ (amgr->num_pages, 5u);
+  id = btor_aig_get_id (aig);
+  ASSERT_EQ (btor_aig_get_by_id (amgr, id), aig);
+  ASSERT_EQ (btor_aig_get_by_id (amgr, -id), BTOR_INVERT_AIG (aig));
+  btor_aig_release (amgr, aig);
+  ASSERT_EQ (btor_aig_get_by_id (amgr, id), BTOR_AIG_FALSE);
+  /* only the page containing 'var' and the partially filled page remain */
+  ASSERT_EQ (amgr->num_pages, 2u);
+  ASSERT_TRUE (btor_aig_is_var (btor_aig_get_by_id (amgr, 2)));
+  btor_aig_release (amgr, var);
+  btor_aig_mgr_delete (amgr);
+}
+
+TEST_F (TestAig, rewrite)
+{
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorAIG *a       = btor_aig_var (amgr);
+  BtorAIG *b       = btor_aig_var (amgr);
+  BtorAIG *c       = btor_aig_var (amgr);
+  BtorAIG *ab      = btor_aig_and (amgr, a, b);
+  BtorAIG *ac      = btor_aig_and (amgr, a, c);
+  BtorAIG *vars[3] = {a, b, c};
+  BtorAIG *aig     = btor_aig_or (amgr, ab, ac);
+  uint32_t i;
+  bool expected[8];
+
+  btor_aig_release (amgr, ab);
+  btor_aig_release (amgr, ac);
+  for (i = 0; i < 8; i++) expected[i] = eval (amgr, aig, vars, 3, i);
+  ASSERT_EQ (count_ands (amgr, &aig, 1), 3u);
+
+  /* (a & b) | (a & c) = a & (b | c) */
+  btor_aig_rewrite (amgr, &aig, 1);
+  ASSERT_EQ (count_ands (amgr, &aig, 1), 2u);
+  ASSERT_EQ (amgr->num_rw_ands_before, 3u);
+  ASSERT_EQ (amgr->num_rw_ands_after, 2u);
+  for (i = 0; i < 8; i++) ASSERT_EQ (eval (amgr, aig, vars, 3, i), expected[i]);
+
+  btor_aig_release (amgr, aig);
+  btor_aig_release (amgr, a);
+  btor_aig_release (amgr, b);
+  btor_aig_release (amgr, c);
+  btor_aig_mgr_delete (amgr);
+}
+
+TEST_F (TestAig, rewrite_random)
+{
+  const uint32_t nvars = 6, nands = 40, nroots = 4;
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorRNG *rng     = &d_btor->rng;
+  BtorAIG *vars[nvars], *roots[nroots], *l, *r;
+  std::vector<BtorAIG *> aigs;
+  uint32_t i, j, k, before;
+  bool expected[nroots][1u << nvars];
+
+  for (i = 0; i < nvars; i++)
+  {
+    vars[i] = btor_aig_var (amgr);
+    aigs.push_back (btor_aig_copy (amgr, vars[i]));
+  }
+
+  for (k = 0; k < 20; k++)
+  {
+    for (i = 0; i < nands; i++)
+    {
+      l = aigs[btor_rng_pick_rand (rng, 0, aigs.size () - 1)];
+      r = aigs[btor_rng_pick_rand (rng, 0, aigs.size () - 1)];
+      if (btor_rng_pick_rand (rng, 0, 1)) l = BTOR_INVERT_AIG (l);
+      if (btor_rng_pick_rand (rng, 0, 1)) r = BTOR_INVERT_AIG (r);
+      aigs.push_back (btor_aig_and (amgr, l, r));
+    }
+    for (i = 0; i < nroots; i++)
+    {
+      roots[i] = btor_aig_copy (amgr, aigs[aigs.size () - 1 - i]);
+      for (j = 0; j < (1u << nvars); j++)
+        expected[i][j] = eval (amgr, roots[i], vars, nvars, j);
+    }
+
+    before = count_ands (amgr, roots, nroots);
+    btor_aig_rewrite (amgr, roots, nroots);
+    ASSERT_LE (count_ands (amgr, roots, nroots), before);
+    for (i = 0; i < nroots; i++)
+    {
+      for (j = 0; j < (1u << nvars); j++)
+        ASSERT_EQ (eval (amgr, roots[i], vars, nvars, j), expected[i][j]);
+      btor_aig_release (amgr, roots[i]);
+    }
+    for (i = nvars; i < aigs.size (); i++) btor_aig_release (amgr, aigs[i]);
+    aigs.resize (nvars);
+  }
+  ASSERT_LE (amgr->num_rw_ands_after, amgr->num_rw_ands_before);
+
+  for (i = 0; i < nvars; i++)
+  {
+    btor_aig_release (amgr, aigs[i]);
+    btor_aig_release (amgr, vars[i]);
+  }
+  btor_aig_mgr_delete (amgr);
+}
+
+TEST_F (TestAig, cnf_pg_random)
+{
+  const uint32_t nvars = 5, nands = 30;
+  BtorAIGMgr *amgr = btor_aig_mgr_new (d_btor);
+  BtorSATMgr *smgr = btor_aig_get_sat_mgr (amgr);
+  BtorRNG *rng     = &d_btor->rng;
+  BtorAIG *vars[nvars], *root, *pos, *neg, *sel[2], *l, *r;
+  std::vector<BtorAIG *> aigs;
+  uint32_t i, j, k;
+  int32_t lit;
+
+  btor_opt_set (d_btor, BTOR_OPT_AIG_CNF_PG, 1);
+  btor_opt_set (d_btor, BTOR_OPT_AIG_CNF_NARY, 1);
+  btor_sat_enable_solver (smgr);
+  btor_sat_init (smgr);
+
+  for (i = 0; i < nvars; i++)
+  {
+    vars[i] = btor_aig_var (amgr);
+    btor_aig_to_sat (amgr, vars[i]);
+    aigs.push_back (btor_aig_copy (amgr, vars[i]));
+  }
+
+  for (k = 0; k < 10; k++)
+  {
+    for (i = 0; i < nands; i++)
+    {
+      l = aigs[btor_rng_pick_rand (rng, 0, aigs.size () - 1)];
+      r = aigs[btor_rng_pick_rand (rng, 0, aigs.size () - 1)];
+      if (btor_rng_pick_rand (rng, 0, 1)) l = BTOR_INVERT_AIG (l);
+      if (btor_rng_pick_rand (rng, 0, 1)) r = BTOR_INVERT_AIG (r);
+      aigs.push_back (btor_aig_and (amgr, l, r));
+    }
+    root = aigs.back ();
+    if (btor_aig_is_const (root)) continue;
+
+    /* add 'root' in positive and later in negative polarity, guarded by
+     * selector variables, the second encoding completes the first one */
+    sel[0] = btor_aig_var (amgr);
+    sel[1] = btor_aig_var (amgr);
+    pos    = btor_aig_or (amgr, BTOR_INVERT_AIG (sel[0]), root);
+    neg    = btor_aig_or (amgr, BTOR_INVERT_AIG (sel[1]), BTOR_INVERT_AIG (root));
+    for (j = 0; j < 2; j++)
+    {
+      btor_aig_add_toplevel_to_sat (amgr, j ? neg : pos);
+      btor_aig_to_sat (amgr, sel[j]);
+      for (i = 0; i < (1u << nvars); i++)
+      {
+        for (uint32_t v = 0; v < nvars; v++)
+        {
+          lit = btor_aig_get_cnf_id (vars[v]);
+          btor_sat_assume (smgr, (i >> v) & 1 ? lit : -lit);
+        }
+        btor_sat_assume (smgr, btor_aig_get_cnf_id (sel[j]));
+        ASSERT_EQ (btor_sat_check_sat (smgr, -1) == BTOR_RESULT_SAT,
+                   eval (amgr, root, vars, nvars, i) == !j);
+        if (eval (amgr, root, vars, nvars, i) != !j) continue;
+        /* assignments of partially encoded AIGs are computed from their
+         * inputs */
+        for (BtorAIG *aig : aigs)
+          ASSERT_EQ (btor_aig_get_assignment (amgr, aig) == 1,
+                     eval (amgr, aig, vars, nvars, i));
+      }
+    }
+    btor_aig_release (amgr, pos);
+    btor_aig_release (amgr, neg);
+    btor_aig_release (amgr, sel[0]);
+    btor_aig_release (amgr, sel[1]);
+  }
+
+  for (BtorAIG *aig : aigs) btor_aig_release (amgr, aig);
+  for (i = 0; i < nvars; i++) btor_aig_release (amgr, vars[i]);
+  btor_sat_reset (smgr);
+  btor_aig_mgr_delete (amgr);
+}
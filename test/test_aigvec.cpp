@@ -11,6 +11,8 @@
 extern "C" {
 #include "btoraigvec.h"
 #include "btorbv.h"
+#include "btorexp.h"
+#include "utils/btoraigmap.h"
 }
 
 class TestAigvec : public TestBtor
@@ -238,6 +240,160 @@ TEST_F (TestAigvec, mul)
   btor_aigvec_mgr_delete (avmgr);
 }
 
+TEST_F (TestAigvec, mul_enc)
+{
+  BtorAIGVecMgr *avmgr = btor_aigvec_mgr_new (d_btor);
+  BtorBitVector *bv1, *bv2, *bv3;
+  BtorAIGVec *av1, *av2, *av3, *av4;
+  uint32_t enc, csd, width, i, j;
+
+  for (enc = BTOR_MUL_ENC_MIN; enc <= BTOR_MUL_ENC_MAX; enc++)
+  {
+    btor_opt_set (d_btor, BTOR_OPT_MUL_ENC, enc);
+    for (csd = 0; csd <= 1; csd++)
+    {
+      btor_opt_set (d_btor, BTOR_OPT_MUL_CSD, csd);
+      for (width = 1; width <= 5; width++)
+      {
+        for (i = 0; i < (1u << width); i++)
+          for (j = 0; j < (1u << width); j++)
+          {
+            bv1 = btor_bv_uint64_to_bv (d_btor->mm, i, width);
+            bv2 = btor_bv_uint64_to_bv (d_btor->mm, j, width);
+            bv3 = btor_bv_mul (d_btor->mm, bv1, bv2);
+            av1 = btor_aigvec_const (avmgr, bv1);
+            av2 = btor_aigvec_const (avmgr, bv2);
+            av3 = btor_aigvec_mul (avmgr, av1, av2);
+            av4 = btor_aigvec_const (avmgr, bv3);
+            ASSERT_EQ (memcmp (av3->aigs, av4->aigs, sizeof (BtorAIG *) * width),
+                       0);
+            btor_aigvec_release_delete (avmgr, av1);
+            btor_aigvec_release_delete (avmgr, av2);
+            btor_aigvec_release_delete (avmgr, av3);
+            btor_aigvec_release_delete (avmgr, av4);
+            btor_bv_free (d_btor->mm, bv1);
+            btor_bv_free (d_btor->mm, bv2);
+            btor_bv_free (d_btor->mm, bv3);
+          }
+        av1 = btor_aigvec_var (avmgr, width);
+        av2 = btor_aigvec_var (avmgr, width);
+        av3 = btor_aigvec_mul (avmgr, av1, av2);
+        ASSERT_EQ (av3->width, width);
+        btor_aigvec_release_delete (avmgr, av1);
+        btor_aigvec_release_delete (avmgr, av2);
+        btor_aigvec_release_delete (avmgr, av3);
+      }
+    }
+  }
+  btor_aigvec_mgr_delete (avmgr);
+}
+
+TEST_F (TestAigvec, mul_booth_const)
+{
+  BtorAIGVecMgr *avmgr = btor_aigvec_mgr_new (d_btor);
+  BtorBitVector *bv    = btor_bv_uint64_to_bv (d_btor->mm, 2, 32);
+  BtorAIGVec *av1, *av2, *av3, *av4;
+  uint32_t num_aigs;
+
+  btor_opt_set (d_btor, BTOR_OPT_MUL_ENC, BTOR_MUL_ENC_BOOTH);
+  av1      = btor_aigvec_var (avmgr, 32);
+  av2      = btor_aigvec_const (avmgr, bv);
+  num_aigs = avmgr->amgr->cur_num_aigs;
+  /* multiplying by 2 is a shift, independent of the operand order */
+  av3 = btor_aigvec_mul (avmgr, av1, av2);
+  av4 = btor_aigvec_mul (avmgr, av2, av1);
+  ASSERT_EQ (avmgr->amgr->cur_num_aigs, num_aigs);
+  btor_aigvec_release_delete (avmgr, av1);
+  btor_aigvec_release_delete (avmgr, av2);
+  btor_aigvec_release_delete (avmgr, av3);
+  btor_aigvec_release_delete (avmgr, av4);
+  btor_aigvec_mgr_delete (avmgr);
+  btor_bv_free (d_btor->mm, bv);
+}
+
+TEST_F (TestAigvec, div_enc)
+{
+  BtorAIGVecMgr *avmgr = btor_aigvec_mgr_new (d_btor);
+  BtorBitVector *bv1, *bv2, *bv3, *bv4;
+  BtorAIGVec *av1, *av2, *av3, *av4, *av5, *av6;
+  uint32_t enc, width, i, j;
+
+  for (enc = BTOR_DIV_ENC_MIN; enc <= BTOR_DIV_ENC_MAX; enc++)
+  {
+    btor_opt_set (d_btor, BTOR_OPT_DIV_ENC, enc);
+    for (width = 1; width <= 5; width++)
+    {
+      for (i = 0; i < (1u << width); i++)
+        for (j = 0; j < (1u << width); j++)
+        {
+          bv1 = btor_bv_uint64_to_bv (d_btor->mm, i, width);
+          bv2 = btor_bv_uint64_to_bv (d_btor->mm, j, width);
+          bv3 = btor_bv_udiv (d_btor->mm, bv1, bv2);
+          bv4 = btor_bv_urem (d_btor->mm, bv1, bv2);
+          av1 = btor_aigvec_const (avmgr, bv1);
+          av2 = btor_aigvec_const (avmgr, bv2);
+          av3 = btor_aigvec_udiv (avmgr, av1, av2);
+          av4 = btor_aigvec_urem (avmgr, av1, av2);
+          av5 = btor_aigvec_const (avmgr, bv3);
+          av6 = btor_aigvec_const (avmgr, bv4);
+          ASSERT_EQ (memcmp (av3->aigs, av5->aigs, sizeof (BtorAIG *) * width),
+                     0);
+          ASSERT_EQ (memcmp (av4->aigs, av6->aigs, sizeof (BtorAIG *) * width),
+                     0);
+          btor_aigvec_release_delete (avmgr, av1);
+          btor_aigvec_release_delete (avmgr, av2);
+          btor_aigvec_release_delete (avmgr, av3);
+          btor_aigvec_release_delete (avmgr, av4);
+          btor_aigvec_release_delete (avmgr, av5);
+          btor_aigvec_release_delete (avmgr, av6);
+          btor_bv_free (d_btor->mm, bv1);
+          btor_bv_free (d_btor->mm, bv2);
+          btor_bv_free (d_btor->mm, bv3);
+          btor_bv_free (d_btor->mm, bv4);
+        }
+    }
+  }
+  btor_aigvec_mgr_delete (avmgr);
+}
+
+TEST_F (TestAigvec, udiv_urem_shared)
+{
+  BtorAIGVecMgr *avmgr = btor_aigvec_mgr_new (d_btor);
+  BtorAIGVec *av1      = btor_aigvec_var (avmgr, 16);
+  BtorAIGVec *av2      = btor_aigvec_var (avmgr, 16);
+  BtorAIGVec *av3      = btor_aigvec_udiv (avmgr, av1, av2);
+  uint32_t num_aigs    = avmgr->amgr->cur_num_aigs;
+  BtorAIGVec *av4      = btor_aigvec_urem (avmgr, av1, av2);
+  ASSERT_EQ (avmgr->amgr->cur_num_aigs, num_aigs);
+  ASSERT_EQ (avmgr->div_cache->count, 0u);
+  btor_aigvec_release_delete (avmgr, av1);
+  btor_aigvec_release_delete (avmgr, av2);
+  btor_aigvec_release_delete (avmgr, av3);
+  btor_aigvec_release_delete (avmgr, av4);
+  btor_aigvec_mgr_delete (avmgr);
+}
+
+TEST_F (TestAigvec, udiv_cache_bounded)
+{
+  BtorAIGVecMgr *avmgr = btor_aigvec_mgr_new (d_btor);
+  BtorAIGVec *av1, *av2, *av3;
+  uint32_t i;
+
+  /* remainders that are never requested must not pile up */
+  for (i = 0; i < 2 * BTOR_AIGVEC_DIV_CACHE_SIZE; i++)
+  {
+    av1 = btor_aigvec_var (avmgr, 4);
+    av2 = btor_aigvec_var (avmgr, 4);
+    av3 = btor_aigvec_udiv (avmgr, av1, av2);
+    ASSERT_LE (avmgr->div_cache->count, (uint32_t) BTOR_AIGVEC_DIV_CACHE_SIZE);
+    btor_aigvec_release_delete (avmgr, av1);
+    btor_aigvec_release_delete (avmgr, av2);
+    btor_aigvec_release_delete (avmgr, av3);
+  }
+  ASSERT_EQ (avmgr->div_cache->count, (uint32_t) BTOR_AIGVEC_DIV_CACHE_SIZE);
+  btor_aigvec_mgr_delete (avmgr);
+}
+
 TEST_F (TestAigvec, udiv)
 {
   BtorAIGVecMgr *avmgr = btor_aigvec_mgr_new (d_btor);
@@ -291,3 +447,75 @@ TEST_F (TestAigvec, cond)
   btor_aigvec_release_delete (avmgr, av4);
   btor_aigvec_mgr_delete (avmgr);
 }
+
+TEST_F (TestAigvec, import)
+{
+  BtorAIGVecMgr *avmgr1 = btor_aigvec_mgr_new (d_btor);
+  BtorAIGVecMgr *avmgr2 = btor_aigvec_mgr_new (d_btor);
+  BtorAIGVec *av1       = btor_aigvec_var (avmgr1, 32);
+  BtorAIGVec *av2       = btor_aigvec_var (avmgr1, 32);
+  BtorAIGVec *av3       = btor_aigvec_mul (avmgr1, av1, av2);
+  BtorAIGMap *map       = btor_aigmap_new (d_btor,
+                                     btor_aigvec_get_aig_mgr (avmgr1),
+                                     btor_aigvec_get_aig_mgr (avmgr2));
+  BtorAIGVec *av4       = btor_aigvec_import (avmgr2, map, av3);
+  BtorAIGVec *av5       = btor_aigvec_import (avmgr2, map, av1);
+  ASSERT_TRUE (av4->width == 32);
+  ASSERT_TRUE (av5->width == 32);
+  ASSERT_TRUE (av5->aigs[31] == btor_aigmap_mapped (map, av1->aigs[31]));
+  btor_aigmap_delete (map);
+  btor_aigvec_release_delete (avmgr1, av1);
+  btor_aigvec_release_delete (avmgr1, av2);
+  btor_aigvec_release_delete (avmgr1, av3);
+  btor_aigvec_release_delete (avmgr2, av4);
+  btor_aigvec_release_delete (avmgr2, av5);
+  btor_aigvec_mgr_delete (avmgr1);
+  btor_aigvec_mgr_delete (avmgr2);
+}
+
+#ifdef BTOR_HAVE_PTHREADS
+/* Bit-blasting independent constraints concurrently yields the same CNF for
+ * any number of threads. */
+TEST_F (TestAigvec, synth_threads)
+{
+  uint32_t i, j, nthreads[] = {2, 3, 8};
+  int32_t maxvar = 0, clauses = 0;
+  Btor *btor;
+  BtorSortId s;
+  BtorNode *x, *y, *m, *c, *e;
+  BtorSATMgr *smgr;
+
+  for (i = 0; i < sizeof (nthreads) / sizeof (*nthreads); i++)
+  {
+    btor = btor_new ();
+    btor_opt_set (btor, BTOR_OPT_SYNTH_THREADS, nthreads[i]);
+    btor_opt_set (btor, BTOR_OPT_REWRITE_LEVEL, 0);
+    s = btor_sort_bv (btor, 16);
+    for (j = 0; j < 8; j++)
+    {
+      x = btor_exp_var (btor, s, 0);
+      y = btor_exp_var (btor, s, 0);
+      m = btor_exp_bv_mul (btor, x, y);
+      c = btor_exp_bv_unsigned (btor, 143 + 2 * j, s);
+      e = btor_exp_eq (btor, m, c);
+      btor_assert_exp (btor, e);
+      btor_node_release (btor, e);
+      btor_node_release (btor, c);
+      btor_node_release (btor, m);
+      btor_node_release (btor, y);
+      btor_node_release (btor, x);
+    }
+    btor_sort_release (btor, s);
+    ASSERT_EQ (btor_check_sat (btor, -1, -1), BTOR_RESULT_SAT);
+    smgr = btor_get_sat_mgr (btor);
+    if (i == 0)
+    {
+      maxvar  = smgr->maxvar;
+      clauses = smgr->clauses;
+    }
+    ASSERT_EQ (smgr->maxvar, maxvar);
+    ASSERT_EQ (smgr->clauses, clauses);
+    btor_delete (btor);
+  }
+}
+#endif
@@ -666,6 +666,215 @@ class TestBv : public TestBtor
     }
   }
 
+  /* Check the limb-wise kernels for widths that exceed the native integer
+   * fast paths against shift-and-add / bit-wise reference computations. */
+  void wide_bitvec (uint32_t num_tests, uint32_t bw)
+  {
+    uint32_t i, j, up, lo;
+    BtorBitVector *a, *b, *c, *d, *e, *tmp, *zero, *res;
+
+    zero = btor_bv_new (d_mm, bw);
+    for (i = 0; i < num_tests; i++)
+    {
+      a = btor_bv_new_random (d_mm, d_rng, bw);
+      b = btor_bv_new_random (d_mm, d_rng, bw);
+
+      /* add, sub, neg, inc, dec */
+      c = btor_bv_add (d_mm, a, b);
+      d = btor_bv_sub (d_mm, c, b);
+      ASSERT_EQ (btor_bv_compare (a, d), 0);
+      btor_bv_free (d_mm, c);
+      btor_bv_free (d_mm, d);
+      c = btor_bv_neg (d_mm, a);
+      d = btor_bv_sub (d_mm, zero, a);
+      ASSERT_EQ (btor_bv_compare (c, d), 0);
+      btor_bv_free (d_mm, d);
+      d = btor_bv_add (d_mm, a, c);
+      ASSERT_TRUE (btor_bv_is_zero (d));
+      btor_bv_free (d_mm, c);
+      btor_bv_free (d_mm, d);
+      c = btor_bv_inc (d_mm, a);
+      d = btor_bv_dec (d_mm, c);
+      ASSERT_EQ (btor_bv_compare (a, d), 0);
+      btor_bv_free (d_mm, d);
+      d = btor_bv_one (d_mm, bw);
+      e = btor_bv_add (d_mm, a, d);
+      ASSERT_EQ (btor_bv_compare (c, e), 0);
+      btor_bv_free (d_mm, c);
+      btor_bv_free (d_mm, d);
+      btor_bv_free (d_mm, e);
+
+      /* mul */
+      res = btor_bv_new (d_mm, bw);
+      for (j = 0; j < bw; j++)
+      {
+        if (!btor_bv_get_bit (b, j)) continue;
+        c   = btor_bv_sll_uint64 (d_mm, a, j);
+        tmp = btor_bv_add (d_mm, res, c);
+        btor_bv_free (d_mm, res);
+        btor_bv_free (d_mm, c);
+        res = tmp;
+      }
+      c = btor_bv_mul (d_mm, a, b);
+      ASSERT_EQ (btor_bv_compare (c, res), 0);
+      btor_bv_free (d_mm, c);
+      btor_bv_free (d_mm, res);
+
+      /* udiv, urem (with divisors of varying length) */
+      res = btor_bv_srl_uint64 (
+          d_mm, b, btor_rng_pick_rand (d_rng, 0, bw - 1));
+      if (btor_bv_is_zero (res))
+      {
+        btor_bv_free (d_mm, res);
+        res = btor_bv_copy (d_mm, b);
+      }
+      c   = btor_bv_udiv (d_mm, a, res);
+      d   = btor_bv_urem (d_mm, a, res);
+      e   = btor_bv_mul (d_mm, c, res);
+      tmp = btor_bv_add (d_mm, e, d);
+      ASSERT_EQ (btor_bv_compare (a, tmp), 0);
+      ASSERT_LT (btor_bv_compare (d, res), 0);
+      btor_bv_free (d_mm, c);
+      btor_bv_free (d_mm, d);
+      btor_bv_free (d_mm, e);
+      btor_bv_free (d_mm, tmp);
+      btor_bv_free (d_mm, res);
+
+      /* slice, concat, sext */
+      up = btor_rng_pick_rand (d_rng, 0, bw - 1);
+      lo = btor_rng_pick_rand (d_rng, 0, up);
+      c  = btor_bv_slice (d_mm, a, up, lo);
+      ASSERT_EQ (btor_bv_get_width (c), up - lo + 1);
+      for (j = lo; j <= up; j++)
+        ASSERT_EQ (btor_bv_get_bit (c, j - lo), btor_bv_get_bit (a, j));
+      d = btor_bv_concat (d_mm, c, b);
+      e = btor_bv_slice (d_mm, d, bw - 1, 0);
+      ASSERT_EQ (btor_bv_compare (b, e), 0);
+      btor_bv_free (d_mm, e);
+      e = btor_bv_slice (d_mm, d, btor_bv_get_width (d) - 1, bw);
+      ASSERT_EQ (btor_bv_compare (c, e), 0);
+      btor_bv_free (d_mm, e);
+      btor_bv_free (d_mm, d);
+      d = btor_bv_sext (d_mm, c, lo);
+      for (j = 0; j < btor_bv_get_width (d); j++)
+        ASSERT_EQ (btor_bv_get_bit (d, j),
+                   btor_bv_get_bit (a, j <= up - lo ? j + lo : up));
+      btor_bv_free (d_mm, c);
+      btor_bv_free (d_mm, d);
+
+      btor_bv_free (d_mm, a);
+      btor_bv_free (d_mm, b);
+    }
+    btor_bv_free (d_mm, zero);
+  }
+
+  void into_bitvec (uint32_t num_tests, uint32_t bw)
+  {
+    uint32_t i, up, lo;
+    uint64_t shift;
+    BtorBitVector *a, *b, *c, *d, *e;
+    BtorBitVectorPool *pool;
+
+    BtorBitVector *(*unary[]) (BtorMemMgr *, const BtorBitVector *) = {
+        btor_bv_not, btor_bv_neg, btor_bv_inc, btor_bv_dec, btor_bv_copy};
+    void (*unary_into[]) (BtorBitVector *, const BtorBitVector *) = {
+        btor_bv_not_into,
+        btor_bv_neg_into,
+        btor_bv_inc_into,
+        btor_bv_dec_into,
+        btor_bv_copy_into};
+    BtorBitVector *(*binary[]) (
+        BtorMemMgr *, const BtorBitVector *, const BtorBitVector *) = {
+        btor_bv_add, btor_bv_sub, btor_bv_and, btor_bv_or, btor_bv_xor};
+    void (*binary_into[]) (
+        BtorBitVector *, const BtorBitVector *, const BtorBitVector *) = {
+        btor_bv_add_into,
+        btor_bv_sub_into,
+        btor_bv_and_into,
+        btor_bv_or_into,
+        btor_bv_xor_into};
+
+    pool = &d_btor->bv_pool;
+    for (i = 0; i < num_tests; i++)
+    {
+      a = btor_bv_new_random (d_mm, d_rng, bw);
+      b = btor_bv_new_random (d_mm, d_rng, bw);
+      c = btor_bv_pool_get (pool, bw);
+      ASSERT_TRUE (btor_bv_is_zero (c));
+
+      for (size_t j = 0; j < sizeof (unary) / sizeof (*unary); j++)
+      {
+        d = unary[j](d_mm, a);
+        unary_into[j](c, a);
+        ASSERT_EQ (btor_bv_compare (c, d), 0);
+        /* in place */
+        btor_bv_copy_into (c, a);
+        unary_into[j](c, c);
+        ASSERT_EQ (btor_bv_compare (c, d), 0);
+        btor_bv_free (d_mm, d);
+      }
+
+      for (size_t j = 0; j < sizeof (binary) / sizeof (*binary); j++)
+      {
+        d = binary[j](d_mm, a, b);
+        binary_into[j](c, a, b);
+        ASSERT_EQ (btor_bv_compare (c, d), 0);
+        /* in place */
+        btor_bv_copy_into (c, a);
+        binary_into[j](c, c, b);
+        ASSERT_EQ (btor_bv_compare (c, d), 0);
+        btor_bv_copy_into (c, b);
+        binary_into[j](c, a, c);
+        ASSERT_EQ (btor_bv_compare (c, d), 0);
+        btor_bv_free (d_mm, d);
+      }
+
+      d = btor_bv_mul (d_mm, a, b);
+      btor_bv_mul_into (c, a, b);
+      ASSERT_EQ (btor_bv_compare (c, d), 0);
+      btor_bv_free (d_mm, d);
+
+      shift = btor_rng_pick_rand (d_rng, 0, bw + 1);
+      d     = btor_bv_sll_uint64 (d_mm, a, shift);
+      btor_bv_copy_into (c, a);
+      btor_bv_sll_uint64_into (c, c, shift);
+      ASSERT_EQ (btor_bv_compare (c, d), 0);
+      btor_bv_free (d_mm, d);
+      d = btor_bv_srl_uint64 (d_mm, a, shift);
+      btor_bv_copy_into (c, a);
+      btor_bv_srl_uint64_into (c, c, shift);
+      ASSERT_EQ (btor_bv_compare (c, d), 0);
+      btor_bv_free (d_mm, d);
+
+      btor_bv_ones_into (c);
+      ASSERT_TRUE (btor_bv_is_ones (c));
+      btor_bv_one_into (c);
+      ASSERT_TRUE (btor_bv_is_one (c));
+      btor_bv_zero_into (c);
+      ASSERT_TRUE (btor_bv_is_zero (c));
+      btor_bv_pool_put (pool, c);
+
+      up = btor_rng_pick_rand (d_rng, 0, bw - 1);
+      lo = btor_rng_pick_rand (d_rng, 0, up);
+      d  = btor_bv_slice (d_mm, a, up, lo);
+      c  = btor_bv_pool_get (pool, up - lo + 1);
+      btor_bv_slice_into (c, a, up, lo);
+      ASSERT_EQ (btor_bv_compare (c, d), 0);
+      e = btor_bv_uext (d_mm, d, bw - (up - lo + 1));
+      btor_bv_free (d_mm, d);
+      d = btor_bv_pool_get (pool, bw);
+      btor_bv_copy_into (d, b);
+      btor_bv_uext_into (d, c);
+      ASSERT_EQ (btor_bv_compare (d, e), 0);
+      btor_bv_free (d_mm, e);
+      btor_bv_pool_put (pool, c);
+      btor_bv_pool_put (pool, d);
+
+      btor_bv_free (d_mm, a);
+      btor_bv_free (d_mm, b);
+    }
+  }
+
   void test_get_num_aux (const std::string &val,
                          uint32_t (*fun) (const BtorBitVector *),
                          bool from_msb = true,
@@ -2693,6 +2902,76 @@ TEST_F (TestBv, flipped_bit_range)
   flipped_bit_range_bitvec (BTOR_TEST_BITVEC_TESTS, 64);
 }
 
+TEST_F (TestBv, wide)
+{
+  wide_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 64);
+  wide_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 65);
+  wide_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 100);
+  wide_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 128);
+  wide_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 129);
+  wide_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 250);
+}
+
+TEST_F (TestBv, udiv_urem_wide)
+{
+  /* divisions that require a correction of the estimated quotient limb
+   * (for 32-bit and 64-bit limbs, respectively) */
+  const char *tests[][4] = {
+      {"7fffffff8000000000000000000000000000000000000000",
+       "0000000080000000ffffffff000000010000000000000000",
+       "0000000000000000000000000000000000000000fffffffd",
+       "0000000000000003fffffffc000000030000000000000000"},
+      {"000000008000000000000000000000030000000000000000",
+       "000000002000000000000000000000010000000000000000",
+       "000000000000000000000000000000000000000000000003",
+       "000000002000000000000000000000000000000000000000"},
+      {"7fffffffffffffff8000000000000000"
+       "00000000000000000000000000000000",
+       "00000000000000008000000000000000"
+       "ffffffffffffffff0000000000000001",
+       "00000000000000000000000000000000"
+       "0000000000000000fffffffffffffffd",
+       "00000000000000000000000000000003"
+       "fffffffffffffffc0000000000000003"},
+      {"80000000000000000000000000000000"
+       "00000000000000030000000000000000",
+       "20000000000000000000000000000000"
+       "00000000000000010000000000000000",
+       "00000000000000000000000000000000"
+       "00000000000000000000000000000003",
+       "20000000000000000000000000000000"
+       "00000000000000000000000000000000"},
+  };
+  uint32_t i, j, bw;
+  BtorBitVector *bv[4], *q, *r;
+
+  for (i = 0; i < sizeof (tests) / sizeof (tests[0]); i++)
+  {
+    bw = strlen (tests[i][0]) * 4;
+    for (j = 0; j < 4; j++) bv[j] = btor_bv_consth (d_mm, tests[i][j], bw);
+    q = btor_bv_udiv (d_mm, bv[0], bv[1]);
+    r = btor_bv_urem (d_mm, bv[0], bv[1]);
+    ASSERT_EQ (btor_bv_compare (q, bv[2]), 0);
+    ASSERT_EQ (btor_bv_compare (r, bv[3]), 0);
+    btor_bv_free (d_mm, q);
+    btor_bv_free (d_mm, r);
+    for (j = 0; j < 4; j++) btor_bv_free (d_mm, bv[j]);
+  }
+}
+
+TEST_F (TestBv, into)
+{
+  into_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 1);
+  into_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 7);
+  into_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 32);
+  into_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 33);
+  into_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 64);
+  into_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 65);
+  into_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 100);
+  into_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 250);
+  into_bitvec (BTOR_TEST_BITVEC_TESTS / 100, 300);
+}
+
 TEST_F (TestBv, is_umulo)
 {
   is_umulo_bitvec (1);
@@ -933,3 +933,39 @@ TEST_F (TestExp, dec)
   btor_node_release (d_btor, exp2);
   btor_node_release (d_btor, exp3);
 }
+
+TEST_F (TestExp, unique_table_resize)
+{
+  const uint32_t n = 64;
+  uint32_t i, j, num_elements;
+  bool resizing = false;
+  BtorNode *vars[n], *adds[n][n];
+  BtorSortId sort;
+
+  sort         = btor_sort_bv (d_btor, 8);
+  num_elements = d_btor->nodes_unique_table.num_elements;
+
+  for (i = 0; i < n; i++) vars[i] = btor_exp_var (d_btor, sort, 0);
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++)
+    {
+      adds[i][j] = btor_node_create_bv_add (d_btor, vars[i], vars[j]);
+      if (d_btor->nodes_unique_table.old_chains) resizing = true;
+    }
+  ASSERT_TRUE (resizing);
+
+  /* nodes are found regardless of whether their chain has been migrated */
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++)
+    {
+      BtorNode *add = btor_node_create_bv_add (d_btor, vars[i], vars[j]);
+      ASSERT_EQ (add, adds[i][j]);
+      btor_node_release (d_btor, add);
+    }
+
+  for (i = 0; i < n; i++)
+    for (j = 0; j < n; j++) btor_node_release (d_btor, adds[i][j]);
+  for (i = 0; i < n; i++) btor_node_release (d_btor, vars[i]);
+  btor_sort_release (d_btor, sort);
+  ASSERT_EQ (d_btor->nodes_unique_table.num_elements, num_elements);
+}
@@ -51,6 +51,7 @@ TEST_F (TestHash, traverse_str2i)
 
   BtorPtrHashTable *ht;
   BtorPtrHashBucket *p;
+  BtorPtrHashTableIterator it;
   char buffer[20];
   int32_t i;
 
@@ -71,8 +72,11 @@ TEST_F (TestHash, traverse_str2i)
     ASSERT_EQ (btor_hashptr_table_get (ht, buffer)->data.as_int, i);
   }
 
-  for (p = ht->first; p; p = p->next)
+  btor_iter_hashptr_init (&it, ht);
+  while (btor_iter_hashptr_has_next (&it))
   {
+    p = it.bucket;
+    (void) btor_iter_hashptr_next (&it);
     fprintf (d_log_file, "%s %d\n", (char *) p->key, p->data.as_int);
     btor_mem_freestr (d_mm, (char *) p->key);
   }
@@ -86,6 +90,7 @@ TEST_F (TestHash, str2str)
 
   BtorPtrHashTable *ht;
   BtorPtrHashBucket *p;
+  BtorPtrHashTableIterator it;
   BtorHashTableData data;
   char buffer[20];
   void *key;
@@ -119,8 +124,11 @@ TEST_F (TestHash, str2str)
     btor_mem_freestr (d_mm, (char *) key);
   }
 
-  for (p = ht->first; p; p = p->next)
+  btor_iter_hashptr_init (&it, ht);
+  while (btor_iter_hashptr_has_next (&it))
   {
+    p = it.bucket;
+    (void) btor_iter_hashptr_next (&it);
     fprintf (d_log_file, "%s -> %s\n", (char *) p->key, p->data.as_str);
     btor_mem_freestr (d_mm, (char *) p->key);
     btor_mem_freestr (d_mm, p->data.as_str);
@@ -128,3 +136,169 @@ TEST_F (TestHash, str2str)
 
   btor_hashptr_table_delete (ht);
 }
+
+TEST_F (TestHash, order_remove)
+{
+  BtorPtrHashTable *ht;
+  BtorPtrHashTableIterator it;
+  BtorPtrHashBucket *p;
+  uintptr_t i, j, n = 999;
+  size_t allocated = d_mm->allocated;
+
+  ht = btor_hashptr_table_new (d_mm, 0, 0);
+
+  for (i = 1; i <= n; i++)
+    btor_hashptr_table_add (ht, (void *) i)->data.as_int = (int32_t) i;
+  for (i = 1; i <= n; i += 3)
+    btor_hashptr_table_remove (ht, (void *) i, 0, 0);
+  ASSERT_EQ (ht->count, n - (n + 2) / 3);
+
+  /* removed keys are not found, buckets of other keys are unaffected */
+  for (i = 1; i <= n; i++)
+  {
+    p = btor_hashptr_table_get (ht, (void *) i);
+    if (i % 3 == 1)
+      ASSERT_EQ (p, nullptr);
+    else
+    {
+      ASSERT_NE (p, nullptr);
+      ASSERT_EQ (p->data.as_int, (int32_t) i);
+    }
+  }
+
+  /* insertion order is preserved in both directions */
+  ASSERT_EQ (btor_hashptr_table_first (ht)->key, (void *) 2);
+  ASSERT_EQ (btor_hashptr_table_last (ht)->key, (void *) n);
+  j = 1;
+  btor_iter_hashptr_init (&it, ht);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    if (++j % 3 == 1) j++;
+    ASSERT_EQ (btor_iter_hashptr_next (&it), (void *) j);
+  }
+  ASSERT_EQ (j, n);
+  btor_iter_hashptr_init_reversed (&it, ht);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    ASSERT_EQ (btor_iter_hashptr_next (&it), (void *) j);
+    if (--j % 3 == 1) j--;
+  }
+  ASSERT_EQ (j, 0u);
+
+  /* remove while traversing, then reuse the table */
+  btor_iter_hashptr_init (&it, ht);
+  while (btor_iter_hashptr_has_next (&it))
+    btor_hashptr_table_remove (ht, btor_iter_hashptr_next (&it), 0, 0);
+  ASSERT_EQ (ht->count, 0u);
+  ASSERT_EQ (btor_hashptr_table_first (ht), nullptr);
+
+  for (i = n; i > 0; i--) btor_hashptr_table_add (ht, (void *) i);
+  btor_iter_hashptr_init (&it, ht);
+  for (i = n; i > 0; i--)
+  {
+    ASSERT_TRUE (btor_iter_hashptr_has_next (&it));
+    ASSERT_EQ (btor_iter_hashptr_next (&it), (void *) i);
+  }
+  ASSERT_FALSE (btor_iter_hashptr_has_next (&it));
+
+  btor_hashptr_table_delete (ht);
+  ASSERT_EQ (allocated, d_mm->allocated);
+}
+
+TEST_F (TestHash, churn_remove)
+{
+  BtorPtrHashTable *ht;
+  BtorPtrHashTableIterator it;
+  uintptr_t i, n = 1 << 20;
+  size_t bytes;
+
+  ht = btor_hashptr_table_new (d_mm, 0, 0);
+
+  /* one long-lived key, all other keys are removed from the middle */
+  btor_hashptr_table_add (ht, (void *) 1);
+  btor_hashptr_table_add (ht, (void *) 2);
+  bytes = 0;
+  for (i = 3; i <= n; i++)
+  {
+    btor_hashptr_table_add (ht, (void *) i)->data.as_int = (int32_t) i;
+    btor_hashptr_table_remove (ht, (void *) (i - 1), 0, 0);
+    ASSERT_EQ (ht->count, 2u);
+    if (btor_hashptr_table_bytes (ht) > bytes)
+      bytes = btor_hashptr_table_bytes (ht);
+  }
+  ASSERT_LE (ht->end, 4u);
+  ASSERT_LE (bytes, 1024u);
+  ASSERT_EQ (btor_hashptr_table_get (ht, (void *) n)->data.as_int,
+             (int32_t) n);
+
+  btor_iter_hashptr_init (&it, ht);
+  ASSERT_EQ (btor_iter_hashptr_next (&it), (void *) 1);
+  ASSERT_EQ (btor_iter_hashptr_next (&it), (void *) n);
+  ASSERT_FALSE (btor_iter_hashptr_has_next (&it));
+
+  btor_hashptr_table_delete (ht);
+}
+
+TEST_F (TestHash, stable_buckets)
+{
+  BtorPtrHashTable *ht;
+  BtorPtrHashTableIterator it;
+  BtorPtrHashBucket *b[64];
+  uintptr_t i, j, k, n = 64;
+
+  ht = btor_hashptr_table_new (d_mm, 0, 0);
+
+  for (i = 1; i <= n; i++)
+  {
+    b[i - 1]              = btor_hashptr_table_add (ht, (void *) i);
+    b[i - 1]->data.as_int = (int32_t) i;
+  }
+
+  /* remove visited elements and add new ones while traversing */
+  btor_iter_hashptr_init (&it, ht);
+  for (i = 1; i <= n; i += 2)
+  {
+    ASSERT_EQ (btor_iter_hashptr_next (&it), (void *) i);
+    ASSERT_EQ (btor_iter_hashptr_next (&it), (void *) (i + 1));
+    btor_hashptr_table_remove (ht, (void *) i, 0, 0);
+    btor_hashptr_table_add (ht, (void *) (n + i))->data.as_int =
+        (int32_t) (n + i);
+  }
+  /* added elements are visited in insertion order */
+  for (i = 1; i <= n; i += 2)
+  {
+    ASSERT_TRUE (btor_iter_hashptr_has_next (&it));
+    ASSERT_EQ (btor_iter_hashptr_next (&it), (void *) (n + i));
+  }
+  ASSERT_FALSE (btor_iter_hashptr_has_next (&it));
+
+  /* buckets of remaining elements have not been moved */
+  for (i = 2; i <= n; i += 2)
+  {
+    ASSERT_EQ (btor_hashptr_table_get (ht, (void *) i), b[i - 1]);
+    ASSERT_EQ (b[i - 1]->key, (void *) i);
+    ASSERT_EQ (b[i - 1]->data.as_int, (int32_t) i);
+  }
+
+  /* positions of removed elements are reused, order is preserved */
+  ASSERT_EQ (ht->end, n);
+  j = 2;
+  k = 0;
+  btor_iter_hashptr_init (&it, ht);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    i = (uintptr_t) btor_iter_hashptr_next (&it);
+    if (i <= n)
+    {
+      ASSERT_EQ (i, j);
+      j += 2;
+    }
+    else
+      k += 1;
+  }
+  ASSERT_EQ (j, n + 2);
+  ASSERT_EQ (k, n / 2);
+  ASSERT_EQ (btor_hashptr_table_last (ht)->key, (void *) (2 * n - 1));
+
+  btor_hashptr_table_delete (ht);
+}
@@ -9,7 +9,9 @@
 #include "test.h"
 
 extern "C" {
+#include "btorcore.h"
 #include "btoropt.h"
+#include "btorslvfun.h"
 }
 
 class TestInc : public TestBoolector
@@ -255,3 +257,319 @@ TEST_F (TestInc, lemmas_on_demand1)
   boolector_release_sort (d_btor, s);
   boolector_release_sort (d_btor, as);
 }
+
+TEST_F (TestInc, lemma_reuse)
+{
+  int32_t sat_result;
+  uint32_t i, iterations;
+  BoolectorNode *array, *index1, *index2, *read1, *read2, *eq, *ne;
+  BoolectorSort s, as;
+  BtorFunSolver *slv;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_REWRITE_LEVEL, 0);
+  /* lemmas are assumed as in the quantifier engine */
+  slv                = (BtorFunSolver *) btor_new_fun_solver (d_btor);
+  slv->assume_lemmas = true;
+  d_btor->slv        = (BtorSolver *) slv;
+
+  s      = boolector_bitvec_sort (d_btor, 8);
+  as     = boolector_array_sort (d_btor, s, s);
+  array  = boolector_array (d_btor, as, "array1");
+  index1 = boolector_var (d_btor, s, "index1");
+  index2 = boolector_var (d_btor, s, "index2");
+  read1  = boolector_read (d_btor, array, index1);
+  read2  = boolector_read (d_btor, array, index2);
+  eq     = boolector_eq (d_btor, index1, index2);
+  ne     = boolector_ne (d_btor, read1, read2);
+  boolector_assert (d_btor, ne);
+  for (i = 0; i < 4; i++)
+  {
+    iterations = slv->stats.refinement_iterations;
+    boolector_assume (d_btor, eq);
+    sat_result = boolector_sat (d_btor);
+    ASSERT_EQ (sat_result, BOOLECTOR_UNSAT);
+    /* the lemma of the first call is re-used in subsequent calls */
+    if (i == 0)
+      ASSERT_GT (slv->stats.refinement_iterations, iterations);
+    else
+      ASSERT_EQ (slv->stats.refinement_iterations, iterations);
+  }
+  ASSERT_EQ (slv->stats.lemmas_reused, 3u);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  boolector_release (d_btor, array);
+  boolector_release (d_btor, index1);
+  boolector_release (d_btor, index2);
+  boolector_release (d_btor, read1);
+  boolector_release (d_btor, read2);
+  boolector_release (d_btor, eq);
+  boolector_release (d_btor, ne);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, as);
+}
+
+TEST_F (TestInc, dual_prop_clone)
+{
+  uint32_t i;
+  BoolectorNode *array, *index[3], *read[3], *eq, *ne;
+  BoolectorSort s, as;
+  BtorFunSolver *slv;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_FUN_DUAL_PROP, 1);
+  s     = boolector_bitvec_sort (d_btor, 8);
+  as    = boolector_array_sort (d_btor, s, s);
+  array = boolector_array (d_btor, as, "array");
+  for (i = 0; i < 3; i++)
+  {
+    index[i] = boolector_var (d_btor, s, 0);
+    read[i]  = boolector_read (d_btor, array, index[i]);
+  }
+  ne = boolector_ne (d_btor, read[0], read[1]);
+  boolector_assert (d_btor, ne);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+
+  /* constraints of popped scopes are removed from the clone */
+  eq = boolector_eq (d_btor, index[0], index[1]);
+  boolector_push (d_btor, 1);
+  boolector_assert (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  boolector_pop (d_btor, 1);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  boolector_release (d_btor, eq);
+
+  /* new constraints and inputs are added to the clone */
+  eq = boolector_eq (d_btor, read[2], read[0]);
+  boolector_assert (d_btor, eq);
+  boolector_release (d_btor, eq);
+  eq = boolector_eq (d_btor, index[2], index[1]);
+  boolector_assume (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  boolector_release (d_btor, eq);
+
+  slv = BTOR_FUN_SOLVER (d_btor);
+  ASSERT_EQ (slv->stats.dp_clones, 1u);
+
+  for (i = 0; i < 3; i++)
+  {
+    boolector_release (d_btor, index[i]);
+    boolector_release (d_btor, read[i]);
+  }
+  boolector_release (d_btor, ne);
+  boolector_release (d_btor, array);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, as);
+}
+
+TEST_F (TestInc, dual_prop_clone_pop)
+{
+  uint32_t i, max_count;
+  BoolectorNode *array, *index, *read, *x, *c, *add, *mul, *eq, *ne;
+  BoolectorSort s, as;
+  BtorFunSolver *slv;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_FUN_DUAL_PROP, 1);
+  s     = boolector_bitvec_sort (d_btor, 8);
+  as    = boolector_array_sort (d_btor, s, s);
+  array = boolector_array (d_btor, as, "array");
+  x     = boolector_var (d_btor, s, "x");
+  read  = boolector_read (d_btor, array, x);
+  ne    = boolector_ne (d_btor, read, x);
+  boolector_release (d_btor, read);
+  boolector_assert (d_btor, ne);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+
+  slv       = BTOR_FUN_SOLVER (d_btor);
+  max_count = 0;
+  for (i = 0; i < 60; i++)
+  {
+    boolector_push (d_btor, 1);
+    index = boolector_var (d_btor, s, "index");
+    c     = boolector_unsigned_int (d_btor, i, s);
+    add   = boolector_add (d_btor, index, c);
+    mul   = boolector_mul (d_btor, add, index);
+    eq    = boolector_eq (d_btor, mul, x);
+    boolector_assert (d_btor, eq);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, mul);
+    boolector_release (d_btor, add);
+    boolector_release (d_btor, c);
+    boolector_release (d_btor, index);
+    boolector_pop (d_btor, 1);
+    if (slv->dp_exp_map && slv->dp_exp_map->table->count > max_count)
+      max_count = slv->dp_exp_map->table->count;
+  }
+
+  /* The scopes are not referenced by lemmas, hence their expressions only
+   * remain reachable until the activation variable of the popped scope is
+   * substituted, after which the clone is rebuilt to release them. */
+  ASSERT_GT (slv->stats.dp_clones, 1u);
+  ASSERT_LT (max_count, 1000u);
+
+  boolector_release (d_btor, ne);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, array);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, as);
+}
+
+TEST_F (TestInc, memory_limit)
+{
+  int32_t sat_result;
+  uint32_t i;
+  BoolectorNode *x, *y, *mul, *eq, *tmp;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_MEMORY_LIMIT, 1);
+  s   = boolector_bitvec_sort (d_btor, 64);
+  x   = boolector_var (d_btor, s, "x");
+  y   = boolector_var (d_btor, s, "y");
+  mul = boolector_copy (d_btor, x);
+  for (i = 0; i < 8; i++)
+  {
+    tmp = boolector_mul (d_btor, mul, y);
+    boolector_release (d_btor, mul);
+    mul = tmp;
+  }
+  eq = boolector_eq (d_btor, mul, x);
+  boolector_assert (d_btor, eq);
+
+  /* bit-blasting the multipliers exceeds the limit */
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_UNKNOWN);
+  ASSERT_EQ (boolector_get_unknown_reason (d_btor),
+             BOOLECTOR_UNKNOWN_REASON_MEMORY);
+
+  /* instance is still usable after lifting the limit */
+  boolector_set_opt (d_btor, BTOR_OPT_MEMORY_LIMIT, 0);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  ASSERT_EQ (boolector_get_unknown_reason (d_btor),
+             BOOLECTOR_UNKNOWN_REASON_NONE);
+  ASSERT_GT (d_btor->stats.memory_reductions, 0u);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, mul);
+  boolector_release (d_btor, eq);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestInc, mem_allocated)
+{
+  size_t nodes, models, total;
+  BoolectorNode *x, *y, *add, *eq;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  s   = boolector_bitvec_sort (d_btor, 32);
+  x   = boolector_var (d_btor, s, "x");
+  y   = boolector_var (d_btor, s, "y");
+  add = boolector_add (d_btor, x, y);
+  eq  = boolector_eq (d_btor, add, x);
+  boolector_assert (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+
+  nodes  = boolector_get_mem_allocated (d_btor, "nodes");
+  models = boolector_get_mem_allocated (d_btor, "models");
+  total  = boolector_get_mem_allocated (d_btor, 0);
+  ASSERT_GT (nodes, 0u);
+  ASSERT_GT (models, 0u);
+  ASSERT_GE (total, nodes + models);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, add);
+  boolector_release (d_btor, eq);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestInc, push_pop)
+{
+  int32_t sat_result;
+  uint32_t i;
+  BoolectorNode *x, *c, *eq, *ne, *ult, *ugt;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  s = boolector_bitvec_sort (d_btor, 8);
+  x = boolector_var (d_btor, s, "x");
+
+  /* contradicting assertions in consecutive scopes */
+  for (i = 0; i < 16; i++)
+  {
+    c  = boolector_unsigned_int (d_btor, i, s);
+    eq = boolector_eq (d_btor, x, c);
+    ne = boolector_ne (d_btor, x, c);
+    boolector_push (d_btor, 1);
+    boolector_assert (d_btor, eq);
+    sat_result = boolector_sat (d_btor);
+    ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+    boolector_assert (d_btor, ne);
+    sat_result = boolector_sat (d_btor);
+    ASSERT_EQ (sat_result, BOOLECTOR_UNSAT);
+    boolector_pop (d_btor, 1);
+    boolector_release (d_btor, c);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, ne);
+  }
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+
+  /* nested scopes */
+  c   = boolector_unsigned_int (d_btor, 4, s);
+  ult = boolector_ult (d_btor, x, c);
+  ugt = boolector_ugt (d_btor, x, c);
+  boolector_push (d_btor, 1);
+  boolector_assert (d_btor, ult);
+  boolector_push (d_btor, 2);
+  boolector_assert (d_btor, ugt);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_UNSAT);
+  boolector_pop (d_btor, 2);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+  boolector_pop (d_btor, 1);
+  boolector_assert (d_btor, ugt);
+  sat_result = boolector_sat (d_btor);
+  ASSERT_EQ (sat_result, BOOLECTOR_SAT);
+
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, ult);
+  boolector_release (d_btor, ugt);
+  boolector_release (d_btor, x);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestInc, push_pop_inconsistent)
+{
+  BoolectorNode *x, *y, *eq, *ne;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  s  = boolector_bitvec_sort (d_btor, 8);
+  x  = boolector_var (d_btor, s, "x");
+  y  = boolector_var (d_btor, s, "y");
+  eq = boolector_eq (d_btor, x, y);
+  ne = boolector_ne (d_btor, x, y);
+
+  /* the activation variable of the scope is substituted while solving */
+  boolector_assert (d_btor, ne);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  boolector_push (d_btor, 1);
+  boolector_assert (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  boolector_pop (d_btor, 1);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+
+  boolector_release (d_btor, eq);
+  boolector_release (d_btor, ne);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release_sort (d_btor, s);
+}
@@ -61,3 +61,134 @@ TEST_F (TestMem, strdup)
   ASSERT_EQ (strcmp (test, "test"), 0);
   btor_mem_freestr (d_mm, test);
 }
+
+TEST_F (TestMem, slab)
+{
+  uint32_t i;
+  int64_t *objs[100];
+  BtorMemSlab *slab =
+      btor_mem_slab_new (d_mm, BTOR_MEM_TAG_NODE, 3 * sizeof (int64_t));
+
+  for (i = 0; i < 100; i++)
+  {
+    objs[i] = (int64_t *) btor_mem_slab_alloc (slab);
+    ASSERT_NE (objs[i], nullptr);
+    ASSERT_EQ (objs[i][0], 0);
+    ASSERT_EQ (objs[i][2], 0);
+    objs[i][0] = objs[i][2] = i;
+  }
+  ASSERT_EQ (slab->cur, 100u);
+  ASSERT_GE (slab->capacity, 100u);
+  ASSERT_EQ (d_mm->allocated, sizeof (BtorMemSlab) + slab->bytes);
+  ASSERT_EQ (btor_mem_tag_allocated (d_mm, BTOR_MEM_TAG_NODE), d_mm->allocated);
+  for (i = 0; i < 100; i++) ASSERT_EQ (objs[i][2], i);
+
+  /* released objects are recycled (and cleared) */
+  btor_mem_slab_free (slab, objs[42]);
+  ASSERT_EQ (slab->cur, 99u);
+  ASSERT_EQ (btor_mem_slab_alloc (slab), objs[42]);
+  ASSERT_EQ (objs[42][0], 0);
+  ASSERT_EQ (slab->max, 100u);
+
+  btor_mem_slab_delete (slab);
+  ASSERT_EQ (d_mm->allocated, 0u);
+}
+
+TEST_F (TestMem, tag)
+{
+  int32_t *a, *b, *c;
+
+  BTOR_NEWN (d_mm, a, 10);
+  BTOR_NEWN_TAG (d_mm, BTOR_MEM_TAG_HASH, b, 20);
+  BTOR_CNEWN_TAG (d_mm, BTOR_MEM_TAG_AIG, c, 30);
+  ASSERT_EQ (btor_mem_tag_allocated (d_mm, BTOR_MEM_TAG_OTHER),
+             10 * sizeof (int32_t));
+  ASSERT_EQ (btor_mem_tag_allocated (d_mm, BTOR_MEM_TAG_HASH),
+             20 * sizeof (int32_t));
+  ASSERT_EQ (btor_mem_tag_allocated (d_mm, BTOR_MEM_TAG_AIG),
+             30 * sizeof (int32_t));
+  ASSERT_EQ (d_mm->allocated, 60 * sizeof (int32_t));
+
+  BTOR_REALLOC_TAG (d_mm, BTOR_MEM_TAG_HASH, b, 20, 40);
+  ASSERT_EQ (btor_mem_tag_allocated (d_mm, BTOR_MEM_TAG_HASH),
+             40 * sizeof (int32_t));
+  BTOR_DELETEN_TAG (d_mm, BTOR_MEM_TAG_HASH, b, 40);
+  ASSERT_EQ (btor_mem_tag_allocated (d_mm, BTOR_MEM_TAG_HASH), 0u);
+  ASSERT_EQ (btor_mem_tag_maxallocated (d_mm, BTOR_MEM_TAG_HASH),
+             40 * sizeof (int32_t));
+
+  BTOR_DELETEN (d_mm, a, 10);
+  BTOR_DELETEN_TAG (d_mm, BTOR_MEM_TAG_AIG, c, 30);
+  ASSERT_EQ (d_mm->allocated, 0u);
+  ASSERT_EQ (d_mm->maxallocated, 80 * sizeof (int32_t));
+  ASSERT_STREQ (btor_mem_tag_name (BTOR_MEM_TAG_AIG), "AIGs");
+}
+
+TEST_F (TestMem, limit)
+{
+  char *a, *b;
+
+  btor_mem_set_limit (d_mm, 100, 200);
+  BTOR_NEWN (d_mm, a, 100);
+  ASSERT_FALSE (d_mm->soft_limit_reached);
+  BTOR_NEWN_TAG (d_mm, BTOR_MEM_TAG_BV, b, 50);
+  ASSERT_TRUE (d_mm->soft_limit_reached);
+  ASSERT_FALSE (d_mm->hard_limit_reached);
+  BTOR_REALLOC_TAG (d_mm, BTOR_MEM_TAG_BV, b, 50, 150);
+  ASSERT_TRUE (d_mm->hard_limit_reached);
+
+  /* limit flags are sticky until checked explicitly */
+  BTOR_DELETEN_TAG (d_mm, BTOR_MEM_TAG_BV, b, 150);
+  ASSERT_TRUE (d_mm->hard_limit_reached);
+  btor_mem_check_limit (d_mm);
+  ASSERT_FALSE (d_mm->soft_limit_reached);
+  ASSERT_FALSE (d_mm->hard_limit_reached);
+
+  btor_mem_set_limit (d_mm, 50, 60);
+  ASSERT_TRUE (d_mm->soft_limit_reached);
+  ASSERT_TRUE (d_mm->hard_limit_reached);
+  btor_mem_set_limit (d_mm, 0, 0);
+  ASSERT_FALSE (d_mm->hard_limit_reached);
+
+  BTOR_DELETEN (d_mm, a, 100);
+}
+
+TEST_F (TestMem, thread)
+{
+  char *a, *b, *c;
+  BtorMemMgr *tmm0, *tmm1;
+
+  btor_mem_set_limit (d_mm, 1000, 2000);
+  BTOR_NEWN (d_mm, a, 100);
+  tmm0 = btor_mem_mgr_new_thread (d_mm, 2);
+  tmm1 = btor_mem_mgr_new_thread (d_mm, 2);
+  /* every thread gets half of the remaining budget */
+  ASSERT_EQ (tmm0->soft_limit, 550u);
+  ASSERT_EQ (tmm0->hard_limit, 1050u);
+
+  btor_mem_set_thread_mgr (tmm0);
+  ASSERT_EQ (btor_mem_get_thread_mgr (d_mm), tmm0);
+  BTOR_NEWN_TAG (d_mm, BTOR_MEM_TAG_BV, b, 500);
+  BTOR_DELETEN (d_mm, a, 100);
+  ASSERT_TRUE (tmm0->soft_limit_reached);
+  btor_mem_set_thread_mgr (tmm1);
+  BTOR_NEWN (d_mm, c, 300);
+  ASSERT_FALSE (tmm1->soft_limit_reached);
+  btor_mem_set_thread_mgr (0);
+  ASSERT_EQ (btor_mem_get_thread_mgr (d_mm), d_mm);
+
+  /* the shared manager is only updated when the threads are merged */
+  ASSERT_EQ (d_mm->allocated, 100u);
+  ASSERT_FALSE (d_mm->soft_limit_reached);
+  btor_mem_mgr_delete_thread (tmm0);
+  btor_mem_mgr_delete_thread (tmm1);
+  ASSERT_EQ (d_mm->allocated, 800u);
+  ASSERT_EQ (btor_mem_tag_allocated (d_mm, BTOR_MEM_TAG_BV), 500u);
+  ASSERT_GE (d_mm->maxallocated, 800u);
+  ASSERT_TRUE (d_mm->soft_limit_reached);
+  ASSERT_FALSE (d_mm->hard_limit_reached);
+
+  BTOR_DELETEN_TAG (d_mm, BTOR_MEM_TAG_BV, b, 500);
+  BTOR_DELETEN (d_mm, c, 300);
+  ASSERT_EQ (d_mm->allocated, 0u);
+}
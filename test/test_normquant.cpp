@@ -500,7 +500,7 @@ TEST_F (TestNormQuant, elim_ite2)
   result = btor_normalize_quantifiers_node (d_btor, forall);
   /* new UF introduced for ITE */
   ASSERT_EQ (d_btor->ufs->count, 1u);
-  uf = (BtorNode *) d_btor->ufs->first->key;
+  uf = (BtorNode *) btor_hashptr_table_first (d_btor->ufs)->key;
 
   X    = btor_exp_param (d_btor, sort, 0);
   Y[0] = btor_exp_param (d_btor, sort, 0);
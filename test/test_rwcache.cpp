@@ -0,0 +1,110 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2007-2021 by the authors listed in the AUTHORS file.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btorrwcache.h"
+}
+
+class TestRwCache : public TestBtor
+{
+ protected:
+  static constexpr uint32_t s_num_vars = 256;
+
+  void SetUp () override
+  {
+    TestBtor::SetUp ();
+
+    BtorSortId sort = btor_sort_bv (d_btor, 8);
+    for (uint32_t i = 0; i < s_num_vars; i++)
+    {
+      d_vars[i] = btor_exp_var (d_btor, sort, 0);
+      d_ids[i]  = btor_node_get_id (d_vars[i]);
+    }
+    btor_sort_release (d_btor, sort);
+  }
+
+  void TearDown () override
+  {
+    for (uint32_t i = 0; i < s_num_vars; i++)
+      btor_node_release (d_btor, d_vars[i]);
+    TestBtor::TearDown ();
+  }
+
+  BtorNode *d_vars[s_num_vars];
+  int32_t d_ids[s_num_vars];
+};
+
+TEST_F (TestRwCache, add_get)
+{
+  BtorRwCache *rwc = d_btor->rw_cache;
+  uint32_t i, j;
+  int32_t k;
+
+  for (i = 0; i < 16; i++)
+    for (j = 0; j < 16; j++)
+      btor_rw_cache_add (
+          rwc, BTOR_BV_ADD_NODE, d_ids[i], d_ids[j], 0, d_ids[i ^ j]);
+
+  /* the cache grows at most once per insertion, entries that still collide
+   * in a full set are evicted even below the memory budget */
+  ASSERT_EQ (rwc->count + rwc->num_evict, 256u);
+  ASSERT_LE (rwc->num_evict, 8u);
+  ASSERT_LT (rwc->num_sets, rwc->max_sets);
+  for (i = 0; i < 16; i++)
+    for (j = 0; j < 16; j++)
+    {
+      k = btor_rw_cache_get (rwc, BTOR_BV_ADD_NODE, d_ids[i], d_ids[j], 0);
+      ASSERT_TRUE (k == 0 || k == d_ids[i ^ j]);
+      ASSERT_EQ (btor_rw_cache_get (
+                     rwc, BTOR_BV_MUL_NODE, d_ids[i], d_ids[j], 0),
+                 0);
+    }
+  ASSERT_EQ (rwc->num_hit, rwc->count);
+  ASSERT_EQ (rwc->num_miss, 256u + rwc->num_evict);
+
+  /* changing the memory budget resets the cache */
+  btor_opt_set (d_btor, BTOR_OPT_RW_CACHE_SIZE, 0);
+  ASSERT_EQ (rwc->count, 0u);
+  btor_rw_cache_add (rwc, BTOR_BV_ADD_NODE, d_ids[0], d_ids[1], 0, d_ids[2]);
+  ASSERT_EQ (btor_rw_cache_get (rwc, BTOR_BV_ADD_NODE, d_ids[0], d_ids[1], 0),
+             0);
+}
+
+TEST_F (TestRwCache, evict)
+{
+  BtorRwCache *rwc;
+  uint32_t i, j, n;
+
+  btor_opt_set (d_btor, BTOR_OPT_RW_CACHE_SIZE, 1);
+  rwc = d_btor->rw_cache;
+
+  n = rwc->max_sets * BTOR_RW_CACHE_WAYS;
+  ASSERT_LE (n * sizeof (BtorRwCacheTuple), 1u << 20);
+  ASSERT_LT (n, s_num_vars * s_num_vars);
+
+  for (i = 0; i < s_num_vars; i++)
+    for (j = 0; j < s_num_vars; j++)
+    {
+      btor_rw_cache_add (
+          rwc, BTOR_BV_AND_NODE, d_ids[i], d_ids[j], 0, d_ids[i]);
+      /* most recently added entry is always cached */
+      ASSERT_EQ (btor_rw_cache_get (
+                     rwc, BTOR_BV_AND_NODE, d_ids[i], d_ids[j], 0),
+                 d_ids[i]);
+    }
+
+  ASSERT_EQ (rwc->num_sets, rwc->max_sets);
+  ASSERT_LE (rwc->count, n);
+  ASSERT_EQ (rwc->count + rwc->num_evict, s_num_vars * s_num_vars);
+  ASSERT_GT (rwc->num_evict, 0u);
+  ASSERT_LE (btor_rw_cache_bytes (rwc), (size_t) 1 << 20);
+}
@@ -40,3 +40,48 @@ TEST_F (TestSatMgr, next_cnf_id)
   ASSERT_EQ (btor_sat_mgr_next_cnf_id (d_smgr), 4);
   btor_sat_reset (d_smgr);
 }
+
+TEST_F (TestSatMgr, portfolio)
+{
+  int32_t a, b;
+
+  btor_opt_set (d_btor, BTOR_OPT_SAT_ENGINE_PORTFOLIO, 1);
+  btor_sat_enable_solver (d_smgr);
+  btor_sat_init (d_smgr);
+  a = btor_sat_mgr_next_cnf_id (d_smgr);
+  b = btor_sat_mgr_next_cnf_id (d_smgr);
+  btor_sat_add (d_smgr, a);
+  btor_sat_add (d_smgr, b);
+  btor_sat_add (d_smgr, 0);
+  btor_sat_add (d_smgr, -a);
+  btor_sat_add (d_smgr, b);
+  btor_sat_add (d_smgr, 0);
+  btor_sat_assume (d_smgr, -b);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_UNSAT);
+  ASSERT_TRUE (btor_sat_failed (d_smgr, -b));
+  btor_sat_assume (d_smgr, -a);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_sat_deref (d_smgr, a), -1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, b), 1);
+  btor_sat_reset (d_smgr);
+}
+
+#ifdef BTOR_USE_PICOSAT
+TEST_F (TestSatMgr, phase)
+{
+  int32_t a, b;
+
+  btor_opt_set (d_btor, BTOR_OPT_SAT_ENGINE, BTOR_SAT_ENGINE_PICOSAT);
+  btor_sat_enable_solver (d_smgr);
+  btor_sat_init (d_smgr);
+  a = btor_sat_mgr_next_cnf_id (d_smgr);
+  b = btor_sat_mgr_next_cnf_id (d_smgr);
+  /* a and b are unconstrained, their values are given by the phases */
+  btor_sat_phase (d_smgr, a);
+  btor_sat_phase (d_smgr, -b);
+  ASSERT_EQ (btor_sat_check_sat (d_smgr, -1), BTOR_RESULT_SAT);
+  ASSERT_EQ (btor_sat_deref (d_smgr, a), 1);
+  ASSERT_EQ (btor_sat_deref (d_smgr, b), -1);
+  btor_sat_reset (d_smgr);
+}
+#endif